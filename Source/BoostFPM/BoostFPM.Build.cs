@@ -6,11 +6,7 @@ public class BoostFPM : ModuleRules
 {
     public BoostFPM(ReadOnlyTargetRules Target) : base(Target)
     {
-		PCHUsage = ModuleRules.PCHUsageMode.UseSharedPCHs;
-        PrivatePCHHeaderFile = "Public/BoostFPM.h";
-        
-        bUseUnity = false;
-
+        // Header only, nothing to compile
         Type = ModuleType.External;
 
         // Add any include paths for the plugin
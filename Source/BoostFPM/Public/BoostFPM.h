@@ -1,11 +1,13 @@
 
+#pragma once
+
+// boost multiprecision, for FRealFloat when USE_BOOST_BIG is 1. odeint is in BoostFPMOdeint.h, as it's much heavier and the plugin doesn't use it
 #pragma warning(push)
 #pragma warning(disable: 4996)
 #pragma warning(disable: 4668)
 
 #define BOOST_ALLOW_DEPRECATED_HEADERS 1
 #include <boost/config.hpp>
-#include <boost/numeric/odeint.hpp>
 #include <boost/multiprecision/cpp_bin_float.hpp>
 #include <boost/multiprecision/number.hpp>
 
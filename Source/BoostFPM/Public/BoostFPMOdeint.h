@@ -0,0 +1,13 @@
+
+#pragma once
+
+// boost odeint, the ordinary differential equations solvers, with boost multiprecision (see BoostFPM.h)
+#include "BoostFPM/Public/BoostFPM.h"
+
+#pragma warning(push)
+#pragma warning(disable: 4996)
+#pragma warning(disable: 4668)
+
+#include <boost/numeric/odeint.hpp>
+
+#pragma warning(pop)
@@ -11,3 +11,33 @@ void UPrecisionConversionMath::ConvQuatFloatToRotatorFloat(const FQuatFloat& Qua
 {
     Rot = FRotatorFloat(Quat);
 }
+
+FRealFloat UPrecisionConversionMath::ConvRealFixedToRealFloat(const FRealFixed& InVal)
+{
+    return FRealFloat(InVal);
+}
+
+FRealFixed UPrecisionConversionMath::ConvRealFloatToRealFixed(const FRealFloat& InVal)
+{
+    return FRealFixed(InVal);
+}
+
+FVectorFloat UPrecisionConversionMath::ConvVectorFixedToVectorFloat(const FVectorFixed& InVec)
+{
+    return FVectorFloat(InVec);
+}
+
+FVectorFixed UPrecisionConversionMath::ConvVectorFloatToVectorFixed(const FVectorFloat& InVec)
+{
+    return FVectorFixed(InVec);
+}
+
+FRotatorFloat UPrecisionConversionMath::ConvRotatorFixedToRotatorFloat(const FRotatorFixed& InRot)
+{
+    return FRotatorFloat(InRot);
+}
+
+FRotatorFixed UPrecisionConversionMath::ConvRotatorFloatToRotatorFixed(const FRotatorFloat& InRot)
+{
+    return FRotatorFixed(InRot);
+}
@@ -0,0 +1,301 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+#include <cstring>
+#include <type_traits>
+
+// Binary serialization of ttmath numbers, for the native Serialize of the precision structs.
+// The words are written lowest first, each in the byte order of the archive, so when the archive doesn't swap bytes, a number is a single
+// Ar.Serialize of its words. On little-endian platforms, the bytes don't depend on the size of ttmath::uint.
+// Archives provide Serialize(void*, int64), IsByteSwapping() and operator<< for uint32 and uint64, like FArchive.
+//
+// The canonical encoding, for files read by other platforms and builds (replays, shared state), doesn't depend on the archive either:
+//   Header, 12 bytes: "SKPC", uint16 version, uint16 mantissa bits, uint16 fraction bits (REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT),
+//                     uint8 bytes per value, uint8 ttmath backend of the writer (informative: every backend gives the same bits)
+//   Then each fixed-point number, as its mantissa in two's complement, little endian, on 8 bytes per 64 bits of mantissa and fraction.
+// Numbers written with other settings are converted when they're decoded: rounded to the nearest (ties to even) when the fraction is
+// shorter, and saturated to the largest mantissa when they don't fit.
+namespace PrecisionBinary
+{
+	// Unsigned integer type of the archives with the size of ttmath::uint
+	using FWord = std::conditional_t<sizeof(ttmath::uint) == 8, uint64, uint32>;
+
+	template<typename ArchiveType>
+	void SerializeWords(ArchiveType& Ar, ttmath::uint* Words, int64 NumWords)
+	{
+		if (!Ar.IsByteSwapping())
+		{
+			Ar.Serialize(Words, NumWords * int64(sizeof(ttmath::uint)));
+			return;
+		}
+
+		for (int64 i = 0; i < NumWords; ++i)
+		{
+			FWord Word = FWord(Words[i]);
+			Ar << Word;
+			Words[i] = ttmath::uint(Word);
+		}
+	}
+
+	// Integers, signed or not, such as the mantissas of real_fixed
+	template<ttmath::uint Words, typename ArchiveType>
+	void SerializeInt(ArchiveType& Ar, ttmath::UInt<Words>& Number)
+	{
+		SerializeWords(Ar, Number.table, int64(Words));
+	}
+
+	// Big floats: exponent, mantissa, then the info byte (sign, NaN)
+	template<ttmath::uint Exponent, ttmath::uint Mantissa, typename ArchiveType>
+	void SerializeBig(ArchiveType& Ar, ttmath::Big<Exponent, Mantissa>& Number)
+	{
+		SerializeInt(Ar, Number.exponent);
+		SerializeInt(Ar, Number.mantissa);
+		Ar.Serialize(&Number.info, 1);
+	}
+
+	constexpr uint16 CanonicalVersion = 1;
+	constexpr int32 CanonicalHeaderSize = 12;
+	constexpr int32 MaxCanonicalValueBytes = 64;
+
+	struct FCanonicalHeader
+	{
+		uint16 Version = CanonicalVersion;
+		uint16 MantissaBits = 0;
+		uint16 FractionBits = 0;
+		uint8 ValueBytes = 0;
+		uint8 Backend = 0;
+	};
+
+	// Bytes of the numbers of MantissaBits and FractionBits: their bits rounded up to 64, like ttmath words on 64-bit platforms
+	constexpr int32 GetCanonicalValueBytes(int32 MantissaBits, int32 FractionBits)
+	{
+		return (MantissaBits + FractionBits + 63) / 64 * 8;
+	}
+
+	inline FCanonicalHeader MakeCanonicalHeader(int32 MantissaBits, int32 FractionBits, uint8 Backend)
+	{
+		FCanonicalHeader Header;
+		Header.MantissaBits = uint16(MantissaBits);
+		Header.FractionBits = uint16(FractionBits);
+		Header.ValueBytes = uint8(GetCanonicalValueBytes(MantissaBits, FractionBits));
+		Header.Backend = Backend;
+		return Header;
+	}
+
+	// ByteArrayType needs Append(const uint8* Data, Num), like TArray<uint8>
+	template<typename ByteArrayType>
+	void WriteCanonicalHeader(ByteArrayType& Bytes, const FCanonicalHeader& Header)
+	{
+		const uint8 Buffer[CanonicalHeaderSize] = { 'S', 'K', 'P', 'C', uint8(Header.Version), uint8(Header.Version >> 8),
+			uint8(Header.MantissaBits), uint8(Header.MantissaBits >> 8), uint8(Header.FractionBits), uint8(Header.FractionBits >> 8),
+			Header.ValueBytes, Header.Backend };
+		Bytes.Append(Buffer, CanonicalHeaderSize);
+	}
+
+	// Returns false when Data isn't a header of this version, or its sizes are inconsistent
+	inline bool ReadCanonicalHeader(const uint8* Data, int64 Num, FCanonicalHeader& OutHeader)
+	{
+		if (Num < CanonicalHeaderSize || std::memcmp(Data, "SKPC", 4) != 0)
+		{
+			return false;
+		}
+		OutHeader.Version = uint16(Data[4] | (Data[5] << 8));
+		OutHeader.MantissaBits = uint16(Data[6] | (Data[7] << 8));
+		OutHeader.FractionBits = uint16(Data[8] | (Data[9] << 8));
+		OutHeader.ValueBytes = Data[10];
+		OutHeader.Backend = Data[11];
+		return OutHeader.Version == CanonicalVersion && OutHeader.MantissaBits > 0
+			&& OutHeader.ValueBytes == GetCanonicalValueBytes(OutHeader.MantissaBits, OutHeader.FractionBits) && OutHeader.ValueBytes <= MaxCanonicalValueBytes;
+	}
+
+	template<typename WordType>
+	WordType SwapBytes(WordType Word)
+	{
+		WordType Swapped = 0;
+		for (int32 Byte = 0; Byte < int32(sizeof(WordType)); ++Byte)
+		{
+			Swapped = WordType((Swapped << 8) | ((Word >> (8 * Byte)) & 0xff));
+		}
+		return Swapped;
+	}
+
+	// Whether the canonical values are the mantissas as they are in memory, for this build
+	template<ttmath::uint Words>
+	bool IsCanonicalMemoryLayout(const FCanonicalHeader& Header, int32 FractionBits)
+	{
+		return PLATFORM_LITTLE_ENDIAN && Header.FractionBits == FractionBits && Header.ValueBytes == Words * sizeof(ttmath::uint);
+	}
+
+	// Writes the Num mantissas to Out, Header.ValueBytes each (see MakeCanonicalHeader with the settings of the mantissas).
+	// On little-endian platforms whose mantissas have the canonical size, this is a copy
+	template<ttmath::uint Words>
+	void EncodeCanonical(const ttmath::Int<Words>* Mantissas, int64 Num, const FCanonicalHeader& Header, uint8* Out)
+	{
+		constexpr int32 MantissaBytes = int32(Words * sizeof(ttmath::uint));
+		const int32 ValueBytes = Header.ValueBytes;
+		if (IsCanonicalMemoryLayout<Words>(Header, Header.FractionBits))
+		{
+			std::memcpy(Out, Mantissas, size_t(Num) * MantissaBytes);
+			return;
+		}
+
+		for (int64 Index = 0; Index < Num; ++Index, Out += ValueBytes)
+		{
+			// Little-endian words, then the sign extended to the size of the value (32-bit platforms), or the low bytes
+			ttmath::uint Swapped[Words];
+			for (ttmath::uint Word = 0; Word < Words; ++Word)
+			{
+				Swapped[Word] = PLATFORM_LITTLE_ENDIAN ? Mantissas[Index].table[Word] : SwapBytes(Mantissas[Index].table[Word]);
+			}
+			const int32 Copied = ValueBytes < MantissaBytes ? ValueBytes : MantissaBytes;
+			std::memcpy(Out, Swapped, size_t(Copied));
+			std::memset(Out + Copied, Mantissas[Index].IsSign() ? 0xff : 0, size_t(ValueBytes - Copied));
+		}
+	}
+
+	// Converts a value of the canonical encoding, of ValueBytes bytes and SourceFractionBits, to a mantissa with FractionBits.
+	// Returns false when it doesn't fit, and the mantissa is then saturated
+	template<int32 FractionBits, ttmath::uint Words>
+	bool ConvertCanonical(const uint8* Value, int32 ValueBytes, int32 SourceFractionBits, ttmath::Int<Words>& OutMantissa)
+	{
+		constexpr ttmath::uint WorkWords = MaxCanonicalValueBytes / sizeof(ttmath::uint) + Words + 1;
+		constexpr int32 WorkBits = int32(WorkWords * TTMATH_BITS_PER_UINT);
+
+		// Sign and magnitude, sign extended to the work words
+		const bool bNegative = (Value[ValueBytes - 1] & 0x80) != 0;
+		ttmath::UInt<WorkWords> Magnitude;
+		for (ttmath::uint Word = 0; Word < WorkWords; ++Word)
+		{
+			Magnitude.table[Word] = bNegative ? ~ttmath::uint(0) : 0;
+		}
+		std::memcpy(Magnitude.table, Value, size_t(ValueBytes));
+		for (int32 Word = 0; !PLATFORM_LITTLE_ENDIAN && Word < ValueBytes / int32(sizeof(ttmath::uint)); ++Word)
+		{
+			Magnitude.table[Word] = SwapBytes(Magnitude.table[Word]);
+		}
+		if (bNegative)
+		{
+			Magnitude.BitNot();
+			Magnitude.AddOne();
+		}
+
+		const auto BitLength = [&Magnitude]()
+		{
+			ttmath::uint Table, Index;
+			return Magnitude.FindLeadingBit(Table, Index) ? int32(Table * TTMATH_BITS_PER_UINT + Index) + 1 : 0;
+		};
+
+		// Whether the magnitude, shifted left by Shifted bits, fits the mantissa. Negative values also reach -2^(MantissaBits - 1), whose magnitude
+		// is the power of two just past the positive ones
+		const auto Fits = [&Magnitude, &BitLength, bNegative](int32 Shifted)
+		{
+			constexpr int32 MantissaBits = int32(Words * TTMATH_BITS_PER_UINT);
+			const int32 Length = BitLength() + Shifted;
+			if (Length != MantissaBits || !bNegative)
+			{
+				return Length < MantissaBits;
+			}
+			ttmath::UInt<WorkWords> Below = Magnitude;
+			Below.SubOne();
+			Below.BitAnd(Magnitude);
+			return Below.IsZero();
+		};
+
+		bool bFits = true;
+		const int32 Shift = FractionBits - SourceFractionBits;
+		if (Shift > 0)
+		{
+			bFits = Fits(Shift);
+			Magnitude.Rcl(bFits ? ttmath::uint(Shift) : 0);
+		}
+		else if (Shift < 0)
+		{
+			// Rounded to the nearest, ties to even, from the dropped bits
+			const int32 Dropped = -Shift;
+			if (Dropped > BitLength())
+			{
+				Magnitude.SetZero();
+			}
+			else
+			{
+				const auto Bit = [&Magnitude](int32 Index)
+				{
+					return (Magnitude.table[Index / int32(TTMATH_BITS_PER_UINT)] >> (Index % int32(TTMATH_BITS_PER_UINT))) & 1;
+				};
+
+				// Whether a bit below the half is set: the whole words below it, then the bits of its word
+				const int32 HalfWord = (Dropped - 1) / int32(TTMATH_BITS_PER_UINT);
+				const int32 HalfBit = (Dropped - 1) % int32(TTMATH_BITS_PER_UINT);
+				bool bSticky = (Magnitude.table[HalfWord] & ((ttmath::uint(1) << HalfBit) - 1)) != 0;
+				for (int32 Word = 0; Word < HalfWord && !bSticky; ++Word)
+				{
+					bSticky = Magnitude.table[Word] != 0;
+				}
+				const bool bHalf = Bit(Dropped - 1) != 0;
+				const bool bOdd = Dropped < WorkBits && Bit(Dropped) != 0;
+				Magnitude.Rcr(ttmath::uint(Dropped));
+				if (bHalf && (bSticky || bOdd))
+				{
+					Magnitude.AddOne();
+				}
+			}
+		}
+		bFits = bFits && Fits(0);
+
+		if (!bFits)
+		{
+			OutMantissa.SetMax();
+		}
+		else
+		{
+			for (ttmath::uint Word = 0; Word < Words; ++Word)
+			{
+				OutMantissa.table[Word] = Magnitude.table[Word];
+			}
+		}
+		if (bNegative)
+		{
+			OutMantissa.ChangeSign();
+		}
+		return bFits;
+	}
+
+	// Reads Num values written with Header to mantissas with FractionBits, converting them when the header's settings aren't the build's.
+	// On little-endian platforms with the build's settings, this is a copy. Returns the number of values that didn't fit, and were saturated
+	template<int32 FractionBits, ttmath::uint Words>
+	int64 DecodeCanonical(const uint8* Data, int64 Num, const FCanonicalHeader& Header, ttmath::Int<Words>* OutMantissas)
+	{
+		constexpr int32 MantissaBytes = int32(Words * sizeof(ttmath::uint));
+		if (IsCanonicalMemoryLayout<Words>(Header, FractionBits))
+		{
+			std::memcpy(static_cast<void*>(OutMantissas), Data, size_t(Num) * MantissaBytes);
+			return 0;
+		}
+
+		if (Header.FractionBits == FractionBits && Header.ValueBytes == MantissaBytes)
+		{
+			for (int64 Index = 0; Index < Num; ++Index)
+			{
+				std::memcpy(OutMantissas[Index].table, Data + Index * MantissaBytes, size_t(MantissaBytes));
+				for (ttmath::uint Word = 0; Word < Words; ++Word)
+				{
+					OutMantissas[Index].table[Word] = SwapBytes(OutMantissas[Index].table[Word]);
+				}
+			}
+			return 0;
+		}
+
+		int64 NumSaturated = 0;
+		for (int64 Index = 0; Index < Num; ++Index)
+		{
+			NumSaturated += ConvertCanonical<FractionBits>(Data + Index * Header.ValueBytes, Header.ValueBytes, Header.FractionBits, OutMantissas[Index]) ? 0 : 1;
+		}
+		return NumSaturated;
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+#include <cstring>
+
+// Block floating point compression of fixed-point mantissas, for TBlockFixedArray.
+// The values of a block share its smallest value, the base, and a shift: each value is stored as (Value - Base) >> Shift, on the narrowest of
+// 0 (all the values are equal), 16, 32 or 64 bits that holds the differences of the block. Shift is the number of trailing zero bits all the
+// differences have, so the compression is lossless. Blocks whose values are too far apart for 64 bits store their mantissas whole.
+// Values can be rounded to a quantum of 2^DroppedBits mantissa units first, which adds trailing zeros to the differences.
+namespace PrecisionBlock
+{
+	template<ttmath::uint Words>
+	struct TBlock
+	{
+		// Smallest value of the block
+		ttmath::Int<Words> Base;
+
+		// Offset of the differences of the block in the storage of the caller
+		int64 Offset = 0;
+
+		// Bytes of each difference: 0, 2, 4, 8, or sizeof(ttmath::Int<Words>) when the block stores its mantissas whole
+		uint8 DeltaBytes = 0;
+
+		uint8 Shift = 0;
+	};
+
+	// Bytes of the differences of a block of Num values, at most
+	template<ttmath::uint Words>
+	constexpr int64 MaxDeltaBytes(int32 Num)
+	{
+		return int64(Num) * int64(sizeof(ttmath::Int<Words>));
+	}
+
+	// Rounds Value to the nearest multiple of 2^DroppedBits, or down when rounding up would overflow
+	template<ttmath::uint Words>
+	void RoundToQuantum(ttmath::Int<Words>& Value, int32 DroppedBits)
+	{
+		if (DroppedBits <= 0)
+		{
+			return;
+		}
+
+		ttmath::Int<Words> Rounded = Value;
+		ttmath::UInt<Words> Half;
+		Half.SetZero();
+		Half.SetBit(ttmath::uint(DroppedBits - 1));
+		static_cast<ttmath::UInt<Words>&>(Rounded).Add(Half);
+		if (Rounded.IsSign() && !Value.IsSign())
+		{
+			Rounded = Value;
+		}
+		for (int32 Bit = 0; Bit < DroppedBits; Bit += int32(TTMATH_BITS_PER_UINT))
+		{
+			const int32 Bits = DroppedBits - Bit;
+			Rounded.table[Bit / TTMATH_BITS_PER_UINT] &= Bits >= int32(TTMATH_BITS_PER_UINT) ? 0 : ~((ttmath::uint(1) << Bits) - 1);
+		}
+		Value = Rounded;
+	}
+
+	// Compresses Num values (up to the block size of the caller), rounded to 2^DroppedBits, to OutBlock and the differences written to OutDeltas,
+	// which holds MaxDeltaBytes(Num) bytes. Returns the number of bytes written. OutBlock.Offset is left to the caller
+	template<ttmath::uint Words>
+	int64 EncodeBlock(const ttmath::Int<Words>* Values, int32 Num, int32 DroppedBits, TBlock<Words>& OutBlock, uint8* OutDeltas)
+	{
+		constexpr int32 MantissaBits = int32(Words * TTMATH_BITS_PER_UINT);
+		DroppedBits = DroppedBits < 0 ? 0 : DroppedBits > MantissaBits - 2 ? MantissaBits - 2 : DroppedBits;
+
+		ttmath::Int<Words> Min;
+		Min.SetMax();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			ttmath::Int<Words> Value = Values[Index];
+			RoundToQuantum(Value, DroppedBits);
+			if (Value < Min)
+			{
+				Min = Value;
+			}
+		}
+
+		// Differences to the smallest value, which are positive, so they fit the unsigned integer
+		const auto GetDelta = [Values, DroppedBits, &Min](int32 Index)
+		{
+			ttmath::Int<Words> Value = Values[Index];
+			RoundToQuantum(Value, DroppedBits);
+			ttmath::UInt<Words> Delta = Value;
+			Delta.Sub(Min);
+			return Delta;
+		};
+		ttmath::UInt<Words> AllBits;
+		ttmath::UInt<Words> MaxDelta;
+		AllBits.SetZero();
+		MaxDelta.SetZero();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const ttmath::UInt<Words> Delta = GetDelta(Index);
+			AllBits.BitOr(Delta);
+			if (Delta > MaxDelta)
+			{
+				MaxDelta = Delta;
+			}
+		}
+
+		OutBlock.Base = Min;
+		ttmath::uint Table, Bit;
+		if (!AllBits.FindLowestBit(Table, Bit))
+		{
+			OutBlock.DeltaBytes = 0;
+			OutBlock.Shift = 0;
+			return 0;
+		}
+		const int32 Shift = int32(Table * TTMATH_BITS_PER_UINT + Bit);
+		MaxDelta.Rcr(ttmath::uint(Shift));
+		MaxDelta.FindLeadingBit(Table, Bit);
+		const int32 DeltaBits = int32(Table * TTMATH_BITS_PER_UINT + Bit + 1);
+
+		if (DeltaBits > 64)
+		{
+			OutBlock.DeltaBytes = uint8(sizeof(ttmath::Int<Words>));
+			OutBlock.Shift = 0;
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				ttmath::Int<Words> Value = Values[Index];
+				RoundToQuantum(Value, DroppedBits);
+				std::memcpy(OutDeltas + Index * sizeof(Value), Value.table, sizeof(Value));
+			}
+			return MaxDeltaBytes<Words>(Num);
+		}
+
+		OutBlock.DeltaBytes = uint8(DeltaBits <= 16 ? 2 : DeltaBits <= 32 ? 4 : 8);
+		OutBlock.Shift = uint8(Shift);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			ttmath::UInt<Words> Delta = GetDelta(Index);
+			Delta.Rcr(ttmath::uint(Shift));
+			const uint64 Narrow = sizeof(ttmath::uint) == 8 || Words == 1 ? uint64(Delta.table[0]) : uint64(Delta.table[0]) | uint64(Delta.table[1 % Words]) << 32;
+			const uint16 Narrow16 = uint16(Narrow);
+			const uint32 Narrow32 = uint32(Narrow);
+			switch (OutBlock.DeltaBytes)
+			{
+			case 2: std::memcpy(OutDeltas + Index * 2, &Narrow16, 2); break;
+			case 4: std::memcpy(OutDeltas + Index * 4, &Narrow32, 4); break;
+			default: std::memcpy(OutDeltas + Index * 8, &Narrow, 8); break;
+			}
+		}
+		return int64(Num) * OutBlock.DeltaBytes;
+	}
+
+	// Base + (Delta << Shift), one word at a time, without branches on the data. The decoding loops are portable C++, without dependencies between
+	// the values: compilers vectorize them where the target has 64-bit compares (SSE4.2, AVX2), not on the SSE2 baseline of x86-64
+	template<ttmath::uint Words>
+	FORCEINLINE void AddShiftedDelta(const ttmath::Int<Words>& Base, uint64 Delta, int32 Shift, ttmath::Int<Words>& Out)
+	{
+		ttmath::uint Carry = 0;
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			// Bits [Offset, Offset + TTMATH_BITS_PER_UINT) of the delta
+			const int32 Offset = int32(i * TTMATH_BITS_PER_UINT) - Shift;
+			const ttmath::uint Part = Offset >= 64 || Offset <= -int32(TTMATH_BITS_PER_UINT) ? 0
+				: Offset >= 0 ? ttmath::uint(Delta >> Offset) : ttmath::uint(Delta << -Offset);
+			const ttmath::uint Sum = Base.table[i] + Part;
+			const ttmath::uint Word = Sum + Carry;
+			Carry = ttmath::uint(Sum < Part) | ttmath::uint(Word < Carry);
+			Out.table[i] = Word;
+		}
+	}
+
+	template<typename DeltaType, ttmath::uint Words>
+	void DecodeDeltas(const TBlock<Words>& Block, const uint8* Deltas, int32 First, int32 Num, ttmath::Int<Words>* Out)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			DeltaType Delta;
+			std::memcpy(&Delta, Deltas + (First + Index) * int32(sizeof(DeltaType)), sizeof(DeltaType));
+			AddShiftedDelta(Block.Base, uint64(Delta), Block.Shift, Out[Index]);
+		}
+	}
+
+	// Decodes the values [First, First + Num) of a block, whose differences are at Deltas, to Out
+	template<ttmath::uint Words>
+	void DecodeBlock(const TBlock<Words>& Block, const uint8* Deltas, int32 First, int32 Num, ttmath::Int<Words>* Out)
+	{
+		switch (Block.DeltaBytes)
+		{
+		case 0:
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Out[Index] = Block.Base;
+			}
+			break;
+		case 2:
+			DecodeDeltas<uint16>(Block, Deltas, First, Num, Out);
+			break;
+		case 4:
+			DecodeDeltas<uint32>(Block, Deltas, First, Num, Out);
+			break;
+		case 8:
+			DecodeDeltas<uint64>(Block, Deltas, First, Num, Out);
+			break;
+		default:
+			std::memcpy(static_cast<void*>(Out), Deltas + int64(First) * int64(sizeof(ttmath::Int<Words>)), int64(Num) * int64(sizeof(ttmath::Int<Words>)));
+			break;
+		}
+	}
+
+	// Decodes one value of a block
+	template<ttmath::uint Words>
+	FORCEINLINE void DecodeValue(const TBlock<Words>& Block, const uint8* Deltas, int32 Index, ttmath::Int<Words>& Out)
+	{
+		uint64 Delta;
+		switch (Block.DeltaBytes)
+		{
+		case 0:
+			Out = Block.Base;
+			return;
+		case 2:
+		{
+			uint16 Delta16;
+			std::memcpy(&Delta16, Deltas + Index * 2, 2);
+			Delta = Delta16;
+			break;
+		}
+		case 4:
+		{
+			uint32 Delta32;
+			std::memcpy(&Delta32, Deltas + Index * 4, 4);
+			Delta = Delta32;
+			break;
+		}
+		case 8:
+			std::memcpy(&Delta, Deltas + Index * 8, 8);
+			break;
+		default:
+			std::memcpy(Out.table, Deltas + int64(Index) * int64(sizeof(Out)), sizeof(Out));
+			return;
+		}
+		AddShiftedDelta(Block.Base, Delta, Block.Shift, Out);
+	}
+}
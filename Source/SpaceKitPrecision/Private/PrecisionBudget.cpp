@@ -0,0 +1,27 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionBudget.h"
+
+// The budget is per thread, so that lowering it for a preview on a worker thread never affects the simulation running on another one
+static thread_local int32 GRealFloatPrecisionBits = REAL_FLOAT_DEFAULT_PRECISION_BITS;
+
+int32 FRealFloatPrecision::Get()
+{
+	return GRealFloatPrecisionBits;
+}
+
+void FRealFloatPrecision::Set(int32 PrecisionBits)
+{
+	GRealFloatPrecisionBits = FMath::Max(PrecisionBits, 0);
+}
+
+FScopedRealFloatPrecision::FScopedRealFloatPrecision(int32 PrecisionBits)
+	: PreviousPrecisionBits(FRealFloatPrecision::Get())
+{
+	FRealFloatPrecision::Set(PrecisionBits);
+}
+
+FScopedRealFloatPrecision::~FScopedRealFloatPrecision()
+{
+	FRealFloatPrecision::Set(PreviousPrecisionBits);
+}
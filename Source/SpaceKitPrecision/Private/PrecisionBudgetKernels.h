@@ -0,0 +1,391 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include <cmath>
+
+// Transcendental functions for ttmath big floats, that stop their series once a given number of significand bits is reached. See FRealFloatPrecision.
+// They follow the same series as ttmath (Taylor for sin, (x-1)/(x+1) for ln), but test each term against the budget instead of waiting for the sum to stop changing.
+// Every function falls back to the matching ttmath function when the budget is 0 or covers the whole significand, so the full precision results don't change.
+namespace PrecisionBudget
+{
+	// Bits computed on top of the budget, so that the rounding errors accumulated by the series don't reach the bits that are kept
+	constexpr int32 GuardBits = 8;
+
+	// Correct bits of the results computed with a budget of Bits: the truncation to Bits bits costs up to one ulp, and the series at most 2^-GuardBits ulp more
+	inline double GetGuaranteedBits(int32 Bits)
+	{
+		return double(Bits - 1) - std::log2(1.0 + std::ldexp(1.0, -GuardBits));
+	}
+
+	// Whether Bits asks for less than the full significand of a Big<exp, man>
+	template<ttmath::uint exp, ttmath::uint man>
+	bool IsBudgeted(int32 Bits)
+	{
+		return Bits > 0 && Bits < int32(man * TTMATH_BITS_PER_UINT);
+	}
+
+	// Whether a term of a series is too small to change the first Bits bits of the sum
+	template<ttmath::uint exp, ttmath::uint man>
+	bool IsNegligible(const ttmath::Big<exp, man>& Term, const ttmath::Big<exp, man>& Sum, int32 Bits)
+	{
+		if (Term.IsZero())
+		{
+			return true;
+		}
+
+		if (Sum.IsZero())
+		{
+			return false;
+		}
+
+		// Both mantissas are standardized (highest bit set), so comparing the exponents compares the magnitudes
+		return Term.exponent.ToInt() < Sum.exponent.ToInt() - ttmath::sint(Bits + GuardBits);
+	}
+
+	// Keeps the first Bits bits of the significand of x, and clears the others
+	template<ttmath::uint exp, ttmath::uint man>
+	void Truncate(ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		int32 ClearedBits = int32(man * TTMATH_BITS_PER_UINT) - Bits;
+
+		for (ttmath::uint i = 0; i < man && ClearedBits > 0; ++i, ClearedBits -= TTMATH_BITS_PER_UINT)
+		{
+			if (ClearedBits >= int32(TTMATH_BITS_PER_UINT))
+			{
+				x.mantissa.table[i] = 0;
+			}
+			else
+			{
+				x.mantissa.table[i] &= ~((ttmath::uint(1) << ClearedBits) - 1);
+			}
+		}
+	}
+
+	// Sin(x) for x in <0, PI/2>, see ttmath::auxiliaryfunctions::Sin0pi05
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Sin0pi05(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		ValueType Result, Numerator, Denominator, DNumerator, DDenominator, One, Temp;
+
+		// Temp = pi/4
+		Temp.Set05Pi();
+		Temp.exponent.SubOne();
+
+		One.SetOne();
+
+		if (x < Temp)
+		{
+			// Taylor series around 0: x - x^3/3! + x^5/5! - ...
+			Result = x;
+			Numerator = x;
+			Denominator = One;
+			DNumerator = x;
+			DNumerator.Mul(x);
+			DDenominator = 2;
+		}
+		else
+		{
+			// Taylor series around PI/2: 1 - (x-PI/2)^2/2! + (x-PI/2)^4/4! - ...
+			ValueType HalfPi;
+			HalfPi.Set05Pi();
+
+			Result = One;
+			Numerator = One;
+			Denominator = One;
+			Temp = x;
+			Temp.Sub(HalfPi);
+			DNumerator = Temp;
+			DNumerator.Mul(Temp);
+			DDenominator = One;
+		}
+
+		bool bAddition = false;
+
+		for (ttmath::uint i = 1; i <= TTMATH_ARITHMETIC_MAX_LOOP; ++i)
+		{
+			ttmath::uint Carry = 0;
+			Carry += Numerator.Mul(DNumerator);
+			Carry += Denominator.Mul(DDenominator);
+			Carry += DDenominator.Add(One);
+			Carry += Denominator.Mul(DDenominator);
+			Carry += DDenominator.Add(One);
+			Temp = Numerator;
+			Carry += Temp.Div(Denominator);
+
+			if (Carry || IsNegligible(Temp, Result, Bits))
+			{
+				break;
+			}
+
+			if (bAddition)
+			{
+				Result.Add(Temp);
+			}
+			else
+			{
+				Result.Sub(Temp);
+			}
+
+			bAddition = !bAddition;
+		}
+
+		return Result;
+	}
+
+	// e^x for small x, using e^x = 1 + x/1! + x^2/2! + ...
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> ExpSurrounding0(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		ValueType Result, Term, Index, One;
+		Result.SetOne();
+		Term.SetOne();
+		Index.SetOne();
+		One.SetOne();
+
+		for (ttmath::uint i = 1; i <= TTMATH_ARITHMETIC_MAX_LOOP; ++i)
+		{
+			if (Term.Mul(x) || Term.Div(Index) || IsNegligible(Term, Result, Bits))
+			{
+				break;
+			}
+
+			Result.Add(Term);
+			Index.Add(One);
+		}
+
+		return Result;
+	}
+
+	// ln(x) for x in <1/sqrt(2), sqrt(2)>, using ln(x) = 2 * [ z + z^3/3 + z^5/5 + ... ] with z = (x-1)/(x+1)
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> LnSurrounding1(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		ValueType One, Two, Z, Z2, Power, Term, Denominator, Result;
+		One.SetOne();
+		Two = 2;
+
+		Z = x;
+		Z.Sub(One);
+		Denominator = x;
+		Denominator.Add(One);
+		Z.Div(Denominator);
+
+		Z2 = Z;
+		Z2.Mul(Z);
+
+		Result = Z;
+		Power = Z;
+		Denominator = One;
+
+		for (ttmath::uint i = 1; i <= TTMATH_ARITHMETIC_MAX_LOOP; ++i)
+		{
+			if (Power.Mul(Z2) || Denominator.Add(Two))
+			{
+				break;
+			}
+
+			Term = Power;
+			if (Term.Div(Denominator) || IsNegligible(Term, Result, Bits))
+			{
+				break;
+			}
+
+			Result.Add(Term);
+		}
+
+		Result.exponent.AddOne();
+		return Result;
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Sin(ttmath::Big<exp, man> x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		if (!IsBudgeted<exp, man>(Bits) || x.IsNan())
+		{
+			return ttmath::Sin(x);
+		}
+
+		bool bChangeSign;
+		if (ttmath::auxiliaryfunctions::PrepareSin(x, bChangeSign))
+		{
+			// x is too big to reduce the period, NaN is set by default
+			return ValueType();
+		}
+
+		ValueType Result = Sin0pi05(x, Bits);
+
+		// Same clamping as ttmath::Sin, the series can step slightly out of <0, 1>
+		ValueType One;
+		One.SetOne();
+		if (Result > One)
+		{
+			Result = One;
+		}
+		else if (Result.IsSign())
+		{
+			Result.SetZero();
+		}
+
+		if (bChangeSign)
+		{
+			Result.ChangeSign();
+		}
+
+		Truncate(Result, Bits);
+		return Result;
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Cos(ttmath::Big<exp, man> x, int32 Bits)
+	{
+		if (!IsBudgeted<exp, man>(Bits) || x.IsNan())
+		{
+			return ttmath::Cos(x);
+		}
+
+		// cos(x) = sin(x + PI/2)
+		ttmath::Big<exp, man> HalfPi;
+		HalfPi.Set05Pi();
+		if (x.Add(HalfPi))
+		{
+			return ttmath::Big<exp, man>();
+		}
+
+		return Sin(x, Bits);
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Tan(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		if (!IsBudgeted<exp, man>(Bits) || x.IsNan())
+		{
+			return ttmath::Tan(x);
+		}
+
+		ttmath::Big<exp, man> Result = Sin(x, Bits + GuardBits);
+		const ttmath::Big<exp, man> CosX = Cos(x, Bits + GuardBits);
+
+		if (CosX.IsZero())
+		{
+			// Same as ttmath::Tan, the result is undefined
+			return ttmath::Big<exp, man>();
+		}
+
+		Result.Div(CosX);
+		Truncate(Result, Bits);
+		return Result;
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Exp(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		if (!IsBudgeted<exp, man>(Bits) || x.IsNan() || x.IsZero())
+		{
+			return ttmath::Exp(x);
+		}
+
+		// Range reduction: x = k*ln(2) + r with |r| <= ln(2)/2, so that e^x = 2^k * e^r
+		ValueType Ln2;
+		Ln2.SetLn2();
+
+		ValueType K = x;
+		ttmath::sint k;
+		if (K.Div(Ln2) || K.Round() || K.ToInt(k))
+		{
+			// Way too big or too small, let ttmath report it
+			return ttmath::Exp(x);
+		}
+
+		ValueType R = x;
+		K.Mul(Ln2);
+		R.Sub(K);
+
+		ValueType Result = ExpSurrounding0(R, Bits);
+		if (Result.exponent.Add(ttmath::Int<exp>(k)))
+		{
+			return ttmath::Exp(x);
+		}
+
+		Truncate(Result, Bits);
+		return Result;
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Ln(const ttmath::Big<exp, man>& x, int32 Bits)
+	{
+		using ValueType = ttmath::Big<exp, man>;
+
+		if (!IsBudgeted<exp, man>(Bits) || x.IsNan() || x.IsSign() || x.IsZero())
+		{
+			return ttmath::Ln(x);
+		}
+
+		// x = m * 2^e with m in <1, 2), so that ln(x) = ln(m) + e*ln(2)
+		ValueType M = x;
+		M.exponent = -ttmath::sint(man * TTMATH_BITS_PER_UINT - 1);
+		ttmath::sint e = x.exponent.ToInt() + ttmath::sint(man * TTMATH_BITS_PER_UINT - 1);
+
+		// Bring m into <1/sqrt(2), sqrt(2)>, where the series converges about twice as fast
+		ValueType Sqrt2 = 2;
+		Sqrt2.Sqrt();
+		if (M > Sqrt2)
+		{
+			M.exponent.SubOne();
+			++e;
+		}
+
+		ValueType Result = LnSurrounding1(M, Bits + GuardBits);
+
+		ValueType Ln2;
+		Ln2.SetLn2();
+		ValueType Exponent;
+		Exponent.FromInt(e);
+		Exponent.Mul(Ln2);
+		Result.Add(Exponent);
+
+		Truncate(Result, Bits);
+		return Result;
+	}
+
+	// Logarithm of x in a given base, computed as ln(x)/ln(base)
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Log(const ttmath::Big<exp, man>& x, const ttmath::Big<exp, man>& Base, int32 Bits)
+	{
+		if (!IsBudgeted<exp, man>(Bits))
+		{
+			return ttmath::Log(x, Base);
+		}
+
+		ttmath::Big<exp, man> Result = Ln(x, Bits + GuardBits);
+		Result.Div(Ln(Base, Bits + GuardBits));
+		Truncate(Result, Bits);
+		return Result;
+	}
+
+	// x^y, computed as e^(y*ln(x))
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Pow(const ttmath::Big<exp, man>& x, const ttmath::Big<exp, man>& y, int32 Bits)
+	{
+		if (!IsBudgeted<exp, man>(Bits))
+		{
+			return ttmath::Exp(y * ttmath::Ln(x));
+		}
+
+		// The error of ln(x) is multiplied by y, so it's computed with twice the guard bits
+		return Exp(y * Ln(x, Bits + 2 * GuardBits), Bits);
+	}
+}
@@ -0,0 +1,266 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionBulkImport.h"
+#include "SpaceKitPrecision/Public/PrecisionStats.h"
+#include "Async/ParallelFor.h"
+#include "Engine/DataTable.h"
+#include "UObject/UnrealType.h"
+#include "SpaceKitPrecision/Private/PrecisionImportKernels.h"
+
+namespace
+{
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+
+	struct FRowRange
+	{
+		const TCHAR* Start;
+		const TCHAR* End;
+	};
+
+	// Columns of the options a column of the text is, if any
+	struct FColumnSlot
+	{
+		int32 Real = INDEX_NONE;
+		int32 Vector = INDEX_NONE;
+	};
+
+	void SetVector(const FMantissa* Mantissas, FVectorFixed& OutVector)
+	{
+		OutVector.X.Value.mantissa = Mantissas[0];
+		OutVector.Y.Value.mantissa = Mantissas[1];
+		OutVector.Z.Value.mantissa = Mantissas[2];
+	}
+
+	// Sizes the result for Rows, then parses the rows in ranges of RowsPerTask rows on the task graph, with ParseRow(Row, Range),
+	// that fills the slots of the row and returns its number of invalid cells. The counts of the ranges are merged in order
+	template<typename ParseRowType>
+	void ParseRows(const TArray<FRowRange>& Rows, const FPrecisionImportOptions& Options, FPrecisionImportResult& OutResult, ParseRowType&& ParseRow)
+	{
+		const int32 NumRows = Rows.Num();
+		OutResult.RowNames.SetNum(NumRows);
+		OutResult.Reals.SetNum(Options.RealColumns.Num());
+		for (TArray<FRealFixed>& Column : OutResult.Reals)
+		{
+			Column.SetNum(NumRows);
+		}
+		OutResult.Vectors.SetNum(Options.VectorColumns.Num());
+		for (TArray<FVectorFixed>& Column : OutResult.Vectors)
+		{
+			Column.SetNum(NumRows);
+		}
+
+		const int32 RowsPerTask = FMath::Max(1, Options.RowsPerTask);
+		const int32 NumTasks = FMath::DivideAndRoundUp(NumRows, RowsPerTask);
+		TArray<int32> NumInvalid;
+		NumInvalid.SetNumZeroed(NumTasks);
+		TArray<int32> FirstInvalid;
+		FirstInvalid.Init(INDEX_NONE, NumTasks);
+
+		ParallelFor(NumTasks, [&](int32 Task)
+		{
+			const int32 End = FMath::Min(NumRows, (Task + 1) * RowsPerTask);
+			for (int32 Row = Task * RowsPerTask; Row < End; ++Row)
+			{
+				const int32 RowInvalid = ParseRow(Row, Rows[Row]);
+				NumInvalid[Task] += RowInvalid;
+				if (RowInvalid > 0 && FirstInvalid[Task] == INDEX_NONE)
+				{
+					FirstInvalid[Task] = Row;
+				}
+			}
+		});
+
+		for (int32 Task = 0; Task < NumTasks; ++Task)
+		{
+			OutResult.NumInvalidCells += NumInvalid[Task];
+			if (OutResult.FirstInvalidRow == INDEX_NONE)
+			{
+				OutResult.FirstInvalidRow = FirstInvalid[Task];
+			}
+		}
+	}
+}
+
+bool FPrecisionBulkImport::ImportCsv(const FString& Csv, const FPrecisionImportOptions& Options, FPrecisionImportResult& OutResult)
+{
+	SPACEKITPRECISION_SCOPE(StringImport);
+
+	OutResult = FPrecisionImportResult();
+
+	TArray<FRowRange> Rows;
+	PrecisionImport::SplitCsvRows(*Csv, Csv.Len(), [&Rows](const TCHAR* Start, const TCHAR* End)
+	{
+		Rows.Add({ Start, End });
+	});
+
+	// The header row gives the columns of the cells
+	TArray<FColumnSlot> Slots;
+	TArray<bool> RealFound;
+	RealFound.Init(false, Options.RealColumns.Num());
+	TArray<bool> VectorFound;
+	VectorFound.Init(false, Options.VectorColumns.Num());
+	if (Rows.Num() > 0)
+	{
+		PrecisionImport::SplitCsvCells(Rows[0].Start, Rows[0].End, [&](int32 Column, const TCHAR* Start, const TCHAR* End)
+		{
+			const FString Name(int32(End - Start), Start);
+			FColumnSlot& Slot = Slots.AddDefaulted_GetRef();
+			Slot.Real = Options.RealColumns.IndexOfByKey(Name);
+			Slot.Vector = Options.VectorColumns.IndexOfByKey(Name);
+			if (Slot.Real != INDEX_NONE)
+			{
+				RealFound[Slot.Real] = true;
+			}
+			if (Slot.Vector != INDEX_NONE)
+			{
+				VectorFound[Slot.Vector] = true;
+			}
+		});
+		Rows.RemoveAt(0, 1, false);
+	}
+
+	// Every requested column needs a header cell. A repeated header doesn't make up for a missing one
+	if (RealFound.Contains(false) || VectorFound.Contains(false))
+	{
+		return false;
+	}
+	const int32 NumColumns = Options.RealColumns.Num() + Options.VectorColumns.Num();
+
+	ParseRows(Rows, Options, OutResult, [&Slots, &OutResult, NumColumns](int32 Row, const FRowRange& Range)
+	{
+		int32 NumInvalid = NumColumns;
+		PrecisionImport::SplitCsvCells(Range.Start, Range.End, [&](int32 Column, const TCHAR* Start, const TCHAR* End)
+		{
+			if (Column == 0)
+			{
+				OutResult.RowNames[Row] = FName(int32(End - Start), Start);
+			}
+			if (Column >= Slots.Num())
+			{
+				return;
+			}
+
+			const FColumnSlot& Slot = Slots[Column];
+			if (Slot.Real != INDEX_NONE)
+			{
+				NumInvalid -= PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(Start, End, OutResult.Reals[Slot.Real][Row].Value.mantissa) ? 1 : 0;
+			}
+			if (Slot.Vector != INDEX_NONE)
+			{
+				FMantissa Mantissas[3];
+				const bool bParsed = PrecisionImport::ParseVector<REAL_FIXED_EXPONENT>(Start, End, Mantissas);
+				SetVector(Mantissas, OutResult.Vectors[Slot.Vector][Row]);
+				NumInvalid -= bParsed ? 1 : 0;
+			}
+		});
+		return NumInvalid;
+	});
+	return true;
+}
+
+bool FPrecisionBulkImport::ImportJson(const FString& Json, const FPrecisionImportOptions& Options, FPrecisionImportResult& OutResult)
+{
+	SPACEKITPRECISION_SCOPE(StringImport);
+
+	OutResult = FPrecisionImportResult();
+
+	TArray<FRowRange> Rows;
+	const bool bArray = PrecisionImport::SplitJsonArray(*Json, Json.Len(), [&Rows](const TCHAR* Start, const TCHAR* End)
+	{
+		Rows.Add({ Start, End });
+	});
+	if (!bArray)
+	{
+		return false;
+	}
+
+	ParseRows(Rows, Options, OutResult, [&Options, &OutResult](int32 Row, const FRowRange& Range)
+	{
+		const TCHAR* Start;
+		const TCHAR* End;
+		if (PrecisionImport::FindJsonField(Range.Start, Range.End, TEXT("Name"), 4, Start, End))
+		{
+			PrecisionImport::UnquoteJson(Start, End);
+			OutResult.RowNames[Row] = FName(int32(End - Start), Start);
+		}
+
+		int32 NumInvalid = 0;
+		for (int32 Column = 0; Column < Options.RealColumns.Num(); ++Column)
+		{
+			const FString& Name = Options.RealColumns[Column];
+			const bool bParsed = PrecisionImport::FindJsonField(Range.Start, Range.End, *Name, Name.Len(), Start, End)
+				&& PrecisionImport::ParseJsonNumber<REAL_FIXED_EXPONENT>(Start, End, OutResult.Reals[Column][Row].Value.mantissa);
+			NumInvalid += bParsed ? 0 : 1;
+		}
+		for (int32 Column = 0; Column < Options.VectorColumns.Num(); ++Column)
+		{
+			const FString& Name = Options.VectorColumns[Column];
+			FMantissa Mantissas[3];
+			const bool bParsed = PrecisionImport::FindJsonField(Range.Start, Range.End, *Name, Name.Len(), Start, End)
+				&& PrecisionImport::ParseJsonVector<REAL_FIXED_EXPONENT>(Start, End, Mantissas);
+			if (bParsed)
+			{
+				SetVector(Mantissas, OutResult.Vectors[Column][Row]);
+			}
+			NumInvalid += bParsed ? 0 : 1;
+		}
+		return NumInvalid;
+	});
+	return true;
+}
+
+int32 FPrecisionBulkImport::ApplyToDataTable(const FPrecisionImportResult& Result, const FPrecisionImportOptions& Options, UDataTable& Table)
+{
+	const UScriptStruct* RowStruct = Table.GetRowStruct();
+	if (!RowStruct)
+	{
+		return 0;
+	}
+
+	// Properties of the columns, null when the row struct doesn't have them
+	const auto FindProperty = [RowStruct](const FString& Name, UScriptStruct* Struct) -> FStructProperty*
+	{
+		FStructProperty* Property = FindFProperty<FStructProperty>(RowStruct, *Name);
+		return Property && Property->Struct == Struct ? Property : nullptr;
+	};
+	TArray<FStructProperty*> RealProperties;
+	for (int32 Column = 0; Column < FMath::Min(Options.RealColumns.Num(), Result.Reals.Num()); ++Column)
+	{
+		RealProperties.Add(FindProperty(Options.RealColumns[Column], FRealFixed::StaticStruct()));
+	}
+	TArray<FStructProperty*> VectorProperties;
+	for (int32 Column = 0; Column < FMath::Min(Options.VectorColumns.Num(), Result.Vectors.Num()); ++Column)
+	{
+		VectorProperties.Add(FindProperty(Options.VectorColumns[Column], FVectorFixed::StaticStruct()));
+	}
+
+	Table.Modify();
+	int32 NumSet = 0;
+	for (int32 Row = 0; Row < Result.GetNumRows(); ++Row)
+	{
+		uint8* RowData = Result.RowNames[Row].IsNone() ? nullptr : Table.FindRowUnchecked(Result.RowNames[Row]);
+		if (!RowData)
+		{
+			continue;
+		}
+		for (int32 Column = 0; Column < RealProperties.Num(); ++Column)
+		{
+			if (RealProperties[Column])
+			{
+				*RealProperties[Column]->ContainerPtrToValuePtr<FRealFixed>(RowData) = Result.Reals[Column][Row];
+			}
+		}
+		for (int32 Column = 0; Column < VectorProperties.Num(); ++Column)
+		{
+			if (VectorProperties[Column])
+			{
+				*VectorProperties[Column]->ContainerPtrToValuePtr<FVectorFixed>(RowData) = Result.Vectors[Column][Row];
+			}
+		}
+		++NumSet;
+	}
+
+	// The rows were written in place, so the editor and the listeners of the table are told here
+	Table.HandleDataTableChanged();
+	return NumSet;
+}
@@ -0,0 +1,35 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionCanonical.h"
+
+FPrecisionCanonicalWriter::FPrecisionCanonicalWriter(TArray<uint8>& InBytes)
+	: Bytes(InBytes)
+	, Header(PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT, uint8(SPACEKITPRECISION_TTMATH_BACKEND)))
+{
+	PrecisionBinary::WriteCanonicalHeader(Bytes, Header);
+}
+
+void FPrecisionCanonicalWriter::Encode(const FMantissa* Mantissas, int32 Num)
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+	const int32 Offset = Bytes.Num();
+	Bytes.AddUninitialized(Num * Header.ValueBytes);
+	PrecisionBinary::EncodeCanonical(Mantissas, Num, Header, Bytes.GetData() + Offset);
+}
+
+FPrecisionCanonicalReader::FPrecisionCanonicalReader(const uint8* InData, int64 InNum)
+	: Data(InData)
+	, Num(InNum)
+{
+	bValid = InData && PrecisionBinary::ReadCanonicalHeader(InData, InNum, Header);
+	Offset = PrecisionBinary::CanonicalHeaderSize;
+}
+
+void FPrecisionCanonicalReader::Decode(FMantissa* Mantissas, int32 Count)
+{
+	NumSaturated += PrecisionBinary::DecodeCanonical<REAL_FIXED_EXPONENT>(Data + Offset, Count, Header, Mantissas);
+	Offset += int64(Count) * Header.ValueBytes;
+}
@@ -0,0 +1,8 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionCustomVersion.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FPrecisionCustomVersion::GUID(0x71677258, 0xC0D847C8, 0x85840515, 0x6FD56A78);
+
+static FCustomVersionRegistration GRegisterPrecisionCustomVersion(FPrecisionCustomVersion::GUID, FPrecisionCustomVersion::LatestVersion, TEXT("SpaceKitPrecisionVer"));
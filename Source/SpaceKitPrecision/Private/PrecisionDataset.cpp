@@ -0,0 +1,273 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionDataset.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	constexpr ttmath::uint MantissaWords = sizeof(real_fixed_type::ttIntMantissaType) / sizeof(ttmath::uint);
+
+	bool IsCompatible(const PrecisionDataset::FHeader& Header)
+	{
+		return PrecisionDataset::FView::IsCompatible<MantissaWords>(Header, REAL_FIXED_EXPONENT);
+	}
+
+	void WriteDataset(TArray<uint8>& Bytes, const TArray<FVectorFixed>& Positions, const TArray<int64>& LodCounts, EPrecisionDatasetLayout Layout)
+	{
+		TArray<real_fixed_type::ttIntMantissaType> Mantissas;
+		Mantissas.Reserve(Positions.Num() * 3);
+		for (const FVectorFixed& Position : Positions)
+		{
+			Mantissas.Add(Position.X.Value.mantissa);
+			Mantissas.Add(Position.Y.Value.mantissa);
+			Mantissas.Add(Position.Z.Value.mantissa);
+		}
+
+		// The LODs must be increasing prefixes of the positions
+		TArray<int64> Counts;
+		for (int32 Lod = 0; Lod < FMath::Min(LodCounts.Num(), int32(PrecisionDataset::MaxLods) - 1); ++Lod)
+		{
+			Counts.Add(FMath::Clamp<int64>(LodCounts[Lod], Counts.Num() > 0 ? Counts.Last() : 0, Positions.Num()));
+		}
+
+		Bytes.Reset();
+		PrecisionDataset::Write(Bytes, Mantissas.GetData(), Positions.Num(), REAL_FIXED_EXPONENT, Layout, Counts.GetData(), uint32(Counts.Num()));
+	}
+
+	// Reads Size bytes of the bulk data, from Offset, to Destination, without loading the rest of it
+	bool ReadPayloadRange(const FByteBulkData& Payload, int64 Offset, int64 Size, uint8* Destination)
+	{
+		TUniquePtr<IBulkDataIORequest> Request(Payload.CreateStreamingRequest(Offset, Size, AIOP_Normal, nullptr, Destination));
+		return Request.IsValid() && Request->WaitCompletion() && Request->GetReadResults() != nullptr;
+	}
+}
+
+void FPrecisionDatasetView::CopyTo(TArray<FVectorFixed>& Out, int64 First, int64 Count) const
+{
+	const int64 Begin = FMath::Clamp<int64>(First, 0, Num());
+	const int64 End = Begin + FMath::Clamp<int64>(Count, 0, Num() - Begin);
+	Out.Reserve(Out.Num() + int32(End - Begin));
+	for (int64 Index = Begin; Index < End; ++Index)
+	{
+		Out.Add((*this)[Index]);
+	}
+}
+
+FPrecisionMappedDataset::FPrecisionMappedDataset() = default;
+
+FPrecisionMappedDataset::~FPrecisionMappedDataset()
+{
+	Close();
+}
+
+bool FPrecisionMappedDataset::Open(const FString& Path)
+{
+	Close();
+	Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	// The header is mapped just long enough to be read: the LODs are mapped when they are viewed
+	const int64 FileSize = Handle->GetFileSize();
+	const int64 MaxHeaderSize = FMath::Min(FileSize, PrecisionDataset::GetHeaderSize(PrecisionDataset::MaxLods));
+	TUniquePtr<IMappedFileRegion> HeaderRegion(MaxHeaderSize >= PrecisionDataset::HeaderSize ? Handle->MapRegion(0, MaxHeaderSize) : nullptr);
+	if (!HeaderRegion.IsValid() || !PrecisionDataset::ReadHeader(HeaderRegion->GetMappedPtr(), HeaderRegion->GetMappedSize(), FileSize, Header)
+		|| !IsCompatible(Header))
+	{
+		HeaderRegion.Reset();
+		Close();
+		return false;
+	}
+
+	Regions.SetNum(int32(Header.NumLods));
+	return true;
+}
+
+void FPrecisionMappedDataset::Close()
+{
+	Regions.Empty();
+	Handle.Reset();
+	Header = PrecisionDataset::FHeader();
+}
+
+FPrecisionDatasetView FPrecisionMappedDataset::GetView(int32 Lod)
+{
+	if (!IsOpen())
+	{
+		return FPrecisionDatasetView();
+	}
+
+	// With the structure of arrays layout, the mapping also spans the X and Y of the other LODs, but only the pages that are read are loaded
+	const int32 LodIndex = Lod < 0 || Lod >= GetNumLods() ? GetNumLods() - 1 : Lod;
+	if (!Regions[LodIndex].IsValid())
+	{
+		int64 Offsets[3];
+		int64 Sizes[3];
+		const int32 NumRanges = Header.GetLodRanges(LodIndex, Offsets, Sizes);
+		Regions[LodIndex].Reset(Handle->MapRegion(0, Offsets[NumRanges - 1] + Sizes[NumRanges - 1]));
+		if (!Regions[LodIndex].IsValid())
+		{
+			return FPrecisionDatasetView();
+		}
+	}
+	return FPrecisionDatasetView(Regions[LodIndex]->GetMappedPtr(), Header, LodIndex);
+}
+
+bool FPrecisionMappedDataset::SaveToFile(const FString& Path, const TArray<FVectorFixed>& Positions, const TArray<int64>& LodCounts,
+	EPrecisionDatasetLayout Layout)
+{
+	TArray<uint8> Bytes;
+	WriteDataset(Bytes, Positions, LodCounts, Layout);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+void UPrecisionPositionDataset::SetPositions(const TArray<FVectorFixed>& Positions, const TArray<int64>& LodCounts, EPrecisionDatasetLayout Layout)
+{
+	TArray<uint8> Bytes;
+	WriteDataset(Bytes, Positions, LodCounts, Layout);
+
+	ClosePayload();
+	Payload.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(Payload.Realloc(Bytes.Num()), Bytes.GetData(), Bytes.Num());
+	Payload.Unlock();
+}
+
+FPrecisionDatasetView UPrecisionPositionDataset::GetView(int32 Lod)
+{
+	if (!OpenPayload())
+	{
+		return FPrecisionDatasetView();
+	}
+	if (LockedPayload)
+	{
+		return FPrecisionDatasetView(LockedPayload, Header, Lod);
+	}
+
+	// Only the ranges of the LOD are read, one after the other
+	const int32 LodIndex = Lod < 0 || Lod >= GetNumLods() ? GetNumLods() - 1 : Lod;
+	const PrecisionDataset::FHeader LodHeader = Header.GetLodHeader(LodIndex);
+	TArray64<uint8>& Bytes = LodPayloads[LodIndex];
+	if (Bytes.Num() == 0 && LodHeader.NumPositions > 0)
+	{
+		int64 Offsets[3];
+		int64 Sizes[3];
+		const int32 NumRanges = Header.GetLodRanges(LodIndex, Offsets, Sizes);
+		Bytes.SetNumUninitialized(NumRanges * Sizes[0]);
+		for (int32 Range = 0; Range < NumRanges; ++Range)
+		{
+			if (!ReadPayloadRange(Payload, Offsets[Range], Sizes[Range], Bytes.GetData() + Range * Sizes[0]))
+			{
+				Bytes.Empty();
+				return FPrecisionDatasetView();
+			}
+		}
+	}
+	return FPrecisionDatasetView(Bytes.GetData(), LodHeader, 0);
+}
+
+int32 UPrecisionPositionDataset::GetNumLods()
+{
+	return OpenPayload() ? int32(Header.NumLods) : 0;
+}
+
+int64 UPrecisionPositionDataset::GetNumPositions(int32 Lod)
+{
+	return OpenPayload() ? Header.GetLodCount(Lod) : 0;
+}
+
+FVectorFixed UPrecisionPositionDataset::GetPosition(int64 Index)
+{
+	if (!OpenPayload())
+	{
+		return FVectorFixed();
+	}
+
+	// The first LOD that has the position, so that only it is read when the payload isn't in memory
+	int32 Lod = 0;
+	while (Lod < GetNumLods() - 1 && Header.LodCounts[Lod] <= Index)
+	{
+		++Lod;
+	}
+	const FPrecisionDatasetView View = GetView(Lod);
+	return Index >= 0 && Index < View.Num() ? View[Index] : FVectorFixed();
+}
+
+void UPrecisionPositionDataset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// Only the archives that load or save the payload replace or lock it: the views stay valid through the other ones (reference collectors...)
+	if ((Ar.IsLoading() || Ar.IsSaving()) && (Ar.IsTransacting() || (Ar.IsPersistent() && !Ar.IsObjectReferenceCollector() && !Ar.ShouldSkipBulkData())))
+	{
+		ClosePayload();
+	}
+
+	// The payload is saved after the exports, so cooked builds map it, where the platform supports it, rather than load it
+	if (Ar.IsSaving())
+	{
+		Payload.SetBulkDataFlags(BULKDATA_Force_NOT_InlinePayload | BULKDATA_MemoryMappedPayload);
+	}
+	Payload.Serialize(Ar, this, INDEX_NONE, true);
+}
+
+void UPrecisionPositionDataset::BeginDestroy()
+{
+	ClosePayload();
+	Super::BeginDestroy();
+}
+
+bool UPrecisionPositionDataset::OpenPayload()
+{
+	if (Header.NumLods > 0)
+	{
+		return true;
+	}
+
+	const int64 Size = Payload.GetBulkDataSize();
+	if (Size < PrecisionDataset::HeaderSize)
+	{
+		return false;
+	}
+
+	// Payloads in memory (new or edited assets) or mapped (cooked builds) are read in place
+	if (Payload.IsBulkDataLoaded() || !Payload.CanLoadFromDisk())
+	{
+		LockedPayload = static_cast<const uint8*>(Payload.LockReadOnly());
+		if (!LockedPayload || !PrecisionDataset::ReadHeader(LockedPayload, Size, Size, Header) || !IsCompatible(Header))
+		{
+			ClosePayload();
+			return false;
+		}
+		return true;
+	}
+
+	// Others are left on the disk: only the header is read, then each LOD the first time it's viewed
+	TArray<uint8> HeaderBytes;
+	HeaderBytes.SetNumUninitialized(int32(FMath::Min(Size, PrecisionDataset::GetHeaderSize(PrecisionDataset::MaxLods))));
+	if (!ReadPayloadRange(Payload, 0, HeaderBytes.Num(), HeaderBytes.GetData())
+		|| !PrecisionDataset::ReadHeader(HeaderBytes.GetData(), HeaderBytes.Num(), Size, Header) || !IsCompatible(Header))
+	{
+		ClosePayload();
+		return false;
+	}
+	LodPayloads.SetNum(int32(Header.NumLods));
+	return true;
+}
+
+void UPrecisionPositionDataset::ClosePayload()
+{
+	if (LockedPayload)
+	{
+		Payload.Unlock();
+		LockedPayload = nullptr;
+	}
+	LodPayloads.Empty();
+	Header = PrecisionDataset::FHeader();
+}
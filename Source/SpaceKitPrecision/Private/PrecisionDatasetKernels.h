@@ -0,0 +1,264 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+#include <cstring>
+
+// Datasets of fixed-point positions (star catalogs, asteroid fields): flat binaries that are read in place, from memory-mapped files or bulk data,
+// without deserializing the positions.
+//
+// Format, little endian:
+//   Header: "SKPD", uint16 version, uint8 layout (see ELayout), uint8 64-bit words per mantissa, int32 fixed-point exponent, uint32 number of LODs,
+//           int64 number of positions, int64 offset of the positions, then the int64 number of positions of each LOD.
+//   Positions: the mantissa words of their components, lowest first, at an offset aligned to PayloadAlignment.
+// The positions are sorted by LOD: LOD i is the first positions of the dataset, up to its count, and the last LOD is the whole dataset. With both
+// layouts, a LOD is contiguous (per component, with SoA), so the pages of the file mapping past it are never touched while only it is read.
+namespace PrecisionDataset
+{
+	constexpr uint16 FormatVersion = 1;
+	constexpr int64 HeaderSize = 32;
+	constexpr int64 PayloadAlignment = 64;
+	constexpr uint32 MaxLods = 32;
+
+	enum class ELayout : uint8
+	{
+		// X, Y, Z of each position, one position after the other
+		ArrayOfStructures,
+		// All the X, then all the Y, then all the Z
+		StructureOfArrays,
+	};
+
+	inline uint64 ReadLittleEndian(const uint8* Bytes, int32 NumBytes)
+	{
+		uint64 Value = 0;
+		for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+		{
+			Value |= uint64(Bytes[Byte]) << (Byte * 8);
+		}
+		return Value;
+	}
+
+	// ByteArrayType needs Append(const uint8* Data, Num), like TArray<uint8>
+	template<typename ByteArrayType>
+	void WriteLittleEndian(ByteArrayType& Bytes, uint64 Value, int32 NumBytes)
+	{
+		uint8 Buffer[8];
+		for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+		{
+			Buffer[Byte] = uint8(Value >> (Byte * 8));
+		}
+		Bytes.Append(Buffer, NumBytes);
+	}
+
+	// Mantissas are 64-bit words in the files, whatever the size of ttmath::uint
+	template<ttmath::uint Words>
+	constexpr int32 FileWords()
+	{
+		return int32((Words * sizeof(ttmath::uint) + 7) / 8);
+	}
+
+	struct FHeader
+	{
+		ELayout Layout = ELayout::ArrayOfStructures;
+		int32 WordsPerMantissa = 0;
+		int32 Exponent = 0;
+		int64 NumPositions = 0;
+		int64 PayloadOffset = 0;
+		uint32 NumLods = 0;
+		int64 LodCounts[MaxLods] = {};
+
+		int64 GetPayloadSize() const
+		{
+			return NumPositions * 3 * WordsPerMantissa * 8;
+		}
+
+		int64 GetLodCount(int32 Lod) const
+		{
+			return LodCounts[Lod < 0 || uint32(Lod) >= NumLods ? NumLods - 1 : uint32(Lod)];
+		}
+
+		// Byte ranges of the file the positions of a LOD are in: 1 with the array of structures layout, 3 with the structure of arrays one
+		int32 GetLodRanges(int32 Lod, int64 OutOffsets[3], int64 OutSizes[3]) const
+		{
+			const int64 ComponentSize = GetLodCount(Lod) * WordsPerMantissa * 8;
+			if (Layout == ELayout::ArrayOfStructures)
+			{
+				OutOffsets[0] = PayloadOffset;
+				OutSizes[0] = 3 * ComponentSize;
+				return 1;
+			}
+			for (int32 Component = 0; Component < 3; ++Component)
+			{
+				OutOffsets[Component] = PayloadOffset + Component * NumPositions * WordsPerMantissa * 8;
+				OutSizes[Component] = ComponentSize;
+			}
+			return 3;
+		}
+
+		// Header of a LOD alone: its ranges, read one after the other to a buffer, are a dataset of one LOD whose positions start at the buffer
+		FHeader GetLodHeader(int32 Lod) const
+		{
+			FHeader LodHeader = *this;
+			LodHeader.NumPositions = GetLodCount(Lod);
+			LodHeader.PayloadOffset = 0;
+			LodHeader.NumLods = 1;
+			LodHeader.LodCounts[0] = LodHeader.NumPositions;
+			return LodHeader;
+		}
+	};
+
+	// Size of the header and the LOD table, that ReadHeader needs
+	inline int64 GetHeaderSize(uint32 NumLods)
+	{
+		return HeaderSize + int64(NumLods) * 8;
+	}
+
+	// Reads the header of a dataset of FileSize bytes, from its first Num bytes. Returns false if it isn't a dataset, or is truncated
+	inline bool ReadHeader(const uint8* Data, int64 Num, int64 FileSize, FHeader& OutHeader)
+	{
+		if (Num < HeaderSize || std::memcmp(Data, "SKPD", 4) != 0 || ReadLittleEndian(Data + 4, 2) != FormatVersion)
+		{
+			return false;
+		}
+
+		OutHeader.Layout = ELayout(Data[6]);
+		OutHeader.WordsPerMantissa = Data[7];
+		OutHeader.Exponent = int32(uint32(ReadLittleEndian(Data + 8, 4)));
+		OutHeader.NumLods = uint32(ReadLittleEndian(Data + 12, 4));
+		OutHeader.NumPositions = int64(ReadLittleEndian(Data + 16, 8));
+		OutHeader.PayloadOffset = int64(ReadLittleEndian(Data + 24, 8));
+		if (OutHeader.Layout > ELayout::StructureOfArrays || OutHeader.WordsPerMantissa == 0 || OutHeader.NumLods == 0 || OutHeader.NumLods > MaxLods
+			|| Num < GetHeaderSize(OutHeader.NumLods) || OutHeader.NumPositions < 0 || OutHeader.NumPositions > (int64(1) << 40)
+			|| OutHeader.PayloadOffset < GetHeaderSize(OutHeader.NumLods) || OutHeader.PayloadOffset + OutHeader.GetPayloadSize() > FileSize)
+		{
+			return false;
+		}
+
+		for (uint32 Lod = 0; Lod < OutHeader.NumLods; ++Lod)
+		{
+			OutHeader.LodCounts[Lod] = int64(ReadLittleEndian(Data + HeaderSize + Lod * 8, 8));
+			if (OutHeader.LodCounts[Lod] < (Lod > 0 ? OutHeader.LodCounts[Lod - 1] : 0) || OutHeader.LodCounts[Lod] > OutHeader.NumPositions)
+			{
+				return false;
+			}
+		}
+		return OutHeader.LodCounts[OutHeader.NumLods - 1] == OutHeader.NumPositions;
+	}
+
+	// Writes a dataset of NumPositions positions, as the 3 mantissas of each one, sorted by LOD. LodCounts are the increasing numbers of positions
+	// of the NumLods LODs (at most MaxLods), the last one is NumPositions, and can be omitted
+	template<ttmath::uint Words, typename ByteArrayType>
+	void Write(ByteArrayType& Bytes, const ttmath::Int<Words>* Mantissas, int64 NumPositions, int32 Exponent, ELayout Layout,
+		const int64* LodCounts = nullptr, uint32 NumLods = 0)
+	{
+		constexpr int32 WordsPerMantissa = FileWords<Words>();
+		const bool bLastLodMissing = NumLods == 0 || LodCounts[NumLods - 1] != NumPositions;
+		const uint32 NumFileLods = bLastLodMissing && NumLods < MaxLods ? NumLods + 1 : NumLods;
+		const int64 PayloadOffset = (GetHeaderSize(NumFileLods) + PayloadAlignment - 1) / PayloadAlignment * PayloadAlignment;
+
+		Bytes.Append(reinterpret_cast<const uint8*>("SKPD"), 4);
+		WriteLittleEndian(Bytes, FormatVersion, 2);
+		WriteLittleEndian(Bytes, uint8(Layout), 1);
+		WriteLittleEndian(Bytes, WordsPerMantissa, 1);
+		WriteLittleEndian(Bytes, uint32(Exponent), 4);
+		WriteLittleEndian(Bytes, NumFileLods, 4);
+		WriteLittleEndian(Bytes, uint64(NumPositions), 8);
+		WriteLittleEndian(Bytes, uint64(PayloadOffset), 8);
+		for (uint32 Lod = 0; Lod < NumFileLods; ++Lod)
+		{
+			WriteLittleEndian(Bytes, uint64(Lod < NumLods && Lod + 1 < NumFileLods ? LodCounts[Lod] : NumPositions), 8);
+		}
+		for (int64 Padding = GetHeaderSize(NumFileLods); Padding < PayloadOffset; ++Padding)
+		{
+			WriteLittleEndian(Bytes, 0, 1);
+		}
+
+		auto WriteMantissa = [&Bytes](const ttmath::Int<Words>& Mantissa)
+		{
+			uint8 Buffer[WordsPerMantissa * 8] = {};
+			for (ttmath::uint i = 0; i < Words; ++i)
+			{
+				for (uint32 Byte = 0; Byte < sizeof(ttmath::uint); ++Byte)
+				{
+					Buffer[i * sizeof(ttmath::uint) + Byte] = uint8(uint64(Mantissa.table[i]) >> (Byte * 8));
+				}
+			}
+			Bytes.Append(Buffer, WordsPerMantissa * 8);
+		};
+		for (int32 Pass = 0; Pass < (Layout == ELayout::ArrayOfStructures ? 1 : 3); ++Pass)
+		{
+			for (int64 Index = 0; Index < NumPositions; ++Index)
+			{
+				for (int32 Component = 0; Component < 3; ++Component)
+				{
+					if (Layout == ELayout::ArrayOfStructures || Component == Pass)
+					{
+						WriteMantissa(Mantissas[Index * 3 + Component]);
+					}
+				}
+			}
+		}
+	}
+
+	// Positions of a dataset, read in place, without copying the file
+	class FView
+	{
+	public:
+		FView() = default;
+
+		// File points to the start of the dataset, whose header is Header. Only the LOD ranges (see FHeader::GetLodRanges) of the LOD of the view
+		// are read, so only they must be mapped, or loaded
+		FView(const uint8* File, const FHeader& InHeader, int32 Lod = -1)
+			: Payload(File + InHeader.PayloadOffset)
+			, Header(InHeader)
+			, NumPositions(InHeader.GetLodCount(Lod))
+		{
+		}
+
+		// Mantissas of other sizes, or of another fixed-point exponent, than the build's can't be read
+		template<ttmath::uint Words>
+		static bool IsCompatible(const FHeader& Header, int32 Exponent)
+		{
+			return Header.WordsPerMantissa == FileWords<Words>() && Header.Exponent == Exponent;
+		}
+
+		int64 Num() const
+		{
+			return NumPositions;
+		}
+
+		// Mantissa of a component of a position, whose size IsCompatible with the dataset
+		template<ttmath::uint Words>
+		void GetMantissa(int64 Index, int32 Component, ttmath::Int<Words>& OutMantissa) const
+		{
+			const int64 Mantissa = Header.Layout == ELayout::ArrayOfStructures ? Index * 3 + Component : Component * Header.NumPositions + Index;
+			const uint8* Bytes = Payload + Mantissa * Header.WordsPerMantissa * 8;
+#if PLATFORM_LITTLE_ENDIAN
+			std::memcpy(OutMantissa.table, Bytes, Words * sizeof(ttmath::uint));
+#else
+			for (ttmath::uint i = 0; i < Words; ++i)
+			{
+				OutMantissa.table[i] = ttmath::uint(ReadLittleEndian(Bytes + i * sizeof(ttmath::uint), int32(sizeof(ttmath::uint))));
+			}
+#endif
+		}
+
+		template<ttmath::uint Words>
+		void GetPosition(int64 Index, ttmath::Int<Words>& OutX, ttmath::Int<Words>& OutY, ttmath::Int<Words>& OutZ) const
+		{
+			GetMantissa(Index, 0, OutX);
+			GetMantissa(Index, 1, OutY);
+			GetMantissa(Index, 2, OutZ);
+		}
+
+	private:
+		const uint8* Payload = nullptr;
+		FHeader Header;
+		int64 NumPositions = 0;
+	};
+}
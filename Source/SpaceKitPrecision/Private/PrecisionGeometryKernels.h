@@ -0,0 +1,77 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Vector, quaternion and transform math of the fixed-point types, without any engine dependency, so that it's also built by Standalone/CMakeLists.txt.
+// The functions are templated on the vector and quaternion types, which only need X, Y, Z (and W) members, a constructor taking the components, and arithmetic operators.
+// FVectorFixed, FQuatFixed and FTransformFixed forward to them, so both builds do the same operations in the same order, and give the same bits.
+namespace PrecisionGeometry
+{
+	template<typename VectorType>
+	auto Dot(const VectorType& A, const VectorType& B) -> decltype(A.X * B.X)
+	{
+		return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+	}
+
+	template<typename VectorType>
+	VectorType Cross(const VectorType& A, const VectorType& B)
+	{
+		return VectorType(A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X);
+	}
+
+	// Standard Hamiltonian product
+	template<typename QuatType>
+	QuatType QuatMultiply(const QuatType& A, const QuatType& B)
+	{
+		return QuatType(
+			(A.W * B.X) + (A.X * B.W) + (A.Y * B.Z) - (A.Z * B.Y),
+			(A.W * B.Y) - (A.X * B.Z) + (A.Y * B.W) + (A.Z * B.X),
+			(A.W * B.Z) + (A.X * B.Y) - (A.Y * B.X) + (A.Z * B.W),
+			(A.W * B.W) - (A.X * B.X) - (A.Y * B.Y) - (A.Z * B.Z)
+		);
+	}
+
+	// For a unit quaternion, the inverse is the conjugate
+	template<typename QuatType>
+	QuatType QuatInverse(const QuatType& Q)
+	{
+		return QuatType(-Q.X, -Q.Y, -Q.Z, Q.W);
+	}
+
+	// Rotates V by a normalized quaternion: V + W*T + Q x T, with T = 2 * (Q x V)
+	template<typename QuatType, typename VectorType>
+	VectorType QuatRotateVector(const QuatType& Q, const VectorType& V)
+	{
+		using ScalarType = decltype(Q.W);
+
+		const VectorType QXYZ(Q.X, Q.Y, Q.Z);
+		const VectorType T = Cross(QXYZ, V) * ScalarType(2);
+		return V + (T * Q.W) + Cross(QXYZ, T);
+	}
+
+	// Builds the quaternion of a rotator, from the sines and cosines of its half angles
+	template<typename QuatType, typename ScalarType>
+	QuatType QuatFromHalfAngles(const ScalarType& SinP, const ScalarType& CosP, const ScalarType& SinY, const ScalarType& CosY, const ScalarType& SinR, const ScalarType& CosR)
+	{
+		return QuatType(
+			SinR * CosP * CosY - CosR * SinP * SinY,
+			CosR * SinP * CosY + SinR * CosP * SinY,
+			CosR * CosP * SinY - SinR * SinP * CosY,
+			CosR * CosP * CosY + SinR * SinP * SinY
+		);
+	}
+
+	// Location + Rotation(V * Scale)
+	template<typename QuatType, typename VectorType>
+	VectorType TransformPosition(const QuatType& Rotation, const VectorType& Location, const VectorType& Scale, const VectorType& V)
+	{
+		return QuatRotateVector(Rotation, V * Scale) + Location;
+	}
+
+	// Inverse of TransformPosition: Rotation^-1(V - Location) / Scale
+	template<typename QuatType, typename VectorType>
+	VectorType InverseTransformPosition(const QuatType& Rotation, const VectorType& Location, const VectorType& Scale, const VectorType& V)
+	{
+		return QuatRotateVector(QuatInverse(Rotation), V - Location) / Scale;
+	}
+}
@@ -0,0 +1,142 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+// Hashes of the mantissas of the precision types, for GetTypeHash and the state checksums of FPrecisionStateHasher.
+// They hash the values of the words, as 64-bit words, so they are the same on every platform, whatever its byte order and the size of ttmath::uint.
+namespace PrecisionHash
+{
+	// XXH64 of a stream of 64-bit words, which is the XXH64 of their little-endian bytes. The 4 lanes of the stripes are independent,
+	// so their multiplications overlap in the pipeline
+	class FXxHash64
+	{
+	public:
+		static constexpr uint64 Prime1 = 11400714785074694791ull;
+		static constexpr uint64 Prime2 = 14029467366897019727ull;
+		static constexpr uint64 Prime3 = 1609587929392839161ull;
+		static constexpr uint64 Prime4 = 9650029242287828579ull;
+		static constexpr uint64 Prime5 = 2870177450012600261ull;
+
+		explicit FXxHash64(uint64 InSeed = 0)
+			: Seed(InSeed)
+		{
+			Lanes[0] = Seed + Prime1 + Prime2;
+			Lanes[1] = Seed + Prime2;
+			Lanes[2] = Seed;
+			Lanes[3] = Seed - Prime1;
+		}
+
+		void Add(uint64 Word)
+		{
+			Stripe[NumWords & 3] = Word;
+			if ((++NumWords & 3) == 0)
+			{
+				Lanes[0] = Round(Lanes[0], Stripe[0]);
+				Lanes[1] = Round(Lanes[1], Stripe[1]);
+				Lanes[2] = Round(Lanes[2], Stripe[2]);
+				Lanes[3] = Round(Lanes[3], Stripe[3]);
+			}
+		}
+
+		// Integers, signed or not. With 32-bit words, the words are paired, lowest first
+		template<ttmath::uint Words>
+		void Add(const ttmath::UInt<Words>& Number)
+		{
+			if constexpr (sizeof(ttmath::uint) == 8)
+			{
+				for (ttmath::uint i = 0; i < Words; ++i)
+				{
+					Add(uint64(Number.table[i]));
+				}
+			}
+			else
+			{
+				for (ttmath::uint i = 0; i < Words; i += 2)
+				{
+					Add(uint64(Number.table[i]) | (i + 1 < Words ? uint64(Number.table[i + 1]) << 32 : 0));
+				}
+			}
+		}
+
+		// Big floats: exponent, mantissa, then the info byte (sign, NaN)
+		template<ttmath::uint Exponent, ttmath::uint Mantissa>
+		void Add(const ttmath::Big<Exponent, Mantissa>& Number)
+		{
+			Add(Number.exponent);
+			Add(Number.mantissa);
+			Add(uint64(Number.info));
+		}
+
+		// Raw bytes, as little-endian words, the last one padded with zeros. For the types whose words aren't accessible
+		void AddBytes(const void* Data, int64 NumBytes)
+		{
+			const uint8* Bytes = static_cast<const uint8*>(Data);
+			for (int64 Offset = 0; Offset < NumBytes; Offset += 8)
+			{
+				uint64 Word = 0;
+				for (int64 Byte = 0; Byte < 8 && Offset + Byte < NumBytes; ++Byte)
+				{
+					Word |= uint64(Bytes[Offset + Byte]) << (Byte * 8);
+				}
+				Add(Word);
+			}
+		}
+
+		uint64 Finish() const
+		{
+			uint64 Hash;
+			if (NumWords >= 4)
+			{
+				Hash = RotateLeft(Lanes[0], 1) + RotateLeft(Lanes[1], 7) + RotateLeft(Lanes[2], 12) + RotateLeft(Lanes[3], 18);
+				for (int32 Lane = 0; Lane < 4; ++Lane)
+				{
+					Hash = (Hash ^ Round(0, Lanes[Lane])) * Prime1 + Prime4;
+				}
+			}
+			else
+			{
+				Hash = Seed + Prime5;
+			}
+			Hash += NumWords * 8;
+
+			for (uint64 i = 0; i < (NumWords & 3); ++i)
+			{
+				Hash = RotateLeft(Hash ^ Round(0, Stripe[i]), 27) * Prime1 + Prime4;
+			}
+
+			Hash ^= Hash >> 33;
+			Hash *= Prime2;
+			Hash ^= Hash >> 29;
+			Hash *= Prime3;
+			Hash ^= Hash >> 32;
+			return Hash;
+		}
+
+	private:
+		static uint64 RotateLeft(uint64 Value, int32 Shift)
+		{
+			return (Value << Shift) | (Value >> (64 - Shift));
+		}
+
+		static uint64 Round(uint64 Lane, uint64 Word)
+		{
+			return RotateLeft(Lane + Word * Prime2, 31) * Prime1;
+		}
+
+		uint64 Seed;
+		uint64 Lanes[4];
+		uint64 Stripe[4] = {};
+		uint64 NumWords = 0;
+	};
+
+	// 32-bit hash for GetTypeHash, from a finished XXH64
+	inline uint32 ToTypeHash(uint64 Hash)
+	{
+		return uint32(Hash ^ (Hash >> 32));
+	}
+}
@@ -0,0 +1,368 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+#include "SpaceKitPrecision/Private/PrecisionTextKernels.h"
+
+#include "HAL/Platform.h"
+
+// Splitting of CSV and JSON tables in rows and cells, and parsing of their fixed-point cells, for FPrecisionBulkImport.
+// The rows are found by one pass over the text, that only looks for line breaks and quotes (and brackets for JSON), so that the cells
+// of the rows can then be parsed in parallel. The numbers are parsed in place, by PrecisionText::ParseFixed, without copying the cells.
+// Texts must be followed by a character that isn't part of a number, like the null of a string.
+namespace PrecisionImport
+{
+	template<typename CharType>
+	bool IsBlank(CharType Char)
+	{
+		return Char == CharType(' ') || Char == CharType('\t') || Char == CharType('\r') || Char == CharType('\n');
+	}
+
+	template<typename CharType>
+	const CharType* SkipBlanks(const CharType* Cursor, const CharType* End)
+	{
+		while (Cursor < End && IsBlank(*Cursor))
+		{
+			++Cursor;
+		}
+		return Cursor;
+	}
+
+	// Calls OnRow(Start, End) for each row of a CSV text, in order. Rows end at line breaks outside of quotes, the \r of \r\n excluded.
+	// Blank lines are skipped
+	template<typename CharType, typename RowFunctionType>
+	void SplitCsvRows(const CharType* Text, int32 Length, RowFunctionType&& OnRow)
+	{
+		const CharType* End = Text + Length;
+		const CharType* Start = Text;
+		const CharType* Cursor = Text;
+		bool bQuoted = false;
+		for (;;)
+		{
+			// Only the line breaks and the quotes matter
+			while (Cursor < End && *Cursor != CharType('\n') && *Cursor != CharType('"'))
+			{
+				++Cursor;
+			}
+			if (Cursor < End && (*Cursor == CharType('"') || bQuoted))
+			{
+				// A doubled quote in a quoted cell toggles twice
+				bQuoted = *Cursor == CharType('"') ? !bQuoted : bQuoted;
+				++Cursor;
+				continue;
+			}
+
+			const CharType* RowEnd = Cursor > Start && Cursor[-1] == CharType('\r') ? Cursor - 1 : Cursor;
+			if (SkipBlanks(Start, RowEnd) != RowEnd)
+			{
+				OnRow(Start, RowEnd);
+			}
+			if (Cursor == End)
+			{
+				return;
+			}
+			Start = ++Cursor;
+		}
+	}
+
+	// Calls OnCell(Column, Start, End) for each cell of a CSV row, in order. The range of a quoted cell is inside its quotes,
+	// and its doubled quotes are left as they are, which only matters to text cells
+	template<typename CharType, typename CellFunctionType>
+	void SplitCsvCells(const CharType* Row, const CharType* End, CellFunctionType&& OnCell)
+	{
+		int32 Column = 0;
+		const CharType* Cursor = Row;
+		for (;;)
+		{
+			Cursor = SkipBlanks(Cursor, End);
+			const CharType* Start = Cursor;
+			const CharType* CellEnd;
+			if (Cursor < End && *Cursor == CharType('"'))
+			{
+				Start = ++Cursor;
+				while (Cursor < End && !(*Cursor == CharType('"') && (Cursor + 1 == End || Cursor[1] != CharType('"'))))
+				{
+					Cursor += *Cursor == CharType('"') ? 2 : 1;
+				}
+				CellEnd = Cursor;
+				while (Cursor < End && *Cursor != CharType(','))
+				{
+					++Cursor;
+				}
+			}
+			else
+			{
+				while (Cursor < End && *Cursor != CharType(','))
+				{
+					++Cursor;
+				}
+				CellEnd = Cursor;
+				while (CellEnd > Start && IsBlank(CellEnd[-1]))
+				{
+					--CellEnd;
+				}
+			}
+
+			OnCell(Column++, Start, CellEnd);
+			if (Cursor >= End)
+			{
+				return;
+			}
+			++Cursor;
+		}
+	}
+
+	// Parses the whole of Start..End as a number, bare or in parentheses, blanks around. Returns false, and Mantissa is then 0, when it isn't one
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	bool ParseNumber(const CharType* Start, const CharType* End, ttmath::Int<Words>& Mantissa)
+	{
+		Start = SkipBlanks(Start, End);
+		const int32 Length = Start < End ? PrecisionText::ParseToken(Start, [&Mantissa](const CharType* Text) { return PrecisionText::ParseFixed<FractionBits>(Text, Mantissa); }) : 0;
+		if (Length == 0 || Start + Length > End || SkipBlanks(Start + Length, End) != End)
+		{
+			Mantissa.SetZero();
+			return false;
+		}
+		return true;
+	}
+
+	// Parses Start..End as a vector, like FVectorFixed::ToString writes it: (X=1.0,Y=2.0,Z=3.0), the parentheses optional, blanks around.
+	// Returns false, and the mantissas are then 0, when it isn't one
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	bool ParseVector(const CharType* Start, const CharType* End, ttmath::Int<Words>* Mantissas)
+	{
+		const auto Fail = [Mantissas]()
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Mantissas[Axis].SetZero();
+			}
+			return false;
+		};
+
+		const CharType* Cursor = SkipBlanks(Start, End);
+		const bool bParenthesis = Cursor < End && *Cursor == CharType('(');
+		Cursor += bParenthesis ? 1 : 0;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Cursor = SkipBlanks(Cursor, End);
+			if (Axis > 0)
+			{
+				if (Cursor == End || *Cursor != CharType(','))
+				{
+					return Fail();
+				}
+				Cursor = SkipBlanks(Cursor + 1, End);
+			}
+			if (End - Cursor < 2 || *Cursor != CharType("XYZ"[Axis]) || Cursor[1] != CharType('='))
+			{
+				return Fail();
+			}
+			Cursor = SkipBlanks(Cursor + 2, End);
+			const int32 Length = Cursor < End ? PrecisionText::ParseFixed<FractionBits>(Cursor, Mantissas[Axis]) : 0;
+			if (Length == 0 || Cursor + Length > End)
+			{
+				return Fail();
+			}
+			Cursor += Length;
+		}
+
+		Cursor = SkipBlanks(Cursor, End);
+		if (bParenthesis)
+		{
+			if (Cursor == End || *Cursor != CharType(')'))
+			{
+				return Fail();
+			}
+			Cursor = SkipBlanks(Cursor + 1, End);
+		}
+		return Cursor == End ? true : Fail();
+	}
+
+	// End of the JSON string starting at the quote Text, after its closing quote, or End when it isn't closed
+	template<typename CharType>
+	const CharType* SkipJsonString(const CharType* Text, const CharType* End)
+	{
+		for (const CharType* Cursor = Text + 1; Cursor < End; ++Cursor)
+		{
+			if (*Cursor == CharType('\\'))
+			{
+				++Cursor;
+			}
+			else if (*Cursor == CharType('"'))
+			{
+				return Cursor + 1;
+			}
+		}
+		return End;
+	}
+
+	// End of the JSON value starting at Text (blanks skipped), at the comma or bracket after it: strings, numbers, objects and arrays.
+	// Returns End when the value isn't closed
+	template<typename CharType>
+	const CharType* SkipJsonValue(const CharType* Text, const CharType* End)
+	{
+		int32 Depth = 0;
+		for (const CharType* Cursor = SkipBlanks(Text, End); Cursor < End;)
+		{
+			const CharType Char = *Cursor;
+			if (Char == CharType('"'))
+			{
+				Cursor = SkipJsonString(Cursor, End);
+				continue;
+			}
+			if (Char == CharType('{') || Char == CharType('['))
+			{
+				++Depth;
+			}
+			else if (Char == CharType('}') || Char == CharType(']') || Char == CharType(','))
+			{
+				if (Depth == 0)
+				{
+					return Cursor;
+				}
+				Depth -= Char == CharType(',') ? 0 : 1;
+			}
+			++Cursor;
+		}
+		return End;
+	}
+
+	// Calls OnElement(Start, End) for each element of the JSON array of the text, in order, blanks trimmed.
+	// Returns false when the text isn't an array, or the array isn't closed
+	template<typename CharType, typename ElementFunctionType>
+	bool SplitJsonArray(const CharType* Text, int32 Length, ElementFunctionType&& OnElement)
+	{
+		const CharType* End = Text + Length;
+		const CharType* Cursor = SkipBlanks(Text, End);
+		if (Cursor == End || *Cursor != CharType('['))
+		{
+			return false;
+		}
+
+		Cursor = SkipBlanks(Cursor + 1, End);
+		if (Cursor < End && *Cursor == CharType(']'))
+		{
+			return true;
+		}
+		while (Cursor < End)
+		{
+			const CharType* ElementEnd = SkipJsonValue(Cursor, End);
+			if (ElementEnd == End)
+			{
+				return false;
+			}
+			const CharType* TrimmedEnd = ElementEnd;
+			while (TrimmedEnd > Cursor && IsBlank(TrimmedEnd[-1]))
+			{
+				--TrimmedEnd;
+			}
+			OnElement(Cursor, TrimmedEnd);
+			if (*ElementEnd == CharType(']'))
+			{
+				return true;
+			}
+			if (*ElementEnd != CharType(','))
+			{
+				return false;
+			}
+			Cursor = SkipBlanks(ElementEnd + 1, End);
+		}
+		return false;
+	}
+
+	// Finds the field Name (NameLength characters, without escapes) of the JSON object Start..End, and sets ValueStart..ValueEnd to its value,
+	// blanks trimmed. Returns false when the object doesn't have it
+	template<typename CharType, typename NameCharType>
+	bool FindJsonField(const CharType* Start, const CharType* End, const NameCharType* Name, int32 NameLength, const CharType*& ValueStart, const CharType*& ValueEnd)
+	{
+		const CharType* Cursor = SkipBlanks(Start, End);
+		if (Cursor == End || *Cursor != CharType('{'))
+		{
+			return false;
+		}
+
+		for (Cursor = SkipBlanks(Cursor + 1, End); Cursor < End && *Cursor == CharType('"'); )
+		{
+			const CharType* KeyEnd = SkipJsonString(Cursor, End);
+			bool bMatch = KeyEnd - Cursor == NameLength + 2;
+			for (int32 Char = 0; bMatch && Char < NameLength; ++Char)
+			{
+				bMatch = Cursor[1 + Char] == CharType(Name[Char]);
+			}
+
+			Cursor = SkipBlanks(KeyEnd, End);
+			if (Cursor == End || *Cursor != CharType(':'))
+			{
+				return false;
+			}
+			Cursor = SkipBlanks(Cursor + 1, End);
+			const CharType* FieldEnd = SkipJsonValue(Cursor, End);
+			if (bMatch)
+			{
+				ValueStart = Cursor;
+				ValueEnd = FieldEnd;
+				while (ValueEnd > ValueStart && IsBlank(ValueEnd[-1]))
+				{
+					--ValueEnd;
+				}
+				return ValueStart < ValueEnd;
+			}
+			if (FieldEnd == End || *FieldEnd != CharType(','))
+			{
+				return false;
+			}
+			Cursor = SkipBlanks(FieldEnd + 1, End);
+		}
+		return false;
+	}
+
+	// Strips the quotes of a JSON string value, so that numbers written as strings, to keep their digits from the doubles of JSON readers, parse
+	template<typename CharType>
+	void UnquoteJson(const CharType*& Start, const CharType*& End)
+	{
+		if (End - Start >= 2 && *Start == CharType('"') && End[-1] == CharType('"'))
+		{
+			++Start;
+			--End;
+		}
+	}
+
+	// Parses a JSON number, or a string of a number. Returns false, and Mantissa is then 0, when it isn't one
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	bool ParseJsonNumber(const CharType* Start, const CharType* End, ttmath::Int<Words>& Mantissa)
+	{
+		UnquoteJson(Start, End);
+		return ParseNumber<FractionBits>(Start, End, Mantissa);
+	}
+
+	// Parses a JSON vector: an object of X, Y and Z numbers, like the engine exports vectors, or a string that ParseVector reads.
+	// Returns false, and the mantissas are then 0, when it isn't one
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	bool ParseJsonVector(const CharType* Start, const CharType* End, ttmath::Int<Words>* Mantissas)
+	{
+		if (Start < End && *Start == CharType('"'))
+		{
+			UnquoteJson(Start, End);
+			return ParseVector<FractionBits>(Start, End, Mantissas);
+		}
+
+		bool bParsed = true;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const CharType* ValueStart;
+			const CharType* ValueEnd;
+			bParsed &= FindJsonField(Start, End, "XYZ" + Axis, 1, ValueStart, ValueEnd) && ParseJsonNumber<FractionBits>(ValueStart, ValueEnd, Mantissas[Axis]);
+		}
+		if (!bParsed)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				Mantissas[Axis].SetZero();
+			}
+		}
+		return bParsed;
+	}
+}
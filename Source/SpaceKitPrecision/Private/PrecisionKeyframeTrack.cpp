@@ -0,0 +1,45 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionKeyframeTrack.h"
+
+bool UTransformFixedTrack::SetKeys(const TArray<FRealFixed>& Times, const TArray<FTransformFixed>& Keys)
+{
+	return Track.SetKeys(Times, Keys);
+}
+
+FTransformFixed UTransformFixedTrack::Sample(const FRealFixed& Time) const
+{
+	return Track.Sample(Time);
+}
+
+int32 UTransformFixedTrack::GetNumKeys() const
+{
+	return Track.GetNumKeys();
+}
+
+void UTransformFixedTrack::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+	Ar << Track;
+}
+
+bool UDualVectorRotatorFixedTrack::SetKeys(const TArray<FRealFixed>& Times, const TArray<FDualVectorRotatorFixed>& Keys)
+{
+	return Track.SetKeys(Times, Keys);
+}
+
+FDualVectorRotatorFixed UDualVectorRotatorFixedTrack::Sample(const FRealFixed& Time) const
+{
+	return Track.Sample(Time);
+}
+
+int32 UDualVectorRotatorFixedTrack::GetNumKeys() const
+{
+	return Track.GetNumKeys();
+}
+
+void UDualVectorRotatorFixedTrack::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+	Ar << Track;
+}
@@ -0,0 +1,231 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+// Bit-packed network encoding of fixed-point mantissas, for NetSerialize.
+// The DroppedBits lowest bits of the mantissa are rounded off (to the nearest, ties away from zero), and the rest is written as:
+//   the bit length L of its magnitude, on LengthPrefixBits bits, then if L > 0, the sign bit and the L - 1 low bits of the magnitude (its top bit is implied).
+// So small values, such as positions relative to a nearby anchor, take a few bits instead of the whole mantissa.
+// Arrays of structures of mantissas (transforms, vectors) are delta encoded, element by element, against what the receiver has (see SerializeElementDelta).
+// Bits go through Ar.SerializeBits(void*, int64), lowest first, like FArchive's, and the direction through Ar.IsLoading().
+namespace PrecisionNet
+{
+	// Bits of the length prefix of magnitudes of up to MaxBits bits
+	constexpr int32 LengthPrefixBits(int32 MaxBits)
+	{
+		int32 Bits = 0;
+		while ((1 << Bits) <= MaxBits)
+		{
+			++Bits;
+		}
+		return Bits;
+	}
+
+	// Bits written for a mantissa of Words words, at most
+	template<int32 DroppedBits, ttmath::uint Words>
+	constexpr int32 MaxSerializedBits()
+	{
+		return LengthPrefixBits(int32(Words * TTMATH_BITS_PER_UINT) - DroppedBits) + int32(Words * TTMATH_BITS_PER_UINT) - DroppedBits;
+	}
+
+	template<ttmath::uint Words, typename ArchiveType>
+	void SerializeLowBits(ArchiveType& Ar, ttmath::UInt<Words>& X, int32 NumBits)
+	{
+		for (ttmath::uint i = 0; NumBits > 0; ++i, NumBits -= int32(TTMATH_BITS_PER_UINT))
+		{
+			Ar.SerializeBits(&X.table[i], NumBits < int32(TTMATH_BITS_PER_UINT) ? NumBits : int32(TTMATH_BITS_PER_UINT));
+		}
+	}
+
+	// Writes Mantissa, or reads it back, without its DroppedBits lowest bits. Values rounded beyond the range of the mantissa are saturated.
+	// Returns false when the data read is malformed, and Mantissa is then 0
+	template<int32 DroppedBits, ttmath::uint Words, typename ArchiveType>
+	bool SerializeMantissa(ArchiveType& Ar, ttmath::Int<Words>& Mantissa)
+	{
+		constexpr int32 MantissaBits = int32(Words * TTMATH_BITS_PER_UINT);
+		static_assert(DroppedBits >= 0 && DroppedBits < MantissaBits, "DroppedBits must leave bits to the mantissa");
+
+		uint32 Length = 0;
+		uint8 bNegative = 0;
+		ttmath::UInt<Words> Magnitude;
+
+		if (!Ar.IsLoading())
+		{
+			// The magnitude of the most negative mantissa still fits in the unsigned integer
+			bNegative = Mantissa.IsSign() ? 1 : 0;
+			for (ttmath::uint i = 0; i < Words; ++i)
+			{
+				Magnitude.table[i] = Mantissa.table[i];
+			}
+			if (bNegative)
+			{
+				Magnitude.BitNot();
+				Magnitude.AddOne();
+			}
+
+			if (DroppedBits > 0)
+			{
+				ttmath::UInt<Words> Half;
+				Half.SetZero();
+				Half.SetBit(ttmath::uint(DroppedBits - 1));
+				Magnitude.Add(Half);
+				Magnitude.Rcr(ttmath::uint(DroppedBits));
+			}
+
+			ttmath::uint Table, Index;
+			Length = Magnitude.FindLeadingBit(Table, Index) ? uint32(Table * TTMATH_BITS_PER_UINT + Index + 1) : 0;
+		}
+
+		Ar.SerializeBits(&Length, LengthPrefixBits(MantissaBits - DroppedBits));
+		if (!Ar.IsLoading())
+		{
+			if (Length > 0)
+			{
+				Ar.SerializeBits(&bNegative, 1);
+				SerializeLowBits(Ar, Magnitude, int32(Length) - 1);
+			}
+			return true;
+		}
+
+		Mantissa.SetZero();
+		if (Length == 0)
+		{
+			return true;
+		}
+		if (Length > uint32(MantissaBits - DroppedBits))
+		{
+			return false;
+		}
+
+		Ar.SerializeBits(&bNegative, 1);
+		Magnitude.SetZero();
+		SerializeLowBits(Ar, Magnitude, int32(Length) - 1);
+		Magnitude.SetBit(Length - 1);
+		Magnitude.Rcl(ttmath::uint(DroppedBits));
+
+		// Back to the mantissa, saturated like the fixed-point arithmetic: the rounding can carry the magnitude to 2^(MantissaBits - 1)
+		if (Magnitude.table[Words - 1] >> (TTMATH_BITS_PER_UINT - 1))
+		{
+			if (bNegative)
+			{
+				Mantissa.SetMin();
+			}
+			else
+			{
+				Mantissa.SetMax();
+			}
+			return true;
+		}
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			Mantissa.table[i] = Magnitude.table[i];
+		}
+		if (bNegative)
+		{
+			Mantissa.ChangeSign();
+		}
+		return true;
+	}
+
+	// uint32 in groups of 7 bits, lowest first, each followed by a bit telling whether another group follows
+	template<typename ArchiveType>
+	void SerializeVarUInt32(ArchiveType& Ar, uint32& Value)
+	{
+		if (!Ar.IsLoading())
+		{
+			uint32 Rest = Value;
+			uint8 Group;
+			do
+			{
+				Group = uint8(Rest & 0x7f) | (Rest > 0x7f ? 0x80 : 0);
+				Ar.SerializeBits(&Group, 8);
+				Rest >>= 7;
+			}
+			while (Group & 0x80);
+			return;
+		}
+
+		Value = 0;
+		for (int32 Shift = 0; Shift < 35; Shift += 7)
+		{
+			uint8 Group = 0;
+			Ar.SerializeBits(&Group, 8);
+			Value |= uint32(Group & 0x7f) << Shift;
+			if (!(Group & 0x80))
+			{
+				break;
+			}
+		}
+	}
+
+	// Element of an array of structures of NumComponents fixed-point mantissas, as its difference to Base, the element the receiver already has
+	// (or zeros, when Base is null): a bit telling whether it changed, then if it did, a bit per component telling whether it changed, and the
+	// difference of each changed component, modulo 2^MantissaBits, with SerializeMantissa. Unchanged elements and components take 1 bit.
+	// When loading, Element is Base plus the differences. Returns false when the data read is malformed
+	template<int32 NumComponents, ttmath::uint Words, typename ArchiveType>
+	bool SerializeElementDelta(ArchiveType& Ar, const ttmath::Int<Words>* Base, ttmath::Int<Words>* Element)
+	{
+		static_assert(NumComponents > 0 && NumComponents <= 32, "The changed components are a uint32 mask");
+
+		uint32 ChangedMask = 0;
+		if (!Ar.IsLoading())
+		{
+			for (int32 Component = 0; Component < NumComponents; ++Component)
+			{
+				if (Base ? Element[Component] != Base[Component] : !Element[Component].IsZero())
+				{
+					ChangedMask |= 1u << Component;
+				}
+			}
+		}
+
+		uint8 bChanged = ChangedMask != 0 ? 1 : 0;
+		Ar.SerializeBits(&bChanged, 1);
+		if (bChanged)
+		{
+			Ar.SerializeBits(&ChangedMask, NumComponents);
+		}
+
+		bool bSuccess = true;
+		for (int32 Component = 0; Component < NumComponents; ++Component)
+		{
+			if (!(ChangedMask & (1u << Component)))
+			{
+				if (Ar.IsLoading())
+				{
+					if (Base)
+					{
+						Element[Component] = Base[Component];
+					}
+					else
+					{
+						Element[Component].SetZero();
+					}
+				}
+				continue;
+			}
+
+			// The differences wrap around, like the unsigned arithmetic of the mantissa words
+			ttmath::Int<Words> Difference = Element[Component];
+			if (Base && !Ar.IsLoading())
+			{
+				static_cast<ttmath::UInt<Words>&>(Difference).Sub(Base[Component]);
+			}
+			bSuccess &= SerializeMantissa<0>(Ar, Difference);
+			if (Ar.IsLoading())
+			{
+				Element[Component] = Difference;
+				if (Base)
+				{
+					static_cast<ttmath::UInt<Words>&>(Element[Component]).Add(Base[Component]);
+				}
+			}
+		}
+		return bSuccess;
+	}
+}
@@ -0,0 +1,243 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionNetSerialization.h"
+#include "SpaceKitPrecision/Private/PrecisionNetKernels.h"
+
+namespace
+{
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+
+	FVectorFixed NetAnchor;
+
+	// Replicates the offset of Position to the anchor, rounded to 2^-FractionBits units
+	template<int32 FractionBits>
+	bool SerializeQuantizedPosition(FArchive& Ar, FVectorFixed& Position)
+	{
+		constexpr int32 DroppedBits = REAL_FIXED_EXPONENT > FractionBits ? REAL_FIXED_EXPONENT - FractionBits : 0;
+
+		FVectorFixed Offset = Ar.IsLoading() ? FVectorFixed() : Position - NetAnchor;
+		bool bSuccess = PrecisionNet::SerializeMantissa<DroppedBits>(Ar, Offset.X.Value.mantissa);
+		bSuccess &= PrecisionNet::SerializeMantissa<DroppedBits>(Ar, Offset.Y.Value.mantissa);
+		bSuccess &= PrecisionNet::SerializeMantissa<DroppedBits>(Ar, Offset.Z.Value.mantissa);
+
+		if (Ar.IsLoading())
+		{
+			Position = Offset + NetAnchor;
+		}
+		return bSuccess;
+	}
+
+	// Components of the items of the delta arrays
+	template<typename ItemType>
+	struct TNetDeltaItem;
+
+	template<>
+	struct TNetDeltaItem<FVectorFixed>
+	{
+		static constexpr int32 NumComponents = 3;
+
+		static void ToMantissas(const FVectorFixed& Item, FMantissa* Mantissas)
+		{
+			Mantissas[0] = Item.X.Value.mantissa;
+			Mantissas[1] = Item.Y.Value.mantissa;
+			Mantissas[2] = Item.Z.Value.mantissa;
+		}
+
+		static void FromMantissas(const FMantissa* Mantissas, FVectorFixed& Item)
+		{
+			Item.X.Value.mantissa = Mantissas[0];
+			Item.Y.Value.mantissa = Mantissas[1];
+			Item.Z.Value.mantissa = Mantissas[2];
+		}
+	};
+
+	template<>
+	struct TNetDeltaItem<FTransformFixed>
+	{
+		static constexpr int32 NumComponents = 9;
+
+		static void ToMantissas(const FTransformFixed& Item, FMantissa* Mantissas)
+		{
+			TNetDeltaItem<FVectorFixed>::ToMantissas(Item.Location, Mantissas);
+			Mantissas[3] = Item.Rotation.Pitch.Value.mantissa;
+			Mantissas[4] = Item.Rotation.Yaw.Value.mantissa;
+			Mantissas[5] = Item.Rotation.Roll.Value.mantissa;
+			TNetDeltaItem<FVectorFixed>::ToMantissas(Item.Scale, Mantissas + 6);
+		}
+
+		static void FromMantissas(const FMantissa* Mantissas, FTransformFixed& Item)
+		{
+			TNetDeltaItem<FVectorFixed>::FromMantissas(Mantissas, Item.Location);
+			Item.Rotation.Pitch.Value.mantissa = Mantissas[3];
+			Item.Rotation.Yaw.Value.mantissa = Mantissas[4];
+			Item.Rotation.Roll.Value.mantissa = Mantissas[5];
+			TNetDeltaItem<FVectorFixed>::FromMantissas(Mantissas + 6, Item.Scale);
+		}
+	};
+
+	// State of a connection, kept by the engine: the mantissas sent with their state number
+	class FPrecisionNetDeltaBaseState : public INetDeltaBaseState
+	{
+	public:
+
+		uint32 StateId = 0;
+		uint32 BaselineEpoch = 0;
+		TArray<FMantissa> Mantissas;
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			const FPrecisionNetDeltaBaseState* Other = static_cast<FPrecisionNetDeltaBaseState*>(OtherState);
+			return BaselineEpoch == Other->BaselineEpoch && Mantissas == Other->Mantissas;
+		}
+	};
+
+	// Message: the number of the state the delta is against (0 for the whole array), the number of the new state, the number of items,
+	// then each item against the same one of the base state (see PrecisionNet::SerializeElementDelta)
+	template<typename ItemType>
+	bool NetDeltaSerializeItems(FNetDeltaSerializeInfo& DeltaParms, TArray<ItemType>& Items, FPrecisionNetDeltaArrayState& State)
+	{
+		constexpr int32 NumComponents = TNetDeltaItem<ItemType>::NumComponents;
+
+		// No object references to map
+		if (DeltaParms.GatherGuidReferences || DeltaParms.bUpdateUnmappedObjects)
+		{
+			return true;
+		}
+		if (DeltaParms.MoveGuidToUnmapped)
+		{
+			return false;
+		}
+
+		if (DeltaParms.Writer)
+		{
+			FBitWriter& Writer = *DeltaParms.Writer;
+
+			// New connections and baseline resets get the whole array
+			const FPrecisionNetDeltaBaseState* OldState = static_cast<FPrecisionNetDeltaBaseState*>(DeltaParms.OldState);
+			if (OldState && OldState->BaselineEpoch != State.BaselineEpoch)
+			{
+				OldState = nullptr;
+			}
+
+			TSharedPtr<FPrecisionNetDeltaBaseState> NewState = MakeShared<FPrecisionNetDeltaBaseState>();
+			NewState->Mantissas.SetNumUninitialized(Items.Num() * NumComponents);
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				TNetDeltaItem<ItemType>::ToMantissas(Items[Index], &NewState->Mantissas[Index * NumComponents]);
+			}
+			if (OldState && OldState->Mantissas == NewState->Mantissas)
+			{
+				return false;
+			}
+
+			State.LastStateId = State.LastStateId == MAX_uint32 ? 1 : State.LastStateId + 1;
+			NewState->StateId = State.LastStateId;
+			NewState->BaselineEpoch = State.BaselineEpoch;
+			*DeltaParms.NewState = NewState;
+
+			uint32 BaseId = OldState ? OldState->StateId : 0;
+			uint32 StateId = NewState->StateId;
+			uint32 Num = uint32(Items.Num());
+			PrecisionNet::SerializeVarUInt32(Writer, BaseId);
+			PrecisionNet::SerializeVarUInt32(Writer, StateId);
+			PrecisionNet::SerializeVarUInt32(Writer, Num);
+
+			const int32 NumBaseItems = OldState ? OldState->Mantissas.Num() / NumComponents : 0;
+			for (int32 Index = 0; Index < Items.Num(); ++Index)
+			{
+				const FMantissa* Base = Index < NumBaseItems ? &OldState->Mantissas[Index * NumComponents] : nullptr;
+				PrecisionNet::SerializeElementDelta<NumComponents>(Writer, Base, &NewState->Mantissas[Index * NumComponents]);
+			}
+			return true;
+		}
+
+		if (DeltaParms.Reader)
+		{
+			FBitReader& Reader = *DeltaParms.Reader;
+
+			uint32 BaseId, StateId, Num;
+			PrecisionNet::SerializeVarUInt32(Reader, BaseId);
+			PrecisionNet::SerializeVarUInt32(Reader, StateId);
+			PrecisionNet::SerializeVarUInt32(Reader, Num);
+
+			// Every item takes at least 1 bit
+			if (Reader.IsError() || int64(Num) > Reader.GetBitsLeft())
+			{
+				Reader.SetError();
+				return false;
+			}
+
+			// A delta against another state than the one received last is read, and dropped. It's only sent when the packet of that state was lost,
+			// and the sender recovers from it: on the NAK, the engine rolls the state of the connection back to the one the lost packet was sent
+			// against (FObjectReplicator::ReceivedNak), which this receiver still has, and the next delta is against it
+			const bool bApply = BaseId == 0 || BaseId == State.ReceivedStateId;
+			const int32 NumBaseItems = bApply && BaseId != 0 ? State.ReceivedMantissas.Num() / NumComponents : 0;
+
+			TArray<FMantissa> Mantissas;
+			Mantissas.SetNumUninitialized(int32(Num) * NumComponents);
+			bool bSuccess = true;
+			for (int32 Index = 0; Index < int32(Num); ++Index)
+			{
+				const FMantissa* Base = Index < NumBaseItems ? &State.ReceivedMantissas[Index * NumComponents] : nullptr;
+				bSuccess &= PrecisionNet::SerializeElementDelta<NumComponents>(Reader, Base, &Mantissas[Index * NumComponents]);
+			}
+			if (!bSuccess || Reader.IsError())
+			{
+				Reader.SetError();
+				return false;
+			}
+
+			if (bApply)
+			{
+				State.ReceivedStateId = StateId;
+				State.ReceivedMantissas = MoveTemp(Mantissas);
+				Items.SetNum(int32(Num));
+				for (int32 Index = 0; Index < int32(Num); ++Index)
+				{
+					TNetDeltaItem<ItemType>::FromMantissas(&State.ReceivedMantissas[Index * NumComponents], Items[Index]);
+				}
+			}
+			return true;
+		}
+
+		return false;
+	}
+}
+
+FVectorFixed FPrecisionNetAnchor::Get()
+{
+	return NetAnchor;
+}
+
+void FPrecisionNetAnchor::Set(const FVectorFixed& Anchor)
+{
+	NetAnchor = Anchor;
+}
+
+bool FVectorFixed_NetQuantize::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializeQuantizedPosition<0>(Ar, *this);
+	return true;
+}
+
+bool FVectorFixed_NetQuantize10::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializeQuantizedPosition<4>(Ar, *this);
+	return true;
+}
+
+bool FVectorFixed_NetQuantize100::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializeQuantizedPosition<7>(Ar, *this);
+	return true;
+}
+
+bool FTransformFixedNetDeltaArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	return NetDeltaSerializeItems(DeltaParms, Items, State);
+}
+
+bool FVectorFixedNetDeltaArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	return NetDeltaSerializeItems(DeltaParms, Items, State);
+}
@@ -0,0 +1,57 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionPredicates.h"
+#include "SpaceKitPrecision/Private/PrecisionPredicatesKernels.h"
+
+// Helpers to pass the coordinates of vectors to the kernels, without copying them
+#define PREDICATE_POINT(Vec) { &(Vec).X.Value, &(Vec).Y.Value, &(Vec).Z.Value }
+
+int32 FPrecisionPredicates::Orient3D(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D)
+{
+	const FRealFloat::ttBigType* const Points[4][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B), PREDICATE_POINT(C), PREDICATE_POINT(D) };
+	return PrecisionPredicates::Orient3D(Points);
+}
+
+int32 FPrecisionPredicates::Orient3D(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D)
+{
+	const real_fixed_type* const Points[4][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B), PREDICATE_POINT(C), PREDICATE_POINT(D) };
+	return PrecisionPredicates::Orient3D(Points);
+}
+
+int32 FPrecisionPredicates::InSphere(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D, const FVectorFloat& E)
+{
+	const FRealFloat::ttBigType* const Points[5][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B), PREDICATE_POINT(C), PREDICATE_POINT(D), PREDICATE_POINT(E) };
+	return PrecisionPredicates::InSphere(Points);
+}
+
+int32 FPrecisionPredicates::InSphere(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D, const FVectorFixed& E)
+{
+	const real_fixed_type* const Points[5][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B), PREDICATE_POINT(C), PREDICATE_POINT(D), PREDICATE_POINT(E) };
+	return PrecisionPredicates::InSphere(Points);
+}
+
+int32 FPrecisionPredicates::CompareDistance(const FVectorFloat& A, const FVectorFloat& B, const FRealFloat& Distance)
+{
+	const FRealFloat::ttBigType* const Points[2][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B) };
+	return PrecisionPredicates::CompareDistance(Points, Distance.Value);
+}
+
+int32 FPrecisionPredicates::CompareDistance(const FVectorFixed& A, const FVectorFixed& B, const FRealFixed& Distance)
+{
+	const real_fixed_type* const Points[2][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B) };
+	return PrecisionPredicates::CompareDistance(Points, Distance.Value);
+}
+
+int32 FPrecisionPredicates::DotSign(const FVectorFloat& A, const FVectorFloat& B)
+{
+	const FRealFloat::ttBigType* const Points[2][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B) };
+	return PrecisionPredicates::DotSign(Points);
+}
+
+int32 FPrecisionPredicates::DotSign(const FVectorFixed& A, const FVectorFixed& B)
+{
+	const real_fixed_type* const Points[2][3] = { PREDICATE_POINT(A), PREDICATE_POINT(B) };
+	return PrecisionPredicates::DotSign(Points);
+}
+
+#undef PREDICATE_POINT
@@ -0,0 +1,454 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "SpaceKitPrecision/Public/RealFixedGeneric.h"
+
+#include "CoreMinimal.h"
+
+// Adaptive geometric predicates, in the style of Shewchuk's filtered predicates. See FPrecisionPredicates.
+// Each predicate is first evaluated in double, together with a bound on its rounding error. When the result is farther from 0 than the bound, its sign is the exact one.
+// Otherwise the predicate is evaluated again with a type wide enough for the result to be exact, which is only needed for nearly degenerate inputs.
+// Points are passed as arrays of 3 pointers to their coordinates, so that the coordinates are never copied.
+namespace PrecisionPredicates
+{
+	// Unit roundoff of double, 2^-53
+	constexpr double Epsilon = 1.1102230246251565e-16;
+
+	// Inputs are only filtered in [2^-120, 2^120]: even the degree 5 in-sphere determinant then never overflows nor underflows in double
+	constexpr double MinFilteredValue = 7.52316384526264e-37;
+	constexpr double MaxFilteredValue = 1.329227995784916e36;
+
+	// Error bounds, relative to the permanent of each expression (the same expression, with absolute values and no cancellation).
+	// A coordinate converted to double is off by less than 2 Epsilon (ttmath truncates), so a difference of coordinates a - b is off by less than 3 Epsilon (|a| + |b|).
+	// A product of k such differences going through r roundings is then off by less than about (5k + r) Epsilon times its permanent; the bounds below add some headroom for the rounding of the permanent itself.
+	constexpr double Orient3DErrorBound = 32.0 * Epsilon;     // k = 3, r = 5
+	constexpr double InSphereErrorBound = 48.0 * Epsilon;     // k = 5, r = 12
+	constexpr double DistanceErrorBound = 24.0 * Epsilon;     // k = 2, r = 4
+	constexpr double DotErrorBound = 12.0 * Epsilon;          // k = 2 coordinates (2 Epsilon each, not differences), r = 3
+
+	// Converts a coordinate to double for the filter. Returns false if it is outside of the filtered range, or NaN
+	template<ttmath::uint exp, ttmath::uint man>
+	bool ToFilterDouble(const ttmath::Big<exp, man>& InVal, double& OutVal)
+	{
+		if (InVal.IsZero())
+		{
+			OutVal = 0.0;
+			return true;
+		}
+
+		OutVal = InVal.ToDouble();
+		const double AbsVal = OutVal < 0.0 ? -OutVal : OutVal;
+		return AbsVal >= MinFilteredValue && AbsVal <= MaxFilteredValue;
+	}
+
+	template<int MantissaSize, int Exponent>
+	bool ToFilterDouble(const real_fixed<MantissaSize, Exponent>& InVal, double& OutVal)
+	{
+		return ToFilterDouble(InVal.ToBig(), OutVal);
+	}
+
+	// Exact sum of terms Mantissa * 2^Exponent, for big floats: their exponents can be arbitrarily far apart, so the terms are never aligned to a common scale.
+	// Products distribute over the terms, and the sign is found from the largest terms down, see GetSign. Words must hold the product of the mantissas of a degree 5 term
+	template<ttmath::uint ExponentWords, ttmath::uint Words>
+	struct TExactTermSum
+	{
+		using FExponent = ttmath::Int<ExponentWords + 1>;
+
+		struct FTerm
+		{
+			ttmath::Int<Words> Mantissa;
+			FExponent Exponent;
+		};
+
+		TArray<FTerm> Terms;
+
+		friend TExactTermSum operator+(const TExactTermSum& A, const TExactTermSum& B)
+		{
+			TExactTermSum Result(A);
+			Result.Terms.Append(B.Terms);
+			return Result;
+		}
+
+		friend TExactTermSum operator-(const TExactTermSum& A, const TExactTermSum& B)
+		{
+			TExactTermSum Result(A);
+			Result.Terms.Reserve(A.Terms.Num() + B.Terms.Num());
+			for (const FTerm& Term : B.Terms)
+			{
+				Result.Terms.Add(Term);
+				Result.Terms.Last().Mantissa.ChangeSign();
+			}
+			return Result;
+		}
+
+		friend TExactTermSum operator*(const TExactTermSum& A, const TExactTermSum& B)
+		{
+			TExactTermSum Result;
+			Result.Terms.Reserve(A.Terms.Num() * B.Terms.Num());
+			for (const FTerm& TermA : A.Terms)
+			{
+				for (const FTerm& TermB : B.Terms)
+				{
+					FTerm Term;
+					Term.Mantissa = TermA.Mantissa * TermB.Mantissa;
+					Term.Exponent = TermA.Exponent + TermB.Exponent;
+					Result.Terms.Add(Term);
+				}
+			}
+			return Result;
+		}
+
+		// Adds the terms from the largest exponent down, in an accumulator at the scale of the last term added. Once the accumulator is larger than all
+		// the remaining terms could be together, its sign is the sign of the sum. Until then it stays under 2^(Words bits + log2(number of terms)), so it never overflows
+		int32 GetSign() const
+		{
+			using FAccumulator = ttmath::Int<Words + 1>;
+
+			TArray<FTerm> Sorted;
+			Sorted.Reserve(Terms.Num());
+			for (const FTerm& Term : Terms)
+			{
+				if (!Term.Mantissa.IsZero())
+				{
+					Sorted.Add(Term);
+				}
+			}
+			Sorted.Sort([](const FTerm& A, const FTerm& B) { return A.Exponent > B.Exponent; });
+
+			int32 LogNumTerms = 0;
+			while ((1 << LogNumTerms) < Sorted.Num())
+			{
+				++LogNumTerms;
+			}
+			const int32 Limit = int32(Words * TTMATH_BITS_PER_UINT) + LogNumTerms - 1;
+
+			FAccumulator Sum;
+			Sum.SetZero();
+			FExponent Scale;
+			Scale.SetZero();
+			for (const FTerm& Term : Sorted)
+			{
+				if (!Sum.IsZero())
+				{
+					FAccumulator Magnitude(Sum);
+					Magnitude.Abs();
+					ttmath::uint Table, Index;
+					Magnitude.FindLeadingBit(Table, Index);
+					const int32 SumBits = int32(Table * TTMATH_BITS_PER_UINT + Index) + 1;
+
+					FExponent Gap(Scale);
+					Gap.Sub(Term.Exponent);
+					if (Gap >= FExponent(ttmath::sint(Limit - SumBits + 1)))
+					{
+						break;
+					}
+					Sum.Rcl(Gap.table[0], 0);
+				}
+				Scale = Term.Exponent;
+
+				FAccumulator Value;
+				Value.FromInt(Term.Mantissa);
+				Sum.Add(Value);
+			}
+			return Sum.IsZero() ? 0 : (Sum.IsSign() ? -1 : 1);
+		}
+
+		bool IsZero() const
+		{
+			return GetSign() == 0;
+		}
+
+		bool IsSign() const
+		{
+			return GetSign() < 0;
+		}
+	};
+
+	// Exact types. Fixed-point numbers all share the same scale, so their mantissas are used as integers, with enough words for a degree 5 polynomial of differences.
+	// Big floats are sums of terms, whatever the span of their exponents
+	template<typename T>
+	struct TExactType;
+
+	template<ttmath::uint exp, ttmath::uint man>
+	struct TExactType<ttmath::Big<exp, man>>
+	{
+		using Type = TExactTermSum<exp, 5 * man + 1>;
+
+		static Type Make(const ttmath::Big<exp, man>& InVal)
+		{
+			Type Result;
+			if (!InVal.IsZero())
+			{
+				typename Type::FTerm Term;
+				Term.Mantissa.FromUInt(InVal.mantissa);
+				if (InVal.IsSign())
+				{
+					Term.Mantissa.ChangeSign();
+				}
+				Term.Exponent.FromInt(InVal.exponent);
+				Result.Terms.Add(Term);
+			}
+			return Result;
+		}
+	};
+
+	template<int MantissaSize, int Exponent>
+	struct TExactType<real_fixed<MantissaSize, Exponent>>
+	{
+		using Type = ttmath::Int<6 * (TTMATH_BITS(MantissaSize + Exponent) + 1)>;
+
+		static Type Make(const real_fixed<MantissaSize, Exponent>& InVal)
+		{
+			Type Result;
+			Result.FromInt(InVal.mantissa);
+			return Result;
+		}
+	};
+
+	// Sign of an exact value, as -1, 0 or 1
+	template<typename T>
+	int32 SignOf(const T& InVal)
+	{
+		return InVal.IsZero() ? 0 : (InVal.IsSign() ? -1 : 1);
+	}
+
+	template<ttmath::uint ExponentWords, ttmath::uint Words>
+	int32 SignOf(const TExactTermSum<ExponentWords, Words>& InVal)
+	{
+		return InVal.GetSign();
+	}
+
+	inline int32 SignOf(double InVal)
+	{
+		return InVal > 0.0 ? 1 : (InVal < 0.0 ? -1 : 0);
+	}
+
+	inline double AbsOf(double InVal)
+	{
+		return InVal < 0.0 ? -InVal : InVal;
+	}
+
+	// Converts the coordinates of points to double. Returns false if any of them can't be filtered
+	template<typename T, int32 NumPoints>
+	bool ToFilterPoints(const T* const (&Points)[NumPoints][3], double (&OutPoints)[NumPoints][3])
+	{
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			for (int32 j = 0; j < 3; ++j)
+			{
+				if (!ToFilterDouble(*Points[i][j], OutPoints[i][j]))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Converts the coordinates of points to the exact type, relative to the last point
+	template<typename T, int32 NumPoints>
+	void ToExactDifferences(const T* const (&Points)[NumPoints][3], typename TExactType<T>::Type (&OutDiffs)[NumPoints - 1][3])
+	{
+		for (int32 j = 0; j < 3; ++j)
+		{
+			const typename TExactType<T>::Type Origin = TExactType<T>::Make(*Points[NumPoints - 1][j]);
+			for (int32 i = 0; i < NumPoints - 1; ++i)
+			{
+				OutDiffs[i][j] = TExactType<T>::Make(*Points[i][j]) - Origin;
+			}
+		}
+	}
+
+	// Sign of the determinant of (A - D, B - D, C - D). Positive when D is below the plane of A, B and C, these three being counterclockwise when seen from above
+	template<typename T>
+	int32 Orient3D(const T* const (&Points)[4][3])
+	{
+		double P[4][3];
+		if (ToFilterPoints(Points, P))
+		{
+			double Diff[3][3];
+			double Mag[3][3];
+			for (int32 i = 0; i < 3; ++i)
+			{
+				for (int32 j = 0; j < 3; ++j)
+				{
+					Diff[i][j] = P[i][j] - P[3][j];
+					Mag[i][j] = AbsOf(P[i][j]) + AbsOf(P[3][j]);
+				}
+			}
+
+			const double Det = Diff[0][0] * (Diff[1][1] * Diff[2][2] - Diff[1][2] * Diff[2][1])
+				+ Diff[1][0] * (Diff[2][1] * Diff[0][2] - Diff[2][2] * Diff[0][1])
+				+ Diff[2][0] * (Diff[0][1] * Diff[1][2] - Diff[0][2] * Diff[1][1]);
+			const double Permanent = Mag[0][0] * (Mag[1][1] * Mag[2][2] + Mag[1][2] * Mag[2][1])
+				+ Mag[1][0] * (Mag[2][1] * Mag[0][2] + Mag[2][2] * Mag[0][1])
+				+ Mag[2][0] * (Mag[0][1] * Mag[1][2] + Mag[0][2] * Mag[1][1]);
+
+			if (AbsOf(Det) > Orient3DErrorBound * Permanent)
+			{
+				return SignOf(Det);
+			}
+		}
+
+		typename TExactType<T>::Type Diff[3][3];
+		ToExactDifferences(Points, Diff);
+
+		return SignOf(Diff[0][0] * (Diff[1][1] * Diff[2][2] - Diff[1][2] * Diff[2][1])
+			+ Diff[1][0] * (Diff[2][1] * Diff[0][2] - Diff[2][2] * Diff[0][1])
+			+ Diff[2][0] * (Diff[0][1] * Diff[1][2] - Diff[0][2] * Diff[1][1]));
+	}
+
+	// In-sphere determinant, once the points are relative to E. Works on double (with Magnitude filled) and on exact types
+	template<typename T>
+	T InSphereDet(const T (&Diff)[4][3])
+	{
+		const T AB = Diff[0][0] * Diff[1][1] - Diff[1][0] * Diff[0][1];
+		const T BC = Diff[1][0] * Diff[2][1] - Diff[2][0] * Diff[1][1];
+		const T CD = Diff[2][0] * Diff[3][1] - Diff[3][0] * Diff[2][1];
+		const T DA = Diff[3][0] * Diff[0][1] - Diff[0][0] * Diff[3][1];
+		const T AC = Diff[0][0] * Diff[2][1] - Diff[2][0] * Diff[0][1];
+		const T BD = Diff[1][0] * Diff[3][1] - Diff[3][0] * Diff[1][1];
+
+		const T ABC = Diff[0][2] * BC - Diff[1][2] * AC + Diff[2][2] * AB;
+		const T BCD = Diff[1][2] * CD - Diff[2][2] * BD + Diff[3][2] * BC;
+		const T CDA = Diff[2][2] * DA + Diff[3][2] * AC + Diff[0][2] * CD;
+		const T DAB = Diff[3][2] * AB + Diff[0][2] * BD + Diff[1][2] * DA;
+
+		T Lift[4];
+		for (int32 i = 0; i < 4; ++i)
+		{
+			Lift[i] = Diff[i][0] * Diff[i][0] + Diff[i][1] * Diff[i][1] + Diff[i][2] * Diff[i][2];
+		}
+
+		return (Lift[3] * ABC - Lift[2] * DAB) + (Lift[1] * CDA - Lift[0] * BCD);
+	}
+
+	// Same as InSphereDet, with absolute values and every subtraction turned into an addition
+	inline double InSpherePermanent(const double (&Mag)[4][3])
+	{
+		const double AB = Mag[0][0] * Mag[1][1] + Mag[1][0] * Mag[0][1];
+		const double BC = Mag[1][0] * Mag[2][1] + Mag[2][0] * Mag[1][1];
+		const double CD = Mag[2][0] * Mag[3][1] + Mag[3][0] * Mag[2][1];
+		const double DA = Mag[3][0] * Mag[0][1] + Mag[0][0] * Mag[3][1];
+		const double AC = Mag[0][0] * Mag[2][1] + Mag[2][0] * Mag[0][1];
+		const double BD = Mag[1][0] * Mag[3][1] + Mag[3][0] * Mag[1][1];
+
+		const double ABC = Mag[0][2] * BC + Mag[1][2] * AC + Mag[2][2] * AB;
+		const double BCD = Mag[1][2] * CD + Mag[2][2] * BD + Mag[3][2] * BC;
+		const double CDA = Mag[2][2] * DA + Mag[3][2] * AC + Mag[0][2] * CD;
+		const double DAB = Mag[3][2] * AB + Mag[0][2] * BD + Mag[1][2] * DA;
+
+		double Lift[4];
+		for (int32 i = 0; i < 4; ++i)
+		{
+			Lift[i] = Mag[i][0] * Mag[i][0] + Mag[i][1] * Mag[i][1] + Mag[i][2] * Mag[i][2];
+		}
+
+		return (Lift[3] * ABC + Lift[2] * DAB) + (Lift[1] * CDA + Lift[0] * BCD);
+	}
+
+	// Positive when E is inside the sphere through A, B, C and D, negative when outside, 0 when on it. A, B, C and D must be ordered so that Orient3D(A, B, C, D) is positive, otherwise the sign is reversed
+	template<typename T>
+	int32 InSphere(const T* const (&Points)[5][3])
+	{
+		double P[5][3];
+		if (ToFilterPoints(Points, P))
+		{
+			double Diff[4][3];
+			double Mag[4][3];
+			for (int32 i = 0; i < 4; ++i)
+			{
+				for (int32 j = 0; j < 3; ++j)
+				{
+					Diff[i][j] = P[i][j] - P[4][j];
+					Mag[i][j] = AbsOf(P[i][j]) + AbsOf(P[4][j]);
+				}
+			}
+
+			const double Det = InSphereDet(Diff);
+			if (AbsOf(Det) > InSphereErrorBound * InSpherePermanent(Mag))
+			{
+				return SignOf(Det);
+			}
+		}
+
+		typename TExactType<T>::Type Diff[4][3];
+		ToExactDifferences(Points, Diff);
+
+		return SignOf(InSphereDet(Diff));
+	}
+
+	// Sign of |A - B| - Distance. A negative distance is smaller than any actual distance
+	template<typename T>
+	int32 CompareDistance(const T* const (&Points)[2][3], const T& Distance)
+	{
+		double P[2][3];
+		double Dist;
+		if (ToFilterPoints(Points, P) && ToFilterDouble(Distance, Dist))
+		{
+			if (Dist < 0.0)
+			{
+				return 1;
+			}
+
+			double SizeSquared = 0.0;
+			double Permanent = Dist * Dist;
+			for (int32 j = 0; j < 3; ++j)
+			{
+				const double Diff = P[0][j] - P[1][j];
+				const double Mag = AbsOf(P[0][j]) + AbsOf(P[1][j]);
+				SizeSquared += Diff * Diff;
+				Permanent += Mag * Mag;
+			}
+
+			const double Det = SizeSquared - Dist * Dist;
+			if (AbsOf(Det) > DistanceErrorBound * Permanent)
+			{
+				return SignOf(Det);
+			}
+		}
+
+		const typename TExactType<T>::Type ExactDist = TExactType<T>::Make(Distance);
+		if (ExactDist.IsSign())
+		{
+			return 1;
+		}
+
+		typename TExactType<T>::Type Diff[1][3];
+		ToExactDifferences(Points, Diff);
+
+		return SignOf(Diff[0][0] * Diff[0][0] + Diff[0][1] * Diff[0][1] + Diff[0][2] * Diff[0][2] - ExactDist * ExactDist);
+	}
+
+	// Sign of the dot product of A and B
+	template<typename T>
+	int32 DotSign(const T* const (&Points)[2][3])
+	{
+		double P[2][3];
+		if (ToFilterPoints(Points, P))
+		{
+			const double Dot = P[0][0] * P[1][0] + P[0][1] * P[1][1] + P[0][2] * P[1][2];
+			const double Permanent = AbsOf(P[0][0] * P[1][0]) + AbsOf(P[0][1] * P[1][1]) + AbsOf(P[0][2] * P[1][2]);
+
+			if (AbsOf(Dot) > DotErrorBound * Permanent)
+			{
+				return SignOf(Dot);
+			}
+		}
+
+		typename TExactType<T>::Type Exact[2][3];
+		for (int32 i = 0; i < 2; ++i)
+		{
+			for (int32 j = 0; j < 3; ++j)
+			{
+				Exact[i][j] = TExactType<T>::Make(*Points[i][j]);
+			}
+		}
+
+		return SignOf(Exact[0][0] * Exact[1][0] + Exact[0][1] * Exact[1][1] + Exact[0][2] * Exact[1][2]);
+	}
+}
@@ -0,0 +1,170 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionReplay.h"
+#include "SpaceKitPrecision/Public/PrecisionBudget.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	using PrecisionReplay::EOp;
+
+	// Executes the operations with the engine types and their math libraries, the ones gameplay code uses
+	struct FEngineExecutor
+	{
+		using FixedType = real_fixed_type;
+		using FloatType = tt_real_float_type;
+
+		static constexpr uint8 Id = PrecisionReplay::EngineExecutorId;
+
+		static FRealFixed Execute(EOp Op, const FRealFixed& A, const FRealFixed& B)
+		{
+			switch (Op)
+			{
+			case EOp::FixedAdd: return URealFixedMath::RealPlusReal(A, B);
+			case EOp::FixedSubtract: return URealFixedMath::RealMinusReal(A, B);
+			case EOp::FixedMultiply: return URealFixedMath::RealMultReal(A, B);
+			case EOp::FixedDivide: return URealFixedMath::RealDivReal(A, B);
+			case EOp::FixedModulo: return URealFixedMath::RealModReal(A, B);
+			case EOp::FixedSqrt: return URealFixedMath::Sqrt(A);
+			case EOp::FixedSinRad: return URealFixedMath::SinRad(A);
+			case EOp::FixedCosRad: return URealFixedMath::CosRad(A);
+			case EOp::FixedTanRad: return URealFixedMath::TanRad(A);
+			case EOp::FixedAtan2Rad: return URealFixedMath::Atan2Rad(A, B);
+			case EOp::FixedExp: return URealFixedMath::Exp(A);
+			case EOp::FixedLogE: return URealFixedMath::LogE(A);
+			default: return FRealFixed();
+			}
+		}
+
+		static FRealFloat Execute(EOp Op, const FRealFloat& A, const FRealFloat& B)
+		{
+			// The traces don't depend on the precision budget of the thread
+			FScopedRealFloatPrecision FullPrecision(0);
+
+			switch (Op)
+			{
+			case EOp::FloatAdd: return URealFloatMath::RealPlusReal(A, B);
+			case EOp::FloatSubtract: return URealFloatMath::RealMinusReal(A, B);
+			case EOp::FloatMultiply: return URealFloatMath::RealMultReal(A, B);
+			case EOp::FloatDivide: return URealFloatMath::RealDivReal(A, B);
+			case EOp::FloatSqrt: return URealFloatMath::Sqrt(A);
+			case EOp::FloatSinRad: return URealFloatMath::SinRad(A);
+			case EOp::FloatCosRad: return URealFloatMath::CosRad(A);
+			case EOp::FloatTanRad: return URealFloatMath::TanRad(A);
+			case EOp::FloatAtan2Rad: return URealFloatMath::Atan2Rad(A, B);
+			case EOp::FloatExp: return URealFloatMath::Exp(A);
+			case EOp::FloatLogE: return URealFloatMath::LogE(A);
+			case EOp::FloatPow: return URealFloatMath::Pow(A, B);
+			default: return FRealFloat();
+			}
+		}
+
+		// The replay works on the raw types
+		static FixedType Execute(EOp Op, const FixedType& A, const FixedType& B)
+		{
+			return Execute(Op, FRealFixed(A), FRealFixed(B)).Value;
+		}
+
+		static FloatType Execute(EOp Op, const FloatType& A, const FloatType& B)
+		{
+			return Execute(Op, FRealFloat(A), FRealFloat(B)).Value;
+		}
+	};
+
+	FString ToFString(const std::string& String)
+	{
+		return FString(ANSI_TO_TCHAR(String.c_str()));
+	}
+}
+
+FString FPrecisionReplayReport::ToString() const
+{
+	if (!Error.IsEmpty())
+	{
+		return Error;
+	}
+	if (FirstDivergentOp < 0)
+	{
+		return FString::Printf(TEXT("The %lld operations recorded by %s give the same results"), NumOps, *RecordedBackend);
+	}
+	return FString::Printf(TEXT("Operation %lld (%s of %s) diverges from the trace recorded by %s: expected %s, got %s"),
+		FirstDivergentOp, *Function, *Inputs, *RecordedBackend, *Expected, *Actual);
+}
+
+FPrecisionReplayRecorder::FPrecisionReplayRecorder()
+	: RollingHash(PrecisionReplay::HashSeed)
+{
+	PrecisionReplay::WriteHeader<real_fixed_type, tt_real_float_type>(Trace, FEngineExecutor::Id, ttmath::UInt<1>::LibTypeStr());
+}
+
+FRealFixed FPrecisionReplayRecorder::Run(EPrecisionReplayOp Op, const FRealFixed& A, const FRealFixed& B)
+{
+	// Big float operations can't be recorded with fixed-point operands
+	if (uint8(Op) >= uint8(EOp::Count) || PrecisionReplay::GetOpInfo(Op).bFloat)
+	{
+		return FRealFixed();
+	}
+
+	const FRealFixed Result = FEngineExecutor::Execute(Op, A, B);
+	PrecisionReplay::WriteOp(Trace, RollingHash, Op, A.Value, B.Value, Result.Value);
+	++NumOps;
+	return Result;
+}
+
+FRealFloat FPrecisionReplayRecorder::Run(EPrecisionReplayOp Op, const FRealFloat& A, const FRealFloat& B)
+{
+	if (uint8(Op) >= uint8(EOp::Count) || !PrecisionReplay::GetOpInfo(Op).bFloat)
+	{
+		return FRealFloat();
+	}
+
+	const FRealFloat Result = FEngineExecutor::Execute(Op, A, B);
+	PrecisionReplay::WriteOp(Trace, RollingHash, Op, A.Value, B.Value, Result.Value);
+	++NumOps;
+	return Result;
+}
+
+void FPrecisionReplayRecorder::RecordWorkload(uint64 Seed, int32 NumWorkloadOps)
+{
+	PrecisionReplay::RunWorkload<real_fixed_type, tt_real_float_type>(Seed, NumWorkloadOps, [this](EOp Op, const auto& A, const auto& B)
+	{
+		PrecisionReplay::WriteOp(Trace, RollingHash, Op, A, B, FEngineExecutor::Execute(Op, A, B));
+		++NumOps;
+	});
+}
+
+bool FPrecisionReplayRecorder::SaveToFile(const FString& Path) const
+{
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	return FFileHelper::SaveArrayToFile(Trace, *Path);
+}
+
+FPrecisionReplayReport FPrecisionReplay::Replay(const TArray<uint8>& Trace)
+{
+	const PrecisionReplay::FReplayReport CoreReport = PrecisionReplay::Replay<FEngineExecutor>(Trace.GetData(), Trace.Num());
+
+	FPrecisionReplayReport Report;
+	Report.Error = ToFString(CoreReport.Error);
+	Report.RecordedBackend = ToFString(CoreReport.RecordedBackend);
+	Report.NumOps = CoreReport.NumOps;
+	Report.FirstDivergentOp = CoreReport.FirstDivergentOp;
+	Report.Function = ToFString(CoreReport.Function);
+	Report.Inputs = ToFString(CoreReport.Inputs);
+	Report.Expected = ToFString(CoreReport.Expected);
+	Report.Actual = ToFString(CoreReport.Actual);
+	return Report;
+}
+
+FPrecisionReplayReport FPrecisionReplay::ReplayFile(const FString& Path)
+{
+	TArray<uint8> Trace;
+	if (!FFileHelper::LoadFileToArray(Trace, *Path))
+	{
+		FPrecisionReplayReport Report;
+		Report.Error = FString::Printf(TEXT("Can't read %s"), *Path);
+		return Report;
+	}
+	return Replay(Trace);
+}
@@ -0,0 +1,46 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionReplayCommandlet.h"
+#include "SpaceKitPrecision/Public/PrecisionReplay.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPrecisionReplay, Log, All);
+
+int32 UPrecisionReplayCommandlet::Main(const FString& Params)
+{
+	FString Path;
+	if (FParse::Value(*Params, TEXT("Record="), Path))
+	{
+		int32 NumOps = 10000;
+		uint64 Seed = 42;
+		FParse::Value(*Params, TEXT("Ops="), NumOps);
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+
+		FPrecisionReplayRecorder Recorder;
+		Recorder.RecordWorkload(Seed, NumOps);
+		if (!Recorder.SaveToFile(Path))
+		{
+			UE_LOG(LogPrecisionReplay, Error, TEXT("Can't write %s"), *Path);
+			return 1;
+		}
+
+		UE_LOG(LogPrecisionReplay, Display, TEXT("Recorded %lld operations to %s"), Recorder.GetNumOps(), *Path);
+		return 0;
+	}
+
+	if (FParse::Value(*Params, TEXT("Replay="), Path))
+	{
+		const FPrecisionReplayReport Report = FPrecisionReplay::ReplayFile(Path);
+		if (!Report.IsOk())
+		{
+			UE_LOG(LogPrecisionReplay, Error, TEXT("%s"), *Report.ToString());
+			return 1;
+		}
+
+		UE_LOG(LogPrecisionReplay, Display, TEXT("%s"), *Report.ToString());
+		return 0;
+	}
+
+	UE_LOG(LogPrecisionReplay, Error, TEXT("Usage: -run=PrecisionReplay -Record=Trace.skpt [-Ops=10000] [-Seed=42] | -Replay=Trace.skpt"));
+	return 1;
+}
@@ -0,0 +1,671 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "SpaceKitPrecision/Public/RealFixedGeneric.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+// Determinism traces: sequences of precision math operations, with their inputs and results, recorded by a build and replayed by
+// another one (other compiler, platform or ttmath backend). The replay executes every operation again, and compares the rolling hash
+// of the results after each one with the recorded one, so it finds the first operation whose result differs, bit for bit.
+//
+// Format, little endian:
+//   Header: "SKPT", uint16 version, uint8 bytes per word, uint8 fixed-point words, uint8 float mantissa words, uint8 float exponent words,
+//           int32 fixed-point exponent, uint8 executor (see the executors below), then the uint8 length and the name of the recording backend
+//   Then, per operation: uint8 operation, its operands (1 or 2), its result, and the uint64 rolling hash of the results so far.
+//   Fixed-point numbers are their mantissa words, floats are their mantissa words, exponent words, and info byte.
+namespace PrecisionReplay
+{
+	constexpr uint16 TraceVersion = 1;
+
+	// Operations of the traces. Their values are stored in the traces: add new ones at the end only
+	enum class EOp : uint8
+	{
+		FixedAdd,
+		FixedSubtract,
+		FixedMultiply,
+		FixedDivide,
+		FixedModulo,
+		FixedSqrt,
+		FixedSinRad,
+		FixedCosRad,
+		FixedTanRad,
+		FixedAtan2Rad,
+		FixedExp,
+		FixedLogE,
+		FloatAdd,
+		FloatSubtract,
+		FloatMultiply,
+		FloatDivide,
+		FloatSqrt,
+		FloatSinRad,
+		FloatCosRad,
+		FloatTanRad,
+		FloatAtan2Rad,
+		FloatExp,
+		FloatLogE,
+		FloatPow,
+		Count
+	};
+
+	struct FOpInfo
+	{
+		const char* Name;
+		bool bFloat;
+		int32 NumOperands;
+	};
+
+	inline const FOpInfo& GetOpInfo(EOp Op)
+	{
+		static const FOpInfo Infos[] =
+		{
+			{ "FixedAdd", false, 2 },
+			{ "FixedSubtract", false, 2 },
+			{ "FixedMultiply", false, 2 },
+			{ "FixedDivide", false, 2 },
+			{ "FixedModulo", false, 2 },
+			{ "FixedSqrt", false, 1 },
+			{ "FixedSinRad", false, 1 },
+			{ "FixedCosRad", false, 1 },
+			{ "FixedTanRad", false, 1 },
+			{ "FixedAtan2Rad", false, 2 },
+			{ "FixedExp", false, 1 },
+			{ "FixedLogE", false, 1 },
+			{ "FloatAdd", true, 2 },
+			{ "FloatSubtract", true, 2 },
+			{ "FloatMultiply", true, 2 },
+			{ "FloatDivide", true, 2 },
+			{ "FloatSqrt", true, 1 },
+			{ "FloatSinRad", true, 1 },
+			{ "FloatCosRad", true, 1 },
+			{ "FloatTanRad", true, 1 },
+			{ "FloatAtan2Rad", true, 2 },
+			{ "FloatExp", true, 1 },
+			{ "FloatLogE", true, 1 },
+			{ "FloatPow", true, 2 },
+		};
+		static_assert(sizeof(Infos) / sizeof(Infos[0]) == size_t(EOp::Count), "Every operation needs its info");
+
+		return Infos[uint8(Op) < uint8(EOp::Count) ? uint8(Op) : 0];
+	}
+
+	// Layout of the fixed-point and float types of the traces
+	template<typename FixedType>
+	struct TFixedTraits;
+
+	template<int MantissaSize, int Exponent>
+	struct TFixedTraits<real_fixed<MantissaSize, Exponent>>
+	{
+		static constexpr int32 FractionBits = Exponent;
+		static constexpr ttmath::uint Words = TTMATH_BITS(MantissaSize + Exponent);
+	};
+
+	template<typename FloatType>
+	struct TFloatTraits;
+
+	template<ttmath::uint exp, ttmath::uint man>
+	struct TFloatTraits<ttmath::Big<exp, man>>
+	{
+		static constexpr ttmath::uint ExponentWords = exp;
+		static constexpr ttmath::uint MantissaWords = man;
+	};
+
+	// FNV-1a, over the little endian bytes of the words
+	inline uint64 HashWord(uint64 Hash, uint64 Word, int32 NumBytes)
+	{
+		for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+		{
+			Hash = (Hash ^ ((Word >> (Byte * 8)) & 0xff)) * 1099511628211ull;
+		}
+		return Hash;
+	}
+
+	constexpr uint64 HashSeed = 14695981039346656037ull;
+
+	// Calls Visit(Word, NumBytes) for every word of a value, in the order they are stored
+	template<int MantissaSize, int Exponent, typename VisitorType>
+	void VisitWords(const real_fixed<MantissaSize, Exponent>& Value, VisitorType&& Visit)
+	{
+		for (ttmath::uint i = 0; i < TTMATH_BITS(MantissaSize + Exponent); ++i)
+		{
+			Visit(uint64(Value.mantissa.table[i]), int32(sizeof(ttmath::uint)));
+		}
+	}
+
+	template<ttmath::uint exp, ttmath::uint man, typename VisitorType>
+	void VisitWords(const ttmath::Big<exp, man>& Value, VisitorType&& Visit)
+	{
+		for (ttmath::uint i = 0; i < man; ++i)
+		{
+			Visit(uint64(Value.mantissa.table[i]), int32(sizeof(ttmath::uint)));
+		}
+		for (ttmath::uint i = 0; i < exp; ++i)
+		{
+			Visit(uint64(Value.exponent.table[i]), int32(sizeof(ttmath::uint)));
+		}
+		Visit(uint64(Value.info), 1);
+	}
+
+	template<typename ValueType>
+	uint64 HashValue(uint64 Hash, const ValueType& Value)
+	{
+		VisitWords(Value, [&Hash](uint64 Word, int32 NumBytes) { Hash = HashWord(Hash, Word, NumBytes); });
+		return Hash;
+	}
+
+	// ByteArrayType needs Append(const uint8* Data, Num), like TArray<uint8>
+	template<typename ByteArrayType>
+	void WriteWord(ByteArrayType& Bytes, uint64 Word, int32 NumBytes)
+	{
+		uint8 Buffer[8];
+		for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+		{
+			Buffer[Byte] = uint8(Word >> (Byte * 8));
+		}
+		Bytes.Append(Buffer, NumBytes);
+	}
+
+	template<typename ByteArrayType, typename ValueType>
+	void WriteValue(ByteArrayType& Bytes, const ValueType& Value)
+	{
+		VisitWords(Value, [&Bytes](uint64 Word, int32 NumBytes) { WriteWord(Bytes, Word, NumBytes); });
+	}
+
+	// Executor is the id of the functions that execute the operations (see the executors below): a trace can only be replayed with them
+	template<typename FixedType, typename FloatType, typename ByteArrayType>
+	void WriteHeader(ByteArrayType& Bytes, uint8 Executor, const char* Backend)
+	{
+		Bytes.Append(reinterpret_cast<const uint8*>("SKPT"), 4);
+		WriteWord(Bytes, TraceVersion, 2);
+		WriteWord(Bytes, sizeof(ttmath::uint), 1);
+		WriteWord(Bytes, TFixedTraits<FixedType>::Words, 1);
+		WriteWord(Bytes, TFloatTraits<FloatType>::MantissaWords, 1);
+		WriteWord(Bytes, TFloatTraits<FloatType>::ExponentWords, 1);
+		WriteWord(Bytes, uint32(TFixedTraits<FixedType>::FractionBits), 4);
+		WriteWord(Bytes, Executor, 1);
+
+		const uint8 BackendLength = uint8(std::min<size_t>(std::char_traits<char>::length(Backend), 255));
+		WriteWord(Bytes, BackendLength, 1);
+		Bytes.Append(reinterpret_cast<const uint8*>(Backend), BackendLength);
+	}
+
+	// Appends an operation, and updates the rolling hash with its result
+	template<typename ByteArrayType, typename ValueType>
+	void WriteOp(ByteArrayType& Bytes, uint64& RollingHash, EOp Op, const ValueType& A, const ValueType& B, const ValueType& Result)
+	{
+		WriteWord(Bytes, uint8(Op), 1);
+		WriteValue(Bytes, A);
+		if (GetOpInfo(Op).NumOperands > 1)
+		{
+			WriteValue(Bytes, B);
+		}
+		WriteValue(Bytes, Result);
+
+		RollingHash = HashValue(HashWord(RollingHash, uint8(Op), 1), Result);
+		WriteWord(Bytes, RollingHash, 8);
+	}
+
+	// Reads a trace, stopping at the first read past its end
+	class FTraceReader
+	{
+	public:
+		FTraceReader(const uint8* InData, int64 InNum)
+			: Data(InData), Num(InNum)
+		{
+		}
+
+		bool IsAtEnd() const
+		{
+			return Offset >= Num;
+		}
+
+		bool IsOk() const
+		{
+			return bOk;
+		}
+
+		uint64 ReadWord(int32 NumBytes)
+		{
+			if (!bOk || Offset + NumBytes > Num)
+			{
+				bOk = false;
+				return 0;
+			}
+
+			uint64 Word = 0;
+			for (int32 Byte = 0; Byte < NumBytes; ++Byte)
+			{
+				Word |= uint64(Data[Offset + Byte]) << (Byte * 8);
+			}
+			Offset += NumBytes;
+			return Word;
+		}
+
+		std::string ReadString(int32 Length)
+		{
+			if (!bOk || Offset + Length > Num)
+			{
+				bOk = false;
+				return std::string();
+			}
+
+			const std::string Result(reinterpret_cast<const char*>(Data + Offset), size_t(Length));
+			Offset += Length;
+			return Result;
+		}
+
+		template<int MantissaSize, int Exponent>
+		void ReadValue(real_fixed<MantissaSize, Exponent>& Value)
+		{
+			for (ttmath::uint i = 0; i < TTMATH_BITS(MantissaSize + Exponent); ++i)
+			{
+				Value.mantissa.table[i] = ttmath::uint(ReadWord(int32(sizeof(ttmath::uint))));
+			}
+		}
+
+		template<ttmath::uint exp, ttmath::uint man>
+		void ReadValue(ttmath::Big<exp, man>& Value)
+		{
+			for (ttmath::uint i = 0; i < man; ++i)
+			{
+				Value.mantissa.table[i] = ttmath::uint(ReadWord(int32(sizeof(ttmath::uint))));
+			}
+			for (ttmath::uint i = 0; i < exp; ++i)
+			{
+				Value.exponent.table[i] = ttmath::uint(ReadWord(int32(sizeof(ttmath::uint))));
+			}
+			Value.info = uint8(ReadWord(1));
+		}
+
+	private:
+		const uint8* Data;
+		int64 Num;
+		int64 Offset = 0;
+		bool bOk = true;
+	};
+
+	// Result of a replay. The trace matched the build when Error is empty and FirstDivergentOp is -1
+	struct FReplayReport
+	{
+		// Why the trace couldn't be replayed (not a trace, other precision settings, other executor), or was only partly (truncated)
+		std::string Error;
+
+		// Backend of the build that recorded the trace, see ttmath::UInt::LibTypeStr
+		std::string RecordedBackend;
+
+		// Number of operations replayed, up to and including the divergent one
+		int64 NumOps = 0;
+
+		// Index of the first operation whose result differs, its function, inputs, and recorded and replayed results
+		int64 FirstDivergentOp = -1;
+		std::string Function;
+		std::string Inputs;
+		std::string Expected;
+		std::string Actual;
+		uint64 ExpectedHash = 0;
+		uint64 ActualHash = 0;
+
+		bool IsOk() const
+		{
+			return Error.empty() && FirstDivergentOp < 0;
+		}
+
+		std::string ToString() const
+		{
+			if (!Error.empty())
+			{
+				return Error;
+			}
+			if (FirstDivergentOp < 0)
+			{
+				return "The " + std::to_string(NumOps) + " operations recorded by " + RecordedBackend + " give the same results";
+			}
+			return "Operation " + std::to_string(FirstDivergentOp) + " (" + Function + " of " + Inputs + ") diverges from the trace recorded by "
+				+ RecordedBackend + ": expected " + Expected + ", got " + Actual;
+		}
+	};
+
+	template<int MantissaSize, int Exponent>
+	std::string ToDisplayString(real_fixed<MantissaSize, Exponent> Value)
+	{
+		return std::string(TCHAR_TO_ANSI(*Value.ToString()));
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	std::string ToDisplayString(const ttmath::Big<exp, man>& Value)
+	{
+		return Value.ToString();
+	}
+
+	// Replays a trace with ExecutorType, which provides FixedType, FloatType, Id, and the static Execute(EOp, A, B) for both types
+	template<typename ExecutorType>
+	FReplayReport Replay(const uint8* Data, int64 Num)
+	{
+		using FixedType = typename ExecutorType::FixedType;
+		using FloatType = typename ExecutorType::FloatType;
+
+		FReplayReport Report;
+		FTraceReader Reader(Data, Num);
+
+		// Every field is read, so that the checks don't depend on the evaluation order
+		const bool bMagic = Reader.ReadString(4) == "SKPT";
+		const bool bVersion = Reader.ReadWord(2) == TraceVersion;
+		const bool bWordSize = Reader.ReadWord(1) == sizeof(ttmath::uint);
+		const bool bFixedWords = Reader.ReadWord(1) == TFixedTraits<FixedType>::Words;
+		const bool bFloatMantissaWords = Reader.ReadWord(1) == TFloatTraits<FloatType>::MantissaWords;
+		const bool bFloatExponentWords = Reader.ReadWord(1) == TFloatTraits<FloatType>::ExponentWords;
+		const bool bFractionBits = int32(uint32(Reader.ReadWord(4))) == TFixedTraits<FixedType>::FractionBits;
+		const bool bSameExecutor = Reader.ReadWord(1) == ExecutorType::Id;
+		Report.RecordedBackend = Reader.ReadString(int32(Reader.ReadWord(1)));
+
+		if (!Reader.IsOk() || !bMagic || !bVersion)
+		{
+			Report.Error = "Not a precision trace, or a trace of another version";
+			return Report;
+		}
+		if (!bWordSize || !bFixedWords || !bFloatMantissaWords || !bFloatExponentWords || !bFractionBits)
+		{
+			Report.Error = "The trace was recorded with other precision settings (PrecisionSettings.h) or word size";
+			return Report;
+		}
+		if (!bSameExecutor)
+		{
+			Report.Error = "The trace was recorded with other functions (engine or standalone core), it can only be replayed with them";
+			return Report;
+		}
+
+		uint64 RollingHash = HashSeed;
+		while (!Reader.IsAtEnd())
+		{
+			const EOp Op = EOp(Reader.ReadWord(1));
+			if (uint8(Op) >= uint8(EOp::Count))
+			{
+				Report.Error = "Unknown operation " + std::to_string(uint8(Op)) + " at operation " + std::to_string(Report.NumOps) + ", the trace is corrupted";
+				return Report;
+			}
+
+			const FOpInfo& Info = GetOpInfo(Op);
+			auto ReplayOp = [&](auto Value)
+			{
+				using ValueType = decltype(Value);
+				ValueType A, B, Expected;
+				Reader.ReadValue(A);
+				if (Info.NumOperands > 1)
+				{
+					Reader.ReadValue(B);
+				}
+				Reader.ReadValue(Expected);
+				const uint64 ExpectedHash = Reader.ReadWord(8);
+				if (!Reader.IsOk())
+				{
+					Report.Error = "The trace is truncated at operation " + std::to_string(Report.NumOps);
+					return false;
+				}
+
+				const ValueType Actual = ExecutorType::Execute(Op, A, B);
+				RollingHash = HashValue(HashWord(RollingHash, uint8(Op), 1), Actual);
+				++Report.NumOps;
+
+				if (RollingHash != ExpectedHash)
+				{
+					Report.FirstDivergentOp = Report.NumOps - 1;
+					Report.Function = Info.Name;
+					Report.Inputs = Info.NumOperands > 1 ? ToDisplayString(A) + ", " + ToDisplayString(B) : ToDisplayString(A);
+					Report.Expected = ToDisplayString(Expected);
+					Report.Actual = ToDisplayString(Actual);
+					Report.ExpectedHash = ExpectedHash;
+					Report.ActualHash = RollingHash;
+					return false;
+				}
+				return true;
+			};
+
+			if (!(Info.bFloat ? ReplayOp(FloatType()) : ReplayOp(FixedType())))
+			{
+				return Report;
+			}
+		}
+
+		return Report;
+	}
+
+	// Random fixed-point number with IntegerBits bits before the point, from the raw bits of Random, so the same on every platform
+	template<typename FixedType>
+	FixedType RandomFixed(std::mt19937_64& Random, int32 IntegerBits, bool bPositive)
+	{
+		typename FixedType::ttIntMantissaType Mantissa;
+
+		const int32 Bits = IntegerBits + TFixedTraits<FixedType>::FractionBits;
+		for (ttmath::uint i = 0; i < TFixedTraits<FixedType>::Words; ++i)
+		{
+			const int32 WordBits = std::max(0, std::min(int32(TTMATH_BITS_PER_UINT), Bits - int32(i * TTMATH_BITS_PER_UINT)));
+			const uint64 Word = uint64(Random());
+			Mantissa.table[i] = WordBits == 0 ? 0 : ttmath::uint(WordBits >= 64 ? Word : Word & ((uint64(1) << WordBits) - 1));
+		}
+
+		// Never zero, so that it can be a divisor
+		Mantissa.table[0] |= 1;
+
+		if (!bPositive && (Random() & 1))
+		{
+			Mantissa.ChangeSign();
+		}
+		return FixedType::FromMantissa(Mantissa);
+	}
+
+	// Random float in [2^MinExponent, 2^MaxExponent[, or its opposite, from the raw bits of Random
+	template<typename FloatType>
+	FloatType RandomFloat(std::mt19937_64& Random, int32 MinExponent, int32 MaxExponent, bool bPositive)
+	{
+		constexpr ttmath::uint man = TFloatTraits<FloatType>::MantissaWords;
+
+		FloatType Result;
+		for (ttmath::uint i = 0; i < man; ++i)
+		{
+			Result.mantissa.table[i] = ttmath::uint(Random());
+		}
+		Result.mantissa.table[man - 1] |= TTMATH_UINT_HIGHEST_BIT;
+
+		const int32 Exponent = MinExponent + int32(Random() % uint64(MaxExponent - MinExponent));
+		Result.exponent = ttmath::sint(Exponent) - ttmath::sint(man * TTMATH_BITS_PER_UINT) + 1;
+		Result.info = 0;
+
+		if (!bPositive && (Random() & 1))
+		{
+			Result.SetSign();
+		}
+		return Result;
+	}
+
+	// Runs NumOps random operations of every kind, with inputs in their domains, through Run(EOp, A, B), e.g. to record a trace.
+	// The inputs only depend on Seed, whatever the platform: A is always drawn before B, as the evaluation order of function arguments is unspecified.
+	// Unary operations get a zero B
+	template<typename FixedType, typename FloatType, typename RunType>
+	void RunWorkload(uint64 Seed, int32 NumOps, RunType&& Run)
+	{
+		std::mt19937_64 Random(Seed);
+
+		const auto Fixed = [&Random](int32 IntegerBits, bool bPositive = false)
+		{
+			return RandomFixed<FixedType>(Random, IntegerBits, bPositive);
+		};
+		const auto Float = [&Random](int32 MinExponent, int32 MaxExponent, bool bPositive = false)
+		{
+			return RandomFloat<FloatType>(Random, MinExponent, MaxExponent, bPositive);
+		};
+
+		const FixedType FixedZero = FixedType::FromMantissa(typename FixedType::ttIntMantissaType(0));
+		FloatType FloatZero;
+		FloatZero.SetZero();
+
+		for (int32 i = 0; i < NumOps; ++i)
+		{
+			const EOp Op = EOp(Random() % uint64(EOp::Count));
+			switch (Op)
+			{
+			// The fixed-point inputs are small enough for the intermediate products of multiplications and divisions to fit in the mantissa
+			case EOp::FixedAdd:
+			case EOp::FixedSubtract:
+			{
+				const FixedType A = Fixed(40);
+				const FixedType B = Fixed(40);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FixedMultiply:
+			{
+				const FixedType A = Fixed(30);
+				const FixedType B = Fixed(30);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FixedDivide:
+			case EOp::FixedModulo:
+			{
+				const FixedType A = Fixed(40);
+				const FixedType B = Fixed(20);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FixedSqrt:
+			case EOp::FixedLogE:
+				Run(Op, Fixed(40, true), FixedZero);
+				break;
+			case EOp::FixedSinRad:
+			case EOp::FixedCosRad:
+			case EOp::FixedTanRad:
+				Run(Op, Fixed(6), FixedZero);
+				break;
+			case EOp::FixedAtan2Rad:
+			{
+				const FixedType A = Fixed(20);
+				const FixedType B = Fixed(20);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FixedExp:
+				Run(Op, Fixed(5), FixedZero);
+				break;
+			case EOp::FloatAdd:
+			case EOp::FloatSubtract:
+			case EOp::FloatMultiply:
+			case EOp::FloatDivide:
+			{
+				const FloatType A = Float(-64, 64);
+				const FloatType B = Float(-64, 64);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FloatSqrt:
+			case EOp::FloatLogE:
+				Run(Op, Float(-64, 64, true), FloatZero);
+				break;
+			case EOp::FloatSinRad:
+			case EOp::FloatCosRad:
+			case EOp::FloatTanRad:
+				Run(Op, Float(-8, 8), FloatZero);
+				break;
+			case EOp::FloatAtan2Rad:
+			{
+				const FloatType A = Float(-32, 32);
+				const FloatType B = Float(-32, 32);
+				Run(Op, A, B);
+				break;
+			}
+			case EOp::FloatExp:
+				Run(Op, Float(-8, 6), FloatZero);
+				break;
+			case EOp::FloatPow:
+			default:
+			{
+				const FloatType A = Float(-4, 4, true);
+				const FloatType B = Float(-4, 3);
+				Run(EOp::FloatPow, A, B);
+				break;
+			}
+			}
+		}
+	}
+
+	// Executor ids, stored in the traces
+	constexpr uint8 CoreExecutorId = 0;
+	constexpr uint8 EngineExecutorId = 1;
+
+	// Executes the operations with real_fixed and ttmath directly, like the standalone build (see Standalone/PrecisionCore.h)
+	template<typename InFixedType, typename InFloatType>
+	struct TCoreExecutor
+	{
+		using FixedType = InFixedType;
+		using FloatType = InFloatType;
+
+		static constexpr uint8 Id = CoreExecutorId;
+
+		template<typename BigType>
+		static BigType Atan2(const BigType& Y, const BigType& X)
+		{
+			BigType Pi;
+			Pi.SetPi();
+
+			if (X.IsZero())
+			{
+				BigType HalfPi = Pi;
+				HalfPi.exponent.SubOne();
+				return Y.IsZero() ? BigType(0) : Y.IsSign() ? -HalfPi : HalfPi;
+			}
+
+			const BigType Angle = ttmath::ATan(Y / X);
+			return !X.IsSign() ? Angle : Y.IsSign() ? Angle - Pi : Angle + Pi;
+		}
+
+		static FixedType Execute(EOp Op, const FixedType& A, const FixedType& B)
+		{
+			switch (Op)
+			{
+			case EOp::FixedAdd: return A + B;
+			case EOp::FixedSubtract: return A - B;
+			case EOp::FixedMultiply: return A * B;
+			case EOp::FixedDivide: return A / B;
+			case EOp::FixedModulo: return A % B;
+			case EOp::FixedSqrt: return FixedType(ttmath::Sqrt(A.ToBig()));
+			case EOp::FixedSinRad: return FixedType(ttmath::Sin(A.ToBig()));
+			case EOp::FixedCosRad: return FixedType(ttmath::Cos(A.ToBig()));
+			case EOp::FixedTanRad: return FixedType(ttmath::Tan(A.ToBig()));
+			case EOp::FixedAtan2Rad: return FixedType(Atan2(A.ToBig(), B.ToBig()));
+			case EOp::FixedExp: return FixedType(ttmath::Exp(A.ToBig()));
+			case EOp::FixedLogE: return FixedType(ttmath::Ln(A.ToBig()));
+			default: return FixedType();
+			}
+		}
+
+		static FloatType Execute(EOp Op, const FloatType& A, const FloatType& B)
+		{
+			switch (Op)
+			{
+			case EOp::FloatAdd: return A + B;
+			case EOp::FloatSubtract: return A - B;
+			case EOp::FloatMultiply: return A * B;
+			case EOp::FloatDivide: return A / B;
+			case EOp::FloatSqrt: return ttmath::Sqrt(A);
+			case EOp::FloatSinRad: return ttmath::Sin(A);
+			case EOp::FloatCosRad: return ttmath::Cos(A);
+			case EOp::FloatTanRad: return ttmath::Tan(A);
+			case EOp::FloatAtan2Rad: return Atan2(A, B);
+			case EOp::FloatExp: return ttmath::Exp(A);
+			case EOp::FloatLogE: return ttmath::Ln(A);
+			case EOp::FloatPow:
+			{
+				FloatType Result = A;
+				Result.Pow(B);
+				return Result;
+			}
+			default: return FloatType();
+			}
+		}
+	};
+}
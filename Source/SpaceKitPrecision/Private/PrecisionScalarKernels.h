@@ -0,0 +1,73 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "SpaceKitPrecision/Public/PrecisionSettings.h"
+#include "SpaceKitPrecision/Private/PrecisionBudgetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionGeometryKernels.h"
+
+// Square root and trigonometric functions of the fixed-point and floating-point reals, and the rotator to quaternion conversion built on them, without any engine dependency.
+// URealFixedMath, URealFloatMath and FQuatFixed forward to them, as does Standalone/PrecisionCore.h, so both builds give the same bits.
+namespace PrecisionScalar
+{
+	// real_fixed has no transcendental functions of its own: they go through ttBigType
+	template<int MantissaSize, int Exponent>
+	real_fixed<MantissaSize, Exponent> Sqrt(const real_fixed<MantissaSize, Exponent>& Val)
+	{
+		return real_fixed<MantissaSize, Exponent>(ttmath::Sqrt(Val.ToBig()));
+	}
+
+	template<int MantissaSize, int Exponent>
+	real_fixed<MantissaSize, Exponent> SinRad(const real_fixed<MantissaSize, Exponent>& Val)
+	{
+		return real_fixed<MantissaSize, Exponent>(ttmath::Sin(Val.ToBig()));
+	}
+
+	template<int MantissaSize, int Exponent>
+	real_fixed<MantissaSize, Exponent> CosRad(const real_fixed<MantissaSize, Exponent>& Val)
+	{
+		return real_fixed<MantissaSize, Exponent>(ttmath::Cos(Val.ToBig()));
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> Sqrt(const ttmath::Big<exp, man>& Val)
+	{
+		return ttmath::Sqrt(Val);
+	}
+
+	// Bits is the precision budget of PrecisionBudget::Sin, 0 for the full significand
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> SinRad(const ttmath::Big<exp, man>& Val, int32 Bits = 0)
+	{
+		return PrecisionBudget::Sin(Val, Bits);
+	}
+
+	template<ttmath::uint exp, ttmath::uint man>
+	ttmath::Big<exp, man> CosRad(const ttmath::Big<exp, man>& Val, int32 Bits = 0)
+	{
+		return PrecisionBudget::Cos(Val, Bits);
+	}
+
+	// Same constant as FRealFixed::DegToRad and FRealFloat::DegToRad
+	template<typename ScalarType>
+	ScalarType DegreesToRadians(const ScalarType& Deg)
+	{
+		static const ScalarType DegToRad = ScalarType("3.1415926535897932384626433832795") / ScalarType(180);
+		return Deg * DegToRad;
+	}
+
+	// Quaternion of a rotator given in degrees. QuatType needs a constructor taking X, Y, Z, W as ScalarType
+	template<typename QuatType, typename ScalarType>
+	QuatType QuatFromRotator(const ScalarType& Pitch, const ScalarType& Yaw, const ScalarType& Roll)
+	{
+		const ScalarType Half("0.5");
+		const ScalarType HalfRadPitch = DegreesToRadians(ScalarType(Pitch * Half));
+		const ScalarType HalfRadYaw = DegreesToRadians(ScalarType(Yaw * Half));
+		const ScalarType HalfRadRoll = DegreesToRadians(ScalarType(Roll * Half));
+
+		return PrecisionGeometry::QuatFromHalfAngles<QuatType>(
+			SinRad(HalfRadPitch), CosRad(HalfRadPitch),
+			SinRad(HalfRadYaw), CosRad(HalfRadYaw),
+			SinRad(HalfRadRoll), CosRad(HalfRadRoll));
+	}
+}
@@ -0,0 +1,180 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionSnapshot.h"
+
+// The copies of a block are used in order, one per capture of a dirty block. The frames in the buffer use the copies from the one of the
+// oldest frame to the latest one, at most NumFrames - 1 of them once the oldest frame is overwritten, so the copy after the latest one is free.
+
+FPrecisionSnapshotBuffer::FPrecisionSnapshotBuffer(int32 InNumFrames, FPrecisionStateHasher* InHasher)
+	: NumFrames(FMath::Max(InNumFrames, 1))
+	, Hasher(InHasher)
+{
+	Slots.SetNum(NumFrames);
+	ForgetFrames();
+}
+
+int32 FPrecisionSnapshotBuffer::AddBlock(void* Data, int64 NumBytes, int32 Num, bool bTrackDirty, int32 HasherArray)
+{
+	FBlock& Block = Blocks.AddDefaulted_GetRef();
+	Block.Data = Data;
+	Block.NumBytes = NumBytes;
+	Block.Num = Num;
+	Block.bTrackDirty = bTrackDirty;
+	Block.bDirty = true;
+	Block.HasherArray = HasherArray;
+	Block.ArenaOffset = Arena.Num();
+	Block.LatestCopy = INDEX_NONE;
+
+	Arena.AddUninitialized(NumBytes * NumFrames);
+	SlotCopies.SetNum(Blocks.Num() * NumFrames);
+	ForgetFrames();
+	return Blocks.Num() - 1;
+}
+
+void FPrecisionSnapshotBuffer::MarkDirty(int32 BlockIndex, int32 First, int32 Num)
+{
+	if (!Blocks.IsValidIndex(BlockIndex))
+	{
+		return;
+	}
+
+	FBlock& Block = Blocks[BlockIndex];
+	Block.bDirty = true;
+	if (Hasher)
+	{
+		Hasher->MarkDirty(Block.HasherArray, First, int32(FMath::Min(int64(Num), int64(Block.Num) - First)));
+	}
+}
+
+void FPrecisionSnapshotBuffer::Capture(int32 Frame)
+{
+	if (Frame < 0)
+	{
+		return;
+	}
+
+	// Capturing a frame again without restoring the one before it: the copies of the frames after it are free again
+	if (Frame <= LatestFrame)
+	{
+		ForgetFramesAfter(Frame);
+		int32 Previous = Frame - 1;
+		while (Previous > LatestFrame - NumFrames && !HasFrame(Previous))
+		{
+			--Previous;
+		}
+		if (!HasFrame(Previous))
+		{
+			ForgetFrames();
+		}
+		for (int32 BlockIndex = 0; BlockIndex < Blocks.Num() && LatestFrame != INDEX_NONE; ++BlockIndex)
+		{
+			Blocks[BlockIndex].LatestCopy = SlotCopies[(Previous % NumFrames) * Blocks.Num() + BlockIndex];
+			Blocks[BlockIndex].bDirty = true;
+		}
+	}
+
+	const int32 Slot = Frame % NumFrames;
+	LastCopiedBytes = 0;
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		FBlock& Block = Blocks[BlockIndex];
+		if (!Block.bTrackDirty || Block.bDirty || Block.LatestCopy == INDEX_NONE)
+		{
+			Block.LatestCopy = (Block.LatestCopy + 1) % NumFrames;
+			FMemory::Memcpy(&Arena[Block.ArenaOffset + Block.LatestCopy * Block.NumBytes], Block.Data, Block.NumBytes);
+			Block.bDirty = false;
+			LastCopiedBytes += Block.NumBytes;
+		}
+		SlotCopies[Slot * Blocks.Num() + BlockIndex] = Block.LatestCopy;
+	}
+
+	Slots[Slot].Frame = Frame;
+	Slots[Slot].Checksum = Hasher ? Hasher->GetChecksum() : 0;
+	LatestFrame = Frame;
+}
+
+bool FPrecisionSnapshotBuffer::Restore(int32 Frame)
+{
+	if (!HasFrame(Frame))
+	{
+		return false;
+	}
+
+	const int32 Slot = Frame % NumFrames;
+	LastCopiedBytes = 0;
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		FBlock& Block = Blocks[BlockIndex];
+		const int32 Copy = SlotCopies[Slot * Blocks.Num() + BlockIndex];
+
+		// Blocks that weren't changed since they were copied from or to this copy already have its data
+		if (Block.bTrackDirty && !Block.bDirty && Block.LatestCopy == Copy)
+		{
+			continue;
+		}
+
+		FMemory::Memcpy(Block.Data, &Arena[Block.ArenaOffset + Copy * Block.NumBytes], Block.NumBytes);
+		Block.LatestCopy = Copy;
+		Block.bDirty = false;
+		LastCopiedBytes += Block.NumBytes;
+		if (Hasher)
+		{
+			Hasher->MarkDirty(Block.HasherArray, 0, Block.Num);
+		}
+	}
+
+	ForgetFramesAfter(Frame);
+	LatestFrame = Frame;
+	return true;
+}
+
+bool FPrecisionSnapshotBuffer::HasFrame(int32 Frame) const
+{
+	return Frame >= 0 && Frame <= LatestFrame && Frame > LatestFrame - NumFrames && Slots[Frame % NumFrames].Frame == Frame;
+}
+
+bool FPrecisionSnapshotBuffer::GetChecksum(int32 Frame, uint64& OutChecksum) const
+{
+	if (!Hasher || !HasFrame(Frame))
+	{
+		return false;
+	}
+	OutChecksum = Slots[Frame % NumFrames].Checksum;
+	return true;
+}
+
+void FPrecisionSnapshotBuffer::Reset()
+{
+	Blocks.Reset();
+	Arena.Reset();
+	SlotCopies.Reset();
+	ForgetFrames();
+}
+
+void FPrecisionSnapshotBuffer::ForgetFrames()
+{
+	for (FFrameSlot& FrameSlot : Slots)
+	{
+		FrameSlot.Frame = INDEX_NONE;
+		FrameSlot.Checksum = 0;
+	}
+	for (FBlock& Block : Blocks)
+	{
+		Block.bDirty = true;
+		Block.LatestCopy = INDEX_NONE;
+	}
+	LatestFrame = INDEX_NONE;
+}
+
+void FPrecisionSnapshotBuffer::ForgetFramesAfter(int32 Frame)
+{
+	for (int32 Later = FMath::Max(Frame + 1, LatestFrame - NumFrames + 1); Later <= LatestFrame; ++Later)
+	{
+		FFrameSlot& FrameSlot = Slots[Later % NumFrames];
+		if (FrameSlot.Frame == Later)
+		{
+			FrameSlot.Frame = INDEX_NONE;
+			FrameSlot.Checksum = 0;
+		}
+	}
+}
@@ -0,0 +1,70 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionStateHasher.h"
+
+int32 FPrecisionStateHasher::AddArray(const void* Data, int32 Num, FHashElementsFunction HashFunction)
+{
+	FRegisteredArray& Array = Arrays.AddDefaulted_GetRef();
+	Array.Data = Data;
+	Array.Num = FMath::Max(Num, 0);
+	Array.HashElements = HashFunction;
+	Array.FirstChunk = ChunkHashes.Num();
+
+	const int32 NumChunks = (Array.Num + ChunkSize - 1) / ChunkSize;
+	ChunkHashes.AddZeroed(NumChunks);
+	DirtyChunks.Add(true, NumChunks);
+	return Arrays.Num() - 1;
+}
+
+void FPrecisionStateHasher::MarkDirty(int32 ArrayIndex, int32 First, int32 Num)
+{
+	if (!Arrays.IsValidIndex(ArrayIndex))
+	{
+		return;
+	}
+
+	const FRegisteredArray& Array = Arrays[ArrayIndex];
+	const int32 Begin = FMath::Max(First, 0);
+	const int32 End = FMath::Min(First + Num, Array.Num);
+	for (int32 Chunk = Begin / ChunkSize; Chunk * ChunkSize < End; ++Chunk)
+	{
+		DirtyChunks[Array.FirstChunk + Chunk] = true;
+	}
+}
+
+void FPrecisionStateHasher::MarkAllDirty()
+{
+	DirtyChunks.SetRange(0, DirtyChunks.Num(), true);
+}
+
+void FPrecisionStateHasher::Reset()
+{
+	Arrays.Reset();
+	ChunkHashes.Reset();
+	DirtyChunks.Reset();
+	NumChunksHashed = 0;
+}
+
+uint64 FPrecisionStateHasher::GetChecksum()
+{
+	NumChunksHashed = 0;
+	PrecisionHash::FXxHash64 Checksum;
+	for (const FRegisteredArray& Array : Arrays)
+	{
+		Checksum.Add(uint64(Array.Num));
+		for (int32 Chunk = 0; Chunk * ChunkSize < Array.Num; ++Chunk)
+		{
+			const int32 ChunkIndex = Array.FirstChunk + Chunk;
+			if (DirtyChunks[ChunkIndex])
+			{
+				PrecisionHash::FXxHash64 Hash;
+				Array.HashElements(Hash, Array.Data, Chunk * ChunkSize, FMath::Min(ChunkSize, Array.Num - Chunk * ChunkSize));
+				ChunkHashes[ChunkIndex] = Hash.Finish();
+				DirtyChunks[ChunkIndex] = false;
+				++NumChunksHashed;
+			}
+			Checksum.Add(ChunkHashes[ChunkIndex]);
+		}
+	}
+	return Checksum.Finish();
+}
@@ -0,0 +1,25 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/PrecisionStats.h"
+
+#if SPACEKITPRECISION_WITH_STATS
+
+DEFINE_STAT(STAT_SpaceKitPrecision_Trig);
+DEFINE_STAT(STAT_SpaceKitPrecision_InverseTrig);
+DEFINE_STAT(STAT_SpaceKitPrecision_Sqrt);
+DEFINE_STAT(STAT_SpaceKitPrecision_ExpLog);
+DEFINE_STAT(STAT_SpaceKitPrecision_ToBig);
+DEFINE_STAT(STAT_SpaceKitPrecision_StringImport);
+DEFINE_STAT(STAT_SpaceKitPrecision_StringExport);
+DEFINE_STAT(STAT_SpaceKitPrecision_TransformCompose);
+
+DEFINE_STAT(STAT_SpaceKitPrecision_TrigCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_InverseTrigCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_SqrtCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_ExpLogCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_ToBigCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_StringImportCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_StringExportCalls);
+DEFINE_STAT(STAT_SpaceKitPrecision_TransformComposeCalls);
+
+#endif
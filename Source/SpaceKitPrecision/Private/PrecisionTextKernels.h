@@ -0,0 +1,976 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+// Decimal formatting and parsing of fixed-point mantissas and ttmath big floats, into and from buffers of the caller, without heap allocation.
+// Formatting writes the shortest digits that parse back to the same value, and parsing rounds to the nearest value (ties to even).
+// Both work with exact integer arithmetic on the mantissa, where ttmath's Conv goes through big float divisions, and rounds its output instead.
+// Big floats out of about 1e+-308 (binary exponents beyond +-ExactExponentBits) are formatted and parsed by ttmath, with allocations.
+namespace PrecisionText
+{
+	constexpr int32 ExactExponentBits = 1024;
+
+	// Words of the widest integers the big float conversions work on: ExactExponentBits, and room for the parsed digits, the significand,
+	// and the powers of 10, so that the numbers formatted in the exact range are also parsed in it
+	template<ttmath::uint man>
+	constexpr ttmath::uint FloatWorkWords()
+	{
+		return 4 * man + ExactExponentBits / TTMATH_BITS_PER_UINT + 4;
+	}
+
+	// Significant digits kept by the parsers, 20 more than the significand: the others only count as a sticky bit, that breaks the ties
+	constexpr int32 MaxSignificantDigits(ttmath::uint Words)
+	{
+		return int32(Words * TTMATH_BITS_PER_UINT * 30103 / 100000) + 20;
+	}
+
+	// Characters needed to format a fixed-point number of Words words, FractionBits of which after the point, with its sign and terminating null
+	constexpr int32 FixedChars(ttmath::uint Words, int32 FractionBits)
+	{
+		return int32(Words * TTMATH_BITS_PER_UINT * 30103 / 100000) + FractionBits * 30103 / 100000 + 6;
+	}
+
+	// Characters needed to format a big float of man mantissa words: the shortest digits, the sign, up to 6 leading zeros or an exponent, and the terminating null
+	constexpr int32 FloatChars(ttmath::uint man)
+	{
+		return int32(man * TTMATH_BITS_PER_UINT * 30103 / 100000) + 34;
+	}
+
+	template<typename CharType>
+	bool IsDigit(CharType Char)
+	{
+		return Char >= CharType('0') && Char <= CharType('9');
+	}
+
+	// Number of significant bits of X, 0 when it's zero
+	template<ttmath::uint Words>
+	int32 BitLength(const ttmath::UInt<Words>& X)
+	{
+		ttmath::uint Table, Index;
+		return X.FindLeadingBit(Table, Index) ? int32(Table * TTMATH_BITS_PER_UINT + Index) + 1 : 0;
+	}
+
+	// Upper bound of BitLength(10^N)
+	inline int32 Pow10BitLength(int32 N)
+	{
+		return int32(int64(N) * 33220 / 10000) + 1;
+	}
+
+	// Clears the bits of X from Bits up
+	template<ttmath::uint Words>
+	void KeepLowBits(ttmath::UInt<Words>& X, int32 Bits)
+	{
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			const int32 WordStart = int32(i * TTMATH_BITS_PER_UINT);
+			if (WordStart >= Bits)
+			{
+				X.table[i] = 0;
+			}
+			else if (Bits - WordStart < int32(TTMATH_BITS_PER_UINT))
+			{
+				X.table[i] &= (ttmath::uint(1) << (Bits - WordStart)) - 1;
+			}
+		}
+	}
+
+	// Whether one of the bits of X below Bits is set
+	template<ttmath::uint Words>
+	bool HasLowBits(const ttmath::UInt<Words>& X, int32 Bits)
+	{
+		ttmath::UInt<Words> Low = X;
+		KeepLowBits(Low, Bits);
+		return !Low.IsZero();
+	}
+
+	// X *= Multiplier, returns the word carried out. Unlike UInt::MulInt, this works in place
+	template<ttmath::uint Words>
+	ttmath::uint MulWord(ttmath::UInt<Words>& X, ttmath::uint Multiplier)
+	{
+		ttmath::uint Carry = 0;
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			ttmath::uint High, Low;
+			ttmath::UInt<1>::MulTwoWords(X.table[i], Multiplier, &High, &Low);
+			Low += Carry;
+			Carry = High + (Low < Carry ? 1 : 0);
+			X.table[i] = Low;
+		}
+		return Carry;
+	}
+
+	// X *= 10^N, returns whether it overflowed
+	template<ttmath::uint Words>
+	bool MulPow10(ttmath::UInt<Words>& X, int32 N)
+	{
+		constexpr int32 WordDigits = TTMATH_BITS_PER_UINT == 64 ? 19 : 9;
+		constexpr ttmath::uint WordPow10 = ttmath::uint(TTMATH_BITS_PER_UINT == 64 ? 10000000000000000000ull : 1000000000ull);
+
+		for (; N >= WordDigits; N -= WordDigits)
+		{
+			if (MulWord(X, WordPow10))
+			{
+				return true;
+			}
+		}
+
+		ttmath::uint Rest = 1;
+		for (; N > 0; --N)
+		{
+			Rest *= 10;
+		}
+		return Rest != 1 && MulWord(X, Rest) != 0;
+	}
+
+	// Decimal number read from a text: Digits * 10^Exponent10, and whether nonzero digits past MaxSignificantDigits were dropped
+	template<ttmath::uint Words>
+	struct TDecimal
+	{
+		ttmath::UInt<Words> Digits;
+		int64 Exponent10 = 0;
+		bool bNegative = false;
+		bool bSticky = false;
+	};
+
+	// Reads [+-]digits[.digits][(e|E)[+-]digits], with at least one digit. Returns the number of characters read, or 0 when Text doesn't start with a number
+	template<ttmath::uint Words, typename CharType>
+	int32 ScanDecimal(const CharType* Text, int32 MaxDigits, TDecimal<Words>& Decimal)
+	{
+		constexpr int32 WordDigits = TTMATH_BITS_PER_UINT == 64 ? 19 : 9;
+
+		const CharType* Cursor = Text;
+		Decimal.bNegative = *Cursor == CharType('-');
+		if (*Cursor == CharType('-') || *Cursor == CharType('+'))
+		{
+			++Cursor;
+		}
+
+		Decimal.Digits.SetZero();
+		Decimal.Exponent10 = 0;
+		Decimal.bSticky = false;
+
+		// The digits are gathered in words, and added to Digits a word at a time
+		ttmath::uint Chunk = 0;
+		ttmath::uint ChunkScale = 1;
+		const auto Flush = [&]()
+		{
+			if (ChunkScale != 1)
+			{
+				MulWord(Decimal.Digits, ChunkScale);
+				Decimal.Digits.AddInt(Chunk);
+			}
+			Chunk = 0;
+			ChunkScale = 1;
+		};
+
+		int32 NumDigits = 0;
+		int32 NumChunkDigits = 0;
+		bool bAnyDigit = false;
+		bool bPoint = false;
+		for (;; ++Cursor)
+		{
+			if (IsDigit(*Cursor))
+			{
+				bAnyDigit = true;
+				const ttmath::uint Digit = ttmath::uint(*Cursor - CharType('0'));
+
+				// Leading zeros are not significant
+				if (NumDigits == 0 && Digit == 0)
+				{
+					Decimal.Exponent10 -= bPoint ? 1 : 0;
+				}
+				else if (NumDigits < MaxDigits)
+				{
+					Chunk = Chunk * 10 + Digit;
+					ChunkScale *= 10;
+					++NumDigits;
+					Decimal.Exponent10 -= bPoint ? 1 : 0;
+					if (++NumChunkDigits == WordDigits)
+					{
+						Flush();
+						NumChunkDigits = 0;
+					}
+				}
+				else
+				{
+					Decimal.bSticky = Decimal.bSticky || Digit != 0;
+					Decimal.Exponent10 += bPoint ? 0 : 1;
+				}
+			}
+			else if (*Cursor == CharType('.') && !bPoint)
+			{
+				bPoint = true;
+			}
+			else
+			{
+				break;
+			}
+		}
+		Flush();
+
+		if (!bAnyDigit)
+		{
+			return 0;
+		}
+
+		// The exponent is only part of the number when it has digits
+		if (*Cursor == CharType('e') || *Cursor == CharType('E'))
+		{
+			const CharType* ExponentCursor = Cursor + 1;
+			const bool bNegativeExponent = *ExponentCursor == CharType('-');
+			if (*ExponentCursor == CharType('-') || *ExponentCursor == CharType('+'))
+			{
+				++ExponentCursor;
+			}
+
+			if (IsDigit(*ExponentCursor))
+			{
+				int64 Exponent = 0;
+				for (; IsDigit(*ExponentCursor); ++ExponentCursor)
+				{
+					Exponent = Exponent < 1000000000 ? Exponent * 10 + (*ExponentCursor - CharType('0')) : Exponent;
+				}
+				Decimal.Exponent10 += bNegativeExponent ? -Exponent : Exponent;
+				Cursor = ExponentCursor;
+			}
+		}
+
+		return int32(Cursor - Text);
+	}
+
+	// Adds one to the last of the decimal digits, removing the trailing zeros this creates. Returns whether the carry went past the first digit
+	inline bool IncrementDigits(char* Digits, int32& NumDigits)
+	{
+		while (NumDigits > 0 && Digits[NumDigits - 1] == '9')
+		{
+			--NumDigits;
+		}
+		if (NumDigits == 0)
+		{
+			return true;
+		}
+		++Digits[NumDigits - 1];
+		return false;
+	}
+
+	// Formats the fixed-point number Mantissa * 2^-FractionBits as [-]integer.fraction, with at least one digit on each side.
+	// Returns the number of characters written, without the terminating null, or 0 when BufferLength is too small (see FixedChars)
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	int32 FormatFixed(const ttmath::Int<Words>& Mantissa, CharType* Buffer, int32 BufferLength)
+	{
+		using FWork = ttmath::UInt<Words + 1>;
+
+		// |Mantissa|, also right for the smallest mantissa, whose opposite doesn't fit in Int<Words>
+		const bool bNegative = Mantissa.IsSign();
+		FWork Magnitude;
+		Magnitude.SetZero();
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			Magnitude.table[i] = bNegative ? ~Mantissa.table[i] : Mantissa.table[i];
+		}
+		if (bNegative)
+		{
+			Magnitude.AddOne();
+		}
+
+		FWork Integer = Magnitude;
+		Integer.Rcr(ttmath::uint(FractionBits));
+		FWork Remainder = Magnitude;
+		KeepLowBits(Remainder, FractionBits);
+
+		// Digits of the fraction, until they are within half a quantum of it: then the parsers round them back to the same value
+		char FractionDigits[FixedChars(0, FractionBits)];
+		int32 NumFractionDigits = 0;
+		if (!Remainder.IsZero())
+		{
+			FWork One;
+			One.SetOne();
+			One.Rcl(ttmath::uint(FractionBits));
+
+			// Remainder / One is what the digits so far are missing, Margin / One a quantum, in units of the last digit
+			FWork Margin;
+			Margin.SetOne();
+			for (;;)
+			{
+				MulWord(Remainder, 10);
+				MulWord(Margin, 10);
+
+				FWork Digit = Remainder;
+				Digit.Rcr(ttmath::uint(FractionBits));
+				KeepLowBits(Remainder, FractionBits);
+				FractionDigits[NumFractionDigits++] = char('0' + Digit.table[0]);
+
+				FWork TwiceRemainder = Remainder;
+				TwiceRemainder.Rcl(1);
+				FWork TwiceRoundUpError = One;
+				TwiceRoundUpError.Sub(Remainder);
+				TwiceRoundUpError.Rcl(1);
+
+				const bool bRoundDown = TwiceRemainder < Margin;
+				const bool bRoundUp = TwiceRoundUpError < Margin;
+				if (bRoundDown || bRoundUp)
+				{
+					if (bRoundUp && (!bRoundDown || One < TwiceRemainder) && IncrementDigits(FractionDigits, NumFractionDigits))
+					{
+						Integer.AddOne();
+					}
+					break;
+				}
+			}
+		}
+		if (NumFractionDigits == 0)
+		{
+			FractionDigits[NumFractionDigits++] = '0';
+		}
+
+		// Digits of the integer part, from the last one
+		char IntegerDigits[FixedChars(Words, 0)];
+		int32 NumIntegerDigits = 0;
+		do
+		{
+			ttmath::uint Digit;
+			Integer.DivInt(10, Digit);
+			IntegerDigits[NumIntegerDigits++] = char('0' + Digit);
+		}
+		while (!Integer.IsZero());
+
+		const int32 Length = (bNegative ? 1 : 0) + NumIntegerDigits + 1 + NumFractionDigits;
+		if (Length >= BufferLength)
+		{
+			if (BufferLength > 0)
+			{
+				Buffer[0] = CharType(0);
+			}
+			return 0;
+		}
+
+		CharType* Cursor = Buffer;
+		if (bNegative)
+		{
+			*Cursor++ = CharType('-');
+		}
+		while (NumIntegerDigits > 0)
+		{
+			*Cursor++ = CharType(IntegerDigits[--NumIntegerDigits]);
+		}
+		*Cursor++ = CharType('.');
+		for (int32 i = 0; i < NumFractionDigits; ++i)
+		{
+			*Cursor++ = CharType(FractionDigits[i]);
+		}
+		*Cursor = CharType(0);
+		return Length;
+	}
+
+	// Parses the short decimals of most texts and tables, [+-]digits[.digits] without exponent, of at most 19 significant digits and as many
+	// fraction digits as a power of 10 in a word, with a 64-bit integer and a division by a word. The mantissa is the same as ParseFixed's.
+	// Returns 0 for the other numbers
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	int32 ParseShortFixed(const CharType* Text, ttmath::Int<Words>& Mantissa)
+	{
+		constexpr int32 WordDigits = TTMATH_BITS_PER_UINT == 64 ? 19 : 9;
+		if (64 + FractionBits >= int32(Words * TTMATH_BITS_PER_UINT) - 1)
+		{
+			return 0;
+		}
+
+		const CharType* Cursor = Text;
+		const bool bNegative = *Cursor == CharType('-');
+		if (*Cursor == CharType('-') || *Cursor == CharType('+'))
+		{
+			++Cursor;
+		}
+
+		uint64 Digits = 0;
+		int32 NumDigits = 0;
+		int32 NumFractionDigits = 0;
+		bool bAnyDigit = false;
+		bool bPoint = false;
+		for (;; ++Cursor)
+		{
+			if (IsDigit(*Cursor))
+			{
+				bAnyDigit = true;
+				NumDigits += NumDigits > 0 || *Cursor != CharType('0') ? 1 : 0;
+				NumFractionDigits += bPoint ? 1 : 0;
+				if (NumDigits > 19 || NumFractionDigits > WordDigits)
+				{
+					return 0;
+				}
+				Digits = Digits * 10 + uint64(*Cursor - CharType('0'));
+			}
+			else if (*Cursor == CharType('.') && !bPoint)
+			{
+				bPoint = true;
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (!bAnyDigit || *Cursor == CharType('e') || *Cursor == CharType('E'))
+		{
+			return 0;
+		}
+
+		// Digits * 2^FractionBits, placed in the words a word of the digits at a time, where Rcl shifts all the words
+		ttmath::UInt<Words>& Result = Mantissa;
+		Result.SetZero();
+		for (int32 Shift = 0; Shift < 64; Shift += int32(TTMATH_BITS_PER_UINT))
+		{
+			const ttmath::uint Piece = ttmath::uint(Digits >> Shift);
+			const int32 Word = (Shift + FractionBits) / int32(TTMATH_BITS_PER_UINT);
+			const int32 Bit = (Shift + FractionBits) % int32(TTMATH_BITS_PER_UINT);
+			Result.table[Word] |= Piece << Bit;
+			if (Bit != 0 && Word + 1 < int32(Words))
+			{
+				Result.table[Word + 1] |= Piece >> (int32(TTMATH_BITS_PER_UINT) - Bit);
+			}
+		}
+
+		if (NumFractionDigits > 0)
+		{
+			ttmath::uint Divisor = 1;
+			for (int32 Digit = 0; Digit < NumFractionDigits; ++Digit)
+			{
+				Divisor *= 10;
+			}
+			ttmath::uint Remainder;
+			Result.DivInt(Divisor, Remainder);
+
+			// Rounded to the nearest, ties to even, with the remainder compared to the rest of the divisor, where twice the remainder would overflow
+			const ttmath::uint Rest = Divisor - Remainder;
+			if (Rest < Remainder || (Rest == Remainder && (Result.table[0] & 1)))
+			{
+				Result.AddOne();
+			}
+		}
+
+		if (bNegative)
+		{
+			Mantissa.ChangeSign();
+		}
+		return int32(Cursor - Text);
+	}
+
+	// Parses a decimal number (see ScanDecimal) into Mantissa = Value * 2^FractionBits, rounded to the nearest, saturated to the largest mantissa.
+	// Returns the number of characters read, or 0 when Text doesn't start with a number, and Mantissa is then 0
+	template<int32 FractionBits, ttmath::uint Words, typename CharType>
+	int32 ParseFixed(const CharType* Text, ttmath::Int<Words>& Mantissa)
+	{
+		constexpr ttmath::uint WorkWords = 2 * Words + 2;
+		using FWork = ttmath::UInt<WorkWords>;
+
+		if (const int32 ShortLength = ParseShortFixed<FractionBits>(Text, Mantissa))
+		{
+			return ShortLength;
+		}
+
+		TDecimal<WorkWords> Decimal;
+		const int32 Length = ScanDecimal(Text, MaxSignificantDigits(Words), Decimal);
+		Mantissa.SetZero();
+		if (Length == 0 || Decimal.Digits.IsZero())
+		{
+			return Length;
+		}
+
+		FWork Result = Decimal.Digits;
+		bool bOverflow = false;
+		if (Decimal.Exponent10 >= 0)
+		{
+			// Larger than any mantissa, or the digits times 10^Exponent10, times 2^FractionBits
+			bOverflow = Decimal.Exponent10 > MaxSignificantDigits(Words) || MulPow10(Result, int32(Decimal.Exponent10))
+				|| BitLength(Result) + FractionBits >= int32(Words * TTMATH_BITS_PER_UINT);
+			Result.Rcl(bOverflow ? 0 : ttmath::uint(FractionBits));
+		}
+		else if (-Decimal.Exponent10 > int64(MaxSignificantDigits(Words)) + FractionBits * 30103 / 100000 + 2)
+		{
+			// Less than half a quantum
+			Result.SetZero();
+		}
+		else
+		{
+			FWork Divisor;
+			Divisor.SetOne();
+			MulPow10(Divisor, int32(-Decimal.Exponent10));
+
+			FWork Remainder;
+			Result.Rcl(ttmath::uint(FractionBits));
+			Result.Div(Divisor, Remainder);
+
+			// Rounded to the nearest, ties to even. The dropped digits only break the ties
+			Remainder.Rcl(1);
+			if (Divisor < Remainder || (Remainder == Divisor && (Decimal.bSticky || (Result.table[0] & 1))))
+			{
+				Result.AddOne();
+			}
+			bOverflow = BitLength(Result) >= int32(Words * TTMATH_BITS_PER_UINT);
+		}
+
+		if (bOverflow)
+		{
+			Mantissa.SetMax();
+		}
+		else
+		{
+			for (ttmath::uint i = 0; i < Words; ++i)
+			{
+				Mantissa.table[i] = Result.table[i];
+			}
+		}
+
+		if (Decimal.bNegative)
+		{
+			Mantissa.ChangeSign();
+		}
+		return Length;
+	}
+
+	// Writes Digits (NumDigits of them, value 0.Digits * 10^PointPosition) like JavaScript writes doubles:
+	// as an integer up to 21 digits, as a decimal down to 0.000001, in scientific notation otherwise
+	template<typename CharType>
+	int32 WriteFloatDigits(bool bNegative, const char* Digits, int32 NumDigits, int64 PointPosition, CharType* Buffer, int32 BufferLength)
+	{
+		// The longest forms are the integers of 21 digits and the scientific notation, exponent included
+		CharType* Cursor = Buffer;
+		const auto Fits = [&](int64 Num)
+		{
+			return (Cursor - Buffer) + Num < BufferLength;
+		};
+		const auto Write = [&](char Char)
+		{
+			*Cursor++ = CharType(Char);
+		};
+
+		if (!Fits(NumDigits + 30))
+		{
+			if (BufferLength > 0)
+			{
+				Buffer[0] = CharType(0);
+			}
+			return 0;
+		}
+
+		if (bNegative)
+		{
+			Write('-');
+		}
+
+		if (PointPosition >= NumDigits && PointPosition <= 21)
+		{
+			for (int32 i = 0; i < NumDigits; ++i)
+			{
+				Write(Digits[i]);
+			}
+			for (int64 i = NumDigits; i < PointPosition; ++i)
+			{
+				Write('0');
+			}
+		}
+		else if (PointPosition > 0 && PointPosition <= 21)
+		{
+			for (int32 i = 0; i < NumDigits; ++i)
+			{
+				if (i == PointPosition)
+				{
+					Write('.');
+				}
+				Write(Digits[i]);
+			}
+		}
+		else if (PointPosition > -6 && PointPosition <= 0)
+		{
+			Write('0');
+			Write('.');
+			for (int64 i = PointPosition; i < 0; ++i)
+			{
+				Write('0');
+			}
+			for (int32 i = 0; i < NumDigits; ++i)
+			{
+				Write(Digits[i]);
+			}
+		}
+		else
+		{
+			Write(Digits[0]);
+			if (NumDigits > 1)
+			{
+				Write('.');
+				for (int32 i = 1; i < NumDigits; ++i)
+				{
+					Write(Digits[i]);
+				}
+			}
+
+			int64 Exponent = PointPosition - 1;
+			Write('e');
+			Write(Exponent < 0 ? '-' : '+');
+			Exponent = Exponent < 0 ? -Exponent : Exponent;
+
+			char ExponentDigits[24];
+			int32 NumExponentDigits = 0;
+			do
+			{
+				ExponentDigits[NumExponentDigits++] = char('0' + Exponent % 10);
+				Exponent /= 10;
+			}
+			while (Exponent != 0);
+			while (NumExponentDigits > 0)
+			{
+				Write(ExponentDigits[--NumExponentDigits]);
+			}
+		}
+
+		*Cursor = CharType(0);
+		return int32(Cursor - Buffer);
+	}
+
+	// Copies a string formatted by ttmath, for the big floats out of the exact range
+	template<typename CharType>
+	int32 WriteAnsi(const std::string& String, CharType* Buffer, int32 BufferLength)
+	{
+		if (int32(String.size()) >= BufferLength)
+		{
+			if (BufferLength > 0)
+			{
+				Buffer[0] = CharType(0);
+			}
+			return 0;
+		}
+
+		for (size_t i = 0; i < String.size(); ++i)
+		{
+			Buffer[i] = CharType(String[i]);
+		}
+		Buffer[String.size()] = CharType(0);
+		return int32(String.size());
+	}
+
+	// Shortest digits of Significand * 2^Exponent, the significand having its highest bit set (Steele & White's free-format algorithm, on integers).
+	// WorkWords must hold max(SignificandBits + max(Exponent, 0), -Exponent) + 16 bits. Returns the number of digits, and the point position
+	template<ttmath::uint WorkWords, ttmath::uint man>
+	int32 ShortestFloatDigits(const ttmath::UInt<man>& Significand, ttmath::sint Exponent, char* Digits, int64& PointPosition)
+	{
+		constexpr int32 SignificandBits = int32(man * TTMATH_BITS_PER_UINT);
+		using FWork = ttmath::UInt<WorkWords>;
+
+		// The value is R / S, and the values between (R - MarginLow) / S and (R + MarginHigh) / S round to it.
+		// The gap below a power of 2 is half the one above
+		bool bPowerOfTwo = Significand.table[man - 1] == TTMATH_UINT_HIGHEST_BIT;
+		for (ttmath::uint i = 0; i + 1 < man; ++i)
+		{
+			bPowerOfTwo = bPowerOfTwo && Significand.table[i] == 0;
+		}
+		const ttmath::uint Extra = bPowerOfTwo ? 2 : 1;
+		const ttmath::uint PositiveExponent = Exponent > 0 ? ttmath::uint(Exponent) : 0;
+		const ttmath::uint NegativeExponent = Exponent < 0 ? ttmath::uint(-Exponent) : 0;
+
+		FWork R, S, MarginHigh, MarginLow;
+		R.SetZero();
+		for (ttmath::uint i = 0; i < man; ++i)
+		{
+			R.table[i] = Significand.table[i];
+		}
+		R.Rcl(PositiveExponent + Extra);
+		S.SetOne();
+		S.Rcl(NegativeExponent + Extra);
+		MarginHigh.SetOne();
+		MarginHigh.Rcl(PositiveExponent + Extra - 1);
+		MarginLow.SetOne();
+		MarginLow.Rcl(PositiveExponent);
+
+		// Point position: 10^(PointPosition - 1) <= Value < 10^PointPosition. This estimate is either right or too small
+		const ttmath::sint HighestBit = Exponent + SignificandBits - 1;
+		PointPosition = int64(std::ceil(double(HighestBit) * 0.30102999566398120 - 1e-9));
+		if (PointPosition >= 0)
+		{
+			MulPow10(S, int32(PointPosition));
+		}
+		else
+		{
+			MulPow10(R, int32(-PointPosition));
+			MulPow10(MarginHigh, int32(-PointPosition));
+			MulPow10(MarginLow, int32(-PointPosition));
+		}
+
+		FWork Sum = R;
+		Sum.Add(MarginHigh);
+		while (S < Sum)
+		{
+			MulWord(S, 10);
+			++PointPosition;
+		}
+
+		// Each digit is found by subtracting 8, 4, 2 and 1 times S
+		FWork MultiplesOfS[4];
+		MultiplesOfS[0] = S;
+		for (int32 i = 1; i < 4; ++i)
+		{
+			MultiplesOfS[i] = MultiplesOfS[i - 1];
+			MultiplesOfS[i].Rcl(1);
+		}
+
+		int32 NumDigits = 0;
+		for (;;)
+		{
+			MulWord(R, 10);
+			MulWord(MarginHigh, 10);
+			if (bPowerOfTwo)
+			{
+				MulWord(MarginLow, 10);
+			}
+			else
+			{
+				MarginLow = MarginHigh;
+			}
+
+			char Digit = '0';
+			for (int32 i = 3; i >= 0; --i)
+			{
+				if (!(R < MultiplesOfS[i]))
+				{
+					R.Sub(MultiplesOfS[i]);
+					Digit += char(1 << i);
+				}
+			}
+			Digits[NumDigits++] = Digit;
+
+			Sum = R;
+			Sum.Add(MarginHigh);
+			const bool bRoundDown = R < MarginLow;
+			const bool bRoundUp = S < Sum;
+			if (bRoundDown || bRoundUp)
+			{
+				FWork TwiceR = R;
+				TwiceR.Rcl(1);
+				if (bRoundUp && (!bRoundDown || S < TwiceR) && IncrementDigits(Digits, NumDigits))
+				{
+					Digits[NumDigits++] = '1';
+					++PointPosition;
+				}
+				return NumDigits;
+			}
+		}
+	}
+
+	// Formats a big float with the shortest digits that parse back to it, see WriteFloatDigits for the notation.
+	// Returns the number of characters written, without the terminating null, or 0 when BufferLength is too small (see FloatChars)
+	template<ttmath::uint exp, ttmath::uint man, typename CharType>
+	int32 FormatFloat(const ttmath::Big<exp, man>& Value, CharType* Buffer, int32 BufferLength)
+	{
+		constexpr int32 SignificandBits = int32(man * TTMATH_BITS_PER_UINT);
+
+		if (Value.IsNan())
+		{
+			return WriteAnsi("NaN", Buffer, BufferLength);
+		}
+		if (Value.IsZero())
+		{
+			return WriteAnsi("0", Buffer, BufferLength);
+		}
+
+		// Value = mantissa * 2^Exponent
+		ttmath::sint Exponent;
+		if (Value.exponent.ToInt(Exponent) || Exponent > ExactExponentBits || Exponent < -ExactExponentBits - SignificandBits)
+		{
+			return WriteAnsi(Value.ToString(), Buffer, BufferLength);
+		}
+
+		// The integers are only as wide as the exponent needs, as every operation goes through all of their words
+		const int64 WorkBits = (Exponent > 0 ? SignificandBits + Exponent : Exponent < -SignificandBits ? -Exponent : SignificandBits) + 16;
+		char Digits[FloatChars(man)];
+		int64 PointPosition;
+		const int32 NumDigits = WorkBits <= int64((man + 1) * TTMATH_BITS_PER_UINT) ? ShortestFloatDigits<man + 1>(Value.mantissa, Exponent, Digits, PointPosition)
+			: WorkBits <= int64((man + 4) * TTMATH_BITS_PER_UINT) ? ShortestFloatDigits<man + 4>(Value.mantissa, Exponent, Digits, PointPosition)
+			: WorkBits <= int64((man + 10) * TTMATH_BITS_PER_UINT) ? ShortestFloatDigits<man + 10>(Value.mantissa, Exponent, Digits, PointPosition)
+			: ShortestFloatDigits<FloatWorkWords<man>()>(Value.mantissa, Exponent, Digits, PointPosition);
+
+		return WriteFloatDigits(Value.IsSign(), Digits, NumDigits, PointPosition, Buffer, BufferLength);
+	}
+
+	// Sets Value to the nearest big float of Significand * 2^Exponent, ties to even, Sticky meaning that the actual significand is a bit larger
+	template<ttmath::uint exp, ttmath::uint man, ttmath::uint Words>
+	void RoundToFloat(ttmath::UInt<Words> Significand, ttmath::sint Exponent, bool bSticky, bool bNegative, ttmath::Big<exp, man>& Value)
+	{
+		constexpr int32 SignificandBits = int32(man * TTMATH_BITS_PER_UINT);
+
+		const int32 Bits = BitLength(Significand);
+		if (Bits > SignificandBits)
+		{
+			const int32 Dropped = Bits - SignificandBits;
+			const bool bAboveHalf = bSticky || HasLowBits(Significand, Dropped - 1);
+			const bool bHalf = Significand.Rcr(ttmath::uint(Dropped)) != 0;
+			Exponent += Dropped;
+
+			if (bHalf && (bAboveHalf || (Significand.table[0] & 1)))
+			{
+				Significand.AddOne();
+				if (BitLength(Significand) > SignificandBits)
+				{
+					Significand.Rcr(1);
+					++Exponent;
+				}
+			}
+		}
+		else
+		{
+			Significand.Rcl(ttmath::uint(SignificandBits - Bits));
+			Exponent -= SignificandBits - Bits;
+		}
+
+		for (ttmath::uint i = 0; i < man; ++i)
+		{
+			Value.mantissa.table[i] = Significand.table[i];
+		}
+		Value.exponent = Exponent;
+		Value.info = bNegative ? TTMATH_BIG_SIGN : 0;
+	}
+
+	// Rounds Digits * 10^Exponent10 to Value, with integers of WorkWords words, that must hold DigitBits + BitLength(10^|Exponent10|) + SignificandBits + 4 bits
+	template<ttmath::uint WorkWords, ttmath::uint DigitWords, ttmath::uint exp, ttmath::uint man>
+	void DecimalToFloat(const TDecimal<DigitWords>& Decimal, ttmath::Big<exp, man>& Value)
+	{
+		constexpr int32 SignificandBits = int32(man * TTMATH_BITS_PER_UINT);
+		using FWork = ttmath::UInt<WorkWords>;
+
+		FWork Significand;
+		Significand.SetZero();
+		for (ttmath::uint i = 0; i < DigitWords; ++i)
+		{
+			Significand.table[i] = Decimal.Digits.table[i];
+		}
+
+		if (Decimal.Exponent10 >= 0)
+		{
+			MulPow10(Significand, int32(Decimal.Exponent10));
+			RoundToFloat(Significand, 0, Decimal.bSticky, Decimal.bNegative, Value);
+			return;
+		}
+
+		// The quotient of the digits by 10^-Exponent10 needs 2 bits more than the significand, to be rounded
+		const int32 DigitBits = BitLength(Decimal.Digits);
+		const int32 DivisorBits = Pow10BitLength(int32(-Decimal.Exponent10));
+		const int32 Shift = DivisorBits + SignificandBits + 2 > DigitBits ? DivisorBits + SignificandBits + 2 - DigitBits : 0;
+
+		FWork Divisor;
+		Divisor.SetOne();
+		MulPow10(Divisor, int32(-Decimal.Exponent10));
+
+		FWork Remainder;
+		Significand.Rcl(ttmath::uint(Shift));
+		Significand.Div(Divisor, Remainder);
+		RoundToFloat(Significand, -Shift, Decimal.bSticky || !Remainder.IsZero(), Decimal.bNegative, Value);
+	}
+
+	// Parses a decimal number (see ScanDecimal) into the nearest big float, ties to even. Numbers of more than MaxSignificantDigits digits
+	// are rounded as if cut there, which only matters when they are within 10^-20 units in the last place of a tie.
+	// NaN, as written by FormatFloat, is also read.
+	// Returns the number of characters read, or 0 when Text doesn't start with a number, and Value is then 0
+	template<ttmath::uint exp, ttmath::uint man, typename CharType>
+	int32 ParseFloat(const CharType* Text, ttmath::Big<exp, man>& Value)
+	{
+		constexpr ttmath::uint DigitWords = man + 2;
+		constexpr int32 SignificandBits = int32(man * TTMATH_BITS_PER_UINT);
+
+		if (Text[0] == CharType('N') && Text[1] == CharType('a') && Text[2] == CharType('N'))
+		{
+			Value.SetNan();
+			return 3;
+		}
+
+		TDecimal<DigitWords> Decimal;
+		const int32 Length = ScanDecimal(Text, MaxSignificantDigits(man), Decimal);
+		Value.SetZero();
+		if (Length == 0 || Decimal.Digits.IsZero())
+		{
+			return Length;
+		}
+
+		// The integers are only as wide as the exponent needs, leaving the highest bit free for the division
+		const int64 Exponent10 = Decimal.Exponent10 < 0 ? -Decimal.Exponent10 : Decimal.Exponent10;
+		const int64 WorkBits = Exponent10 < ExactExponentBits ? BitLength(Decimal.Digits) + Pow10BitLength(int32(Exponent10)) + SignificandBits + 6 : INT64_MAX;
+		if (WorkBits <= int64((man + 4) * TTMATH_BITS_PER_UINT))
+		{
+			DecimalToFloat<man + 4>(Decimal, Value);
+			return Length;
+		}
+		if (WorkBits <= int64((man + 10) * TTMATH_BITS_PER_UINT))
+		{
+			DecimalToFloat<man + 10>(Decimal, Value);
+			return Length;
+		}
+		if (WorkBits <= int64(FloatWorkWords<man>() * TTMATH_BITS_PER_UINT))
+		{
+			DecimalToFloat<FloatWorkWords<man>()>(Decimal, Value);
+			return Length;
+		}
+
+		// Out of the exact range: ttmath parses the significant digits
+		char Fallback[FloatChars(man) + 64];
+		char Reversed[FloatChars(man) + 32];
+		int32 NumReversed = 0;
+		ttmath::UInt<DigitWords> Digits = Decimal.Digits;
+		while (!Digits.IsZero())
+		{
+			ttmath::uint Digit;
+			Digits.DivInt(10, Digit);
+			Reversed[NumReversed++] = char('0' + Digit);
+		}
+
+		int32 FallbackLength = 0;
+		if (Decimal.bNegative)
+		{
+			Fallback[FallbackLength++] = '-';
+		}
+		while (NumReversed > 0)
+		{
+			Fallback[FallbackLength++] = Reversed[--NumReversed];
+		}
+		std::snprintf(Fallback + FallbackLength, sizeof(Fallback) - FallbackLength, "e%lld", (long long)Decimal.Exponent10);
+		Value.FromString(Fallback);
+		return Length;
+	}
+
+	template<typename CharType>
+	int32 SkipBlanks(const CharType* Text)
+	{
+		int32 Length = 0;
+		while (Text[Length] == CharType(' ') || Text[Length] == CharType('\t'))
+		{
+			++Length;
+		}
+		return Length;
+	}
+
+	// Reads a number as exported by ExportTextItem, (number), or bare, with Parse(Text), that returns the number of characters it read (ParseFixed, ParseFloat).
+	// Only the token is scanned, so that importing many numbers from one buffer is linear in its length.
+	// Returns the number of characters read, parentheses included, or 0 when Text doesn't start with a number, or its parenthesis isn't closed after it
+	template<typename CharType, typename ParserType>
+	int32 ParseToken(const CharType* Text, ParserType&& Parse)
+	{
+		if (Text[0] != CharType('('))
+		{
+			return Parse(Text);
+		}
+
+		int32 Length = 1 + SkipBlanks(Text + 1);
+		const int32 NumberLength = Parse(Text + Length);
+		if (NumberLength == 0)
+		{
+			return 0;
+		}
+		Length += NumberLength;
+		Length += SkipBlanks(Text + Length);
+		return Text[Length] == CharType(')') ? Length + 1 : 0;
+	}
+}
@@ -0,0 +1,279 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+
+#include "HAL/Platform.h"
+
+// Delta encoding of keyframe tracks of fixed-point values (trajectories, hitbox sweeps), for TPrecisionKeyframeTrack.
+// A key is NumValues mantissas, its time first. Each value is written as its difference to the same value of the previous key, modulo
+// 2^MantissaBits, zigzag encoded (0, -1, 1, -2...) and written 7 bits at a time, lowest first, each group followed by a bit telling whether
+// another one follows. So values that change by less than 64 quanta from key to key take a byte.
+// Every SeekInterval keys, the key is written whole (as its difference to zeros), and a seek point keeps its time and offset: finding the keys
+// around a time is a binary search of the seek points, then the decoding of at most SeekInterval keys.
+namespace PrecisionTrack
+{
+	constexpr int32 SeekInterval = 16;
+
+	// Version of the layout of the tracks in archives, written in front of them
+	constexpr uint8 FormatVersion = 1;
+
+	// (Delta << 1) for positive differences, (~Delta << 1) | 1 for negative ones
+	template<ttmath::uint Words>
+	ttmath::UInt<Words> ZigZag(const ttmath::Int<Words>& Delta)
+	{
+		ttmath::UInt<Words> Result = Delta;
+		const bool bNegative = Delta.IsSign();
+		if (bNegative)
+		{
+			Result.BitNot();
+		}
+		Result.Rcl(1, bNegative ? 1 : 0);
+		return Result;
+	}
+
+	template<ttmath::uint Words>
+	ttmath::Int<Words> UnZigZag(ttmath::UInt<Words> Value)
+	{
+		const bool bNegative = (Value.table[0] & 1) != 0;
+		Value.Rcr(1);
+		if (bNegative)
+		{
+			Value.BitNot();
+		}
+		ttmath::Int<Words> Result;
+		for (ttmath::uint i = 0; i < Words; ++i)
+		{
+			Result.table[i] = Value.table[i];
+		}
+		return Result;
+	}
+
+	// ByteArrayType needs Append(const uint8* Data, Num), like TArray<uint8>
+	template<ttmath::uint Words, typename ByteArrayType>
+	void WriteVarUInt(ByteArrayType& Bytes, ttmath::UInt<Words> Value)
+	{
+		uint8 Buffer[(Words * TTMATH_BITS_PER_UINT + 6) / 7];
+		int32 Num = 0;
+		uint8 Group;
+		do
+		{
+			Group = uint8(Value.table[0] & 0x7f);
+			Value.Rcr(7);
+			if (!Value.IsZero())
+			{
+				Group |= 0x80;
+			}
+			Buffer[Num++] = Group;
+		}
+		while (Group & 0x80);
+		Bytes.Append(Buffer, Num);
+	}
+
+	// Returns false when the data is truncated, or longer than the integer
+	template<ttmath::uint Words>
+	bool ReadVarUInt(const uint8*& Cursor, const uint8* End, ttmath::UInt<Words>& OutValue)
+	{
+		OutValue.SetZero();
+		for (int32 Shift = 0; Shift < int32(Words * TTMATH_BITS_PER_UINT); Shift += 7)
+		{
+			if (Cursor == End)
+			{
+				return false;
+			}
+			const uint8 Group = *Cursor++;
+			const uint64 Bits = Group & 0x7f;
+			const int32 Word = Shift / int32(TTMATH_BITS_PER_UINT);
+			const int32 Bit = Shift % int32(TTMATH_BITS_PER_UINT);
+			OutValue.table[Word] |= ttmath::uint(Bits << Bit);
+			if (Bit + 7 > int32(TTMATH_BITS_PER_UINT) && Word + 1 < int32(Words))
+			{
+				OutValue.table[Word + 1] |= ttmath::uint(Bits >> (int32(TTMATH_BITS_PER_UINT) - Bit));
+			}
+			if (!(Group & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Writes Key, as its differences to Previous, or whole when Previous is null
+	template<ttmath::uint Words, typename ByteArrayType>
+	void WriteKey(ByteArrayType& Bytes, const ttmath::Int<Words>* Key, const ttmath::Int<Words>* Previous, int32 NumValues)
+	{
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			ttmath::Int<Words> Delta = Key[Value];
+			if (Previous)
+			{
+				static_cast<ttmath::UInt<Words>&>(Delta).Sub(Previous[Value]);
+			}
+			WriteVarUInt(Bytes, ZigZag(Delta));
+		}
+	}
+
+	// Reads the key after InOutKey, or a whole key when bWhole. Returns false when the data is malformed
+	template<ttmath::uint Words>
+	bool ReadKey(const uint8*& Cursor, const uint8* End, ttmath::Int<Words>* InOutKey, int32 NumValues, bool bWhole)
+	{
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			ttmath::UInt<Words> Encoded;
+			if (!ReadVarUInt(Cursor, End, Encoded))
+			{
+				return false;
+			}
+			const ttmath::Int<Words> Delta = UnZigZag(Encoded);
+			if (bWhole)
+			{
+				InOutKey[Value] = Delta;
+			}
+			else
+			{
+				static_cast<ttmath::UInt<Words>&>(InOutKey[Value]).Add(Delta);
+			}
+		}
+		return true;
+	}
+
+	template<ttmath::uint Words>
+	struct TSeekPoint
+	{
+		ttmath::Int<Words> Time;
+		int64 Offset = 0;
+	};
+
+	// Whether loaded seek points can be seeked: their offsets are inside the NumBytes of the keys, in order, and their times increase
+	template<ttmath::uint Words>
+	bool AreSeekPointsValid(const TSeekPoint<Words>* SeekPoints, int32 NumSeekPoints, int64 NumBytes)
+	{
+		for (int32 Point = 0; Point < NumSeekPoints; ++Point)
+		{
+			if (SeekPoints[Point].Offset < 0 || SeekPoints[Point].Offset > NumBytes)
+			{
+				return false;
+			}
+			if (Point > 0 && (!(SeekPoints[Point - 1].Time < SeekPoints[Point].Time) || SeekPoints[Point].Offset <= SeekPoints[Point - 1].Offset))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Keys around the last sampled time. Playing a track forward from a cursor only decodes the keys it goes past
+	template<ttmath::uint Words, int32 NumValues>
+	struct TCursor
+	{
+		// Index of Current, the last key at or before the time, or the first key when the time is before it. -1 until the first seek
+		int32 Key = -1;
+		ttmath::Int<Words> Current[NumValues];
+
+		// Key after Current, when Key isn't the last one, and the offset of the key after it
+		bool bHasNext = false;
+		ttmath::Int<Words> Next[NumValues];
+		int64 NextOffset = 0;
+
+		void Reset()
+		{
+			Key = -1;
+		}
+	};
+
+	// Moves Cursor to the keys around Time, in a track of NumKeys keys (at least 1) written with a seek point every SeekInterval keys.
+	// Returns false when the data is malformed, and the cursor is then reset
+	template<ttmath::uint Words, int32 NumValues>
+	bool Seek(const uint8* Bytes, int64 NumBytes, int32 NumKeys, const TSeekPoint<Words>* SeekPoints, const ttmath::Int<Words>& Time,
+		TCursor<Words, NumValues>& Cursor)
+	{
+		const uint8* End = Bytes + NumBytes;
+
+		// Reads the key after Next, which becomes Current
+		const auto Step = [&]()
+		{
+			for (int32 Value = 0; Value < NumValues; ++Value)
+			{
+				Cursor.Current[Value] = Cursor.Next[Value];
+			}
+			++Cursor.Key;
+			Cursor.bHasNext = Cursor.Key + 1 < NumKeys;
+			if (!Cursor.bHasNext)
+			{
+				return true;
+			}
+			const bool bWhole = (Cursor.Key + 1) % SeekInterval == 0;
+			const uint8* Read = Bytes + Cursor.NextOffset;
+			if (!ReadKey(Read, End, Cursor.Next, NumValues, bWhole))
+			{
+				return false;
+			}
+			Cursor.NextOffset = Read - Bytes;
+			return true;
+		};
+
+		// Forward from the cursor, for monotonic playback, if the time is at most a seek interval away
+		if (Cursor.Key >= 0 && !(Time < Cursor.Current[0]))
+		{
+			for (int32 Steps = 0; Cursor.bHasNext && !(Time < Cursor.Next[0]); ++Steps)
+			{
+				if (Steps == SeekInterval)
+				{
+					break;
+				}
+				if (!Step())
+				{
+					Cursor.Reset();
+					return false;
+				}
+			}
+			if (!Cursor.bHasNext || Time < Cursor.Next[0])
+			{
+				return true;
+			}
+		}
+
+		// Last seek point at or before the time, or the first one
+		const int32 NumSeekPoints = (NumKeys + SeekInterval - 1) / SeekInterval;
+		int32 Low = 0;
+		int32 High = NumSeekPoints;
+		while (High - Low > 1)
+		{
+			const int32 Middle = (Low + High) / 2;
+			if (Time < SeekPoints[Middle].Time)
+			{
+				High = Middle;
+			}
+			else
+			{
+				Low = Middle;
+			}
+		}
+
+		// Decodes the key of the seek point into Next, to step to it
+		const uint8* Read = Bytes + SeekPoints[Low].Offset;
+		if (SeekPoints[Low].Offset < 0 || SeekPoints[Low].Offset > NumBytes || !ReadKey(Read, End, Cursor.Next, NumValues, true))
+		{
+			Cursor.Reset();
+			return false;
+		}
+		Cursor.NextOffset = Read - Bytes;
+		Cursor.Key = Low * SeekInterval - 1;
+		if (!Step())
+		{
+			Cursor.Reset();
+			return false;
+		}
+		while (Cursor.bHasNext && !(Time < Cursor.Next[0]))
+		{
+			if (!Step())
+			{
+				Cursor.Reset();
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,36 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Include ttmath, with the fastest limb backend (add with carry, word multiplication and division) the compiler supports.
+// Every backend gives the same results, bit for bit, see Standalone/Determinism.
+
+// Portable C++, ttmathuint_noasm.h as is
+#define SPACEKITPRECISION_TTMATH_PORTABLE 0
+// ttmathuint_noasm.h with compiler intrinsics for the word operations: unsigned __int128 on GCC and Clang, _addcarry_u64, _umul128 and _udiv128 on MSVC
+#define SPACEKITPRECISION_TTMATH_INTRINSICS 1
+// ttmathuint_x86_64.h GCC inline assembly. Not available on MSVC, where ttmath would need ttmathuint_x86_64_msvc.asm to be linked, which UBT doesn't do
+#define SPACEKITPRECISION_TTMATH_ASM 2
+
+// Backend of ttmath. Default is the inline assembly on GCC and Clang for x86-64, and the intrinsics wherever they exist
+#ifndef SPACEKITPRECISION_TTMATH_BACKEND
+	#if defined(__GNUC__) && defined(__x86_64__)
+		#define SPACEKITPRECISION_TTMATH_BACKEND SPACEKITPRECISION_TTMATH_ASM
+	#elif (defined(_MSC_VER) && _MSC_VER >= 1920 && defined(_M_X64)) || defined(__SIZEOF_INT128__)
+		#define SPACEKITPRECISION_TTMATH_BACKEND SPACEKITPRECISION_TTMATH_INTRINSICS
+	#else
+		#define SPACEKITPRECISION_TTMATH_BACKEND SPACEKITPRECISION_TTMATH_PORTABLE
+	#endif
+#endif
+
+#if SPACEKITPRECISION_TTMATH_BACKEND != SPACEKITPRECISION_TTMATH_ASM
+	#define TTMATH_NOASM
+#endif
+#if SPACEKITPRECISION_TTMATH_BACKEND == SPACEKITPRECISION_TTMATH_INTRINSICS
+	#define TTMATH_NOASM_INTRINSICS
+#endif
+
+#pragma warning(push)
+#pragma warning(disable: 5051)
+#include "SpaceKitPrecision/Private/ttmath/ttmath.h"
+#pragma warning(pop)
@@ -3,27 +3,28 @@
 
 #include "SpaceKitPrecision/Public/QuatFixed.h"
 #include "SpaceKitPrecision/Public/RotatorFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionScalarKernels.h"
 
 FQuatFixed FQuatFixed::Identity = FQuatFixed();
 
-FQuatFixed::FQuatFixed(const FRotatorFixed& Rotator)
+namespace
 {
-    const FRealFixed Half(FRealFixed("0.5"));
-    const FRealFixed HalfRadPitch = URealFixedMath::DegreesToRadians(Rotator.Pitch * Half);
-    const FRealFixed HalfRadYaw   = URealFixedMath::DegreesToRadians(Rotator.Yaw   * Half);
-    const FRealFixed HalfRadRoll  = URealFixedMath::DegreesToRadians(Rotator.Roll  * Half);
+    // Components computed by the kernels on the raw fixed-point values, as FQuatFixed only takes FRealFixed
+    struct FQuatFixedComponents
+    {
+        real_fixed_type X, Y, Z, W;
 
-    const FRealFixed SinP = URealFixedMath::SinRad(HalfRadPitch);
-    const FRealFixed CosP = URealFixedMath::CosRad(HalfRadPitch);
-    const FRealFixed SinY = URealFixedMath::SinRad(HalfRadYaw);
-    const FRealFixed CosY = URealFixedMath::CosRad(HalfRadYaw);
-    const FRealFixed SinR = URealFixedMath::SinRad(HalfRadRoll);
-    const FRealFixed CosR = URealFixedMath::CosRad(HalfRadRoll);
+        FQuatFixedComponents(const real_fixed_type& InX, const real_fixed_type& InY, const real_fixed_type& InZ, const real_fixed_type& InW)
+            : X(InX), Y(InY), Z(InZ), W(InW)
+        {
+        }
+    };
+}
 
-	W = CosR * CosP * CosY + SinR * SinP * SinY;
-	X = SinR * CosP * CosY - CosR * SinP * SinY;
-	Y = CosR * SinP * CosY + SinR * CosP * SinY;
-	Z = CosR * CosP * SinY - SinR * SinP * CosY;
+FQuatFixed::FQuatFixed(const FRotatorFixed& Rotator)
+{
+    const FQuatFixedComponents Quat = PrecisionScalar::QuatFromRotator<FQuatFixedComponents>(Rotator.Pitch.Value, Rotator.Yaw.Value, Rotator.Roll.Value);
+    *this = FQuatFixed(FRealFixed(Quat.X), FRealFixed(Quat.Y), FRealFixed(Quat.Z), FRealFixed(Quat.W));
 }
 
 FQuatFixed::FQuatFixed(const FVectorFixed& Axis, const FRealFixed& AngleDeg)
@@ -61,13 +62,7 @@ FQuatFixed FQuatFixed::GetNormalized(const FRealFixed& Tolerance) const
 
 FQuatFixed FQuatFixed::operator*(const FQuatFixed& Other) const
 {
-    // Standard Hamiltonian product
-    return FQuatFixed(
-        (W * Other.X) + (X * Other.W) + (Y * Other.Z) - (Z * Other.Y),
-        (W * Other.Y) - (X * Other.Z) + (Y * Other.W) + (Z * Other.X),
-        (W * Other.Z) + (X * Other.Y) - (Y * Other.X) + (Z * Other.W),
-        (W * Other.W) - (X * Other.X) - (Y * Other.Y) - (Z * Other.Z)
-    );
+    return PrecisionGeometry::QuatMultiply(*this, Other);
 }
 
 bool FQuatFixed::Equals(const FQuatFixed& Other, const FRealFixed& Tolerance) const
@@ -1,6 +1,7 @@
 // Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
 
 #include "SpaceKitPrecision/Public/QuatFloat.h"
+#include "SpaceKitPrecision/Public/RotationMatrixFloat.h"
 #include "SpaceKitPrecision/Public/RotatorFloat.h"
 
 FQuatFloat FQuatFloat::Identity = FQuatFloat();
@@ -98,3 +99,48 @@ FQuatFloat UQuatFloatMath::Slerp(FQuatFloat First, FQuatFloat Second, const FRea
         (s0 * First.W) + (s1 * Second.W)
     );
 }
+
+FRotationMatrixFloat FQuatFloat::ToMatrix() const
+{
+    return FRotationMatrixFloat(*this);
+}
+
+void FQuatFloat::RotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+    ToMatrix().RotateVectors(Vectors);
+}
+
+void FQuatFloat::UnrotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+    ToMatrix().UnrotateVectors(Vectors);
+}
+
+TArray<FVectorFloat> UQuatFloatMath::RotateVectors(const FQuatFloat& Quat, const TArray<FVectorFloat>& Vectors, bool bParallel)
+{
+    TArray<FVectorFloat> Result = Vectors;
+    const FRotationMatrixFloat Matrix = Quat.ToMatrix();
+    if (bParallel)
+    {
+        Matrix.ParallelRotateVectors(Result);
+    }
+    else
+    {
+        Matrix.RotateVectors(Result);
+    }
+    return Result;
+}
+
+TArray<FVectorFloat> UQuatFloatMath::UnrotateVectors(const FQuatFloat& Quat, const TArray<FVectorFloat>& Vectors, bool bParallel)
+{
+    TArray<FVectorFloat> Result = Vectors;
+    const FRotationMatrixFloat Matrix = Quat.ToMatrix();
+    if (bParallel)
+    {
+        Matrix.ParallelUnrotateVectors(Result);
+    }
+    else
+    {
+        Matrix.UnrotateVectors(Result);
+    }
+    return Result;
+}
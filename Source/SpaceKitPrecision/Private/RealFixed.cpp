@@ -1,7 +1,11 @@
 // Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
 
 #include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Public/PrecisionStats.h"
 #include "RealFloat.h"
+#include "SpaceKitPrecision/Private/PrecisionNetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionScalarKernels.h"
 
 
 FRealFixed::FRealFixed()
@@ -60,9 +64,16 @@ FRealFixed::FRealFixed(const std::string& InValue)
 FRealFixed::FRealFixed(const FString& InValue)
     : Value(*reinterpret_cast<real_fixed_type*>(InternalValue))
 {
+    SPACEKITPRECISION_SCOPE(StringImport);
     Value = InValue;
 }
 
+FRealFixed::FRealFixed(const FRealFloat& InValue)
+    : Value(*reinterpret_cast<real_fixed_type*>(InternalValue))
+{
+    Value = real_fixed_type::FromBigRounded(InValue.Value);
+}
+
 // Converts this number to a double number. Note that this can lead to huge precision loss
 double FRealFixed::ToDouble() const
 {
@@ -78,34 +89,67 @@ float FRealFixed::ToFloat() const
 // Converts this number to a floating-point big number. This may not lead to precision loss
 real_fixed_type::ttBigType FRealFixed::ToBig() const
 {
+    SPACEKITPRECISION_SCOPE(ToBig);
     return Value.ToBig();
 }
 
 FString FRealFixed::ToString() const
 {
+    SPACEKITPRECISION_SCOPE(StringExport);
     return Value.ToString();
 }
 
+int32 FRealFixed::ToChars(TCHAR* Buffer, int32 BufferLength) const
+{
+    SPACEKITPRECISION_SCOPE(StringExport);
+    return Value.ToChars(Buffer, BufferLength);
+}
+
+int32 FRealFixed::FromChars(const TCHAR* Text, FRealFixed& OutValue)
+{
+    SPACEKITPRECISION_SCOPE(StringImport);
+    return real_fixed_type::FromChars(Text, OutValue.Value);
+}
+
 bool FRealFixed::ExportTextItem(FString& ValueStr, FRealFixed const& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
 {
-    ValueStr += FString::Printf(TEXT("(%s)"), *ToString());
+    TCHAR Chars[MaxChars];
+    const int32 Length = ToChars(Chars, MaxChars);
+    ValueStr += TEXT("(");
+    ValueStr.AppendChars(Chars, Length);
+    ValueStr += TEXT(")");
     return true;
 }
 
 bool FRealFixed::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
 {
-    FString MutableString = Buffer;
-    const int32 Len = MutableString.Find(")") + 1;
-    Buffer += Len;
+    SPACEKITPRECISION_SCOPE(StringImport);
 
-    MutableString = MutableString.Left(Len);
-    MutableString.RemoveFromStart("(");
-    MutableString.RemoveFromEnd(")");
+    // Parses in place, from the buffer of the whole import, reading only the (number) token
+    real_fixed_type Parsed;
+    const int32 Length = PrecisionText::ParseToken(Buffer, [&Parsed](const TCHAR* Text) { return real_fixed_type::FromChars(Text, Parsed); });
+    if (Length == 0)
+    {
+        return false;
+    }
 
-    Value = MutableString;
+    Value = Parsed;
+    Buffer += Length;
     return true;
 }
 
+bool FRealFixed::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    bOutSuccess = PrecisionNet::SerializeMantissa<0>(Ar, Value.mantissa);
+    return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FRealFixed& Real)
+{
+    PrecisionBinary::SerializeInt(Ar, Real.Value.mantissa);
+    return Ar;
+}
+
 
 // Conversions
 
@@ -190,21 +234,25 @@ bool URealFixedMath::RealSupEqReal(const FRealFixed& First, const FRealFixed& Se
 
 FRealFixed URealFixedMath::Sqrt(const FRealFixed& Val)
 {
-    return FRealFixed(ttmath::Sqrt((Val.ToBig())));
+    SPACEKITPRECISION_SCOPE(Sqrt);
+    return FRealFixed(PrecisionScalar::Sqrt(Val.Value));
 }
 
 FRealFixed URealFixedMath::LogE(const FRealFixed& Val)
 {
+    SPACEKITPRECISION_SCOPE(ExpLog);
     return FRealFixed(ttmath::Ln(Val.ToBig()));
 }
 
 FRealFixed URealFixedMath::Log2(const FRealFixed& Val)
 {
+    SPACEKITPRECISION_SCOPE(ExpLog);
     return FRealFixed(ttmath::Log(Val.ToBig(), real_fixed_type::ttBigType(2)));
 }
 
 FRealFixed URealFixedMath::Log10(const FRealFixed& Val)
 {
+    SPACEKITPRECISION_SCOPE(ExpLog);
     return FRealFixed(ttmath::Log(Val.ToBig(), real_fixed_type::ttBigType(10)));
 }
 
@@ -309,16 +357,19 @@ FRealFixed URealFixedMath::NormalizeAngleDeg(const FRealFixed& InVal)
 
 FRealFixed URealFixedMath::SinRad(const FRealFixed& InVal)
 {
-    return FRealFixed(ttmath::Sin(InVal.ToBig()));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFixed(PrecisionScalar::SinRad(InVal.Value));
 }
 
 FRealFixed URealFixedMath::CosRad(const FRealFixed& InVal)
 {
-    return FRealFixed(ttmath::Cos(InVal.ToBig()));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFixed(PrecisionScalar::CosRad(InVal.Value));
 }
 
 FRealFixed URealFixedMath::TanRad(const FRealFixed& InVal)
 {
+    SPACEKITPRECISION_SCOPE(Trig);
     return FRealFixed(ttmath::Tan(InVal.ToBig()));
 }
 
@@ -342,16 +393,19 @@ FRealFixed URealFixedMath::TanDeg(const FRealFixed& InVal)
 
 FRealFixed URealFixedMath::AsinRad(const FRealFixed& InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFixed(ttmath::ASin(InVal.ToBig()));
 }
 
 FRealFixed URealFixedMath::AcosRad(const FRealFixed& InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFixed(ttmath::ACos(InVal.ToBig()));
 }
 
 FRealFixed URealFixedMath::AtanRad(const FRealFixed& InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFixed(ttmath::ATan(InVal.ToBig()));
 }
 
@@ -391,11 +445,13 @@ FRealFixed URealFixedMath::Atan2Deg(const FRealFixed& Y, const FRealFixed& X)
 
 FRealFixed URealFixedMath::Pow(const FRealFixed& Base, const FRealFixed& Exp)
 {
+    SPACEKITPRECISION_SCOPE(ExpLog);
     // a^b = e^(b*ln(a))
     return FRealFixed(ttmath::Exp(Exp.Value.ToBig() * ttmath::Ln(Base.Value.ToBig())));
 }
 
 FRealFixed URealFixedMath::Exp(const FRealFixed& Val)
 {
+    SPACEKITPRECISION_SCOPE(ExpLog);
     return FRealFixed(ttmath::Exp(Val.ToBig()));
 }
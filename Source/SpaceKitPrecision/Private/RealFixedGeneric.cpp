@@ -1,5 +1,9 @@
 // Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
 
-// This file's only purpose is to include RealFixedGeneric.h, so it's systematically included, and checked for errors. Otherwise, it might not be included anywhere.
+// This file includes RealFixedGeneric.h, so it's systematically included, and checked for errors. Otherwise, it might not be included anywhere.
+// It also holds the only instantiation of real_fixed_type that the modules using the plugin link to, see SPACEKITPRECISION_EXTERN_TEMPLATES.
 
 #include "SpaceKitPrecision/Public/RealFixedGeneric.h"
+#include "SpaceKitPrecision/Public/PrecisionSettings.h"
+
+SPACEKITPRECISION_REAL_FIXED_INSTANTIATIONS(template)
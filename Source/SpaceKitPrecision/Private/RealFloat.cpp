@@ -5,6 +5,12 @@
 
 #include "SpaceKitPrecision/SpaceKitPrecision.h"
 #include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Public/PrecisionBudget.h"
+#include "SpaceKitPrecision/Public/PrecisionStats.h"
+#include "SpaceKitPrecision/Public/RealFloatAccumulator.h"
+#include "SpaceKitPrecision/Private/PrecisionBudgetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionScalarKernels.h"
 
 
 FRealFloat::FRealFloat()
@@ -54,23 +60,32 @@ FRealFloat::FRealFloat(double InValue)
 
 FRealFloat::FRealFloat(const char* InValue)
 {
-    Value = ttBigType(InValue);
+    PrecisionText::ParseFloat(InValue, Value);
 }
 
 FRealFloat::FRealFloat(const std::string& InValue)
 {
-	if (IsFloat(FString(InValue.c_str())))
-	{
-	    Value = ttBigType(InValue.c_str());
+    // The whole string must be a number, or this is 0
+    const int32 Length = PrecisionText::ParseFloat(InValue.c_str(), Value);
+    if (Length == 0 || Length != int32(InValue.size()))
+    {
+        Value.SetZero();
     }
 }
 
 FRealFloat::FRealFloat(const FString& InValue)
 {
-	if (IsFloat(InValue))
+	SPACEKITPRECISION_SCOPE(StringImport);
+	const int32 Length = PrecisionText::ParseFloat(*InValue, Value);
+	if (Length == 0 || Length != InValue.Len())
 	{
-		Value = ttBigType(TCHAR_TO_ANSI(*InValue));
-    }
+		Value.SetZero();
+	}
+}
+
+FRealFloat::FRealFloat(const FRealFixed& InValue)
+{
+    Value = InValue.Value.ToBigExact<ttBigType>();
 }
 
 static FRealFloat::ttBigType GenPi()
@@ -101,29 +116,61 @@ float FRealFloat::ToFloat() const
 
 FString FRealFloat::ToString() const
 {
-    return Value.ToString().c_str();
+    SPACEKITPRECISION_SCOPE(StringExport);
+    TCHAR Chars[MaxChars];
+    PrecisionText::FormatFloat(Value, Chars, MaxChars);
+    return FString(Chars);
+}
+
+int32 FRealFloat::ToChars(TCHAR* Buffer, int32 BufferLength) const
+{
+    SPACEKITPRECISION_SCOPE(StringExport);
+    return PrecisionText::FormatFloat(Value, Buffer, BufferLength);
+}
+
+int32 FRealFloat::FromChars(const TCHAR* Text, FRealFloat& OutValue)
+{
+    SPACEKITPRECISION_SCOPE(StringImport);
+    return PrecisionText::ParseFloat(Text, OutValue.Value);
 }
 
 bool FRealFloat::ExportTextItem(FString& ValueStr, FRealFloat const& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const
 {
-    ValueStr += FString::Printf(TEXT("(%s)"), *ToString());
+    TCHAR Chars[MaxChars];
+    const int32 Length = ToChars(Chars, MaxChars);
+    ValueStr += TEXT("(");
+    ValueStr.AppendChars(Chars, Length);
+    ValueStr += TEXT(")");
     return true;
 }
 
 bool FRealFloat::ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText)
 {
-    FString MutableString = Buffer;
-    const int32 Len = MutableString.Find(")") + 1;
-    Buffer += Len;
+    SPACEKITPRECISION_SCOPE(StringImport);
 
-    MutableString = MutableString.Left(Len);
-    MutableString.RemoveFromStart("(");
-    MutableString.RemoveFromEnd(")");
+    // Parses in place, from the buffer of the whole import, reading only the (number) token
+    ttBigType Parsed;
+    const int32 Length = PrecisionText::ParseToken(Buffer, [&Parsed](const TCHAR* Text) { return PrecisionText::ParseFloat(Text, Parsed); });
+    if (Length == 0)
+    {
+        return false;
+    }
 
-    *this = FRealFloat(MutableString);
+    Value = Parsed;
+    Buffer += Length;
     return true;
 }
 
+FArchive& operator<<(FArchive& Ar, FRealFloat& Real)
+{
+#if USE_BOOST_BIG
+    Ar.Serialize(&Real.Value, sizeof(FRealFloat::ttBigType));
+#else
+    PrecisionBinary::SerializeBig(Ar, Real.Value);
+#endif
+    return Ar;
+}
+
 FRealFloat FRealFloat::GetMaxValue()
 {
     return 0.00000000001_fl;
@@ -221,17 +268,20 @@ FRealFloat URealFloatMath::NormalizeAngleRad(FRealFloat InVal)
 
 FRealFloat URealFloatMath::SinRad(FRealFloat InVal)
 {
-	return FRealFloat(ttmath::Sin(InVal.Value));
+	SPACEKITPRECISION_SCOPE(Trig);
+	return FRealFloat(PrecisionScalar::SinRad(InVal.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::CosRad(FRealFloat InVal)
 {
-    return FRealFloat(ttmath::Cos(InVal.Value));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionScalar::CosRad(InVal.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::TanRad(FRealFloat InVal)
 {
-    return FRealFloat(ttmath::Tan(InVal.Value));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionBudget::Tan(InVal.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::NormalizeAngleDeg(FRealFloat InVal)
@@ -242,31 +292,37 @@ FRealFloat URealFloatMath::NormalizeAngleDeg(FRealFloat InVal)
 
 FRealFloat URealFloatMath::SinDeg(FRealFloat InVal)
 {
-    return FRealFloat(ttmath::Sin((InVal * FRealFloat::DegToRad).Value));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionBudget::Sin((InVal * FRealFloat::DegToRad).Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::CosDeg(FRealFloat InVal)
 {
-    return FRealFloat(ttmath::Cos((InVal * FRealFloat::DegToRad).Value));
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionBudget::Cos((InVal * FRealFloat::DegToRad).Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::TanDeg(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(Trig);
     return FRealFloat(ttmath::ATan((InVal * FRealFloat::DegToRad).Value));
 }
 
 FRealFloat URealFloatMath::AsinRad(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ASin(InVal.Value));
 }
 
 FRealFloat URealFloatMath::AcosRad(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ACos(InVal.Value));
 }
 
 FRealFloat URealFloatMath::AtanRad(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ATan(InVal.Value));
 }
 
@@ -312,16 +368,19 @@ FRealFloat URealFloatMath::Atan2Rad(FRealFloat Y, FRealFloat X)
 
 FRealFloat URealFloatMath::AsinDeg(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ASin(InVal.Value)) / FRealFloat::DegToRad;
 }
 
 FRealFloat URealFloatMath::AcosDeg(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ACos(InVal.Value)) / FRealFloat::DegToRad;
 }
 
 FRealFloat URealFloatMath::AtanDeg(FRealFloat InVal)
 {
+    SPACEKITPRECISION_SCOPE(InverseTrig);
     return FRealFloat(ttmath::ATan(InVal.Value)) / FRealFloat::DegToRad;
 }
 
@@ -334,33 +393,39 @@ FRealFloat URealFloatMath::Atan2Deg(FRealFloat Y, FRealFloat X)
 
 FRealFloat URealFloatMath::Pow(FRealFloat X, FRealFloat Y)
 {
+	SPACEKITPRECISION_SCOPE(ExpLog);
 	// a^b = e^(b*ln(a))
-    return FRealFloat(ttmath::Exp(Y.Value * ttmath::Ln(X.Value)));
+    return FRealFloat(PrecisionBudget::Pow(X.Value, Y.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::Sqrt(FRealFloat Val)
 {
-    return FRealFloat(ttmath::Sqrt(Val.Value));
+    SPACEKITPRECISION_SCOPE(Sqrt);
+    return FRealFloat(PrecisionScalar::Sqrt(Val.Value));
 }
 
 FRealFloat URealFloatMath::Exp(FRealFloat Val)
 {
-    return FRealFloat(ttmath::Exp(Val.Value));
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Exp(Val.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::LogE(FRealFloat Val)
 {
-    return FRealFloat(ttmath::Ln(Val.Value));
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Ln(Val.Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::Log2(FRealFloat Val)
 {
-    return FRealFloat(ttmath::Log(Val.Value, FRealFloat(2).Value));
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Log(Val.Value, FRealFloat(2).Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::Log10(FRealFloat Val)
 {
-    return FRealFloat(ttmath::Log(Val.Value, FRealFloat(10).Value));
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Log(Val.Value, FRealFloat(10).Value, FRealFloatPrecision::Get()));
 }
 
 FRealFloat URealFloatMath::Min(FRealFloat First, FRealFloat Second)
@@ -387,3 +452,61 @@ FRealFloat URealFloatMath::Sign(FRealFloat Val)
 {
     return FRealFloat(Val < FRealFloat(0) ? 1 : -1);
 }
+
+// Precision-budgeted FRealFloat math
+
+FRealFloat URealFloatMath::SinRadWithPrecision(FRealFloat InVal, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionScalar::SinRad(InVal.Value, PrecisionBits));
+}
+
+FRealFloat URealFloatMath::CosRadWithPrecision(FRealFloat InVal, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionScalar::CosRad(InVal.Value, PrecisionBits));
+}
+
+FRealFloat URealFloatMath::TanRadWithPrecision(FRealFloat InVal, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(Trig);
+    return FRealFloat(PrecisionBudget::Tan(InVal.Value, PrecisionBits));
+}
+
+FRealFloat URealFloatMath::ExpWithPrecision(FRealFloat Val, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Exp(Val.Value, PrecisionBits));
+}
+
+FRealFloat URealFloatMath::LogEWithPrecision(FRealFloat Val, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Ln(Val.Value, PrecisionBits));
+}
+
+FRealFloat URealFloatMath::PowWithPrecision(FRealFloat X, FRealFloat Y, int32 PrecisionBits)
+{
+    SPACEKITPRECISION_SCOPE(ExpLog);
+    return FRealFloat(PrecisionBudget::Pow(X.Value, Y.Value, PrecisionBits));
+}
+
+int32 URealFloatMath::GetPrecisionBudget()
+{
+    return FRealFloatPrecision::Get();
+}
+
+FRealFloat URealFloatMath::SumArray(const TArray<FRealFloat>& Values)
+{
+    return FRealFloatAccumulator::Sum(Values);
+}
+
+FRealFloat URealFloatMath::DotArrays(const TArray<FRealFloat>& A, const TArray<FRealFloat>& B)
+{
+    return FRealFloatAccumulator::Dot(A, B);
+}
+
+FRealFloat URealFloatMath::MeanArray(const TArray<FRealFloat>& Values)
+{
+    return FRealFloatAccumulator::Mean(Values);
+}
@@ -0,0 +1,499 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/RealFloatAccumulator.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	constexpr int64 WordBits = TTMATH_BITS_PER_UINT;
+	constexpr int32 MaxWindowWords = int32(FRealFloatAccumulator::MaxWindowBits / WordBits);
+	constexpr int32 MantissaWords = int32(sizeof(FRealFloat::ttBigType::mantissa) / sizeof(ttmath::uint));
+
+	// Number of values summed by each task of the ParallelSum functions
+	constexpr int32 ParallelBatchSize = 1024;
+
+	// Rounds an exponent down to a multiple of the word size
+	int64 FloorToWord(int64 Exponent)
+	{
+		return Exponent >= 0 ? Exponent / WordBits * WordBits : -((-Exponent + WordBits - 1) / WordBits) * WordBits;
+	}
+
+	// Index of the highest non-zero word, or -1 if the magnitude is 0
+	int32 GetTopWord(const TArray<ttmath::uint>& Magnitude)
+	{
+		int32 Top = Magnitude.Num() - 1;
+		while (Top >= 0 && Magnitude[Top] == 0)
+		{
+			--Top;
+		}
+		return Top;
+	}
+
+	// Compares two magnitudes: -1, 0 or 1
+	int32 CompareMagnitudes(const TArray<ttmath::uint>& A, const TArray<ttmath::uint>& B)
+	{
+		const int32 TopA = GetTopWord(A);
+		const int32 TopB = GetTopWord(B);
+		if (TopA != TopB)
+		{
+			return TopA < TopB ? -1 : 1;
+		}
+
+		for (int32 i = TopA; i >= 0; --i)
+		{
+			if (A[i] != B[i])
+			{
+				return A[i] < B[i] ? -1 : 1;
+			}
+		}
+		return 0;
+	}
+
+	// Result = A - B, with A >= B
+	void SubtractMagnitudes(const TArray<ttmath::uint>& A, const TArray<ttmath::uint>& B, TArray<ttmath::uint>& Result)
+	{
+		Result = A;
+		ttmath::uint Borrow = 0;
+		for (int32 i = 0; i < Result.Num(); ++i)
+		{
+			const ttmath::uint Sub = i < B.Num() ? B[i] : 0;
+			const ttmath::uint Before = Result[i];
+			Result[i] = Before - Sub - Borrow;
+			Borrow = (Before < Sub || (Borrow && Before == Sub)) ? 1 : 0;
+		}
+	}
+
+	// Magnitude = |Positive - Negative|. Returns the sign of Positive - Negative
+	int32 GetDifference(const TArray<ttmath::uint>& Positive, const TArray<ttmath::uint>& Negative, TArray<ttmath::uint>& Magnitude)
+	{
+		const int32 Comparison = CompareMagnitudes(Positive, Negative);
+		if (Comparison > 0)
+		{
+			SubtractMagnitudes(Positive, Negative, Magnitude);
+		}
+		else if (Comparison < 0)
+		{
+			SubtractMagnitudes(Negative, Positive, Magnitude);
+		}
+		return Comparison;
+	}
+
+	// The WordBits bits of Magnitude starting at bit Position, which can be negative or past the end (missing bits are 0)
+	ttmath::uint GetWordAt(const TArray<ttmath::uint>& Magnitude, int64 Position)
+	{
+		const int64 Index = FloorToWord(Position) / WordBits;
+		const int64 Shift = Position - Index * WordBits;
+
+		const ttmath::uint Low = (Index >= 0 && Index < Magnitude.Num()) ? Magnitude[Index] : 0;
+		if (Shift == 0)
+		{
+			return Low;
+		}
+
+		const ttmath::uint High = (Index + 1 >= 0 && Index + 1 < Magnitude.Num()) ? Magnitude[Index + 1] : 0;
+		return (Low >> Shift) | (High << (WordBits - Shift));
+	}
+
+	// Whether any bit of Magnitude below Position is set
+	bool HasBitsBelow(const TArray<ttmath::uint>& Magnitude, int64 Position)
+	{
+		for (int64 i = 0; i < Magnitude.Num() && i * WordBits < Position; ++i)
+		{
+			const int64 BitsInWord = Position - i * WordBits;
+			const ttmath::uint Mask = BitsInWord >= WordBits ? ~ttmath::uint(0) : ((ttmath::uint(1) << BitsInWord) - 1);
+			if (Magnitude[i] & Mask)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Rounds Magnitude * 2^BaseExponent to the nearest Big, ties to even
+	template<ttmath::uint exp, ttmath::uint man>
+	void RoundToBig(const TArray<ttmath::uint>& Magnitude, int64 BaseExponent, bool bNegative, ttmath::Big<exp, man>& Out)
+	{
+		const int32 TopWord = GetTopWord(Magnitude);
+		if (TopWord < 0)
+		{
+			Out.SetZero();
+			return;
+		}
+
+		// Position of the lowest bit kept in the significand
+		const int64 HighestBit = TopWord * WordBits + ttmath::UInt<1>::FindLeadingBitInWord(Magnitude[TopWord]);
+		const int64 LowestBit = HighestBit - int64(man) * WordBits + 1;
+
+		ttmath::UInt<man> Mantissa;
+		for (ttmath::uint i = 0; i < man; ++i)
+		{
+			Mantissa.table[i] = GetWordAt(Magnitude, LowestBit + int64(i) * WordBits);
+		}
+
+		int64 Exponent = BaseExponent + LowestBit;
+		if (LowestBit > 0)
+		{
+			const bool bRoundBit = (GetWordAt(Magnitude, LowestBit - 1) & 1) != 0;
+			if (bRoundBit && ((Mantissa.table[0] & 1) != 0 || HasBitsBelow(Magnitude, LowestBit - 1)))
+			{
+				if (Mantissa.AddOne())
+				{
+					// The significand overflowed: it's now a power of two
+					Mantissa.SetZero();
+					Mantissa.table[man - 1] = ttmath::uint(1) << (WordBits - 1);
+					++Exponent;
+				}
+			}
+		}
+
+		Out.info = 0;
+		Out.mantissa = Mantissa;
+		Out.exponent.FromInt(ttmath::sint(Exponent));
+		Out.Standardizing();
+		if (bNegative)
+		{
+			Out.SetSign();
+		}
+	}
+}
+
+FRealFloatAccumulator::FRealFloatAccumulator()
+	: BaseExponent(0), bIsNan(false)
+{
+}
+
+void FRealFloatAccumulator::Add(const FRealFloat& InValue)
+{
+	if (InValue.Value.IsNan())
+	{
+		bIsNan = true;
+		return;
+	}
+
+	if (InValue.Value.IsZero())
+	{
+		return;
+	}
+
+	AddWords(InValue.Value.IsSign(), InValue.Value.mantissa.table, MantissaWords, InValue.Value.exponent.ToInt());
+}
+
+void FRealFloatAccumulator::AddProduct(const FRealFloat& A, const FRealFloat& B)
+{
+	if (A.Value.IsNan() || B.Value.IsNan())
+	{
+		bIsNan = true;
+		return;
+	}
+
+	if (A.Value.IsZero() || B.Value.IsZero())
+	{
+		return;
+	}
+
+	// The full product of the significands, without rounding
+	ttmath::UInt<MantissaWords> Mantissa = A.Value.mantissa;
+	ttmath::UInt<2 * MantissaWords> Product;
+	Mantissa.MulBig(B.Value.mantissa, Product);
+
+	AddWords(A.Value.IsSign() != B.Value.IsSign(), Product.table, 2 * MantissaWords, int64(A.Value.exponent.ToInt()) + int64(B.Value.exponent.ToInt()));
+}
+
+void FRealFloatAccumulator::Merge(const FRealFloatAccumulator& Other)
+{
+	bIsNan |= Other.bIsNan;
+
+	if (Other.Positive.Num() > 0)
+	{
+		AddWords(false, Other.Positive.GetData(), Other.Positive.Num(), Other.BaseExponent);
+	}
+	if (Other.Negative.Num() > 0)
+	{
+		AddWords(true, Other.Negative.GetData(), Other.Negative.Num(), Other.BaseExponent);
+	}
+}
+
+void FRealFloatAccumulator::Reset()
+{
+	Positive.Reset();
+	Negative.Reset();
+	BaseExponent = 0;
+	bIsNan = false;
+}
+
+FRealFloat FRealFloatAccumulator::GetResult() const
+{
+	FRealFloat Result;
+	if (bIsNan)
+	{
+		Result.Value.SetNan();
+		return Result;
+	}
+
+	TArray<ttmath::uint> Magnitude;
+	const int32 Sign = GetDifference(Positive, Negative, Magnitude);
+	if (Sign == 0)
+	{
+		return Result;
+	}
+
+	RoundToBig(Magnitude, BaseExponent, Sign < 0, Result.Value);
+	return Result;
+}
+
+FRealFloat FRealFloatAccumulator::GetResultDividedBy(int64 Count) const
+{
+	FRealFloat Result;
+	if (bIsNan || Count == 0)
+	{
+		Result.Value.SetNan();
+		return Result;
+	}
+
+	TArray<ttmath::uint> Magnitude;
+	const int32 Sign = GetDifference(Positive, Negative, Magnitude);
+	if (Sign == 0)
+	{
+		return Result;
+	}
+
+	// The exact magnitude is shifted up by enough words for the quotient to keep more bits than the significand, plus a word below the rounding bit.
+	// A non-zero remainder then only sets the lowest bit of the quotient, far below the rounding bit, so the quotient is rounded once, from its exact value
+	// The divisor is a single word, which holds any count on 64-bit platforms
+	const uint64 Divisor = Count < 0 ? uint64(-(Count + 1)) + 1 : uint64(Count);
+	if (Divisor > uint64(TTMATH_UINT_MAX_VALUE))
+	{
+		Result.Value.SetNan();
+		return Result;
+	}
+
+	constexpr int32 ShiftWords = MantissaWords + 2;
+	TArray<ttmath::uint> Quotient;
+	Quotient.AddZeroed(ShiftWords + Magnitude.Num());
+	ttmath::uint Rest = 0;
+	for (int32 i = Quotient.Num() - 1; i >= 0; --i)
+	{
+		const ttmath::uint Word = i >= ShiftWords ? Magnitude[i - ShiftWords] : 0;
+		ttmath::UInt<1>::DivTwoWords(Rest, Word, ttmath::uint(Divisor), &Quotient[i], &Rest);
+	}
+	if (Rest != 0)
+	{
+		Quotient[0] |= 1;
+	}
+
+	RoundToBig(Quotient, BaseExponent - ShiftWords * WordBits, (Sign < 0) != (Count < 0), Result.Value);
+	return Result;
+}
+
+void FRealFloatAccumulator::AddWords(bool bNegative, const ttmath::uint* Words, int32 NumWords, int64 Exponent)
+{
+	if (Positive.Num() == 0 && Negative.Num() == 0)
+	{
+		BaseExponent = FloorToWord(Exponent);
+	}
+	else if (Exponent < BaseExponent)
+	{
+		ExtendDown(Exponent);
+	}
+
+	TArray<ttmath::uint>& Target = bNegative ? Negative : Positive;
+
+	int64 Shift = Exponent - BaseExponent;
+	int64 WordOffset = FloorToWord(Shift) / WordBits;
+	const int64 BitShift = Shift - WordOffset * WordBits;
+
+	// The shifted words, plus one for the carry, must fit in the window: drop its lowest words otherwise
+	const int64 TopWord = WordOffset + NumWords + 1;
+	if (TopWord > MaxWindowWords)
+	{
+		const int32 DroppedWords = int32(TopWord - MaxWindowWords);
+		Positive.RemoveAt(0, FMath::Min(DroppedWords, Positive.Num()));
+		Negative.RemoveAt(0, FMath::Min(DroppedWords, Negative.Num()));
+		BaseExponent += DroppedWords * WordBits;
+		WordOffset -= DroppedWords;
+	}
+
+	if (Target.Num() < WordOffset + NumWords + 1)
+	{
+		Target.AddZeroed(int32(WordOffset + NumWords + 1 - Target.Num()));
+	}
+
+	// Adds the words shifted by BitShift. Words that fall below the window are dropped
+	ttmath::uint Carry = 0;
+	for (int32 i = 0; i <= NumWords; ++i)
+	{
+		const int64 Index = WordOffset + i;
+		if (Index < 0)
+		{
+			continue;
+		}
+
+		const ttmath::uint Current = i < NumWords ? Words[i] : 0;
+		const ttmath::uint Previous = i > 0 ? Words[i - 1] : 0;
+		const ttmath::uint Shifted = BitShift == 0 ? Current : ((Current << BitShift) | (Previous >> (WordBits - BitShift)));
+
+		const ttmath::uint Before = Target[Index];
+		const ttmath::uint Sum = Before + Shifted + Carry;
+		Carry = (Sum < Before || (Carry && Sum == Before)) ? 1 : 0;
+		Target[Index] = Sum;
+	}
+
+	for (int64 Index = WordOffset + NumWords + 1; Carry; ++Index)
+	{
+		if (Index == Target.Num())
+		{
+			Target.Add(0);
+		}
+		Target[Index] += 1;
+		Carry = Target[Index] == 0 ? 1 : 0;
+	}
+}
+
+void FRealFloatAccumulator::ExtendDown(int64 NewBaseExponent)
+{
+	const int32 CurrentWords = FMath::Max(Positive.Num(), Negative.Num());
+	const int32 AddedWords = FMath::Min(int32((BaseExponent - FloorToWord(NewBaseExponent)) / WordBits), MaxWindowWords - CurrentWords);
+	if (AddedWords <= 0)
+	{
+		return;
+	}
+
+	if (Positive.Num() > 0)
+	{
+		Positive.InsertZeroed(0, AddedWords);
+	}
+	if (Negative.Num() > 0)
+	{
+		Negative.InsertZeroed(0, AddedWords);
+	}
+	BaseExponent -= AddedWords * WordBits;
+}
+
+FRealFloat FRealFloatAccumulator::Sum(TArrayView<const FRealFloat> Values)
+{
+	FRealFloatAccumulator Accumulator;
+	for (const FRealFloat& Value : Values)
+	{
+		Accumulator.Add(Value);
+	}
+	return Accumulator.GetResult();
+}
+
+FVectorFloat FRealFloatAccumulator::Sum(TArrayView<const FVectorFloat> Values)
+{
+	FRealFloatAccumulator X, Y, Z;
+	for (const FVectorFloat& Value : Values)
+	{
+		X.Add(Value.X);
+		Y.Add(Value.Y);
+		Z.Add(Value.Z);
+	}
+	return FVectorFloat(X.GetResult(), Y.GetResult(), Z.GetResult());
+}
+
+FRealFloat FRealFloatAccumulator::ParallelSum(TArrayView<const FRealFloat> Values)
+{
+	const int32 NumBatches = FMath::DivideAndRoundUp(Values.Num(), ParallelBatchSize);
+	TArray<FRealFloatAccumulator> Partials;
+	Partials.SetNum(NumBatches);
+
+	ParallelFor(NumBatches, [&Values, &Partials](int32 Batch)
+	{
+		const int32 End = FMath::Min(Values.Num(), (Batch + 1) * ParallelBatchSize);
+		for (int32 i = Batch * ParallelBatchSize; i < End; ++i)
+		{
+			Partials[Batch].Add(Values[i]);
+		}
+	});
+
+	FRealFloatAccumulator Accumulator;
+	for (const FRealFloatAccumulator& Partial : Partials)
+	{
+		Accumulator.Merge(Partial);
+	}
+	return Accumulator.GetResult();
+}
+
+FVectorFloat FRealFloatAccumulator::ParallelSum(TArrayView<const FVectorFloat> Values)
+{
+	const int32 NumBatches = FMath::DivideAndRoundUp(Values.Num(), ParallelBatchSize);
+	TArray<FRealFloatAccumulator> Partials;
+	Partials.SetNum(3 * NumBatches);
+
+	ParallelFor(NumBatches, [&Values, &Partials](int32 Batch)
+	{
+		const int32 End = FMath::Min(Values.Num(), (Batch + 1) * ParallelBatchSize);
+		for (int32 i = Batch * ParallelBatchSize; i < End; ++i)
+		{
+			Partials[3 * Batch].Add(Values[i].X);
+			Partials[3 * Batch + 1].Add(Values[i].Y);
+			Partials[3 * Batch + 2].Add(Values[i].Z);
+		}
+	});
+
+	FRealFloatAccumulator X, Y, Z;
+	for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+	{
+		X.Merge(Partials[3 * Batch]);
+		Y.Merge(Partials[3 * Batch + 1]);
+		Z.Merge(Partials[3 * Batch + 2]);
+	}
+	return FVectorFloat(X.GetResult(), Y.GetResult(), Z.GetResult());
+}
+
+FRealFloat FRealFloatAccumulator::Dot(TArrayView<const FRealFloat> A, TArrayView<const FRealFloat> B)
+{
+	FRealFloatAccumulator Accumulator;
+	const int32 Num = FMath::Min(A.Num(), B.Num());
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Accumulator.AddProduct(A[i], B[i]);
+	}
+	return Accumulator.GetResult();
+}
+
+FRealFloat FRealFloatAccumulator::Dot(TArrayView<const FVectorFloat> A, TArrayView<const FVectorFloat> B)
+{
+	FRealFloatAccumulator Accumulator;
+	const int32 Num = FMath::Min(A.Num(), B.Num());
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Accumulator.AddProduct(A[i].X, B[i].X);
+		Accumulator.AddProduct(A[i].Y, B[i].Y);
+		Accumulator.AddProduct(A[i].Z, B[i].Z);
+	}
+	return Accumulator.GetResult();
+}
+
+FRealFloat FRealFloatAccumulator::Mean(TArrayView<const FRealFloat> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return FRealFloat(0);
+	}
+
+	FRealFloatAccumulator Accumulator;
+	for (const FRealFloat& Value : Values)
+	{
+		Accumulator.Add(Value);
+	}
+	return Accumulator.GetResultDividedBy(Values.Num());
+}
+
+FVectorFloat FRealFloatAccumulator::Mean(TArrayView<const FVectorFloat> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return FVectorFloat(0, 0, 0);
+	}
+
+	FRealFloatAccumulator X, Y, Z;
+	for (const FVectorFloat& Value : Values)
+	{
+		X.Add(Value.X);
+		Y.Add(Value.Y);
+		Z.Add(Value.Z);
+	}
+	return FVectorFloat(X.GetResultDividedBy(Values.Num()), Y.GetResultDividedBy(Values.Num()), Z.GetResultDividedBy(Values.Num()));
+}
@@ -0,0 +1,75 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "SpaceKitPrecision/Public/RotationMatrixFloat.h"
+
+#include "Async/ParallelFor.h"
+
+// Number of vectors rotated by each task of the ParallelFor variants
+static constexpr int32 RotationBatchSize = 256;
+
+FRotationMatrixFloat::FRotationMatrixFloat()
+{
+	Rows[0] = FVectorFloat(1, 0, 0);
+	Rows[1] = FVectorFloat(0, 1, 0);
+	Rows[2] = FVectorFloat(0, 0, 1);
+}
+
+FRotationMatrixFloat::FRotationMatrixFloat(const FQuatFloat& Quat)
+{
+	const FRealFloat X2 = Quat.X + Quat.X;
+	const FRealFloat Y2 = Quat.Y + Quat.Y;
+	const FRealFloat Z2 = Quat.Z + Quat.Z;
+
+	const FRealFloat XX = Quat.X * X2;
+	const FRealFloat XY = Quat.X * Y2;
+	const FRealFloat XZ = Quat.X * Z2;
+	const FRealFloat YY = Quat.Y * Y2;
+	const FRealFloat YZ = Quat.Y * Z2;
+	const FRealFloat ZZ = Quat.Z * Z2;
+	const FRealFloat WX = Quat.W * X2;
+	const FRealFloat WY = Quat.W * Y2;
+	const FRealFloat WZ = Quat.W * Z2;
+
+	Rows[0] = FVectorFloat(1_fl - (YY + ZZ), XY - WZ, XZ + WY);
+	Rows[1] = FVectorFloat(XY + WZ, 1_fl - (XX + ZZ), YZ - WX);
+	Rows[2] = FVectorFloat(XZ - WY, YZ + WX, 1_fl - (XX + YY));
+}
+
+FRotationMatrixFloat::FRotationMatrixFloat(const FRotatorFloat& Rotator)
+	: FRotationMatrixFloat(FQuatFloat(Rotator))
+{
+}
+
+void FRotationMatrixFloat::RotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+	for (FVectorFloat& Vec : Vectors)
+	{
+		Vec = RotateVector(Vec);
+	}
+}
+
+void FRotationMatrixFloat::UnrotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+	for (FVectorFloat& Vec : Vectors)
+	{
+		Vec = UnrotateVector(Vec);
+	}
+}
+
+void FRotationMatrixFloat::ParallelRotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+	ParallelFor(FMath::DivideAndRoundUp(Vectors.Num(), RotationBatchSize), [this, Vectors](int32 Batch)
+	{
+		const int32 Start = Batch * RotationBatchSize;
+		RotateVectors(Vectors.Slice(Start, FMath::Min(RotationBatchSize, Vectors.Num() - Start)));
+	});
+}
+
+void FRotationMatrixFloat::ParallelUnrotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+	ParallelFor(FMath::DivideAndRoundUp(Vectors.Num(), RotationBatchSize), [this, Vectors](int32 Batch)
+	{
+		const int32 Start = Batch * RotationBatchSize;
+		UnrotateVectors(Vectors.Slice(Start, FMath::Min(RotationBatchSize, Vectors.Num() - Start)));
+	});
+}
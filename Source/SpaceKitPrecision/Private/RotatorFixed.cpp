@@ -3,6 +3,7 @@
 
 #include "SpaceKitPrecision/Public/RotatorFixed.h"
 #include "SpaceKitPrecision/Public/QuatFixed.h"
+#include "SpaceKitPrecision/Public/RotatorFloat.h"
 #include "SpaceKitPrecision/Public/RealFixed.h" // Assuming this is where URealFixedMath resides
 
 // Initialize the static Identity member
@@ -37,6 +38,11 @@ FRotatorFixed::FRotatorFixed(const FQuatFixed& InQuat)
     Yaw = URealFixedMath::Atan2Deg(siny_cosp, cosy_cosp);
 }
 
+FRotatorFixed::FRotatorFixed(const FRotatorFloat& InRot)
+    : Pitch(InRot.Pitch), Yaw(InRot.Yaw), Roll(InRot.Roll)
+{
+}
+
 FVectorFixed FRotatorFixed::RotateVector(const FVectorFixed& Vec) const
 {
     return FQuatFixed(*this).RotateVector(Vec);
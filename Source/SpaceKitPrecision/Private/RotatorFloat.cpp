@@ -1,7 +1,9 @@
 // Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
 
 #include "SpaceKitPrecision/Public/RotatorFloat.h"
+#include "SpaceKitPrecision/Public/RotationMatrixFloat.h"
 #include "SpaceKitPrecision/Public/QuatFloat.h"
+#include "SpaceKitPrecision/Public/RotatorFixed.h"
 
 FRotatorFloat FRotatorFloat::Identity = FRotatorFloat();
 
@@ -29,6 +31,11 @@ FRotatorFloat::FRotatorFloat(const FQuatFloat& Rotator)
     Yaw = URealFloatMath::Atan2Deg(siny_cosp, cosy_cosp);
 }
 
+FRotatorFloat::FRotatorFloat(const FRotatorFixed& InRot)
+    : Yaw(InRot.Yaw), Pitch(InRot.Pitch), Roll(InRot.Roll)
+{
+}
+
 FVectorFloat FRotatorFloat::RotateVector(const FVectorFloat& Vec) const
 {
     return FQuatFloat(*this).RotateVector(Vec);
@@ -88,3 +95,48 @@ bool URotatorFloatMath::RotNotEqualsRot(const FRotatorFloat& First, const FRotat
 {
 	return !RotEqualsRot(First, Second, Tolerance);
 }
+
+FRotationMatrixFloat FRotatorFloat::ToMatrix() const
+{
+    return FRotationMatrixFloat(*this);
+}
+
+void FRotatorFloat::RotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+    ToMatrix().RotateVectors(Vectors);
+}
+
+void FRotatorFloat::UnrotateVectors(TArrayView<FVectorFloat> Vectors) const
+{
+    ToMatrix().UnrotateVectors(Vectors);
+}
+
+TArray<FVectorFloat> URotatorFloatMath::RotateVectors(const FRotatorFloat& Rot, const TArray<FVectorFloat>& Vectors, bool bParallel)
+{
+    TArray<FVectorFloat> Result = Vectors;
+    const FRotationMatrixFloat Matrix = Rot.ToMatrix();
+    if (bParallel)
+    {
+        Matrix.ParallelRotateVectors(Result);
+    }
+    else
+    {
+        Matrix.RotateVectors(Result);
+    }
+    return Result;
+}
+
+TArray<FVectorFloat> URotatorFloatMath::UnrotateVectors(const FRotatorFloat& Rot, const TArray<FVectorFloat>& Vectors, bool bParallel)
+{
+    TArray<FVectorFloat> Result = Vectors;
+    const FRotationMatrixFloat Matrix = Rot.ToMatrix();
+    if (bParallel)
+    {
+        Matrix.ParallelUnrotateVectors(Result);
+    }
+    else
+    {
+        Matrix.UnrotateVectors(Result);
+    }
+    return Result;
+}
@@ -0,0 +1,56 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/BlockFixedArray.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpaceBlockFixedArrayTest, "SpaceKitPrecision.FixedPointMath.BlockArray", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpaceBlockFixedArrayTest::RunTest(const FString& Parameters)
+{
+	// Height samples, within a few hundred units, on a 1/64 grid
+	TArray<FRealFixed> Heights;
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		Heights.Add(FRealFixed(5000 + (Index * 7919) % 20011) / 64_fx);
+	}
+
+	TBlockFixedArray<> Compressed;
+	Compressed.Append(Heights);
+	TestEqual(TEXT("Num"), Compressed.Num(), 1000);
+	TestTrue(TEXT("Compressed 4 times at least"), Compressed.GetCompressedSize() * 4 < 960 * sizeof(FRealFixed));
+
+	bool bAllEqual = true;
+	for (int32 Index = 0; Index < Heights.Num(); ++Index)
+	{
+		bAllEqual &= Compressed[Index] == Heights[Index];
+	}
+	TestTrue(TEXT("Random access is lossless"), bAllEqual);
+
+	// Ranges across blocks, and into the uncompressed one
+	TArray<FRealFixed> Decoded;
+	Decoded.SetNum(100);
+	Compressed.Decode(900, 100, Decoded.GetData());
+	TestTrue(TEXT("Range decoded"), Decoded == TArray<FRealFixed>(Heights.GetData() + 900, 100));
+
+	// Rounded to 1/256 unit, trajectory points within the quantum
+	TBlockFixedArray<32> Trajectory(REAL_FIXED_EXPONENT - 8);
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Trajectory.Add(FRealFixed(1e9 + Index * 0.123));
+	}
+	TestTrue(TEXT("Rounded to the quantum"), URealFixedMath::Abs(Trajectory[42] - FRealFixed(1e9 + 42 * 0.123)) <= FRealFixed(1.0 / 512));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
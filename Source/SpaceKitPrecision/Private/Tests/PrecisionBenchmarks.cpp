@@ -0,0 +1,433 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "SpaceKitPrecision/Public/PrecisionSettings.h"
+#include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Public/RealFloat.h"
+#include "SpaceKitPrecision/Public/VectorFixed.h"
+#include "SpaceKitPrecision/Public/VectorFloat.h"
+#include "SpaceKitPrecision/Public/RotatorFixed.h"
+#include "SpaceKitPrecision/Public/RotatorFloat.h"
+#include "SpaceKitPrecision/Public/QuatFixed.h"
+#include "SpaceKitPrecision/Public/QuatFloat.h"
+#include "SpaceKitPrecision/Public/TransformFixed.h"
+#include "SpaceKitPrecision/Public/Conversions.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Benchmarks are not wrapped in #pragma optimize("", off) like the functional tests: they measure the optimized code.
+// Run them with "Automation RunTests SpaceKitPrecision.Benchmarks", results are also written to Saved/Benchmarks/SpaceKitPrecision/<Suite>.json and .csv
+
+namespace
+{
+	// Each sample runs the operation in a batch lasting at least this long, so that the timer resolution doesn't matter
+	constexpr double BenchmarkMinBatchSeconds = 20e-6;
+
+	// Number of timed batches per operation, p50 and p99 are computed over them
+	constexpr int32 BenchmarkSampleCount = 200;
+
+	// Compiler barrier over a whole object: the optimizer must assume it is read and written here, so it can neither fold operations on it nor drop the code that computes it
+	template<typename T>
+	FORCEINLINE void DoNotOptimize(T& Value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		// No inline assembly on x64 MSVC: the object's address escapes through a volatile pointer instead
+		static const volatile void* volatile Escaped = nullptr;
+		Escaped = &Value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&Value) : "memory");
+#endif
+	}
+
+	// The inputs of the measured operations go through the barrier, so that operations on constants are not folded away. The inputs must not be const objects
+	template<typename T>
+	FORCEINLINE T& Opaque(T& Value)
+	{
+		DoNotOptimize(Value);
+		return Value;
+	}
+
+	// Makes the whole result of an operation observable, so that no part of the operation is removed as dead code
+	template<typename T>
+	FORCEINLINE void KeepResult(T&& Result)
+	{
+		DoNotOptimize(Result);
+	}
+
+	struct FPrecisionBenchmarkResult
+	{
+		FString Name;
+		int64 OpsPerBatch;
+		double NsPerOp;
+		double OpsPerSecond;
+		double P50NsPerOp;
+		double P99NsPerOp;
+	};
+
+	class FPrecisionBenchmarkSuite
+	{
+	public:
+		explicit FPrecisionBenchmarkSuite(const TCHAR* InSuiteName)
+			: SuiteName(InSuiteName)
+		{
+		}
+
+		// Times Function, which takes no argument and returns the result of the measured operation
+		template<typename FunctionType>
+		void Run(const TCHAR* Name, FunctionType&& Function)
+		{
+			// Warm up the caches while doubling the batch until it is long enough to be timed
+			int64 OpsPerBatch = 1;
+			while (true)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				for (int64 i = 0; i < OpsPerBatch; ++i)
+				{
+					KeepResult(Function());
+				}
+				const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+				if (Seconds >= BenchmarkMinBatchSeconds || OpsPerBatch >= (int64(1) << 30))
+				{
+					break;
+				}
+				OpsPerBatch *= 2;
+			}
+
+			TArray<double> Samples;
+			Samples.Reserve(BenchmarkSampleCount);
+			double TotalSeconds = 0.0;
+			for (int32 Sample = 0; Sample < BenchmarkSampleCount; ++Sample)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				for (int64 i = 0; i < OpsPerBatch; ++i)
+				{
+					KeepResult(Function());
+				}
+				const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+				TotalSeconds += Seconds;
+				Samples.Add(Seconds * 1e9 / OpsPerBatch);
+			}
+			Samples.Sort();
+
+			FPrecisionBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Name;
+			Result.OpsPerBatch = OpsPerBatch;
+			Result.NsPerOp = TotalSeconds * 1e9 / (double(OpsPerBatch) * BenchmarkSampleCount);
+			Result.OpsPerSecond = Result.NsPerOp > 0.0 ? 1e9 / Result.NsPerOp : 0.0;
+			Result.P50NsPerOp = Samples[(BenchmarkSampleCount - 1) / 2];
+			Result.P99NsPerOp = Samples[(BenchmarkSampleCount - 1) * 99 / 100];
+		}
+
+		// Logs the results in the test output and writes them as JSON and CSV in the Saved directory
+		void Report(FAutomationTestBase& Test) const
+		{
+			const FString Settings = FString::Printf(TEXT("REAL_FIXED_MANTISSA_SIZE=%d REAL_FIXED_EXPONENT=%d USE_BOOST_BIG=%d TT_REAL_FLOAT_SIZE=%d BOOST_REAL_FLOAT_SIZE=%d"),
+				REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT, USE_BOOST_BIG, TT_REAL_FLOAT_SIZE, BOOST_REAL_FLOAT_SIZE);
+			Test.AddInfo(FString::Printf(TEXT("%s (%s)"), *SuiteName, *Settings));
+
+			FString Json = TEXT("{\n");
+			Json += FString::Printf(TEXT("\t\"suite\": \"%s\",\n"), *SuiteName);
+			Json += FString::Printf(TEXT("\t\"timestamp\": \"%s\",\n"), *FDateTime::UtcNow().ToIso8601());
+			Json += FString::Printf(TEXT("\t\"settings\": { \"REAL_FIXED_MANTISSA_SIZE\": %d, \"REAL_FIXED_EXPONENT\": %d, \"USE_BOOST_BIG\": %d, \"TT_REAL_FLOAT_SIZE\": %d, \"BOOST_REAL_FLOAT_SIZE\": %d },\n"),
+				REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT, USE_BOOST_BIG, TT_REAL_FLOAT_SIZE, BOOST_REAL_FLOAT_SIZE);
+			Json += TEXT("\t\"results\": [\n");
+
+			FString Csv = TEXT("suite,name,ns_per_op,ops_per_s,p50_ns,p99_ns,ops_per_batch\n");
+
+			for (int32 i = 0; i < Results.Num(); ++i)
+			{
+				const FPrecisionBenchmarkResult& Result = Results[i];
+				Test.AddInfo(FString::Printf(TEXT("%-40s %12.1f ns/op %14.0f ops/s   p50 %12.1f ns   p99 %12.1f ns"),
+					*Result.Name, Result.NsPerOp, Result.OpsPerSecond, Result.P50NsPerOp, Result.P99NsPerOp));
+
+				Json += FString::Printf(TEXT("\t\t{ \"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_s\": %.1f, \"p50_ns\": %.3f, \"p99_ns\": %.3f, \"ops_per_batch\": %lld }%s\n"),
+					*Result.Name, Result.NsPerOp, Result.OpsPerSecond, Result.P50NsPerOp, Result.P99NsPerOp, Result.OpsPerBatch, i + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+				Csv += FString::Printf(TEXT("%s,\"%s\",%.3f,%.1f,%.3f,%.3f,%lld\n"),
+					*SuiteName, *Result.Name, Result.NsPerOp, Result.OpsPerSecond, Result.P50NsPerOp, Result.P99NsPerOp, Result.OpsPerBatch);
+			}
+			Json += TEXT("\t]\n}\n");
+
+			const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("SpaceKitPrecision"));
+			FFileHelper::SaveStringToFile(Json, *FPaths::Combine(Directory, SuiteName + TEXT(".json")));
+			FFileHelper::SaveStringToFile(Csv, *FPaths::Combine(Directory, SuiteName + TEXT(".csv")));
+		}
+
+	private:
+		FString SuiteName;
+		TArray<FPrecisionBenchmarkResult> Results;
+	};
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionRealFixedBenchmark, "SpaceKitPrecision.Benchmarks.RealFixed", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionRealFixedBenchmark::RunTest(const FString& Parameters)
+{
+	FRealFixed A(1234.5678);
+	FRealFixed B(-0.3125);
+	FRealFixed Angle(0.75);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("RealFixed"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("operator-"), [&]() { return Opaque(A) - Opaque(B); });
+	Suite.Run(TEXT("operator*"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("operator/"), [&]() { return Opaque(A) / Opaque(B); });
+	Suite.Run(TEXT("operator%"), [&]() { return Opaque(A) % Opaque(B); });
+	Suite.Run(TEXT("operator<"), [&]() { return Opaque(A) < Opaque(B); });
+	Suite.Run(TEXT("Abs"), [&]() { return URealFixedMath::Abs(Opaque(B)); });
+	Suite.Run(TEXT("Sqrt"), [&]() { return URealFixedMath::Sqrt(Opaque(A)); });
+	Suite.Run(TEXT("InvSqrt"), [&]() { return URealFixedMath::InvSqrt(Opaque(A)); });
+	Suite.Run(TEXT("SinRad"), [&]() { return URealFixedMath::SinRad(Opaque(Angle)); });
+	Suite.Run(TEXT("CosRad"), [&]() { return URealFixedMath::CosRad(Opaque(Angle)); });
+	Suite.Run(TEXT("TanRad"), [&]() { return URealFixedMath::TanRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AsinRad"), [&]() { return URealFixedMath::AsinRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AcosRad"), [&]() { return URealFixedMath::AcosRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AtanRad"), [&]() { return URealFixedMath::AtanRad(Opaque(Angle)); });
+	Suite.Run(TEXT("Atan2Rad"), [&]() { return URealFixedMath::Atan2Rad(Opaque(B), Opaque(A)); });
+	Suite.Run(TEXT("NormalizeAngleDeg"), [&]() { return URealFixedMath::NormalizeAngleDeg(Opaque(A)); });
+	Suite.Run(TEXT("Exp"), [&]() { return URealFixedMath::Exp(Opaque(Angle)); });
+	Suite.Run(TEXT("LogE"), [&]() { return URealFixedMath::LogE(Opaque(A)); });
+	Suite.Run(TEXT("Pow"), [&]() { return URealFixedMath::Pow(Opaque(A), Opaque(Angle)); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionRealFloatBenchmark, "SpaceKitPrecision.Benchmarks.RealFloat", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionRealFloatBenchmark::RunTest(const FString& Parameters)
+{
+	FRealFloat A(1234.5678);
+	FRealFloat B(-0.3125);
+	FRealFloat Angle(0.75);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("RealFloat"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("operator-"), [&]() { return Opaque(A) - Opaque(B); });
+	Suite.Run(TEXT("operator*"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("operator/"), [&]() { return Opaque(A) / Opaque(B); });
+	Suite.Run(TEXT("operator<"), [&]() { return Opaque(A) < Opaque(B); });
+	Suite.Run(TEXT("Abs"), [&]() { return URealFloatMath::Abs(Opaque(B)); });
+	Suite.Run(TEXT("Sqrt"), [&]() { return URealFloatMath::Sqrt(Opaque(A)); });
+	Suite.Run(TEXT("SinRad"), [&]() { return URealFloatMath::SinRad(Opaque(Angle)); });
+	Suite.Run(TEXT("CosRad"), [&]() { return URealFloatMath::CosRad(Opaque(Angle)); });
+	Suite.Run(TEXT("TanRad"), [&]() { return URealFloatMath::TanRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AsinRad"), [&]() { return URealFloatMath::AsinRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AcosRad"), [&]() { return URealFloatMath::AcosRad(Opaque(Angle)); });
+	Suite.Run(TEXT("AtanRad"), [&]() { return URealFloatMath::AtanRad(Opaque(Angle)); });
+	Suite.Run(TEXT("Atan2Rad"), [&]() { return URealFloatMath::Atan2Rad(Opaque(B), Opaque(A)); });
+	Suite.Run(TEXT("NormalizeAngleDeg"), [&]() { return URealFloatMath::NormalizeAngleDeg(Opaque(A)); });
+	Suite.Run(TEXT("Exp"), [&]() { return URealFloatMath::Exp(Opaque(Angle)); });
+	Suite.Run(TEXT("LogE"), [&]() { return URealFloatMath::LogE(Opaque(A)); });
+	Suite.Run(TEXT("Pow"), [&]() { return URealFloatMath::Pow(Opaque(A), Opaque(Angle)); });
+	Suite.Run(TEXT("SinRadWithPrecision(64)"), [&]() { return URealFloatMath::SinRadWithPrecision(Opaque(Angle), 64); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionVectorFixedBenchmark, "SpaceKitPrecision.Benchmarks.VectorFixed", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionVectorFixedBenchmark::RunTest(const FString& Parameters)
+{
+	FVectorFixed A(FRealFixed(1.5), FRealFixed(-2.25), FRealFixed(1e6));
+	FVectorFixed B(FRealFixed(-0.125), FRealFixed(3.0), FRealFixed(42.0));
+	FRealFixed Scalar(0.5);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("VectorFixed"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("operator*(Vector)"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("operator*(Real)"), [&]() { return Opaque(A) * Opaque(Scalar); });
+	Suite.Run(TEXT("operator/(Real)"), [&]() { return Opaque(A) / Opaque(Scalar); });
+	Suite.Run(TEXT("DotProduct"), [&]() { return FVectorFixed::DotProduct(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("CrossProduct"), [&]() { return FVectorFixed::CrossProduct(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("Size"), [&]() { return Opaque(A).Size(); });
+	Suite.Run(TEXT("GetNormal"), [&]() { return Opaque(A).GetNormal(); });
+	Suite.Run(TEXT("ProjectOnTo"), [&]() { return UVectorFixedMath::ProjectOnTo(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("DotSign"), [&]() { return UVectorFixedMath::DotSign(Opaque(A), Opaque(B)); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionVectorFloatBenchmark, "SpaceKitPrecision.Benchmarks.VectorFloat", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionVectorFloatBenchmark::RunTest(const FString& Parameters)
+{
+	FVectorFloat A(FRealFloat(1.5), FRealFloat(-2.25), FRealFloat(1e6));
+	FVectorFloat B(FRealFloat(-0.125), FRealFloat(3.0), FRealFloat(42.0));
+	FRealFloat Scalar(0.5);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("VectorFloat"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("operator*(Vector)"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("operator*(Real)"), [&]() { return Opaque(A) * Opaque(Scalar); });
+	Suite.Run(TEXT("operator/(Real)"), [&]() { return Opaque(A) / Opaque(Scalar); });
+	Suite.Run(TEXT("DotProduct"), [&]() { return FVectorFloat::DotProduct(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("CrossProduct"), [&]() { return FVectorFloat::CrossProduct(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("Size"), [&]() { return Opaque(A).Size(); });
+	Suite.Run(TEXT("GetNormal"), [&]() { return Opaque(A).GetNormal(); });
+	Suite.Run(TEXT("ProjectOnTo"), [&]() { return UVectorFloatMath::ProjectOnTo(Opaque(A), Opaque(B)); });
+	Suite.Run(TEXT("DotSign"), [&]() { return UVectorFloatMath::DotSign(Opaque(A), Opaque(B)); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionQuatFixedBenchmark, "SpaceKitPrecision.Benchmarks.QuatFixed", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionQuatFixedBenchmark::RunTest(const FString& Parameters)
+{
+	FQuatFixed A(FRotatorFixed(FRealFixed(30.0), FRealFixed(-45.0), FRealFixed(60.0)));
+	FQuatFixed B(FRotatorFixed(FRealFixed(-10.0), FRealFixed(90.0), FRealFixed(5.0)));
+	FVectorFixed Vec(FRealFixed(1.5), FRealFixed(-2.25), FRealFixed(1e6));
+	FRealFixed Alpha(0.25);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("QuatFixed"));
+	Suite.Run(TEXT("operator*"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("Inverse"), [&]() { return Opaque(A).Inverse(); });
+	Suite.Run(TEXT("RotateVector"), [&]() { return Opaque(A).RotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("UnrotateVector"), [&]() { return Opaque(A).UnrotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("Slerp"), [&]() { return UQuatFixedMath::Slerp(Opaque(A), Opaque(B), Opaque(Alpha)); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionQuatFloatBenchmark, "SpaceKitPrecision.Benchmarks.QuatFloat", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionQuatFloatBenchmark::RunTest(const FString& Parameters)
+{
+	FQuatFloat A(FRotatorFloat(FRealFloat(30.0), FRealFloat(-45.0), FRealFloat(60.0)));
+	FQuatFloat B(FRotatorFloat(FRealFloat(-10.0), FRealFloat(90.0), FRealFloat(5.0)));
+	FVectorFloat Vec(FRealFloat(1.5), FRealFloat(-2.25), FRealFloat(1e6));
+	FRealFloat Alpha(0.25);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("QuatFloat"));
+	Suite.Run(TEXT("operator*"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("InvQuat"), [&]() { return UQuatFloatMath::InvQuat(Opaque(A)); });
+	Suite.Run(TEXT("RotateVector"), [&]() { return Opaque(A).RotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("UnrotateVector"), [&]() { return Opaque(A).UnrotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("Slerp"), [&]() { return UQuatFloatMath::Slerp(Opaque(A), Opaque(B), Opaque(Alpha)); });
+	Suite.Run(TEXT("ToMatrix"), [&]() { return Opaque(A).ToMatrix(); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionRotatorFixedBenchmark, "SpaceKitPrecision.Benchmarks.RotatorFixed", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionRotatorFixedBenchmark::RunTest(const FString& Parameters)
+{
+	FRotatorFixed A(FRealFixed(30.0), FRealFixed(-45.0), FRealFixed(60.0));
+	FRotatorFixed B(FRealFixed(-10.0), FRealFixed(90.0), FRealFixed(5.0));
+	FVectorFixed Vec(FRealFixed(1.5), FRealFixed(-2.25), FRealFixed(1e6));
+
+	FPrecisionBenchmarkSuite Suite(TEXT("RotatorFixed"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("RotateVector"), [&]() { return Opaque(A).RotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("ToQuat"), [&]() { return FQuatFixed(Opaque(A)); });
+	Suite.Run(TEXT("FromQuat"), [&]() { return FRotatorFixed(FQuatFixed(Opaque(A))); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionRotatorFloatBenchmark, "SpaceKitPrecision.Benchmarks.RotatorFloat", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionRotatorFloatBenchmark::RunTest(const FString& Parameters)
+{
+	FRotatorFloat A(FRealFloat(30.0), FRealFloat(-45.0), FRealFloat(60.0));
+	FRotatorFloat B(FRealFloat(-10.0), FRealFloat(90.0), FRealFloat(5.0));
+	FVectorFloat Vec(FRealFloat(1.5), FRealFloat(-2.25), FRealFloat(1e6));
+
+	TArray<FVectorFloat> Batch;
+	Batch.Init(Vec, 256);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("RotatorFloat"));
+	Suite.Run(TEXT("operator+"), [&]() { return Opaque(A) + Opaque(B); });
+	Suite.Run(TEXT("RotateVector"), [&]() { return Opaque(A).RotateVector(Opaque(Vec)); });
+	Suite.Run(TEXT("ToQuat"), [&]() { return FQuatFloat(Opaque(A)); });
+	Suite.Run(TEXT("FromQuat"), [&]() { return FRotatorFloat(FQuatFloat(Opaque(A))); });
+	Suite.Run(TEXT("RotateVectors(256)"), [&]() { Opaque(A).RotateVectors(Batch); return Batch[0]; });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionTransformFixedBenchmark, "SpaceKitPrecision.Benchmarks.TransformFixed", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionTransformFixedBenchmark::RunTest(const FString& Parameters)
+{
+	FTransformFixed A(FRotatorFixed(FRealFixed(30.0), FRealFixed(-45.0), FRealFixed(60.0)), FVectorFixed(FRealFixed(1e9), FRealFixed(-3.0), FRealFixed(0.5)), FVectorFixed(FRealFixed(2.0), FRealFixed(2.0), FRealFixed(2.0)));
+	FTransformFixed B(FRotatorFixed(FRealFixed(-10.0), FRealFixed(90.0), FRealFixed(5.0)), FVectorFixed(FRealFixed(-7.0), FRealFixed(1e6), FRealFixed(12.0)));
+	FVectorFixed Vec(FRealFixed(1.5), FRealFixed(-2.25), FRealFixed(1e6));
+	FRealFixed Alpha(0.25);
+
+	FPrecisionBenchmarkSuite Suite(TEXT("TransformFixed"));
+	Suite.Run(TEXT("TransformPosition"), [&]() { return Opaque(A).TransformPosition(Opaque(Vec)); });
+	Suite.Run(TEXT("TransformVectorNoScale"), [&]() { return Opaque(A).TransformVectorNoScale(Opaque(Vec)); });
+	Suite.Run(TEXT("InverseTransformPosition"), [&]() { return Opaque(A).InverseTransformPosition(Opaque(Vec)); });
+	Suite.Run(TEXT("operator*"), [&]() { return Opaque(A) * Opaque(B); });
+	Suite.Run(TEXT("Inverse"), [&]() { return Opaque(A).Inverse(); });
+	Suite.Run(TEXT("Lerp"), [&]() { return FTransformFixed::Lerp(Opaque(A), Opaque(B), Opaque(Alpha)); });
+	Suite.Report(*this);
+
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionConversionsBenchmark, "SpaceKitPrecision.Benchmarks.Conversions", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::PerfFilter)
+
+bool FSpacePrecisionConversionsBenchmark::RunTest(const FString& Parameters)
+{
+	double Double = 1234.5678;
+	FRealFixed Fixed(Double);
+	FRealFloat Float(Double);
+	FVectorFixed VecFixed(FRealFixed(1.5), FRealFixed(-2.25), FRealFixed(1e6));
+	FVectorFloat VecFloat(FRealFloat(1.5), FRealFloat(-2.25), FRealFloat(1e6));
+	FVector Vec(1.5, -2.25, 1e6);
+	FString String = TEXT("1234.5678");
+
+	FPrecisionBenchmarkSuite Suite(TEXT("Conversions"));
+	Suite.Run(TEXT("RealFixed from double"), [&]() { return FRealFixed(Opaque(Double)); });
+	Suite.Run(TEXT("RealFixed to double"), [&]() { return Opaque(Fixed).ToDouble(); });
+	Suite.Run(TEXT("RealFloat from double"), [&]() { return FRealFloat(Opaque(Double)); });
+	Suite.Run(TEXT("RealFloat to float"), [&]() { return Opaque(Float).ToFloat(); });
+	Suite.Run(TEXT("RealFixed to RealFloat"), [&]() { return FRealFloat(Opaque(Fixed)); });
+	Suite.Run(TEXT("RealFloat to RealFixed"), [&]() { return FRealFixed(Opaque(Float)); });
+	Suite.Run(TEXT("VectorFixed to VectorFloat"), [&]() { return FVectorFloat(Opaque(VecFixed)); });
+	Suite.Run(TEXT("VectorFloat to VectorFixed"), [&]() { return FVectorFixed(Opaque(VecFloat)); });
+	Suite.Run(TEXT("VectorFixed from FVector"), [&]() { return FVectorFixed(Opaque(Vec)); });
+	Suite.Run(TEXT("VectorFixed to FVector"), [&]() { return Opaque(VecFixed).ToFVector(); });
+	Suite.Run(TEXT("RealFixed to string"), [&]() { return Opaque(Fixed).ToString().Len(); });
+	Suite.Run(TEXT("RealFixed from string"), [&]() { return URealFixedMath::ConvStringToReal(Opaque(String)); });
+	Suite.Run(TEXT("RealFloat to string"), [&]() { return Opaque(Float).ToString().Len(); });
+	Suite.Run(TEXT("RealFloat from string"), [&]() { return URealFloatMath::ConvStringToReal(Opaque(String)); });
+	Suite.Run(TEXT("RealFixed to chars"), [&]() { TCHAR Buffer[FRealFixed::MaxChars]; return Opaque(Fixed).ToChars(Buffer, FRealFixed::MaxChars); });
+	Suite.Run(TEXT("RealFixed from chars"), [&]() { FRealFixed Result; FRealFixed::FromChars(*Opaque(String), Result); return Result; });
+	Suite.Run(TEXT("RealFloat to chars"), [&]() { TCHAR Buffer[FRealFloat::MaxChars]; return Opaque(Float).ToChars(Buffer, FRealFloat::MaxChars); });
+	Suite.Run(TEXT("RealFloat from chars"), [&]() { FRealFloat Result; FRealFloat::FromChars(*Opaque(String), Result); return Result; });
+	Suite.Report(*this);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,70 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/PrecisionBulkImport.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionBulkImportTest, "SpaceKitPrecision.FixedPointMath.BulkImport", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionBulkImportTest::RunTest(const FString& Parameters)
+{
+	// A balance table, as the editor exports data tables
+	FString Csv = TEXT("---,Mass,Position,Label\r\n");
+	for (int32 Row = 0; Row < 1000; ++Row)
+	{
+		Csv += FString::Printf(TEXT("Ship%d,%d.125,\"(X=1e9,Y=%d.5,Z=-0.25)\",\"a, \"\"b\"\"\"\r\n"), Row, Row, Row);
+	}
+
+	FPrecisionImportOptions Options;
+	Options.RealColumns.Add(TEXT("Mass"));
+	Options.VectorColumns.Add(TEXT("Position"));
+	Options.RowsPerTask = 64;
+
+	FPrecisionImportResult Result;
+	TestTrue(TEXT("CSV imported"), FPrecisionBulkImport::ImportCsv(Csv, Options, Result));
+	TestEqual(TEXT("CSV rows"), Result.GetNumRows(), 1000);
+	TestEqual(TEXT("CSV invalid cells"), Result.NumInvalidCells, 0);
+
+	// The rows are in the order of the text, whatever task parsed them
+	bool bInOrder = true;
+	for (int32 Row = 0; Row < Result.GetNumRows(); ++Row)
+	{
+		bInOrder &= Result.RowNames[Row] == FName(*FString::Printf(TEXT("Ship%d"), Row));
+		bInOrder &= Result.Reals[0][Row] == FRealFixed(Row) + 0.125_fx;
+		bInOrder &= Result.Vectors[0][Row] == FVectorFixed(1e9_fx, FRealFixed(Row) + 0.5_fx, -0.25_fx);
+	}
+	TestTrue(TEXT("CSV rows in order"), bInOrder);
+
+	// Same numbers as the single parses
+	TestTrue(TEXT("Same as FRealFixed"), Result.Reals[0][42] == FRealFixed(FString(TEXT("42.125"))));
+
+	Options.RealColumns.Add(TEXT("Speed"));
+	TestFalse(TEXT("Missing column"), FPrecisionBulkImport::ImportCsv(Csv, Options, Result));
+	Options.RealColumns.Pop();
+	TestFalse(TEXT("Missing column with a repeated header"), FPrecisionBulkImport::ImportCsv(TEXT("---,Mass,Mass\r\nShip0,1,2\r\n"), Options, Result));
+
+	// The same table in JSON, numbers as numbers or strings, vectors as objects or strings, one row invalid
+	const FString Json = TEXT("[{\"Name\": \"Ship0\", \"Mass\": 0.125, \"Position\": {\"X\": 1e9, \"Y\": \"0.5\", \"Z\": -0.25}},")
+		TEXT(" {\"Name\": \"Ship1\", \"Label\": \"[1, 2]\", \"Mass\": \"1.125\", \"Position\": \"(X=1e9,Y=-0.5,Z=-0.25)\"},")
+		TEXT(" {\"Name\": \"Ship2\", \"Mass\": \"heavy\"}]");
+	TestTrue(TEXT("JSON imported"), FPrecisionBulkImport::ImportJson(Json, Options, Result));
+	TestEqual(TEXT("JSON rows"), Result.GetNumRows(), 3);
+	TestTrue(TEXT("JSON number"), Result.Reals[0][0] == 0.125_fx && Result.Reals[0][1] == 1.125_fx);
+	TestTrue(TEXT("JSON vectors"), Result.Vectors[0][0] == FVectorFixed(1e9_fx, 0.5_fx, -0.25_fx) && Result.Vectors[0][1] == FVectorFixed(1e9_fx, -0.5_fx, -0.25_fx));
+	TestEqual(TEXT("JSON invalid cells"), Result.NumInvalidCells, 2);
+	TestEqual(TEXT("JSON first invalid row"), Result.FirstInvalidRow, 2);
+	TestFalse(TEXT("Not an array"), FPrecisionBulkImport::ImportJson(TEXT("{\"Mass\": 1}"), Options, Result));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,77 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/PrecisionCanonical.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionCanonicalTest, "SpaceKitPrecision.FixedPointMath.CanonicalEncoding", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionCanonicalTest::RunTest(const FString& Parameters)
+{
+	TArray<FTransformFixed> Transforms;
+	for (int32 Index = 0; Index < 300; ++Index)
+	{
+		Transforms.Add(FTransformFixed(FRotatorFixed(FRealFixed(Index), -45_fx, 0.5_fx), FVectorFixed(1e12_fx, FRealFixed(-Index), 1_fx / 3_fx),
+			FVectorFixed(1_fx, 2_fx, 3_fx)));
+	}
+
+	TArray<uint8> Bytes;
+	FPrecisionCanonicalWriter Writer(Bytes);
+	Writer.Write(1_fx);
+	Writer.Write(Transforms);
+	Writer.Write(FDualVectorRotatorFixed());
+	const int32 ValueBytes = Writer.GetHeader().ValueBytes;
+	TestEqual(TEXT("Encoded size"), Bytes.Num(), PrecisionBinary::CanonicalHeaderSize + (1 + 300 * 9 + 9) * ValueBytes);
+
+	// 1 is 2^REAL_FIXED_EXPONENT, little endian, on every platform
+	TestTrue(TEXT("Magic"), FMemory::Memcmp(Bytes.GetData(), "SKPC", 4) == 0);
+	const uint8* One = Bytes.GetData() + PrecisionBinary::CanonicalHeaderSize;
+	TestEqual(TEXT("Little endian"), One[REAL_FIXED_EXPONENT / 8], uint8(1 << (REAL_FIXED_EXPONENT % 8)));
+
+	FPrecisionCanonicalReader Reader(Bytes);
+	TestTrue(TEXT("Header read"), Reader.IsValid() && !Reader.NeedsConversion());
+	FRealFixed Real;
+	TArray<FTransformFixed> Loaded;
+	FDualVectorRotatorFixed Dual(FVectorFixed(1_fx, 1_fx, 1_fx), FVectorFixed(1_fx, 1_fx, 1_fx), FRotatorFixed(1_fx, 1_fx, 1_fx));
+	TestTrue(TEXT("Structs read"), Reader.Read(Real) && Reader.Read(Loaded, Transforms.Num()) && Reader.Read(Dual));
+	TestTrue(TEXT("Same structs"), Real == 1_fx && Loaded == Transforms && Dual == FDualVectorRotatorFixed());
+	TestFalse(TEXT("Nothing past the end"), Reader.Read(Real));
+
+	// Written by a build with 4 more fraction bits: rounded to the nearest
+	TArray<uint8> Finer;
+	PrecisionBinary::WriteCanonicalHeader(Finer, PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE - 4, REAL_FIXED_EXPONENT + 4, 0));
+	real_fixed_type::ttIntMantissaType Mantissas[2] = { (1_fx).Value.mantissa, (-1_fx).Value.mantissa };
+	Mantissas[0].MulInt(16);
+	Mantissas[0].AddInt(8);
+	Mantissas[1].MulInt(16);
+	Mantissas[1].AddInt(9);
+	Finer.AddUninitialized(2 * ValueBytes);
+	PrecisionBinary::EncodeCanonical(Mantissas, 2, PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE - 4, REAL_FIXED_EXPONENT + 4, 0),
+		Finer.GetData() + PrecisionBinary::CanonicalHeaderSize);
+
+	FPrecisionCanonicalReader Converted(Finer);
+	FRealFixed Converted0, Converted1;
+	TestTrue(TEXT("Needs conversion"), Converted.NeedsConversion());
+	TestTrue(TEXT("Converted"), Converted.Read(Converted0) && Converted.Read(Converted1));
+	TestTrue(TEXT("Tie to even"), Converted0 == 1_fx);
+	TestTrue(TEXT("Rounded to nearest"), Converted1 == -1_fx + FRealFixed(real_fixed_type::FromMantissa(1)));
+	TestEqual(TEXT("Nothing saturated"), Converted.GetNumSaturated(), int64(0));
+
+	FPrecisionCanonicalReader NotCanonical(Bytes.GetData() + 1, Bytes.Num() - 1);
+	TestFalse(TEXT("Not canonical"), NotCanonical.IsValid());
+	TArray<FVectorFixed> NoVectors;
+	TestFalse(TEXT("Nothing read from invalid data"), NotCanonical.Read(NoVectors, 0));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
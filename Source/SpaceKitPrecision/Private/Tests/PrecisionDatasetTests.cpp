@@ -0,0 +1,65 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#include "SpaceKitPrecision/Public/PrecisionDataset.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionDatasetTest, "SpaceKitPrecision.Dataset.MappedPositions", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionDatasetTest::RunTest(const FString& Parameters)
+{
+	// Stars sorted by brightness: the first 16 are LOD 0, the first 256 LOD 1
+	TArray<FVectorFixed> Stars;
+	for (int32 Index = 0; Index < 4096; ++Index)
+	{
+		Stars.Add(FVectorFixed(FRealFixed(Index) * 1e9_fx, FRealFixed(-Index) - 0.5_fx, 1e15_fx));
+	}
+	const TArray<int64> LodCounts = { 16, 256 };
+
+	// Bulk data of the asset, read in place
+	UPrecisionPositionDataset* Asset = NewObject<UPrecisionPositionDataset>();
+	Asset->SetPositions(Stars, LodCounts, EPrecisionDatasetLayout::StructureOfArrays);
+	TestEqual(TEXT("Asset LODs"), Asset->GetNumLods(), 3);
+	TestEqual(TEXT("Asset LOD 1"), Asset->GetNumPositions(1), int64(256));
+	TestEqual(TEXT("Asset positions"), Asset->GetNumPositions(), int64(4096));
+	TestTrue(TEXT("Asset position"), Asset->GetPosition(4000) == Stars[4000]);
+
+	const FPrecisionDatasetView Bright = Asset->GetView(0);
+	TArray<FVectorFixed> Copied;
+	Bright.CopyTo(Copied);
+	TestTrue(TEXT("Asset LOD 0 copied"), Copied == TArray<FVectorFixed>(Stars.GetData(), 16));
+
+	// Loose files, mapped
+	const FString Path = FPaths::AutomationTransientDir() / TEXT("PrecisionDatasetTest.skpd");
+	TestTrue(TEXT("File saved"), FPrecisionMappedDataset::SaveToFile(Path, Stars, LodCounts));
+	{
+		FPrecisionMappedDataset Mapped;
+		if (Mapped.Open(Path))
+		{
+			const FPrecisionDatasetView Lod1 = Mapped.GetView(1);
+			TestEqual(TEXT("Mapped LOD 1"), Lod1.Num(), int64(256));
+			TestTrue(TEXT("Mapped position"), Lod1[255] == Stars[255]);
+			TestTrue(TEXT("Mapped whole dataset"), Mapped.GetView()[4095] == Stars[4095]);
+		}
+		else
+		{
+			AddInfo(TEXT("The platform can't map files"));
+		}
+	}
+	IFileManager::Get().Delete(*Path);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
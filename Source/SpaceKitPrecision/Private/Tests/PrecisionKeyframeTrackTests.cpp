@@ -0,0 +1,87 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "SpaceKitPrecision/Public/PrecisionKeyframeTrack.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionKeyframeTrackTest, "SpaceKitPrecision.FixedPointMath.KeyframeTracks", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionKeyframeTrackTest::RunTest(const FString& Parameters)
+{
+	// An attack trajectory, a key every 1/30 s
+	TArray<FRealFixed> Times;
+	TArray<FTransformFixed> Keys;
+	for (int32 Key = 0; Key < 100; ++Key)
+	{
+		Times.Add(FRealFixed(Key) / 30_fx);
+		Keys.Add(FTransformFixed(FRotatorFixed(0_fx, FRealFixed(Key * 3), 0_fx), FVectorFixed(1e9_fx + FRealFixed(Key * 25), 2_fx, FRealFixed(-Key)),
+			FVectorFixed(1_fx, 1_fx, 1_fx)));
+	}
+
+	TPrecisionKeyframeTrack<FTransformFixed> Track;
+	TestTrue(TEXT("Keys set"), Track.SetKeys(Times, Keys));
+	TestTrue(TEXT("Smaller than the keys"), Track.GetAllocatedSize() * 4 < SIZE_T(Keys.Num()) * 9 * sizeof(real_fixed_type));
+
+	// Samples at the keys are the keys, and between them, interpolated
+	bool bKeysSampled = true;
+	for (int32 Key = 0; Key < Keys.Num(); Key += 7)
+	{
+		bKeysSampled &= Track.Sample(Times[Key]) == Keys[Key];
+	}
+	TestTrue(TEXT("Keys sampled"), bKeysSampled);
+	TestTrue(TEXT("Interpolated"), Track.Sample(Times[10] + 1_fx / 60_fx).Location.Equals(FVectorFixed(1e9_fx + 262.5_fx, 2_fx, -10.5_fx)));
+	TestTrue(TEXT("Clamped before the first key"), Track.Sample(-1_fx) == Keys[0]);
+	TestTrue(TEXT("Clamped after the last key"), Track.Sample(100_fx) == Keys.Last());
+
+	FRealFixed Time;
+	FTransformFixed Key;
+	TestTrue(TEXT("Key decoded"), Track.GetKey(42, Time, Key) && Time == Times[42] && Key == Keys[42]);
+
+	// Playing forward with a cursor gives the same samples
+	TPrecisionKeyframeTrack<FTransformFixed>::FCursor Cursor;
+	bool bSameSamples = true;
+	for (int32 Frame = 0; Frame < 400; ++Frame)
+	{
+		const FRealFixed FrameTime = FRealFixed(Frame) / 120_fx;
+		bSameSamples &= Track.Sample(FrameTime, &Cursor) == Track.Sample(FrameTime);
+	}
+	TestTrue(TEXT("Cursor samples"), bSameSamples);
+
+	// Unsorted keys are skipped
+	TPrecisionKeyframeTrack<FDualVectorRotatorFixed> Sweep;
+	TestTrue(TEXT("Sorted key added"), Sweep.AddKey(1_fx, FDualVectorRotatorFixed()));
+	TestFalse(TEXT("Unsorted key skipped"), Sweep.AddKey(0.5_fx, FDualVectorRotatorFixed()));
+	TestEqual(TEXT("Sweep keys"), Sweep.GetNumKeys(), 1);
+
+	// Saved and loaded with the asset
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << Track;
+	TPrecisionKeyframeTrack<FTransformFixed> Loaded;
+	FMemoryReader Reader(Bytes);
+	Reader << Loaded;
+	TestEqual(TEXT("Loaded keys"), Loaded.GetNumKeys(), Keys.Num());
+	TestTrue(TEXT("Loaded samples"), Loaded.Sample(1.234_fx) == Track.Sample(1.234_fx));
+	TestTrue(TEXT("Key appended after loading"), Loaded.AddKey(4_fx, Keys[0]) && Loaded.Sample(4_fx) == Keys[0]);
+
+	// Layouts from a newer version of the plugin are not read
+	Bytes[0] = PrecisionTrack::FormatVersion + 1;
+	FMemoryReader NewerReader(Bytes);
+	NewerReader << Loaded;
+	TestTrue(TEXT("Newer layout"), NewerReader.IsError() && Loaded.GetNumKeys() == 0);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,175 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#include "SpaceKitPrecision/Public/PrecisionNetSerialization.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// NetSerializes Value to a bit stream, reads it back to Result, and returns the number of bits of the stream
+	template<typename T>
+	int64 NetRoundTrip(T Value, T& Result, bool& bSuccess)
+	{
+		FBitWriter Writer(0, true);
+		bool bWriteSuccess = false;
+		Value.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		bool bReadSuccess = false;
+		Result.NetSerialize(Reader, nullptr, bReadSuccess);
+		bSuccess = bWriteSuccess && bReadSuccess && !Reader.IsError() && Reader.GetBitsLeft() == 0;
+		return Writer.GetNumBits();
+	}
+
+	// Sends Source with NetDeltaSerialize, against OldState, to Destination (or nowhere, as if the packet was lost), and returns the new state of
+	// the connection, or null when nothing changed
+	template<typename T>
+	TSharedPtr<INetDeltaBaseState> SendDelta(T& Source, const TSharedPtr<INetDeltaBaseState>& OldState, T* Destination, int64& NumBits)
+	{
+		FBitWriter Writer(0, true);
+		TSharedPtr<INetDeltaBaseState> NewState;
+		FNetDeltaSerializeInfo WriteParms;
+		WriteParms.Writer = &Writer;
+		WriteParms.OldState = OldState.Get();
+		WriteParms.NewState = &NewState;
+		NumBits = 0;
+		if (!Source.NetDeltaSerialize(WriteParms))
+		{
+			return nullptr;
+		}
+		NumBits = Writer.GetNumBits();
+
+		if (Destination)
+		{
+			FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+			FNetDeltaSerializeInfo ReadParms;
+			ReadParms.Reader = &Reader;
+			Destination->NetDeltaSerialize(ReadParms);
+		}
+		return NewState;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionNetSerializationTest, "SpaceKitPrecision.Net.Serialization", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionNetSerializationTest::RunTest(const FString& Parameters)
+{
+	bool bSuccess;
+
+	// Scalars and vectors are lossless, without the leading zero bits of their mantissas
+	FRealFixed Real;
+	const int64 RealBits = NetRoundTrip(FRealFixed(1000.5), Real, bSuccess);
+	TestTrue(TEXT("Real serialized"), bSuccess);
+	TestEqual(TEXT("Real round trip"), Real, FRealFixed(1000.5));
+	TestEqual(TEXT("Real bits"), RealBits, int64(8 + 1 + 35));
+
+	FVectorFixed Vec;
+	const FVectorFixed Direction(0.6_fx, -0.8_fx, 0_fx);
+	NetRoundTrip(Direction, Vec, bSuccess);
+	TestTrue(TEXT("Vector serialized"), bSuccess);
+	TestTrue(TEXT("Vector round trip"), Vec == Direction);
+
+	// Positions are rounded to their quantum, relative to the anchor
+	const FVectorFixed Position(123456.7_fx, -0.3_fx, 999999.5_fx);
+	FVectorFixed_NetQuantize Quantized;
+	const int64 QuantizedBits = NetRoundTrip(FVectorFixed_NetQuantize(Position), Quantized, bSuccess);
+	TestTrue(TEXT("Quantized position serialized"), bSuccess);
+	TestTrue(TEXT("Position rounded to 1 unit"), Quantized == FVectorFixed(123457_fx, 0_fx, 1000000_fx));
+	TestTrue(TEXT("Position bits"), QuantizedBits <= 3 * 27);
+
+	FVectorFixed_NetQuantize100 Quantized100;
+	NetRoundTrip(FVectorFixed_NetQuantize100(Position), Quantized100, bSuccess);
+	TestTrue(TEXT("Position rounded to 1/128 unit"), (Quantized100 - Position).GetAbsSum() <= FRealFixed(3.0 / 256));
+
+	const FVectorFixed SectorOrigin(1e12_fx, -1e12_fx, 5e11_fx);
+	FPrecisionNetAnchor::Set(SectorOrigin);
+	FVectorFixed_NetQuantize10 Anchored;
+	const int64 AnchoredBits = NetRoundTrip(FVectorFixed_NetQuantize10(SectorOrigin + FVectorFixed(1.5_fx, 2_fx, -3_fx)), Anchored, bSuccess);
+	FPrecisionNetAnchor::Set(FVectorFixed());
+	TestTrue(TEXT("Anchored position serialized"), bSuccess);
+	TestTrue(TEXT("Anchored position round trip"), Anchored == SectorOrigin + FVectorFixed(1.5_fx, 2_fx, -3_fx));
+	TestTrue(TEXT("Anchored position bits"), AnchoredBits <= 3 * (7 + 1 + 6));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionNetDeltaArrayTest, "SpaceKitPrecision.Net.DeltaArray", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionNetDeltaArrayTest::RunTest(const FString& Parameters)
+{
+	FTransformFixedNetDeltaArray Server;
+	FTransformFixedNetDeltaArray Client;
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Server.Items.Add(FTransformFixed(FVectorFixed(FRealFixed(Index * 1000), 2e9_fx, -0.5_fx)));
+	}
+
+	// The first replication sends the whole array, the next ones only the changes
+	int64 FullBits;
+	TSharedPtr<INetDeltaBaseState> Acked = SendDelta(Server, nullptr, &Client, FullBits);
+	TestTrue(TEXT("Whole array received"), Client.Items == Server.Items);
+
+	int64 NumBits;
+	TestFalse(TEXT("Nothing sent without changes"), SendDelta(Server, Acked, &Client, NumBits).IsValid());
+
+	auto MoveSome = [&Server]()
+	{
+		for (int32 Index = 0; Index < Server.Items.Num(); Index += 10)
+		{
+			Server.Items[Index].Location.X += 0.25_fx;
+		}
+	};
+	MoveSome();
+	Acked = SendDelta(Server, Acked, &Client, NumBits);
+	TestTrue(TEXT("Changes received"), Client.Items == Server.Items);
+	TestTrue(TEXT("Changes are smaller than the array"), NumBits * 10 < FullBits);
+
+	// A lost delta: on its NAK, the engine rolls the state of the connection back to the acknowledged one, and the retransmission is against it,
+	// even without changes since the lost delta
+	MoveSome();
+	TSharedPtr<INetDeltaBaseState> Lost = SendDelta(Server, Acked, (FTransformFixedNetDeltaArray*)nullptr, NumBits);
+	TestTrue(TEXT("Lost delta sent"), Lost.IsValid());
+	TestFalse(TEXT("Lost delta not received"), Client.Items == Server.Items);
+	Acked = SendDelta(Server, Acked, &Client, NumBits);
+	TestTrue(TEXT("Retransmission sent"), Acked.IsValid());
+	TestTrue(TEXT("Retransmission applied"), Client.Items == Server.Items);
+
+	// The deltas sent against the lost state before its NAK are dropped, until the one against the acknowledged state
+	MoveSome();
+	Lost = SendDelta(Server, Acked, (FTransformFixedNetDeltaArray*)nullptr, NumBits);
+	MoveSome();
+	SendDelta(Server, Lost, &Client, NumBits);
+	TestFalse(TEXT("Delta against a lost state dropped"), Client.Items == Server.Items);
+	Acked = SendDelta(Server, Acked, &Client, NumBits);
+	TestTrue(TEXT("Delta against the acknowledged state applied"), Client.Items == Server.Items);
+	TestFalse(TEXT("Nothing sent once received"), SendDelta(Server, Acked, &Client, NumBits).IsValid());
+
+	// Removed items, and baseline resets
+	Server.Items.SetNum(50);
+	Acked = SendDelta(Server, Acked, &Client, NumBits);
+	TestEqual(TEXT("Items removed"), Client.Items.Num(), 50);
+
+	Server.ResetBaseline();
+	Acked = SendDelta(Server, Acked, &Client, NumBits);
+	TestTrue(TEXT("Baseline reset sends the whole array"), Acked.IsValid() && NumBits * 2 > FullBits);
+	TestTrue(TEXT("Whole array received again"), Client.Items == Server.Items);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,67 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/PrecisionPredicates.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionPredicatesTest, "SpaceKitPrecision.Predicates", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+// Runs the same cases on both vector types. Points are offset far away from the origin, so that the degenerate cases can't be decided in double
+template<typename VecType, typename RealType>
+static void TestPredicates(FAutomationTestBase& Test, const TCHAR* TypeName, const RealType& Offset)
+{
+	const VecType O(Offset, Offset, Offset);
+	const auto Point = [&O](const char* X, const char* Y, const char* Z) { return O + VecType(RealType(X), RealType(Y), RealType(Z)); };
+
+	// Orientation: A, B and C are counterclockwise in the z = 0 plane
+	const VecType A = Point("1", "0", "0");
+	const VecType B = Point("0", "1", "0");
+	const VecType C = Point("-1", "0", "0");
+	Test.TestEqual(FString::Printf(TEXT("%s Orient3D coplanar"), TypeName), FPrecisionPredicates::Orient3D(A, B, C, Point("0.5", "0.25", "0")), 0);
+	Test.TestEqual(FString::Printf(TEXT("%s Orient3D above"), TypeName), FPrecisionPredicates::Orient3D(A, B, C, Point("0", "0", "0.25")), -1);
+	Test.TestEqual(FString::Printf(TEXT("%s Orient3D below"), TypeName), FPrecisionPredicates::Orient3D(A, B, C, Point("0", "0", "-0.25")), 1);
+
+	// In-sphere, on the unit sphere around O. D is chosen so that Orient3D(A, B, C, D) is positive
+	const VecType D = Point("0", "0", "-1");
+	Test.TestEqual(FString::Printf(TEXT("%s Orient3D of the sphere points"), TypeName), FPrecisionPredicates::Orient3D(A, B, C, D), 1);
+	Test.TestEqual(FString::Printf(TEXT("%s InSphere on"), TypeName), FPrecisionPredicates::InSphere(A, B, C, D, Point("0", "-1", "0")), 0);
+	Test.TestEqual(FString::Printf(TEXT("%s InSphere inside"), TypeName), FPrecisionPredicates::InSphere(A, B, C, D, Point("0", "-0.5", "0")), 1);
+	Test.TestEqual(FString::Printf(TEXT("%s InSphere outside"), TypeName), FPrecisionPredicates::InSphere(A, B, C, D, Point("0", "-1.5", "0")), -1);
+
+	// Distance: a 3-4-5 triangle
+	const VecType Far = Point("3", "4", "0");
+	Test.TestEqual(FString::Printf(TEXT("%s CompareDistance equal"), TypeName), FPrecisionPredicates::CompareDistance(O, Far, RealType("5")), 0);
+	Test.TestEqual(FString::Printf(TEXT("%s CompareDistance farther"), TypeName), FPrecisionPredicates::CompareDistance(O, Far, RealType("4.99")), 1);
+	Test.TestEqual(FString::Printf(TEXT("%s CompareDistance closer"), TypeName), FPrecisionPredicates::CompareDistance(O, Far, RealType("5.01")), -1);
+	Test.TestEqual(FString::Printf(TEXT("%s CompareDistance negative distance"), TypeName), FPrecisionPredicates::CompareDistance(O, O, RealType("-1")), 1);
+
+	// Dot sign, with orthogonal vectors and a nearly orthogonal one
+	const VecType X(RealType("1"), RealType("1"), RealType("0"));
+	Test.TestEqual(FString::Printf(TEXT("%s DotSign orthogonal"), TypeName), FPrecisionPredicates::DotSign(X, VecType(RealType("1"), RealType("-1"), RealType("0.001"))), 0);
+	Test.TestEqual(FString::Printf(TEXT("%s DotSign nearly orthogonal"), TypeName), FPrecisionPredicates::DotSign(X + VecType(RealType("0"), RealType("0"), RealType("0.001")), VecType(RealType("1"), RealType("-1"), RealType("-0.001"))), -1);
+	Test.TestEqual(FString::Printf(TEXT("%s DotSign same side"), TypeName), FPrecisionPredicates::DotSign(X, X), 1);
+}
+
+bool FSpacePrecisionPredicatesTest::RunTest(const FString& Parameters)
+{
+	TestPredicates<FVectorFloat, FRealFloat>(*this, TEXT("VectorFloat"), FRealFloat("100000000000000000000"));
+	TestPredicates<FVectorFixed, FRealFixed>(*this, TEXT("VectorFixed"), FRealFixed("100000000000000000000"));
+
+	// Blueprint nodes use the same predicates
+	TestEqual(TEXT("Blueprint Orient3D"), UVectorFixedMath::Orient3D(FVectorFixed(1, 0, 0), FVectorFixed(0, 1, 0), FVectorFixed(-1, 0, 0), FVectorFixed(0, 0, -1)), 1);
+	TestEqual(TEXT("Blueprint DotSign"), UVectorFloatMath::DotSign(FVectorFloat(1, 0, 0), FVectorFloat(-1, 0, 0)), -1);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,71 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#include "SpaceKitPrecision/Public/PrecisionReplay.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionReplayTest, "SpaceKitPrecision.Determinism.Replay", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionReplayTest::RunTest(const FString& Parameters)
+{
+	FPrecisionReplayRecorder Recorder;
+	Recorder.RecordWorkload(7, 2000);
+	TestEqual(TEXT("Recorded operations"), Recorder.GetNumOps(), int64(2000));
+
+	// The operations run through the recorder return their results
+	const FRealFixed Three(3);
+	const FRealFixed Four(4);
+	TestEqual(TEXT("Recorded fixed-point operation"), Recorder.Run(EPrecisionReplayOp::FixedMultiply, Three, Four), FRealFixed(12));
+	TestEqual(TEXT("Recorded big float operation"), Recorder.Run(EPrecisionReplayOp::FloatSqrt, FRealFloat(16)), FRealFloat(4));
+	TestEqual(TEXT("Operations of the other type are not recorded"), Recorder.Run(EPrecisionReplayOp::FloatAdd, Three, Four), FRealFixed());
+	TestEqual(TEXT("Recorded operations"), Recorder.GetNumOps(), int64(2002));
+
+	// The same build gives the same results
+	FPrecisionReplayReport Report = FPrecisionReplay::Replay(Recorder.GetTrace());
+	TestTrue(*Report.ToString(), Report.IsOk());
+	TestEqual(TEXT("Replayed operations"), Report.NumOps, int64(2002));
+
+	// Truncated traces are reported
+	TArray<uint8> Trace = Recorder.GetTrace();
+	Trace.SetNum(Trace.Num() - 3);
+	Report = FPrecisionReplay::Replay(Trace);
+	TestFalse(TEXT("Truncated trace"), Report.Error.IsEmpty());
+
+	// A wrong result is pinpointed: change the lowest byte of the result of 3 * 4, which is followed by its rolling hash and the square root
+	Trace = Recorder.GetTrace();
+	const int32 FloatSize = int32(sizeof(ttmath::uint)) * (int32(PrecisionReplay::TFloatTraits<tt_real_float_type>::MantissaWords + PrecisionReplay::TFloatTraits<tt_real_float_type>::ExponentWords)) + 1;
+	const int32 FixedSize = int32(sizeof(ttmath::uint) * PrecisionReplay::TFixedTraits<real_fixed_type>::Words);
+	const int32 LastFixedResult = Trace.Num() - (8 + 2 * FloatSize + 1) - 8 - FixedSize;
+	Trace[LastFixedResult] ^= 1;
+	Report = FPrecisionReplay::Replay(Trace);
+	TestEqual(TEXT("First divergent operation"), Report.FirstDivergentOp, int64(2000));
+	TestEqual(TEXT("Divergent function"), Report.Function, FString(TEXT("FixedMultiply")));
+
+	// The trace of this build is saved, for other builds to replay, and the traces saved by other builds are replayed
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PrecisionReplay"));
+	const FString BuildTrace = FPaths::Combine(Directory, FString(ANSI_TO_TCHAR(ttmath::UInt<1>::LibTypeStr())) + TEXT(".skpt"));
+	TestTrue(TEXT("Trace saved"), Recorder.SaveToFile(BuildTrace));
+
+	TArray<FString> OtherTraces;
+	IFileManager::Get().FindFiles(OtherTraces, *FPaths::Combine(Directory, TEXT("*.skpt")), true, false);
+	for (const FString& OtherTrace : OtherTraces)
+	{
+		Report = FPrecisionReplay::ReplayFile(FPaths::Combine(Directory, OtherTrace));
+		TestTrue(FString::Printf(TEXT("%s: %s"), *OtherTrace, *Report.ToString()), Report.IsOk());
+	}
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,88 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/PrecisionSnapshot.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionSnapshotTest, "SpaceKitPrecision.Determinism.Snapshots", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionSnapshotTest::RunTest(const FString& Parameters)
+{
+	// Fighters that move every frame, and a static arena, captured with dirty tracking
+	TArray<FTransformFixed> Fighters;
+	Fighters.SetNum(2);
+	TArray<FVectorFixed> Arena;
+	Arena.Init(FVectorFixed(100_fx, 0_fx, 0_fx), 256);
+
+	FPrecisionStateHasher Hasher;
+	FPrecisionSnapshotBuffer Snapshots(8, &Hasher);
+	const int32 FightersBlock = Snapshots.AddBlock(Fighters);
+	const int32 ArenaBlock = Snapshots.AddBlock(Arena, true);
+
+	auto Simulate = [&](int32 Frame)
+	{
+		Fighters[0].Location.X = FRealFixed(Frame) * 1.5_fx;
+		Fighters[1].Rotation.Yaw = FRealFixed(Frame * 3);
+		Snapshots.MarkDirty(FightersBlock);
+	};
+
+	TArray<uint64> Checksums;
+	for (int32 Frame = 0; Frame < 12; ++Frame)
+	{
+		Simulate(Frame);
+		Snapshots.Capture(Frame);
+		Checksums.Add(Hasher.GetChecksum());
+	}
+	TestEqual(TEXT("Clean blocks are not copied"), Snapshots.GetLastCopiedBytes(), int64(Fighters.Num() * sizeof(FTransformFixed)));
+	TestFalse(TEXT("Frames older than the buffer are forgotten"), Snapshots.HasFrame(3));
+
+	// Rolling back restores the state, and its checksum
+	Arena[10].Z = 5_fx;
+	Snapshots.MarkDirty(ArenaBlock, 10);
+	TestTrue(TEXT("Rollback"), Snapshots.Restore(6));
+	TestTrue(TEXT("Restored fighter"), Fighters[0].Location.X == 9_fx && Fighters[1].Rotation.Yaw == 18_fx);
+	TestTrue(TEXT("Restored arena"), Arena[10] == FVectorFixed(100_fx, 0_fx, 0_fx));
+	TestFalse(TEXT("Frames after the rollback are forgotten"), Snapshots.HasFrame(7));
+	uint64 Checksum = 0;
+	TestTrue(TEXT("Checksum of the frame"), Snapshots.GetChecksum(6, Checksum) && Checksum == Checksums[6]);
+	TestEqual(TEXT("Checksum of the restored state"), Hasher.GetChecksum(), Checksums[6]);
+
+	// Simulating again from the restored frame gives the same frames
+	for (int32 Frame = 7; Frame < 10; ++Frame)
+	{
+		Simulate(Frame);
+		Snapshots.Capture(Frame);
+		TestEqual(TEXT("Resimulated checksum"), Hasher.GetChecksum(), Checksums[Frame]);
+	}
+	TestTrue(TEXT("Rollback after resimulation"), Snapshots.Restore(4) && Fighters[0].Location.X == 6_fx);
+	TestEqual(TEXT("Unchanged blocks are not restored"), Snapshots.GetLastCopiedBytes(), int64(Fighters.Num() * sizeof(FTransformFixed)));
+
+	// The frames forgotten by a rollback stay forgotten when the next frames are captured with a gap
+	for (const int32 Frame : { 5, 6, 8 })
+	{
+		Simulate(Frame);
+		Snapshots.Capture(Frame);
+	}
+	TestTrue(TEXT("Frame captured after the rollback"), Snapshots.HasFrame(6));
+	TestFalse(TEXT("Frame skipped after the rollback"), Snapshots.HasFrame(7));
+
+	// Same when a frame is captured again without restoring it first
+	Simulate(6);
+	Snapshots.Capture(6);
+	Simulate(9);
+	Snapshots.Capture(9);
+	TestFalse(TEXT("Frame skipped after capturing again"), Snapshots.HasFrame(8));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
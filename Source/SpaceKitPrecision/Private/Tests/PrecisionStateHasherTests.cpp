@@ -0,0 +1,69 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/PrecisionStateHasher.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionStateHasherTest, "SpaceKitPrecision.Determinism.StateHasher", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionStateHasherTest::RunTest(const FString& Parameters)
+{
+	// Equal values have equal hashes, so the precision structs can be keys of TMap and TSet
+	TestEqual(TEXT("Equal numbers"), GetTypeHash(FRealFixed(1.5)), GetTypeHash(1.5_fx));
+	TestNotEqual(TEXT("Different numbers"), GetTypeHash(FRealFixed(1.5)), GetTypeHash(-1.5_fx));
+	TSet<FVectorFixed> Positions;
+	Positions.Add(FVectorFixed(1_fx, 2_fx, 3_fx));
+	Positions.Add(FVectorFixed(1_fx, 2_fx, 3_fx));
+	Positions.Add(FVectorFixed(3_fx, 2_fx, 1_fx));
+	TestEqual(TEXT("Set of vectors"), Positions.Num(), 2);
+
+	// A world of entities, with their transforms and speeds
+	TArray<FTransformFixed> Transforms;
+	TArray<FRealFixed> Speeds;
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		Transforms.Add(FTransformFixed(FVectorFixed(FRealFixed(Index), FRealFixed(Index * 2), 1e9_fx)));
+		Speeds.Add(FRealFixed(Index % 7));
+	}
+
+	FPrecisionStateHasher Hasher;
+	const int32 TransformsIndex = Hasher.AddArray(Transforms);
+	Hasher.AddArray(Speeds);
+	const uint64 Checksum = Hasher.GetChecksum();
+	TestEqual(TEXT("First checksum hashes everything"), Hasher.GetNumChunksHashed(), 2 * 16);
+	TestEqual(TEXT("Same state, same checksum"), Hasher.GetChecksum(), Checksum);
+	TestEqual(TEXT("Clean chunks are not hashed again"), Hasher.GetNumChunksHashed(), 0);
+
+	// Only the chunks of the changed elements are hashed again, and the checksum matches a full one
+	Transforms[500].Location.Z += 0.001_fx;
+	Hasher.MarkDirty(TransformsIndex, 500);
+	const uint64 Changed = Hasher.GetChecksum();
+	TestNotEqual(TEXT("Changed state, changed checksum"), Changed, Checksum);
+	TestEqual(TEXT("One chunk hashed"), Hasher.GetNumChunksHashed(), 1);
+
+	FPrecisionStateHasher FullHasher;
+	FullHasher.AddArray(Transforms);
+	FullHasher.AddArray(Speeds);
+	TestEqual(TEXT("Incremental checksum"), FullHasher.GetChecksum(), Changed);
+
+	// Restoring the state restores the checksum
+	Transforms[500].Location.Z -= 0.001_fx;
+	Hasher.MarkAllDirty();
+	TestEqual(TEXT("Restored checksum"), Hasher.GetChecksum(), Checksum);
+	TestEqual(TEXT("Restored state hashed again"), Hasher.GetNumChunksHashed(), 2 * 16);
+
+	TestNotEqual(TEXT("Hash of an array"), FPrecisionStateHasher::HashArray(Speeds.GetData(), Speeds.Num()), FPrecisionStateHasher::HashArray(Speeds.GetData(), 999));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+#endif //WITH_DEV_AUTOMATION_TESTS
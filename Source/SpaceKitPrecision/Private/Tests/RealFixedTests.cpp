@@ -3,8 +3,13 @@
 #include "CoreTypes.h"
 #include "Containers/UnrealString.h"
 #include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Public/Conversions.h"
+#include "SpaceKitPrecision/Public/TransformFixed.h"
+#include "SpaceKitPrecision/Public/VectorFloat.h"
 
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -171,4 +176,189 @@ bool FCoreMathFixedLimitsTest::RunTest(const FString& Parameters)
 #pragma optimize("", on)
 
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoreMathFixedFloatConversionsTest, "SpaceKitPrecision.FixedPointMath.FloatConversions", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FCoreMathFixedFloatConversionsTest::RunTest(const FString& Parameters)
+{
+	const FRealFixed Quantum = FRealFixed::GetMinValue();
+
+	// Fixed -> float -> fixed is lossless, including the smallest and biggest values
+	const FRealFixed RoundTripValues[] = { 0_fx, 1_fx, -1_fx, 0.1_fx, -123456789.987654321_fx, Quantum, -Quantum, FRealFixed::GetMaxValue(), -FRealFixed::GetMaxValue() };
+	for (const FRealFixed& Val : RoundTripValues)
+	{
+		TestEqual(FString::Printf(TEXT("Round trip of %s"), *Val.ToString()), FRealFixed(FRealFloat(Val)), Val);
+	}
+
+	// Float -> fixed rounds to the nearest quantum, ties away from zero
+	const FRealFloat FloatQuantum = FRealFloat(Quantum);
+	TestEqual(TEXT("0.49 quantum rounds to 0"), FRealFixed(FloatQuantum * FRealFloat(0.49)), 0_fx);
+	TestEqual(TEXT("0.5 quantum rounds to 1 quantum"), FRealFixed(FloatQuantum * FRealFloat(0.5)), Quantum);
+	TestEqual(TEXT("1.5 quantum rounds to 2 quanta"), FRealFixed(FloatQuantum * FRealFloat(1.5)), Quantum + Quantum);
+	TestEqual(TEXT("-1.5 quantum rounds to -2 quanta"), FRealFixed(FloatQuantum * FRealFloat(-1.5)), -(Quantum + Quantum));
+
+	// Out of range values are clamped instead of wrapping around
+	TestEqual(TEXT("Too big value is clamped"), FRealFixed(1e40_fl), FRealFixed::GetMaxValue());
+	TestEqual(TEXT("Too small value is clamped"), FRealFixed(-1e40_fl), -FRealFixed::GetMaxValue());
+
+	// Vectors and rotators convert component-wise, keeping each component in place
+	const FVectorFixed Vec(1.5_fx, -2.25_fx, 0.1_fx);
+	const FVectorFloat VecFloat = UPrecisionConversionMath::ConvVectorFixedToVectorFloat(Vec);
+	TestEqual(TEXT("Vector to float Y"), VecFloat.Y, -2.25_fl);
+	TestTrue(TEXT("Vector round trip"), UPrecisionConversionMath::ConvVectorFloatToVectorFixed(VecFloat) == Vec);
+
+	const FRotatorFixed Rot(10_fx, 20_fx, 30_fx);
+	const FRotatorFloat RotFloat = UPrecisionConversionMath::ConvRotatorFixedToRotatorFloat(Rot);
+	TestEqual(TEXT("Rotator to float pitch"), RotFloat.Pitch, 10_fl);
+	TestEqual(TEXT("Rotator to float yaw"), RotFloat.Yaw, 20_fl);
+	TestEqual(TEXT("Rotator to float roll"), RotFloat.Roll, 30_fl);
+	TestTrue(TEXT("Rotator round trip"), UPrecisionConversionMath::ConvRotatorFloatToRotatorFixed(RotFloat) == Rot);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoreMathFixedStringConversionsTest, "SpaceKitPrecision.FixedPointMath.StringConversions", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FCoreMathFixedStringConversionsTest::RunTest(const FString& Parameters)
+{
+	// The shortest fraction that converts back to the same number, with the sign of the numbers between -1 and 0
+	TestEqual(TEXT("Integer to string"), (3_fx).ToString(), FString(TEXT("3.0")));
+	TestEqual(TEXT("Fraction to string"), (0.1_fx).ToString(), FString(TEXT("0.1")));
+	TestEqual(TEXT("Negative fraction to string"), (-0.5_fx).ToString(), FString(TEXT("-0.5")));
+
+	// String -> fixed -> string -> fixed is lossless, including the smallest and biggest values
+	const FRealFixed Quantum = FRealFixed::GetMinValue();
+	const FRealFixed RoundTripValues[] = { 0_fx, -123456789.987654321_fx, Quantum, -Quantum, FRealFixed::GetMaxValue(), -FRealFixed::GetMaxValue() };
+	for (const FRealFixed& Val : RoundTripValues)
+	{
+		TestEqual(FString::Printf(TEXT("String round trip of %s"), *Val.ToString()), FRealFixed(Val.ToString()), Val);
+	}
+
+	// ToChars needs MaxChars characters, and FromChars stops at the end of the number
+	TCHAR Buffer[FRealFixed::MaxChars];
+	TestEqual(TEXT("Too small buffer"), (1_fx).ToChars(Buffer, 3), 0);
+	TestEqual(TEXT("Characters written"), (-2.25_fx).ToChars(Buffer, FRealFixed::MaxChars), 5);
+
+	FRealFixed Parsed;
+	TestEqual(TEXT("Characters read"), FRealFixed::FromChars(TEXT("1.5e2)"), Parsed), 5);
+	TestEqual(TEXT("Exponent read"), Parsed, 150_fx);
+	TestEqual(TEXT("Not a number"), FRealFixed::FromChars(TEXT("x"), Parsed), 0);
+
+	// Parsing rounds to the nearest quantum: 0.7 quantum is 1 quantum, where the old truncation gave 0
+	TestEqual(TEXT("Parsed to the nearest quantum"), FRealFixed((FRealFloat(Quantum) * 0.7_fl).ToString()), Quantum);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoreMathFixedTextImportTest, "SpaceKitPrecision.FixedPointMath.TextImport", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FCoreMathFixedTextImportTest::RunTest(const FString& Parameters)
+{
+	// Each import reads its token, and leaves the buffer after it
+	const TCHAR* Buffer = TEXT("(1.5),( -2.25 ),3");
+	FRealFixed Value;
+	TestTrue(TEXT("Parenthesized import"), Value.ImportTextItem(Buffer, PPF_None, nullptr, nullptr));
+	TestEqual(TEXT("Parenthesized value"), Value, 1.5_fx);
+	TestEqual(TEXT("Buffer after the token"), *Buffer, TEXT(','));
+	++Buffer;
+	TestTrue(TEXT("Import with blanks"), Value.ImportTextItem(Buffer, PPF_None, nullptr, nullptr));
+	TestEqual(TEXT("Value with blanks"), Value, -2.25_fx);
+	++Buffer;
+	TestTrue(TEXT("Bare import"), Value.ImportTextItem(Buffer, PPF_None, nullptr, nullptr));
+	TestEqual(TEXT("Bare value"), Value, 3_fx);
+	TestEqual(TEXT("Buffer at the end"), *Buffer, TEXT('\0'));
+
+	// Invalid tokens leave the value and the buffer alone
+	const TCHAR* Invalid = TEXT("(1.5");
+	TestFalse(TEXT("Unclosed parenthesis"), Value.ImportTextItem(Invalid, PPF_None, nullptr, nullptr));
+	TestEqual(TEXT("Value after a failed import"), Value, 3_fx);
+	TestEqual(TEXT("Buffer after a failed import"), *Invalid, TEXT('('));
+
+	FRealFloat FloatValue;
+	const TCHAR* FloatBuffer = TEXT("(1e+22))");
+	TestTrue(TEXT("Big float import"), FloatValue.ImportTextItem(FloatBuffer, PPF_None, nullptr, nullptr));
+	TestEqual(TEXT("Big float value"), FloatValue, 1e22_fl);
+	TestEqual(TEXT("Buffer after the big float"), *FloatBuffer, TEXT(')'));
+
+	// Vectors and transforms import their components through the same tokens, and export/import round trips
+	FVectorFixed Vec;
+	FVectorFixed::StaticStruct()->ImportText(TEXT("(X=(1.5),Y=(-0.1),Z=(1000000.0))"), &Vec, nullptr, PPF_None, nullptr, TEXT("FVectorFixed"));
+	TestTrue(TEXT("Vector import"), Vec == FVectorFixed(1.5_fx, -0.1_fx, 1000000_fx));
+
+	FTransformFixed Transform;
+	Transform.Location = Vec;
+	FString Exported;
+	FTransformFixed::StaticStruct()->ExportText(Exported, &Transform, nullptr, nullptr, PPF_None, nullptr);
+	FTransformFixed Imported;
+	FTransformFixed::StaticStruct()->ImportText(*Exported, &Imported, nullptr, PPF_None, nullptr, TEXT("FTransformFixed"));
+	TestEqual(TEXT("Transform round trip"), Imported.ToString(), Transform.ToString());
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoreMathFixedBinarySerializationTest, "SpaceKitPrecision.FixedPointMath.BinarySerialization", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FCoreMathFixedBinarySerializationTest::RunTest(const FString& Parameters)
+{
+	// The structs are saved as the words of their mantissas, and nothing else
+	FTransformFixed Transform(FRotatorFixed(10_fx, -20.5_fx, 0_fx), FVectorFixed(1e12_fx, -0.1_fx, 3_fx));
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	TestTrue(TEXT("Transform saved"), Transform.Serialize(Writer));
+	TestEqual(TEXT("Transform size"), Bytes.Num(), int32(9 * sizeof(real_fixed_type::ttIntMantissaType)));
+
+	FTransformFixed Loaded;
+	FMemoryReader Reader(Bytes);
+	Reader.SetCustomVersions(Writer.GetCustomVersions());
+	TestTrue(TEXT("Transform loaded"), Loaded.Serialize(Reader));
+	TestTrue(TEXT("Transform round trip"), Loaded == Transform);
+
+	FRealFloat Float = 1_fl / 3_fl;
+	Bytes.Reset();
+	FMemoryWriter FloatWriter(Bytes);
+	FloatWriter << Float;
+	FRealFloat LoadedFloat;
+	FMemoryReader FloatReader(Bytes);
+	FloatReader << LoadedFloat;
+	TestEqual(TEXT("Big float round trip"), LoadedFloat, Float);
+
+	// Data saved as tagged properties is left to the engine
+	FMemoryReader OldReader(Bytes);
+	OldReader.SetCustomVersion(FPrecisionCustomVersion::GUID, FPrecisionCustomVersion::BeforeCustomVersionWasAdded, TEXT("SpaceKitPrecisionVer"));
+	TestFalse(TEXT("Tagged properties"), Loaded.Serialize(OldReader));
+
+	// The engine uses the native serialization and operator==
+	UScriptStruct::ICppStructOps* StructOps = FTransformFixed::StaticStruct()->GetCppStructOps();
+	TestTrue(TEXT("Native serializer"), StructOps->HasSerializer());
+	TestTrue(TEXT("Identical via equality"), StructOps->HasIdentical());
+	TestTrue(TEXT("Identical transforms"), FTransformFixed::StaticStruct()->CompareScriptStruct(&Loaded, &Transform, PPF_None));
+	Loaded.Location.X.Value.mantissa.AddOne();
+	TestFalse(TEXT("Different transforms"), FTransformFixed::StaticStruct()->CompareScriptStruct(&Loaded, &Transform, PPF_None));
+
+	// The float vectors compare exactly, even though operator== has a tolerance
+	const FVectorFloat FloatVector(FRealFloat(1), FRealFloat(2), FRealFloat(3));
+	const FVectorFloat NearFloatVector(FRealFloat(1), FRealFloat(2), FRealFloat(3) + FRealFloat(1.0e-12));
+	TestTrue(TEXT("Equal within tolerance"), FloatVector == NearFloatVector);
+	TestTrue(TEXT("Identical float vectors"), FVectorFloat::StaticStruct()->CompareScriptStruct(&FloatVector, &FloatVector, PPF_None));
+	TestFalse(TEXT("Different float vectors"), FVectorFloat::StaticStruct()->CompareScriptStruct(&FloatVector, &NearFloatVector, PPF_None));
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+
 #endif //WITH_DEV_AUTOMATION_TESTS
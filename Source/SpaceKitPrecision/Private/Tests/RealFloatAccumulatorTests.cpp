@@ -0,0 +1,101 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#include "CoreTypes.h"
+#include "Containers/UnrealString.h"
+#include "Misc/AutomationTest.h"
+
+#include "SpaceKitPrecision/Public/RealFloatAccumulator.h"
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionFloatAccumulatorTest, "SpaceKitPrecision.FloatingPointMath.Accumulator", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionFloatAccumulatorTest::RunTest(const FString& Parameters)
+{
+	// Values that cancel out don't swallow the small ones
+	FRealFloatAccumulator Accumulator;
+	Accumulator.Add(1e30_fl);
+	Accumulator.Add(1_fl);
+	Accumulator.Add(-1e30_fl);
+	TestEqual(TEXT("Cancellation is exact"), Accumulator.GetResult(), 1_fl);
+
+	Accumulator.Reset();
+	Accumulator.Add(-2.5_fl);
+	Accumulator.Add(-1e-40_fl);
+	TestEqual(TEXT("Negative sums are rounded to nearest"), Accumulator.GetResult(), -2.5_fl);
+
+	// The result doesn't depend on the order of the additions, nor on how partial sums are merged
+	TArray<FRealFloat> Values;
+	FRandomStream Random(42);
+	for (int32 i = 0; i < 5000; ++i)
+	{
+		Values.Add(FRealFloat(Random.FRandRange(-1.0f, 1.0f)) * URealFloatMath::Pow(10_fl, FRealFloat(Random.RandRange(-20, 20))));
+	}
+
+	TArray<FRealFloat> Reversed;
+	for (int32 i = Values.Num() - 1; i >= 0; --i)
+	{
+		Reversed.Add(Values[i]);
+	}
+
+	const FRealFloat Sum = FRealFloatAccumulator::Sum(Values);
+	TestTrue(TEXT("Sum doesn't depend on the order"), FRealFloatAccumulator::Sum(Reversed).Value == Sum.Value);
+	TestTrue(TEXT("ParallelSum gives the same bits as Sum"), FRealFloatAccumulator::ParallelSum(Values).Value == Sum.Value);
+
+	FRealFloatAccumulator FirstHalf;
+	FRealFloatAccumulator SecondHalf;
+	for (int32 i = 0; i < Values.Num(); ++i)
+	{
+		(i < Values.Num() / 2 ? FirstHalf : SecondHalf).Add(Values[i]);
+	}
+	SecondHalf.Merge(FirstHalf);
+	TestTrue(TEXT("Merged partial sums give the same bits as Sum"), SecondHalf.GetResult().Value == Sum.Value);
+
+	// Dot products don't round the products
+	const TArray<FRealFloat> A = { 1e20_fl, 1_fl, -1e20_fl };
+	const TArray<FRealFloat> B = { 1e20_fl, 3_fl, 1e20_fl };
+	TestEqual(TEXT("Dot is exact"), FRealFloatAccumulator::Dot(A, B), 3_fl);
+
+	// Mean
+	const TArray<FRealFloat> Mean = { 1_fl, 2_fl, 3_fl, 4_fl };
+	TestEqual(TEXT("Mean"), FRealFloatAccumulator::Mean(Mean), 2.5_fl);
+	TestEqual(TEXT("Mean of an empty array"), FRealFloatAccumulator::Mean(TArray<FRealFloat>()), 0_fl);
+
+	// The quotient is rounded once: 1 + half an ulp + a tiny value is just above the tie, and rounds up. Rounding the sum first would drop the tiny value, and the tie would round down to 1
+	constexpr int32 SignificandBits = int32(sizeof(FRealFloat::ttBigType::mantissa) * 8);
+	FRealFloat HalfUlp = 1_fl;
+	FRealFloat Tiny = 1_fl;
+	HalfUlp.Value.exponent.SubInt(SignificandBits);
+	Tiny.Value.exponent.SubInt(4 * SignificandBits);
+	Accumulator.Reset();
+	Accumulator.Add(1_fl);
+	Accumulator.Add(HalfUlp);
+	Accumulator.Add(Tiny);
+	TestEqual(TEXT("Division rounds once"), Accumulator.GetResultDividedBy(1), 1_fl + (HalfUlp + HalfUlp));
+	TestEqual(TEXT("Division by a negative count"), Accumulator.GetResultDividedBy(-1), -(1_fl + (HalfUlp + HalfUlp)));
+
+	// Vectors
+	const TArray<FVectorFloat> Vectors = { FVectorFloat(1, 2, 1e30), FVectorFloat(-1, 0.5, 1), FVectorFloat(0, 0, -1e30) };
+	const FVectorFloat VectorSum = FRealFloatAccumulator::Sum(Vectors);
+	TestEqual(TEXT("Vector sum X"), VectorSum.X, 0_fl);
+	TestEqual(TEXT("Vector sum Y"), VectorSum.Y, 2.5_fl);
+	TestEqual(TEXT("Vector sum Z"), VectorSum.Z, 1_fl);
+	TestTrue(TEXT("Vector ParallelSum"), FRealFloatAccumulator::ParallelSum(Vectors) == VectorSum);
+	TestEqual(TEXT("Vector mean Z"), FRealFloatAccumulator::Mean(Vectors).Z, 1_fl / 3_fl);
+	const TArray<FVectorFloat> DotVectors = { FVectorFloat(1, 2, 3), FVectorFloat(4, 5, 6) };
+	TestEqual(TEXT("Vector dot"), FRealFloatAccumulator::Dot(DotVectors, DotVectors), 91_fl);
+
+	// Blueprint nodes
+	TestEqual(TEXT("Blueprint sum"), URealFloatMath::SumArray(A), 1_fl);
+	TestEqual(TEXT("Blueprint vector mean"), UVectorFloatMath::MeanArray(Vectors).Y, 2.5_fl / 3_fl);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -5,6 +5,7 @@
 #include "Misc/AutomationTest.h"
 
 #include "SpaceKitPrecision/Public/RealFloat.h"
+#include "SpaceKitPrecision/Public/PrecisionBudget.h"
 
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -139,6 +140,21 @@ bool FSpacePrecisionFloatAdvancedMath::RunTest(const FString& Parameters)
 		TestEqual(TEXT("Predefined conversion string bidirectional 4"), URealFloatMath::ConvStringToReal(URealFloatMath::ConvRealToString(-102_fl)), -102_fl);
 	}
 
+	// Shortest digits, that convert back to the same number, and nearest rounding of the strings
+	{
+		TestEqual(TEXT("Shortest digits"), (0.1_fl).ToString(), FString(TEXT("0.1")));
+		TestEqual(TEXT("Exponent notation"), (1e22_fl).ToString(), FString(TEXT("1e+22")));
+		const FRealFloat Third = 1_fl / 3_fl;
+		TestEqual(TEXT("String round trip of 1/3"), FRealFloat(Third.ToString()), Third);
+		TestEqual(TEXT("Not a whole number"), FRealFloat(FString(TEXT("2.5x"))), 0_fl);
+
+		TCHAR Buffer[FRealFloat::MaxChars];
+		TestEqual(TEXT("Too small buffer"), Third.ToChars(Buffer, 4), 0);
+		FRealFloat Parsed;
+		TestEqual(TEXT("Characters read"), FRealFloat::FromChars(TEXT("-2.5e-1,"), Parsed), 7);
+		TestEqual(TEXT("Parsed value"), Parsed, -0.25_fl);
+	}
+
 	// Test real to float
 	{
 		const FRealFloat a("2.5");
@@ -432,4 +448,45 @@ bool FSpacePrecisionFloatLimitsTest::RunTest(const FString& Parameters)
 
 #pragma optimize("", on)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpacePrecisionFloatPrecisionBudgetTest, "SpaceKitPrecision.FloatingPointMath.PrecisionBudget", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FSpacePrecisionFloatPrecisionBudgetTest::RunTest(const FString& Parameters)
+{
+	const FRealFloat x = 2.5_fl;
+
+	// A budget of 0 is the full precision
+	TestEqual(TEXT("Full precision sin"), URealFloatMath::SinRadWithPrecision(x, 0), URealFloatMath::SinRad(x));
+	TestEqual(TEXT("Full precision exp"), URealFloatMath::ExpWithPrecision(x, 0), URealFloatMath::Exp(x));
+
+	// Budgeted results stay within their budget
+	const FRealFloat Tolerance53 = URealFloatMath::Pow(2_fl, FRealFloat(-52));
+	TestTrue(TEXT("53 bits sin"), URealFloatMath::RealEqualsReal(URealFloatMath::SinRadWithPrecision(x, 53), URealFloatMath::SinRad(x), Tolerance53));
+	TestTrue(TEXT("53 bits cos"), URealFloatMath::RealEqualsReal(URealFloatMath::CosRadWithPrecision(x, 53), URealFloatMath::CosRad(x), Tolerance53));
+	TestTrue(TEXT("53 bits tan"), URealFloatMath::RealEqualsReal(URealFloatMath::TanRadWithPrecision(x, 53), URealFloatMath::TanRad(x), Tolerance53));
+	TestTrue(TEXT("53 bits exp"), URealFloatMath::RealEqualsReal(URealFloatMath::ExpWithPrecision(x, 53), URealFloatMath::Exp(x), Tolerance53 * 16_fl));
+	TestTrue(TEXT("53 bits loge"), URealFloatMath::RealEqualsReal(URealFloatMath::LogEWithPrecision(x, 53), URealFloatMath::LogE(x), Tolerance53));
+	TestTrue(TEXT("53 bits pow"), URealFloatMath::RealEqualsReal(URealFloatMath::PowWithPrecision(x, 1.7_fl, 53), URealFloatMath::Pow(x, 1.7_fl), Tolerance53 * 8_fl));
+	TestEqual(TEXT("24 bits sin"), URealFloatMath::SinRadWithPrecision(x, 24).ToFloat(), sinf(2.5f));
+
+	// Budgeted results are deterministic
+	TestEqual(TEXT("Deterministic sin"), URealFloatMath::SinRadWithPrecision(x, 53), URealFloatMath::SinRadWithPrecision(x, 53));
+	TestEqual(TEXT("Deterministic pow"), URealFloatMath::PowWithPrecision(x, 1.7_fl, 80), URealFloatMath::PowWithPrecision(x, 1.7_fl, 80));
+
+	// The scoped budget applies to the regular functions, and is restored afterwards
+	const int32 PreviousBudget = FRealFloatPrecision::Get();
+	{
+		FScopedRealFloatPrecision ScopedPrecision(53);
+		TestEqual(TEXT("Scoped budget"), FRealFloatPrecision::Get(), 53);
+		TestEqual(TEXT("Scoped sin"), URealFloatMath::SinRad(x), URealFloatMath::SinRadWithPrecision(x, 53));
+		TestEqual(TEXT("Scoped exp"), URealFloatMath::Exp(x), URealFloatMath::ExpWithPrecision(x, 53));
+	}
+	TestEqual(TEXT("Restored budget"), FRealFloatPrecision::Get(), PreviousBudget);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
 #endif //WITH_DEV_AUTOMATION_TESTS
@@ -6,6 +6,7 @@
 
 #include "SpaceKitPrecision/Public/RotatorFloat.h"
 #include "SpaceKitPrecision/Public/QuatFloat.h"
+#include "SpaceKitPrecision/Public/RotationMatrixFloat.h"
 
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -93,4 +94,63 @@ bool FCoreMathRotatorFloatOperatorsTest::RunTest(const FString& Parameters)
 
 #pragma optimize("", on)
 
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCoreMathRotatorFloatBatchTest, "SpaceKitPrecision.RotatorFloatMath.BatchRotation", EAutomationTestFlags::ProgramContext | EAutomationTestFlags::SmokeFilter)
+
+#pragma optimize("", off)
+
+bool FCoreMathRotatorFloatBatchTest::RunTest(const FString& Parameters)
+{
+	const FRotatorFloat Rot(30_fl, -45_fl, 60_fl);
+	const FRealFloat Tolerance(1e-30);
+
+	TArray<FVectorFloat> Vectors;
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		Vectors.Add(FVectorFloat(FRealFloat(i), FRealFloat(i % 7) - 3_fl, 1_fl / FRealFloat(i + 1)));
+	}
+
+	// Batched rotations match the per-vector ones, up to rounding
+	TArray<FVectorFloat> Rotated = Vectors;
+	Rot.RotateVectors(Rotated);
+	bool bRotatedMatch = true;
+	for (int32 i = 0; i < Vectors.Num(); ++i)
+	{
+		bRotatedMatch &= Rotated[i].Equals(Rot.RotateVector(Vectors[i]), Tolerance);
+	}
+	TestTrue(TEXT("RotateVectors matches RotateVector"), bRotatedMatch);
+
+	// Unrotating gives back the original vectors
+	TArray<FVectorFloat> Unrotated = Rotated;
+	Rot.UnrotateVectors(Unrotated);
+	bool bUnrotatedMatch = true;
+	for (int32 i = 0; i < Vectors.Num(); ++i)
+	{
+		bUnrotatedMatch &= Unrotated[i].Equals(Vectors[i], Tolerance);
+	}
+	TestTrue(TEXT("UnrotateVectors inverts RotateVectors"), bUnrotatedMatch);
+
+	// Parallel variants give the very same results
+	const FRotationMatrixFloat Matrix = Rot.ToMatrix();
+	TArray<FVectorFloat> ParallelRotated = Vectors;
+	Matrix.ParallelRotateVectors(ParallelRotated);
+	bool bParallelMatch = true;
+	for (int32 i = 0; i < Vectors.Num(); ++i)
+	{
+		bParallelMatch &= ParallelRotated[i].Equals(Rotated[i], 0_fl);
+	}
+	TestTrue(TEXT("ParallelRotateVectors matches RotateVectors"), bParallelMatch);
+
+	// Quaternion and Blueprint variants
+	const FQuatFloat Quat(Rot);
+	TestTrue(TEXT("Quaternion matrix"), Quat.ToMatrix().RotateVector(Vectors[10]).Equals(Quat.RotateVector(Vectors[10]), Tolerance));
+	TestTrue(TEXT("Blueprint RotateVectors"), URotatorFloatMath::RotateVectors(Rot, Vectors, true)[500].Equals(Rotated[500], 0_fl));
+	TestTrue(TEXT("Blueprint UnrotateVectors"), UQuatFloatMath::UnrotateVectors(Quat, Rotated, false)[500].Equals(Vectors[500], Tolerance));
+	TestEqual(TEXT("Identity matrix"), FRotationMatrixFloat().RotateVector(Vectors[3]), Vectors[3]);
+
+	return true;
+}
+
+#pragma optimize("", on)
+
 #endif //WITH_DEV_AUTOMATION_TESTS
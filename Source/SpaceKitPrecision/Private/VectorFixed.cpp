@@ -1,6 +1,9 @@
 // Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
 
 #include "SpaceKitPrecision/Public/VectorFixed.h"
+#include "SpaceKitPrecision/Public/VectorFloat.h"
+#include "SpaceKitPrecision/Public/PrecisionPredicates.h"
+#include "SpaceKitPrecision/Private/PrecisionNetKernels.h"
 
 FVectorFixed FVectorFixed::Identity = FVectorFixed();
 FVectorFixed FVectorFixed::ZeroVector = FVectorFixed(0, 0, 0);
@@ -10,6 +13,19 @@ FVectorFixed FVectorFixed::VectorLeft = FVectorFixed(0, -1, 0);
 FVectorFixed FVectorFixed::VectorRight = FVectorFixed(0, 1, 0);
 FVectorFixed FVectorFixed::VectorOne = FVectorFixed(1, 1, 1);
 
+FVectorFixed::FVectorFixed(const FVectorFloat& InVec)
+	: X(InVec.X), Y(InVec.Y), Z(InVec.Z)
+{
+}
+
+bool FVectorFixed::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = PrecisionNet::SerializeMantissa<0>(Ar, X.Value.mantissa);
+	bOutSuccess &= PrecisionNet::SerializeMantissa<0>(Ar, Y.Value.mantissa);
+	bOutSuccess &= PrecisionNet::SerializeMantissa<0>(Ar, Z.Value.mantissa);
+	return true;
+}
+
 FVectorFixed UVectorFixedMath::ConvFVectorToVectorFixed(const FVector& InVec)
 {
 	return FVectorFixed(InVec);
@@ -74,3 +90,23 @@ FVectorFixed UVectorFixedMath::ProjectOnTo(const FVectorFixed& B, const FVectorF
 {
 	return (B * ((A | B) / (B | B)));
 }
+
+int32 UVectorFixedMath::Orient3D(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D)
+{
+	return FPrecisionPredicates::Orient3D(A, B, C, D);
+}
+
+int32 UVectorFixedMath::InSphere(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D, const FVectorFixed& E)
+{
+	return FPrecisionPredicates::InSphere(A, B, C, D, E);
+}
+
+int32 UVectorFixedMath::CompareDistance(const FVectorFixed& A, const FVectorFixed& B, const FRealFixed& Distance)
+{
+	return FPrecisionPredicates::CompareDistance(A, B, Distance);
+}
+
+int32 UVectorFixedMath::DotSign(const FVectorFixed& A, const FVectorFixed& B)
+{
+	return FPrecisionPredicates::DotSign(A, B);
+}
@@ -2,9 +2,16 @@
 
 #include "SpaceKitPrecision/Public/VectorFloat.h"
 #include "SpaceKitPrecision/Public/VectorFixed.h"
+#include "SpaceKitPrecision/Public/PrecisionPredicates.h"
+#include "SpaceKitPrecision/Public/RealFloatAccumulator.h"
 
 FVectorFloat FVectorFloat::Identity = FVectorFloat();
 
+FVectorFloat::FVectorFloat(const FVectorFixed& InVec)
+    : X(InVec.X), Y(InVec.Y), Z(InVec.Z)
+{
+}
+
 FVectorFloat UVectorFloatMath::ConvFVectorToVectorFloat(const FVector& InVec)
 {
     return FVectorFloat(InVec);
@@ -81,3 +88,38 @@ FVectorFloat UVectorFloatMath::ProjectOnTo(const FVectorFloat& B, const FVectorF
 {
 	return (B * ((A | B) / (B | B)));
 }
+
+int32 UVectorFloatMath::Orient3D(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D)
+{
+	return FPrecisionPredicates::Orient3D(A, B, C, D);
+}
+
+int32 UVectorFloatMath::InSphere(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D, const FVectorFloat& E)
+{
+	return FPrecisionPredicates::InSphere(A, B, C, D, E);
+}
+
+int32 UVectorFloatMath::CompareDistance(const FVectorFloat& A, const FVectorFloat& B, const FRealFloat& Distance)
+{
+	return FPrecisionPredicates::CompareDistance(A, B, Distance);
+}
+
+int32 UVectorFloatMath::DotSign(const FVectorFloat& A, const FVectorFloat& B)
+{
+	return FPrecisionPredicates::DotSign(A, B);
+}
+
+FVectorFloat UVectorFloatMath::SumArray(const TArray<FVectorFloat>& Values)
+{
+	return FRealFloatAccumulator::Sum(Values);
+}
+
+FRealFloat UVectorFloatMath::DotArrays(const TArray<FVectorFloat>& A, const TArray<FVectorFloat>& B)
+{
+	return FRealFloatAccumulator::Dot(A, B);
+}
+
+FVectorFloat UVectorFloatMath::MeanArray(const TArray<FVectorFloat>& Values)
+{
+	return FRealFloatAccumulator::Mean(Values);
+}
@@ -299,6 +299,16 @@ namespace ttmath
 #endif
 
 
+/*!
+	UInt<value_size> with value_size up to TTMATH_UNROLLED_MAX_SIZE multiply and divide
+	with the kernels of ttmathuint_unrolled.h (SpaceKitPrecision), instead of the generic
+	algorithms. 0 disables them
+*/
+#ifndef TTMATH_UNROLLED_MAX_SIZE
+	#define TTMATH_UNROLLED_MAX_SIZE 4
+#endif
+
+
 /*!
 	this is a special value used when calculating the Gamma(x) function
 	if x is greater than this value then the Gamma(x) will be calculated using
@@ -61,6 +61,21 @@
 namespace ttmath
 {
 
+/*!
+	multiplication and division kernels for small sizes, see ttmathuint_unrolled.h
+	the generic version is never called (enabled is false)
+*/
+template<uint value_size, bool unrolled = (value_size <= TTMATH_UNROLLED_MAX_SIZE)>
+struct UnrolledKernels
+{
+	static const bool enabled = false;
+
+	static void MulBig(const uint *, const uint *, uint *) {}
+	static void SqrBig(const uint *, uint *) {}
+	static uint Div(uint *, const uint *, uint *) { return 0; }
+};
+
+
 /*! 
 	\brief UInt implements a big integer value without a sign
 
@@ -1492,6 +1507,16 @@ public:
 	*/
 	void MulFastestBig(const UInt<value_size> & ss2, UInt<value_size*2> & result)
 	{
+		if( UnrolledKernels<value_size>::enabled )
+		{
+			if( this == &ss2 )
+				UnrolledKernels<value_size>::SqrBig(table, result.table);
+			else
+				UnrolledKernels<value_size>::MulBig(table, ss2.table, result.table);
+
+			return;
+		}
+
 		if( value_size < TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
 			return Mul2Big(ss2, result);
 
@@ -2119,6 +2144,9 @@ private:
 	{
 	uint m,n, test;
 
+		if( UnrolledKernels<value_size>::enabled )
+			return UnrolledKernels<value_size>::Div(table, v.table, remainder ? remainder->table : 0);
+
 		test = Div_StandardTest(v, m, n, remainder);
 		if( test < 2 )
 			return test;
@@ -4161,5 +4189,6 @@ public:
 #include "ttmathuint_x86.h"
 #include "ttmathuint_x86_64.h"
 #include "ttmathuint_noasm.h"
+#include "ttmathuint_unrolled.h"
 
 #endif
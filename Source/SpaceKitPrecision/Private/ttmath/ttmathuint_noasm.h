@@ -49,6 +49,16 @@
 */
 
 
+/*
+	TTMATH_NOASM_INTRINSICS (SpaceKitPrecision): on 64 bit platforms, the word operations
+	(AddTwoWords, SubTwoWords, MulTwoWords, DivTwoWords) use compiler intrinsics
+	instead of the portable code, which gives the same results
+*/
+#if defined(TTMATH_NOASM_INTRINSICS) && defined(TTMATH_PLATFORM64) && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+
 namespace ttmath
 {
 
@@ -70,7 +80,11 @@ namespace ttmath
 		#endif		
 
 		#ifdef TTMATH_PLATFORM64
-			static const char info[] = "no_asm_64";
+			#ifdef TTMATH_NOASM_INTRINSICS
+				static const char info[] = "no_asm_intrinsics_64";
+			#else
+				static const char info[] = "no_asm_64";
+			#endif
 		#endif
 
 	return info;
@@ -104,6 +118,15 @@ namespace ttmath
 	template<uint value_size>
 	uint UInt<value_size>::AddTwoWords(uint a, uint b, uint carry, uint * result)
 	{
+	#if defined(TTMATH_NOASM_INTRINSICS) && defined(TTMATH_PLATFORM64)
+		#if defined(_MSC_VER) && !defined(__clang__)
+			return _addcarry_u64(carry != 0, a, b, result);
+		#else
+			unsigned __int128 sum = (unsigned __int128)a + b + (carry != 0);
+			*result = uint(sum);
+			return uint(sum >> 64);
+		#endif
+	#else
 	uint temp;
 
 		if( carry == 0 )
@@ -125,6 +148,7 @@ namespace ttmath
 		*result = temp;
 
 	return carry;
+	#endif
 	}
 
 
@@ -291,6 +315,15 @@ namespace ttmath
 	template<uint value_size>
 	uint UInt<value_size>::SubTwoWords(uint a, uint b, uint carry, uint * result)
 	{
+	#if defined(TTMATH_NOASM_INTRINSICS) && defined(TTMATH_PLATFORM64)
+		#if defined(_MSC_VER) && !defined(__clang__)
+			return _subborrow_u64(carry != 0, a, b, result);
+		#else
+			unsigned __int128 difference = (unsigned __int128)a - b - (carry != 0);
+			*result = uint(difference);
+			return uint(difference >> 64) & 1;
+		#endif
+	#else
 		if( carry == 0 )
 		{
 			*result = a - b;
@@ -308,6 +341,7 @@ namespace ttmath
 		}
 
 	return carry;
+	#endif
 	}
 
 
@@ -666,6 +700,15 @@ namespace ttmath
 	template<uint value_size>
 	void UInt<value_size>::MulTwoWords(uint a, uint b, uint * result_high, uint * result_low)
 	{
+	#if defined(TTMATH_NOASM_INTRINSICS) && defined(TTMATH_PLATFORM64)
+		#if defined(_MSC_VER) && !defined(__clang__)
+			*result_low = _umul128(a, b, result_high);
+		#else
+			unsigned __int128 product = (unsigned __int128)a * b;
+			*result_high = uint(product >> 64);
+			*result_low  = uint(product);
+		#endif
+	#else
 	#ifdef TTMATH_PLATFORM32
 
 		/*
@@ -747,6 +790,7 @@ namespace ttmath
 		*result_high = res_high2.u;
 		*result_low  = res_low2.u;
 
+	#endif
 	#endif
 	}
 
@@ -778,7 +822,15 @@ namespace ttmath
 	// (a < c ) for the result to be one word
 	TTMATH_ASSERT( c != 0 && a < c )
 
-	#ifdef TTMATH_PLATFORM32
+	#if defined(TTMATH_NOASM_INTRINSICS) && defined(TTMATH_PLATFORM64)
+		#if defined(_MSC_VER) && !defined(__clang__)
+			*r = _udiv128(a, b, c, rest);
+		#else
+			unsigned __int128 dividend = ((unsigned __int128)a << 64) | b;
+			*r    = uint(dividend / c);
+			*rest = uint(dividend % c);
+		#endif
+	#elif defined(TTMATH_PLATFORM32)
 
 		union
 		{
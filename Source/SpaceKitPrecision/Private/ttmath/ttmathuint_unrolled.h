@@ -0,0 +1,476 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#ifndef headerfilettmathuint_unrolled
+#define headerfilettmathuint_unrolled
+
+
+/*!
+	\file ttmathuint_unrolled.h
+    \brief multiplication, square and division of UInt<1> ... UInt<TTMATH_UNROLLED_MAX_SIZE>
+	with the loops unrolled at compile time (SpaceKitPrecision)
+
+	UInt::MulFastestBig() and UInt::Div3() go through UnrolledKernels<value_size> when
+	value_size is small enough: the word count is known at compile time, so there are no
+	loops over value_size, no search of the non-zero words, and no choice of algorithm.
+	The results are the same as the generic algorithms, bit for bit.
+
+	this file is included at the end of ttmathuint.h
+*/
+
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+namespace ttmath
+{
+
+namespace unrolled
+{
+
+	/*!
+		a + b + carry (carry is 0 or 1), without branches
+	*/
+	inline uint AddWithCarry(uint a, uint b, uint carry, uint & carry_out)
+	{
+	uint sum    = a + b;
+	uint carry1 = uint(sum < a);
+	uint result = sum + carry;
+
+		carry_out = carry1 | uint(result < sum);
+
+	return result;
+	}
+
+
+	/*!
+		a - b - borrow (borrow is 0 or 1), without branches
+	*/
+	inline uint SubWithBorrow(uint a, uint b, uint borrow, uint & borrow_out)
+	{
+	uint difference = a - b;
+	uint borrow1    = uint(a < b);
+	uint result     = difference - borrow;
+
+		borrow_out = borrow1 | uint(difference < borrow);
+
+	return result;
+	}
+
+
+	/*!
+		(c2:c1:c0) += high:low
+	*/
+	inline void AddProduct(uint high, uint low, uint & c0, uint & c1, uint & c2)
+	{
+	uint carry;
+
+		c0  = AddWithCarry(c0, low, 0, carry);
+		c1  = AddWithCarry(c1, high, carry, carry);
+		c2 += carry;
+	}
+
+
+	/*!
+		(c2:c1:c0) += a * b
+	*/
+	inline void MulAdd(uint a, uint b, uint & c0, uint & c1, uint & c2)
+	{
+	uint high, low;
+
+		UInt<1>::MulTwoWords(a, b, &high, &low);
+		AddProduct(high, low, c0, c1, c2);
+	}
+
+
+	/*!
+		(c2:c1:c0) += 2 * a * b
+	*/
+	inline void MulAdd2(uint a, uint b, uint & c0, uint & c1, uint & c2)
+	{
+	uint high, low;
+
+		UInt<1>::MulTwoWords(a, b, &high, &low);
+		AddProduct(high, low, c0, c1, c2);
+		AddProduct(high, low, c0, c1, c2);
+	}
+
+
+	/*!
+		the number of leading zero bits of x (x is not zero)
+	*/
+	inline uint LeadingZeros(uint x)
+	{
+	#if defined(__GNUC__) && defined(TTMATH_PLATFORM64)
+		return uint(__builtin_clzll(x));
+	#elif defined(__GNUC__)
+		return uint(__builtin_clz(x));
+	#elif defined(_MSC_VER) && defined(TTMATH_PLATFORM64)
+		unsigned long index;
+		_BitScanReverse64(&index, x);
+		return uint(TTMATH_BITS_PER_UINT - 1 - index);
+	#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, x);
+		return uint(TTMATH_BITS_PER_UINT - 1 - index);
+	#else
+		return uint(TTMATH_BITS_PER_UINT - 1 - UInt<1>::FindLeadingBitInWord(x));
+	#endif
+	}
+
+
+	/*!
+		the high word of (high:low) << shift, for shift in <0, TTMATH_BITS_PER_UINT)
+		(a shift by the whole word width is undefined, hence the two steps)
+	*/
+	inline uint ShiftLeft(uint high, uint low, uint shift)
+	{
+		return (high << shift) | ((low >> 1) >> (TTMATH_BITS_PER_UINT - 1 - shift));
+	}
+
+
+	/*!
+		the low word of (high:low) >> shift, for shift in <0, TTMATH_BITS_PER_UINT)
+	*/
+	inline uint ShiftRight(uint high, uint low, uint shift)
+	{
+		return (low >> shift) | ((high << 1) << (TTMATH_BITS_PER_UINT - 1 - shift));
+	}
+
+
+
+	/*!
+		the products a[i]*b[k-i] of the column k of a schoolbook multiplication,
+		for i from 'i' to min(k, size-1)
+	*/
+	template<uint size, uint k, uint i, bool end = (i > k || i >= size)>
+	struct MulColumn
+	{
+		static void Add(const uint * a, const uint * b, uint & c0, uint & c1, uint & c2)
+		{
+			MulAdd(a[i], b[k-i], c0, c1, c2);
+			MulColumn<size, k, i+1>::Add(a, b, c0, c1, c2);
+		}
+	};
+
+	template<uint size, uint k, uint i>
+	struct MulColumn<size, k, i, true>
+	{
+		static void Add(const uint *, const uint *, uint &, uint &, uint &)
+		{
+		}
+	};
+
+
+	/*!
+		the products of the column k of a square: 2*a[i]*a[k-i] for i < k-i,
+		and a[k/2]*a[k/2] when k is even
+	*/
+	template<uint size, uint k, uint i, bool end = (2*i >= k || i >= size)>
+	struct SqrColumn
+	{
+		static void Add(const uint * a, uint & c0, uint & c1, uint & c2)
+		{
+			MulAdd2(a[i], a[k-i], c0, c1, c2);
+			SqrColumn<size, k, i+1>::Add(a, c0, c1, c2);
+		}
+	};
+
+	template<uint size, uint k, uint i>
+	struct SqrColumn<size, k, i, true>
+	{
+		static void Add(const uint * a, uint & c0, uint & c1, uint & c2)
+		{
+			if( 2*i == k )
+				MulAdd(a[i], a[i], c0, c1, c2);
+		}
+	};
+
+
+	/*!
+		the columns k ... 2*size-1 of a product (product scanning, the columns are summed
+		in a three words accumulator, and the lowest word is the word k of the result)
+	*/
+	template<uint size, uint k, bool square, bool end = (k == 2*size - 1)>
+	struct Columns
+	{
+		static void Run(const uint * a, const uint * b, uint * result, uint & c0, uint & c1, uint & c2)
+		{
+			const uint first = k < size ? 0 : k - size + 1;
+
+			if( square )
+				SqrColumn<size, k, first>::Add(a, c0, c1, c2);
+			else
+				MulColumn<size, k, first>::Add(a, b, c0, c1, c2);
+
+			result[k] = c0;
+			c0 = c1;
+			c1 = c2;
+			c2 = 0;
+
+			Columns<size, k+1, square>::Run(a, b, result, c0, c1, c2);
+		}
+	};
+
+	template<uint size, uint k, bool square>
+	struct Columns<size, k, square, true>
+	{
+		static void Run(const uint *, const uint *, uint * result, uint & c0, uint &, uint &)
+		{
+			// the product of two size-word values has 2*size words, the last one can't carry
+			result[k] = c0;
+		}
+	};
+
+
+
+	/*!
+		u = u / v, remainder = u % v, when v has exactly n significant words
+		(n is 2 or more, see DivWord for one word)
+
+		"The art of computer programming 2" (4.3.1 algorithm D), Donald E. Knuth,
+		with the loops over the words bounded at compile time
+	*/
+	template<uint size, uint n>
+	void DivWords(uint * u, const uint * v, uint * remainder)
+	{
+	uint vn[n];
+	uint un[size+1];
+	uint q[size];
+	uint i;
+
+		// normalization: the highest bit of the divisor is set
+		const uint shift = LeadingZeros(v[n-1]);
+
+		for(i=n-1 ; i>0 ; --i)
+			vn[i] = ShiftLeft(v[i], v[i-1], shift);
+
+		vn[0] = v[0] << shift;
+
+		un[size] = ShiftLeft(0, u[size-1], shift);
+
+		for(i=size-1 ; i>0 ; --i)
+			un[i] = ShiftLeft(u[i], u[i-1], shift);
+
+		un[0] = u[0] << shift;
+
+		for(i=0 ; i<size ; ++i)
+			q[i] = 0;
+
+		for(uint j=size-n+1 ; j-- > 0 ; )
+		{
+			// estimating the quotient word from the two highest words
+			uint qhat, rhat;
+			bool rhat_overflow = false;
+
+			if( un[j+n] >= vn[n-1] )
+			{
+				// un[j+n] == vn[n-1] (the invariant of the algorithm), qhat is the largest word
+				qhat = TTMATH_UINT_MAX_VALUE;
+				uint carry;
+				rhat = AddWithCarry(un[j+n-1], vn[n-1], 0, carry);
+				rhat_overflow = carry != 0;
+			}
+			else
+			{
+				UInt<1>::DivTwoWords(un[j+n], un[j+n-1], vn[n-1], &qhat, &rhat);
+			}
+
+			// at most two corrections with the third highest word
+			while( !rhat_overflow )
+			{
+				uint high, low;
+				UInt<1>::MulTwoWords(qhat, vn[n-2], &high, &low);
+
+				if( high < rhat || (high == rhat && low <= un[j+n-2]) )
+					break;
+
+				--qhat;
+				uint carry;
+				rhat = AddWithCarry(rhat, vn[n-1], 0, carry);
+				rhat_overflow = carry != 0;
+			}
+
+			// un[j ... j+n] -= qhat * vn
+			uint mul_carry = 0, borrow = 0;
+
+			for(i=0 ; i<n ; ++i)
+			{
+				uint high, low, carry;
+				UInt<1>::MulTwoWords(qhat, vn[i], &high, &low);
+				low  = AddWithCarry(low, mul_carry, 0, carry);
+				high = high + carry;
+
+				un[i+j]   = SubWithBorrow(un[i+j], low, borrow, borrow);
+				mul_carry = high;
+			}
+
+			un[j+n] = SubWithBorrow(un[j+n], mul_carry, borrow, borrow);
+
+			if( borrow )
+			{
+				// qhat was one too big, adding the divisor back
+				--qhat;
+				uint carry = 0;
+
+				for(i=0 ; i<n ; ++i)
+					un[i+j] = AddWithCarry(un[i+j], vn[i], carry, carry);
+
+				un[j+n] += carry;
+			}
+
+			q[j] = qhat;
+		}
+
+		if( remainder )
+		{
+			for(i=0 ; i<n ; ++i)
+				remainder[i] = ShiftRight(un[i+1], un[i], shift);
+
+			for( ; i<size ; ++i)
+				remainder[i] = 0;
+		}
+
+		for(i=0 ; i<size ; ++i)
+			u[i] = q[i];
+	}
+
+
+	/*!
+		u = u / v, remainder = u % v, when v has one significant word
+	*/
+	template<uint size>
+	void DivWord(uint * u, uint v, uint * remainder)
+	{
+	uint rest = 0, m = size;
+
+		// the leading zero words of u give zero words of the quotient, without the (slow) division instruction
+		for( ; m>0 && u[m-1]==0 ; --m);
+
+		for(uint i=m ; i-- > 0 ; )
+			UInt<1>::DivTwoWords(rest, u[i], v, &u[i], &rest);
+
+		if( remainder )
+		{
+			remainder[0] = rest;
+
+			for(uint i=1 ; i<size ; ++i)
+				remainder[i] = 0;
+		}
+	}
+
+
+	/*!
+		DivWords for n in <2, size>, and nothing for the sizes that can't have such a divisor
+	*/
+	template<uint size, uint n, bool valid = (n >= 2 && n <= size)>
+	struct DivDispatch
+	{
+		static void Run(uint * u, const uint * v, uint * remainder)
+		{
+			DivWords<size, n>(u, v, remainder);
+		}
+	};
+
+	template<uint size, uint n>
+	struct DivDispatch<size, n, false>
+	{
+		static void Run(uint *, const uint *, uint *)
+		{
+		}
+	};
+
+
+	/*!
+		DivDispatch for the n known at run time only, from 2 up to size
+	*/
+	template<uint size, uint n = 2, bool last = (n >= size)>
+	struct DivSelect
+	{
+		static void Run(uint count, uint * u, const uint * v, uint * remainder)
+		{
+			if( count == n )
+				DivDispatch<size, n>::Run(u, v, remainder);
+			else
+				DivSelect<size, n+1>::Run(count, u, v, remainder);
+		}
+	};
+
+	template<uint size, uint n>
+	struct DivSelect<size, n, true>
+	{
+		static void Run(uint, uint * u, const uint * v, uint * remainder)
+		{
+			DivDispatch<size, n>::Run(u, v, remainder);
+		}
+	};
+
+} // namespace unrolled
+
+
+
+	/*!
+		the kernels of UInt<size> for size <= TTMATH_UNROLLED_MAX_SIZE
+	*/
+	template<uint size>
+	struct UnrolledKernels<size, true>
+	{
+		static const bool enabled = true;
+
+
+		/*!
+			result (2*size words) = a * b
+		*/
+		static void MulBig(const uint * a, const uint * b, uint * result)
+		{
+		uint c0 = 0, c1 = 0, c2 = 0;
+
+			unrolled::Columns<size, 0, false>::Run(a, b, result, c0, c1, c2);
+		}
+
+
+		/*!
+			result (2*size words) = a * a
+			the products of two different words are computed once, and doubled
+		*/
+		static void SqrBig(const uint * a, uint * result)
+		{
+		uint c0 = 0, c1 = 0, c2 = 0;
+
+			unrolled::Columns<size, 0, true>::Run(a, a, result, c0, c1, c2);
+		}
+
+
+		/*!
+			u = u / v, remainder = u % v (remainder can be null)
+			returns 1 if v is zero (nothing is changed then), like UInt::Div3()
+		*/
+		static uint Div(uint * u, const uint * v, uint * remainder)
+		{
+		uint n = size;
+
+			for( ; n>0 && v[n-1]==0 ; --n);
+
+			switch( n )
+			{
+			case 0:
+				return 1;
+
+			case 1:
+				unrolled::DivWord<size>(u, v[0], remainder);
+				break;
+
+			default:
+				unrolled::DivSelect<size>::Run(n, u, v, remainder);
+				break;
+			}
+
+		return 0;
+		}
+	};
+
+
+} //namespace
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionBlockKernels.h"
+
+/**
+ * Compressed array of fixed-point numbers, for large arrays whose neighbouring values are close (height samples, trajectory logs, replay buffers).
+ * The values are stored by blocks of BlockSize, 32 or 64: each block keeps its smallest value and a shift, and each value its difference to it,
+ * shifted, on 16, 32 or 64 bits (see PrecisionBlockKernels.h). Values within 2^16 quanta of their block take 2 bytes instead of 16.
+ * The compression is lossless, unless the array rounds the values to a quantum of 2^DroppedBits mantissa units.
+ *
+ * Values are appended to an uncompressed block, compressed when it's full. Reading a value decodes it alone, and Decode decodes ranges a block
+ * at a time, e.g. into the SoA buffers of a simulation, one array per component. The array holds up to MAX_int32 values: their differences
+ * can take more than 2 GB, so they're in a TArray64.
+ */
+template<int32 BlockSize = 64>
+class TBlockFixedArray
+{
+	static_assert(BlockSize == 32 || BlockSize == 64, "Blocks are 32 or 64 values");
+
+	static constexpr ttmath::uint Words = sizeof(real_fixed_type::ttIntMantissaType) / sizeof(ttmath::uint);
+	using FBlock = PrecisionBlock::TBlock<Words>;
+
+public:
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+
+	explicit TBlockFixedArray(int32 InDroppedBits = 0)
+		: DroppedBits(FMath::Clamp(InDroppedBits, 0, int32(Words * TTMATH_BITS_PER_UINT) - 2))
+	{
+	}
+
+	int32 Num() const
+	{
+		return Blocks.Num() * BlockSize + NumPending;
+	}
+
+	void Add(const FRealFixed& Value)
+	{
+		Pending[NumPending] = Value.Value.mantissa;
+		PrecisionBlock::RoundToQuantum(Pending[NumPending], DroppedBits);
+		if (++NumPending == BlockSize)
+		{
+			CompressPending();
+		}
+	}
+
+	void Append(const FRealFixed* Values, int32 Count)
+	{
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Add(Values[Index]);
+		}
+	}
+
+	void Append(const TArray<FRealFixed>& Values)
+	{
+		Append(Values.GetData(), Values.Num());
+	}
+
+	FRealFixed operator[](int32 Index) const
+	{
+		checkSlow(Index >= 0 && Index < Num());
+		FRealFixed Result;
+		const int32 BlockIndex = Index / BlockSize;
+		if (BlockIndex == Blocks.Num())
+		{
+			Result.Value.mantissa = Pending[Index % BlockSize];
+		}
+		else
+		{
+			const FBlock& Block = Blocks[BlockIndex];
+			PrecisionBlock::DecodeValue(Block, Deltas.GetData() + Block.Offset, Index % BlockSize, Result.Value.mantissa);
+		}
+		return Result;
+	}
+
+	// Decodes the values [First, First + Count) to the mantissas at Out, a block at a time, without going through FRealFixed
+	void Decode(int32 First, int32 Count, FMantissa* Out) const
+	{
+		for (int32 Index = First; Index < First + Count;)
+		{
+			const int32 BlockIndex = Index / BlockSize;
+			const int32 InBlock = Index % BlockSize;
+			const int32 NumDecoded = FMath::Min(BlockSize - InBlock, First + Count - Index);
+			if (BlockIndex < Blocks.Num())
+			{
+				const FBlock& Block = Blocks[BlockIndex];
+				PrecisionBlock::DecodeBlock(Block, Deltas.GetData() + Block.Offset, InBlock, NumDecoded, Out + (Index - First));
+			}
+			else
+			{
+				for (int32 Value = 0; Value < NumDecoded; ++Value)
+				{
+					Out[Index - First + Value] = Pending[InBlock + Value];
+				}
+			}
+			Index += NumDecoded;
+		}
+	}
+
+	void Decode(int32 First, int32 Count, FRealFixed* Out) const
+	{
+		FMantissa Buffer[BlockSize];
+		for (int32 Index = First; Index < First + Count; Index += BlockSize)
+		{
+			const int32 NumDecoded = FMath::Min(BlockSize, First + Count - Index);
+			Decode(Index, NumDecoded, Buffer);
+			for (int32 Value = 0; Value < NumDecoded; ++Value)
+			{
+				Out[Index - First + Value].Value.mantissa = Buffer[Value];
+			}
+		}
+	}
+
+	void Empty()
+	{
+		Blocks.Empty();
+		Deltas.Empty();
+		NumPending = 0;
+	}
+
+	void Reset()
+	{
+		Blocks.Reset();
+		Deltas.Reset();
+		NumPending = 0;
+	}
+
+	void Shrink()
+	{
+		Blocks.Shrink();
+		Deltas.Shrink();
+	}
+
+	// Bytes allocated by the array, without the uncompressed block
+	SIZE_T GetAllocatedSize() const
+	{
+		return Blocks.GetAllocatedSize() + Deltas.GetAllocatedSize();
+	}
+
+	// Bytes used by the compressed blocks
+	SIZE_T GetCompressedSize() const
+	{
+		return Blocks.Num() * sizeof(FBlock) + Deltas.Num();
+	}
+
+private:
+	void CompressPending()
+	{
+		FBlock& Block = Blocks.AddDefaulted_GetRef();
+		Block.Offset = Deltas.Num();
+		Deltas.AddUninitialized(PrecisionBlock::MaxDeltaBytes<Words>(BlockSize));
+		const int64 NumBytes = PrecisionBlock::EncodeBlock(Pending, BlockSize, DroppedBits, Block, Deltas.GetData() + Block.Offset);
+
+		// The differences of the next block start 8-byte aligned
+		Deltas.SetNum(Block.Offset + Align(NumBytes, 8), false);
+		NumPending = 0;
+	}
+
+	int32 DroppedBits;
+
+	TArray<FBlock> Blocks;
+	TArray64<uint8> Deltas;
+
+	// Block the values are appended to, compressed once full
+	FMantissa Pending[BlockSize];
+	int32 NumPending = 0;
+};
@@ -5,6 +5,7 @@
 #include "RotatorFloat.h"
 #include "QuatFloat.h"
 #include "VectorFixed.h"
+#include "RotatorFixed.h"
 
 #include "Conversions.generated.h"
 
@@ -25,4 +26,25 @@ public:
     UFUNCTION(BlueprintPure, category = "QuatFloat", meta = (DisplayName = "QuatFloat to RotatorFloat", CompactNodeTitle = "->", BlueprintAutocast))
     static void ConvQuatFloatToRotatorFloat(const FQuatFloat& Quat, FRotatorFloat& Rot);
 
+// Fixed-point <-> floating-point conversions. They work on the binary representation: float to fixed rounds to the nearest quantum, and fixed to float is exact with the default settings
+public:
+
+    UFUNCTION(BlueprintPure, category = "RealFixed", meta = (DisplayName = "RealFixed to RealFloat", CompactNodeTitle = "->", BlueprintAutocast))
+    static FRealFloat ConvRealFixedToRealFloat(const FRealFixed& InVal);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat", meta = (DisplayName = "RealFloat to RealFixed", CompactNodeTitle = "->", BlueprintAutocast))
+    static FRealFixed ConvRealFloatToRealFixed(const FRealFloat& InVal);
+
+    UFUNCTION(BlueprintPure, category = "VectorFixed", meta = (DisplayName = "VectorFixed to VectorFloat", CompactNodeTitle = "->", BlueprintAutocast))
+    static FVectorFloat ConvVectorFixedToVectorFloat(const FVectorFixed& InVec);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat", meta = (DisplayName = "VectorFloat to VectorFixed", CompactNodeTitle = "->", BlueprintAutocast))
+    static FVectorFixed ConvVectorFloatToVectorFixed(const FVectorFloat& InVec);
+
+    UFUNCTION(BlueprintPure, category = "RotatorFixed", meta = (DisplayName = "RotatorFixed to RotatorFloat", CompactNodeTitle = "->", BlueprintAutocast))
+    static FRotatorFloat ConvRotatorFixedToRotatorFloat(const FRotatorFixed& InRot);
+
+    UFUNCTION(BlueprintPure, category = "RotatorFloat", meta = (DisplayName = "RotatorFloat to RotatorFixed", CompactNodeTitle = "->", BlueprintAutocast))
+    static FRotatorFixed ConvRotatorFloatToRotatorFixed(const FRotatorFloat& InRot);
+
 };
@@ -63,6 +63,43 @@ public:
             *VectorB.ToString(), 
             *Rotator.ToString());
     }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FDualVectorRotatorFixed& D)
+    {
+        return Ar << D.VectorA << D.VectorB << D.Rotator;
+    }
+
+    // Feeds the vectors and rotator to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        VectorA.AppendHash(Hash);
+        VectorB.AppendHash(Hash);
+        Rotator.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FDualVectorRotatorFixed& D)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        D.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FDualVectorRotatorFixed> : public TStructOpsTypeTraitsBase2<FDualVectorRotatorFixed>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 UCLASS(BlueprintType, Abstract)
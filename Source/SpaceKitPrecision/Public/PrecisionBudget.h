@@ -0,0 +1,44 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PrecisionSettings.h"
+
+/**
+ * Precision budget of the FRealFloat transcendental functions (sin, cos, tan, exp, ln, log and pow), in significand bits.
+ * With a budget, the series behind these functions stop as soon as their next term can't change the first PrecisionBits bits of the result,
+ * and the result is then truncated to PrecisionBits bits. For a given input and budget, the result is always the same.
+ * The truncation costs up to one ulp, so a result has PrecisionBits - 1 correct bits, give or take the series' rounding (see PrecisionBudget::GetGuaranteedBits).
+ * A budget of 0, or a budget at least as large as the FRealFloat significand, means full precision (the results are then the same as without budget).
+ * The default budget is REAL_FLOAT_DEFAULT_PRECISION_BITS, see PrecisionSettings.h
+ */
+struct SPACEKITPRECISION_API FRealFloatPrecision
+{
+	// Gets the precision budget used by URealFloatMath on the calling thread
+	static int32 Get();
+
+	// Sets the precision budget used by URealFloatMath on the calling thread. Prefer FScopedRealFloatPrecision, that restores the previous budget
+	static void Set(int32 PrecisionBits);
+};
+
+/**
+ * Sets the precision budget of the calling thread for the lifetime of this object, then restores the previous one.
+ * Meant for visual-only code, such as orbit path previews, that doesn't need simulation-grade precision:
+ *     FScopedRealFloatPrecision PreviewPrecision(53);
+ */
+class SPACEKITPRECISION_API FScopedRealFloatPrecision
+{
+public:
+
+	explicit FScopedRealFloatPrecision(int32 PrecisionBits);
+
+	~FScopedRealFloatPrecision();
+
+	FScopedRealFloatPrecision(const FScopedRealFloatPrecision&) = delete;
+	FScopedRealFloatPrecision& operator=(const FScopedRealFloatPrecision&) = delete;
+
+private:
+
+	int32 PreviousPrecisionBits;
+};
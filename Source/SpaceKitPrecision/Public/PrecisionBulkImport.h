@@ -0,0 +1,64 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceKitPrecision/Public/RealFixed.h"
+#include "SpaceKitPrecision/Public/VectorFixed.h"
+
+class UDataTable;
+
+// Columns to import from a table, by the names of their header cells (CSV) or fields (JSON)
+struct SPACEKITPRECISION_API FPrecisionImportOptions
+{
+	TArray<FString> RealColumns;
+
+	// Cells like FVectorFixed::ToString writes them, (X=1.0,Y=2.0,Z=3.0), or JSON objects of X, Y and Z numbers
+	TArray<FString> VectorColumns;
+
+	// Rows parsed by each task
+	int32 RowsPerTask = 1024;
+};
+
+// Imported columns, in the order of the options, with a value for each row in the order of the text
+struct SPACEKITPRECISION_API FPrecisionImportResult
+{
+	// First cell of each CSV row, or "Name" field of each JSON object, like the engine exports data tables. None when missing
+	TArray<FName> RowNames;
+
+	TArray<TArray<FRealFixed>> Reals;
+	TArray<TArray<FVectorFixed>> Vectors;
+
+	// Cells of the columns that were missing or weren't numbers (their values are 0), and the first row of one, or INDEX_NONE
+	int32 NumInvalidCells = 0;
+	int32 FirstInvalidRow = INDEX_NONE;
+
+	int32 GetNumRows() const
+	{
+		return RowNames.Num();
+	}
+};
+
+/**
+ * Parallel import of the fixed-point columns of CSV and JSON tables, like balance tables and trajectories of millions of values.
+ * A first pass splits the text in rows, then ranges of rows are parsed on the task graph, each into the slots of its rows, so that the result
+ * is committed in the order of the text, the same as a sequential import. The numbers are parsed in place, straight into mantissas, without
+ * the strings and the property system of a row by row import:
+ *     FPrecisionImportOptions Options;
+ *     Options.RealColumns.Add(TEXT("Mass"));
+ *     Options.VectorColumns.Add(TEXT("Position"));
+ *     FPrecisionImportResult Result;
+ *     FPrecisionBulkImport::ImportCsv(Csv, Options, Result);
+ */
+struct SPACEKITPRECISION_API FPrecisionBulkImport
+{
+	// Imports a CSV text with a header row. Returns false when a column isn't in the header
+	static bool ImportCsv(const FString& Csv, const FPrecisionImportOptions& Options, FPrecisionImportResult& OutResult);
+
+	// Imports a JSON array of objects, whose numbers can be strings, to keep their digits. Returns false when the text isn't an array
+	static bool ImportJson(const FString& Json, const FPrecisionImportOptions& Options, FPrecisionImportResult& OutResult);
+
+	// Sets the FRealFixed and FVectorFixed properties named like the columns, of the rows of Table named like the rows, in order.
+	// Rows missing from the table are skipped. Returns the number of rows set
+	static int32 ApplyToDataTable(const FPrecisionImportResult& Result, const FPrecisionImportOptions& Options, UDataTable& Table);
+};
@@ -0,0 +1,269 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceKitPrecision/Public/DualVectorRotatorFixed.h"
+#include "SpaceKitPrecision/Public/QuatFixed.h"
+#include "SpaceKitPrecision/Public/TransformFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+
+// Fixed-point numbers of the precision structs, in the order of their canonical encoding. Visit calls Function with each of them
+template<typename T>
+struct TPrecisionCanonicalTraits;
+
+template<>
+struct TPrecisionCanonicalTraits<FRealFixed>
+{
+	static constexpr int32 NumValues = 1;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Real, FunctionType&& Function)
+	{
+		Function(Real);
+	}
+};
+
+template<>
+struct TPrecisionCanonicalTraits<FVectorFixed>
+{
+	static constexpr int32 NumValues = 3;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Vector, FunctionType&& Function)
+	{
+		Function(Vector.X);
+		Function(Vector.Y);
+		Function(Vector.Z);
+	}
+};
+
+template<>
+struct TPrecisionCanonicalTraits<FRotatorFixed>
+{
+	static constexpr int32 NumValues = 3;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Rotator, FunctionType&& Function)
+	{
+		Function(Rotator.Pitch);
+		Function(Rotator.Yaw);
+		Function(Rotator.Roll);
+	}
+};
+
+template<>
+struct TPrecisionCanonicalTraits<FQuatFixed>
+{
+	static constexpr int32 NumValues = 4;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Quat, FunctionType&& Function)
+	{
+		Function(Quat.X);
+		Function(Quat.Y);
+		Function(Quat.Z);
+		Function(Quat.W);
+	}
+};
+
+template<>
+struct TPrecisionCanonicalTraits<FTransformFixed>
+{
+	static constexpr int32 NumValues = 9;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Transform, FunctionType&& Function)
+	{
+		TPrecisionCanonicalTraits<FVectorFixed>::Visit(Transform.Location, Function);
+		TPrecisionCanonicalTraits<FRotatorFixed>::Visit(Transform.Rotation, Function);
+		TPrecisionCanonicalTraits<FVectorFixed>::Visit(Transform.Scale, Function);
+	}
+};
+
+template<>
+struct TPrecisionCanonicalTraits<FDualVectorRotatorFixed>
+{
+	static constexpr int32 NumValues = 9;
+
+	template<typename StructType, typename FunctionType>
+	static void Visit(StructType& Dual, FunctionType&& Function)
+	{
+		TPrecisionCanonicalTraits<FVectorFixed>::Visit(Dual.VectorA, Function);
+		TPrecisionCanonicalTraits<FVectorFixed>::Visit(Dual.VectorB, Function);
+		TPrecisionCanonicalTraits<FRotatorFixed>::Visit(Dual.Rotator, Function);
+	}
+};
+
+/**
+ * Writes the fixed-point precision structs in the canonical encoding (see PrecisionBinaryKernels.h), for replay files and state read by other
+ * platforms and builds: the numbers are the same bytes on every platform, after a header of the precision settings, so that a build with
+ * other settings converts them. Arrays are encoded in bulk, which is a copy of their mantissas on little-endian platforms:
+ *     TArray<uint8> Bytes;
+ *     FPrecisionCanonicalWriter Writer(Bytes);
+ *     Writer.Write(Positions);
+ *     ...
+ *     FPrecisionCanonicalReader Reader(Bytes);
+ *     Reader.Read(Positions, NumPositions);
+ */
+class SPACEKITPRECISION_API FPrecisionCanonicalWriter
+{
+public:
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+
+	// Appends the header of the build's settings to Bytes
+	explicit FPrecisionCanonicalWriter(TArray<uint8>& InBytes);
+
+	template<typename T>
+	void Write(const T& Value)
+	{
+		Write(TArrayView<const T>(&Value, 1));
+	}
+
+	template<typename T>
+	void Write(const TArray<T>& Values)
+	{
+		Write(TArrayView<const T>(Values));
+	}
+
+	// The numbers are gathered in chunks, each encoded at once
+	template<typename T>
+	void Write(TArrayView<const T> Values)
+	{
+		FMantissa Chunk[ChunkSize];
+		int32 NumChunk = 0;
+		for (const T& Value : Values)
+		{
+			TPrecisionCanonicalTraits<T>::Visit(Value, [&](const FRealFixed& Real)
+			{
+				Chunk[NumChunk++] = Real.Value.mantissa;
+				if (NumChunk == ChunkSize)
+				{
+					Encode(Chunk, NumChunk);
+					NumChunk = 0;
+				}
+			});
+		}
+		Encode(Chunk, NumChunk);
+	}
+
+	const PrecisionBinary::FCanonicalHeader& GetHeader() const
+	{
+		return Header;
+	}
+
+private:
+	static constexpr int32 ChunkSize = 256;
+
+	void Encode(const FMantissa* Mantissas, int32 Num);
+
+	TArray<uint8>& Bytes;
+	PrecisionBinary::FCanonicalHeader Header;
+};
+
+/**
+ * Reads the fixed-point precision structs written by FPrecisionCanonicalWriter, on any platform, converting their numbers when they were
+ * written with other precision settings: rounded to the nearest when the fraction is shorter, saturated when they don't fit.
+ * The data must stay valid while it's read.
+ */
+class SPACEKITPRECISION_API FPrecisionCanonicalReader
+{
+public:
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+
+	FPrecisionCanonicalReader(const uint8* InData, int64 InNum);
+
+	explicit FPrecisionCanonicalReader(const TArray<uint8>& Bytes)
+		: FPrecisionCanonicalReader(Bytes.GetData(), Bytes.Num())
+	{
+	}
+
+	// Whether the data starts with a header of a known version
+	bool IsValid() const
+	{
+		return bValid;
+	}
+
+	// Whether the numbers were written with other precision settings, and are converted
+	bool NeedsConversion() const
+	{
+		return bValid && (Header.MantissaBits != REAL_FIXED_MANTISSA_SIZE || Header.FractionBits != REAL_FIXED_EXPONENT);
+	}
+
+	const PrecisionBinary::FCanonicalHeader& GetHeader() const
+	{
+		return Header;
+	}
+
+	// Numbers left to read, each struct being TPrecisionCanonicalTraits::NumValues numbers
+	int64 GetNumRemainingNumbers() const
+	{
+		return bValid ? (Num - Offset) / Header.ValueBytes : 0;
+	}
+
+	// Numbers read so far that didn't fit in the build's mantissas, and were saturated
+	int64 GetNumSaturated() const
+	{
+		return NumSaturated;
+	}
+
+	template<typename T>
+	bool Read(T& Value)
+	{
+		return Read(TArrayView<T>(&Value, 1));
+	}
+
+	// Reads Count structs into Values, resized to Count
+	template<typename T>
+	bool Read(TArray<T>& Values, int32 Count)
+	{
+		if (!bValid || Count < 0 || GetNumRemainingNumbers() < int64(Count) * TPrecisionCanonicalTraits<T>::NumValues)
+		{
+			return false;
+		}
+		Values.SetNum(Count);
+		return Read(TArrayView<T>(Values));
+	}
+
+	// Returns false, and reads nothing, when the header is invalid or the data doesn't have all the structs
+	template<typename T>
+	bool Read(TArrayView<T> Values)
+	{
+		if (!bValid || GetNumRemainingNumbers() < int64(Values.Num()) * TPrecisionCanonicalTraits<T>::NumValues)
+		{
+			return false;
+		}
+
+		FMantissa Chunk[ChunkSize];
+		int32 NumChunk = 0;
+		int32 ChunkIndex = 0;
+		int64 NumLeft = int64(Values.Num()) * TPrecisionCanonicalTraits<T>::NumValues;
+		for (T& Value : Values)
+		{
+			TPrecisionCanonicalTraits<T>::Visit(Value, [&](FRealFixed& Real)
+			{
+				if (ChunkIndex == NumChunk)
+				{
+					NumChunk = int32(FMath::Min<int64>(NumLeft, ChunkSize));
+					NumLeft -= NumChunk;
+					ChunkIndex = 0;
+					Decode(Chunk, NumChunk);
+				}
+				Real.Value.mantissa = Chunk[ChunkIndex++];
+			});
+		}
+		return true;
+	}
+
+private:
+	static constexpr int32 ChunkSize = 256;
+
+	void Decode(FMantissa* Mantissas, int32 Count);
+
+	const uint8* Data = nullptr;
+	int64 Num = 0;
+	int64 Offset = 0;
+	PrecisionBinary::FCanonicalHeader Header;
+	bool bValid = false;
+	int64 NumSaturated = 0;
+};
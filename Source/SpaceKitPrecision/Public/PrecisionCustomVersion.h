@@ -0,0 +1,47 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+// Versions of the binary serialization of the precision structs, recorded in the packages that save them
+struct SPACEKITPRECISION_API FPrecisionCustomVersion
+{
+	enum Type
+	{
+		// The structs were saved as their tagged properties, the bytes of InternalValue
+		BeforeCustomVersionWasAdded = 0,
+
+		// The structs are saved with their native Serialize, as the words of their mantissas (see PrecisionBinaryKernels.h)
+		NativeSerialization,
+
+		// The keyframe tracks write the version of their layout in front of it (see PrecisionTrack::FormatVersion)
+		KeyframeTrackFormatVersion,
+
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	static const FGuid GUID;
+
+	// Whether Ar uses the native Serialize of the precision structs. When loading data saved before it, Serialize returns false, and the
+	// engine reads the tagged properties instead
+	static bool UsesNativeSerialization(FArchive& Ar)
+	{
+		Ar.UsingCustomVersion(GUID);
+		return !Ar.IsLoading() || Ar.CustomVer(GUID) >= NativeSerialization;
+	}
+
+	// Native Serialize of the precision structs: saves or loads Struct with its operator<<, or returns false for the tagged properties of old data
+	template<typename StructType>
+	static bool SerializeNative(FArchive& Ar, StructType& Struct)
+	{
+		if (!UsesNativeSerialization(Ar))
+		{
+			return false;
+		}
+		Ar << Struct;
+		return true;
+	}
+};
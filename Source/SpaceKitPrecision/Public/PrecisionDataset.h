@@ -0,0 +1,146 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Serialization/BulkData.h"
+#include "SpaceKitPrecision/Public/VectorFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionDatasetKernels.h"
+
+#include "PrecisionDataset.generated.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Layouts of the positions of the datasets, see PrecisionDatasetKernels.h
+using EPrecisionDatasetLayout = PrecisionDataset::ELayout;
+
+/**
+ * Positions of a dataset, or of one of its LODs, read in place from its mapped file or bulk data: getting a position only reads its mantissas.
+ * The view is valid as long as the dataset it comes from.
+ */
+class SPACEKITPRECISION_API FPrecisionDatasetView
+{
+public:
+	FPrecisionDatasetView() = default;
+
+	FPrecisionDatasetView(const uint8* File, const PrecisionDataset::FHeader& Header, int32 Lod)
+		: View(File, Header, Lod)
+	{
+	}
+
+	int64 Num() const
+	{
+		return View.Num();
+	}
+
+	FVectorFixed operator[](int64 Index) const
+	{
+		FVectorFixed Position;
+		View.GetPosition(Index, Position.X.Value.mantissa, Position.Y.Value.mantissa, Position.Z.Value.mantissa);
+		return Position;
+	}
+
+	// Copies the positions [First, First + Count) to the end of Out
+	void CopyTo(TArray<FVectorFixed>& Out, int64 First = 0, int64 Count = MAX_int64) const;
+
+private:
+	PrecisionDataset::FView View;
+};
+
+/**
+ * Dataset of positions saved to a loose .skpd file (see PrecisionDatasetKernels.h), memory-mapped rather than loaded.
+ * Each LOD is mapped the first time it's viewed, and its pages are only read from the disk when its positions are:
+ *     FPrecisionMappedDataset Stars;
+ *     Stars.Open(FPaths::ProjectContentDir() / TEXT("Catalogs/Stars.skpd"));
+ *     const FPrecisionDatasetView Bright = Stars.GetView(0);
+ */
+class SPACEKITPRECISION_API FPrecisionMappedDataset
+{
+public:
+	FPrecisionMappedDataset();
+	~FPrecisionMappedDataset();
+
+	FPrecisionMappedDataset(const FPrecisionMappedDataset&) = delete;
+	FPrecisionMappedDataset& operator=(const FPrecisionMappedDataset&) = delete;
+
+	// Maps the header of the file. Returns false if the platform can't map files, or the file isn't a dataset of the build's precision settings
+	bool Open(const FString& Path);
+
+	void Close();
+
+	bool IsOpen() const
+	{
+		return Handle.IsValid();
+	}
+
+	int32 GetNumLods() const
+	{
+		return int32(Header.NumLods);
+	}
+
+	int64 GetNumPositions(int32 Lod = -1) const
+	{
+		return IsOpen() ? Header.GetLodCount(Lod) : 0;
+	}
+
+	// Positions of a LOD, or of the whole dataset when Lod is -1. Maps the LOD, if it isn't yet
+	FPrecisionDatasetView GetView(int32 Lod = -1);
+
+	// Writes Positions, sorted by LOD, to a dataset file. LodCounts are the increasing numbers of positions of the LODs but the last one
+	static bool SaveToFile(const FString& Path, const TArray<FVectorFixed>& Positions, const TArray<int64>& LodCounts = TArray<int64>(),
+		EPrecisionDatasetLayout Layout = EPrecisionDatasetLayout::ArrayOfStructures);
+
+private:
+	TUniquePtr<IMappedFileHandle> Handle;
+	PrecisionDataset::FHeader Header;
+
+	// Mapping of the header, then of each LOD, from the start of the file to the end of its last range
+	TArray<TUniquePtr<IMappedFileRegion>> Regions;
+};
+
+/**
+ * Data asset of millions of positions (star catalogs, asteroid fields), saved as a flat dataset (see PrecisionDatasetKernels.h) in bulk data
+ * rather than as a UPROPERTY array: loading the asset doesn't deserialize the positions. The payload is memory-mapped where the platform
+ * supports it, so the views read the positions in place, and elsewhere each LOD is read from the disk, alone, the first time it's viewed.
+ */
+UCLASS(BlueprintType)
+class SPACEKITPRECISION_API UPrecisionPositionDataset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Replaces the positions, sorted by LOD. LodCounts are the increasing numbers of positions of the LODs but the last one
+	void SetPositions(const TArray<FVectorFixed>& Positions, const TArray<int64>& LodCounts = TArray<int64>(),
+		EPrecisionDatasetLayout Layout = EPrecisionDatasetLayout::ArrayOfStructures);
+
+	// Positions of a LOD, or of the whole dataset when Lod is -1. Empty if the dataset was saved with other precision settings
+	FPrecisionDatasetView GetView(int32 Lod = -1);
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Dataset")
+	int32 GetNumLods();
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Dataset")
+	int64 GetNumPositions(int32 Lod = -1);
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Dataset")
+	FVectorFixed GetPosition(int64 Index);
+
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void BeginDestroy() override;
+
+private:
+	// Reads the header of the payload, locking the payload if it's in memory or mapped
+	bool OpenPayload();
+
+	void ClosePayload();
+
+	FByteBulkData Payload;
+
+	const uint8* LockedPayload = nullptr;
+	PrecisionDataset::FHeader Header;
+
+	// LODs read from the disk, when the payload isn't locked
+	TArray<TArray64<uint8>> LodPayloads;
+};
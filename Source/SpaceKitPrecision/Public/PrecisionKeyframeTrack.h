@@ -0,0 +1,334 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SpaceKitPrecision/Public/DualVectorRotatorFixed.h"
+#include "SpaceKitPrecision/Public/PrecisionCustomVersion.h"
+#include "SpaceKitPrecision/Public/TransformFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionTrackKernels.h"
+
+#include "PrecisionKeyframeTrack.generated.h"
+
+// Values of the keys of the tracks, as mantissas, and their interpolation
+template<typename KeyType>
+struct TPrecisionTrackKeyTraits;
+
+template<>
+struct TPrecisionTrackKeyTraits<FTransformFixed>
+{
+	static constexpr int32 NumValues = 9;
+
+	static void ToMantissas(const FTransformFixed& Key, real_fixed_type::ttIntMantissaType* Out)
+	{
+		const FRealFixed* Values[NumValues] = { &Key.Location.X, &Key.Location.Y, &Key.Location.Z,
+			&Key.Rotation.Pitch, &Key.Rotation.Yaw, &Key.Rotation.Roll, &Key.Scale.X, &Key.Scale.Y, &Key.Scale.Z };
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			Out[Value] = Values[Value]->Value.mantissa;
+		}
+	}
+
+	static void FromMantissas(const real_fixed_type::ttIntMantissaType* Mantissas, FTransformFixed& Out)
+	{
+		FRealFixed* Values[NumValues] = { &Out.Location.X, &Out.Location.Y, &Out.Location.Z,
+			&Out.Rotation.Pitch, &Out.Rotation.Yaw, &Out.Rotation.Roll, &Out.Scale.X, &Out.Scale.Y, &Out.Scale.Z };
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			Values[Value]->Value.mantissa = Mantissas[Value];
+		}
+	}
+
+	static FTransformFixed Interpolate(const FTransformFixed& A, const FTransformFixed& B, const FRealFixed& Alpha)
+	{
+		return FTransformFixed::Lerp(A, B, Alpha);
+	}
+};
+
+template<>
+struct TPrecisionTrackKeyTraits<FDualVectorRotatorFixed>
+{
+	static constexpr int32 NumValues = 9;
+
+	static void ToMantissas(const FDualVectorRotatorFixed& Key, real_fixed_type::ttIntMantissaType* Out)
+	{
+		const FRealFixed* Values[NumValues] = { &Key.VectorA.X, &Key.VectorA.Y, &Key.VectorA.Z, &Key.VectorB.X, &Key.VectorB.Y, &Key.VectorB.Z,
+			&Key.Rotator.Pitch, &Key.Rotator.Yaw, &Key.Rotator.Roll };
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			Out[Value] = Values[Value]->Value.mantissa;
+		}
+	}
+
+	static void FromMantissas(const real_fixed_type::ttIntMantissaType* Mantissas, FDualVectorRotatorFixed& Out)
+	{
+		FRealFixed* Values[NumValues] = { &Out.VectorA.X, &Out.VectorA.Y, &Out.VectorA.Z, &Out.VectorB.X, &Out.VectorB.Y, &Out.VectorB.Z,
+			&Out.Rotator.Pitch, &Out.Rotator.Yaw, &Out.Rotator.Roll };
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			Values[Value]->Value.mantissa = Mantissas[Value];
+		}
+	}
+
+	// The vectors are interpolated linearly, and the rotator along the shortest arc, like FTransformFixed::Lerp
+	static FDualVectorRotatorFixed Interpolate(const FDualVectorRotatorFixed& A, const FDualVectorRotatorFixed& B, const FRealFixed& Alpha)
+	{
+		return FDualVectorRotatorFixed(A.VectorA + (B.VectorA - A.VectorA) * Alpha, A.VectorB + (B.VectorB - A.VectorB) * Alpha,
+			FRotatorFixed(UQuatFixedMath::Slerp(FQuatFixed(A.Rotator), FQuatFixed(B.Rotator), Alpha)));
+	}
+};
+
+/**
+ * Keyframe track of FTransformFixed or FDualVectorRotatorFixed keys, delta encoded in mantissa space (see PrecisionTrackKernels.h): keys that
+ * move by small amounts take a few bytes instead of 9 mantissas. Sampling finds the keys around a time with a binary search of the seek points,
+ * and interpolates them with the fixed-point math, so every platform gets the same samples. With a cursor, playing the track forward only
+ * decodes the keys it goes past.
+ */
+template<typename KeyType>
+class TPrecisionKeyframeTrack
+{
+	using FTraits = TPrecisionTrackKeyTraits<KeyType>;
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+	static constexpr ttmath::uint Words = sizeof(FMantissa) / sizeof(ttmath::uint);
+	static constexpr int32 NumValues = FTraits::NumValues + 1;
+
+public:
+	TPrecisionKeyframeTrack()
+	{
+		Empty();
+	}
+
+	// Keys around the last time sampled with it. It's reset when the track changes
+	struct FCursor
+	{
+		PrecisionTrack::TCursor<Words, NumValues> Keys;
+		const TPrecisionKeyframeTrack* Track = nullptr;
+		uint32 Generation = 0;
+	};
+
+	int32 GetNumKeys() const
+	{
+		return NumKeys;
+	}
+
+	// Appends a key. Returns false, and ignores it, if it isn't after the last key
+	bool AddKey(const FRealFixed& Time, const KeyType& Key)
+	{
+		if (NumKeys > 0 && !(LastKey[0] < Time.Value.mantissa))
+		{
+			return false;
+		}
+
+		FMantissa Mantissas[NumValues];
+		Mantissas[0] = Time.Value.mantissa;
+		FTraits::ToMantissas(Key, Mantissas + 1);
+		const bool bSeekPoint = NumKeys % PrecisionTrack::SeekInterval == 0;
+		if (bSeekPoint)
+		{
+			PrecisionTrack::TSeekPoint<Words>& SeekPoint = SeekPoints.AddDefaulted_GetRef();
+			SeekPoint.Time = Mantissas[0];
+			SeekPoint.Offset = Bytes.Num();
+		}
+		PrecisionTrack::WriteKey(Bytes, Mantissas, bSeekPoint ? nullptr : LastKey, NumValues);
+		for (int32 Value = 0; Value < NumValues; ++Value)
+		{
+			LastKey[Value] = Mantissas[Value];
+		}
+		++NumKeys;
+		++Generation;
+		return true;
+	}
+
+	// Replaces the keys, sorted by time. Returns false if they weren't, and the keys that weren't after the previous one were ignored
+	bool SetKeys(const TArray<FRealFixed>& Times, const TArray<KeyType>& Keys)
+	{
+		Empty();
+		bool bSorted = Times.Num() == Keys.Num();
+		for (int32 Key = 0; Key < FMath::Min(Times.Num(), Keys.Num()); ++Key)
+		{
+			bSorted &= AddKey(Times[Key], Keys[Key]);
+		}
+		Bytes.Shrink();
+		SeekPoints.Shrink();
+		return bSorted;
+	}
+
+	void Empty()
+	{
+		Bytes.Empty();
+		SeekPoints.Empty();
+		NumKeys = 0;
+		for (FMantissa& Value : LastKey)
+		{
+			Value.SetZero();
+		}
+		++Generation;
+	}
+
+	// Time and value of a key. Decodes the keys from its seek point
+	bool GetKey(int32 Index, FRealFixed& OutTime, KeyType& OutKey) const
+	{
+		if (Index < 0 || Index >= NumKeys)
+		{
+			return false;
+		}
+		FMantissa Mantissas[NumValues];
+		const uint8* Read = Bytes.GetData() + SeekPoints[Index / PrecisionTrack::SeekInterval].Offset;
+		for (int32 Key = Index / PrecisionTrack::SeekInterval * PrecisionTrack::SeekInterval; Key <= Index; ++Key)
+		{
+			if (!PrecisionTrack::ReadKey(Read, Bytes.GetData() + Bytes.Num(), Mantissas, NumValues, Key % PrecisionTrack::SeekInterval == 0))
+			{
+				return false;
+			}
+		}
+		OutTime.Value.mantissa = Mantissas[0];
+		FTraits::FromMantissas(Mantissas + 1, OutKey);
+		return true;
+	}
+
+	// Value of the track at Time, interpolated between the keys around it, and clamped to the first and last keys. Pass the same cursor to
+	// successive samples (e.g. one cursor per playing montage) to skip the search while playing forward
+	KeyType Sample(const FRealFixed& Time, FCursor* Cursor = nullptr) const
+	{
+		KeyType Result;
+		if (NumKeys == 0)
+		{
+			return Result;
+		}
+
+		FCursor LocalCursor;
+		FCursor& Keys = Cursor ? *Cursor : LocalCursor;
+		if (Keys.Track != this || Keys.Generation != Generation)
+		{
+			Keys.Keys.Reset();
+			Keys.Track = this;
+			Keys.Generation = Generation;
+		}
+		if (!PrecisionTrack::Seek(Bytes.GetData(), Bytes.Num(), NumKeys, SeekPoints.GetData(), Time.Value.mantissa, Keys.Keys))
+		{
+			return Result;
+		}
+
+		FTraits::FromMantissas(Keys.Keys.Current + 1, Result);
+		if (!Keys.Keys.bHasNext || !(Keys.Keys.Current[0] < Time.Value.mantissa))
+		{
+			return Result;
+		}
+
+		KeyType Next;
+		FTraits::FromMantissas(Keys.Keys.Next + 1, Next);
+		const FRealFixed Start(real_fixed_type::FromMantissa(Keys.Keys.Current[0]));
+		const FRealFixed End(real_fixed_type::FromMantissa(Keys.Keys.Next[0]));
+		return FTraits::Interpolate(Result, Next, (Time - Start) / (End - Start));
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Bytes.GetAllocatedSize() + SeekPoints.GetAllocatedSize();
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, TPrecisionKeyframeTrack& Track)
+	{
+		Ar.UsingCustomVersion(FPrecisionCustomVersion::GUID);
+		if (!Ar.IsLoading() || Ar.CustomVer(FPrecisionCustomVersion::GUID) >= FPrecisionCustomVersion::KeyframeTrackFormatVersion)
+		{
+			uint8 FormatVersion = PrecisionTrack::FormatVersion;
+			Ar << FormatVersion;
+			if (FormatVersion != PrecisionTrack::FormatVersion)
+			{
+				// A layout from a newer plugin, whose size isn't known
+				Ar.SetError();
+				Track.Empty();
+				return Ar;
+			}
+		}
+
+		Ar << Track.NumKeys;
+		Ar << Track.Bytes;
+		int32 NumSeekPoints = Track.SeekPoints.Num();
+		Ar << NumSeekPoints;
+		if (Ar.IsLoading())
+		{
+			Track.SeekPoints.SetNum(FMath::Max(NumSeekPoints, 0));
+		}
+		for (PrecisionTrack::TSeekPoint<Words>& SeekPoint : Track.SeekPoints)
+		{
+			PrecisionBinary::SerializeInt(Ar, SeekPoint.Time);
+			Ar << SeekPoint.Offset;
+		}
+		for (FMantissa& Value : Track.LastKey)
+		{
+			PrecisionBinary::SerializeInt(Ar, Value);
+		}
+
+		// Tracks that don't match their seek points are emptied rather than read out of bounds
+		++Track.Generation;
+		if (Ar.IsLoading() && (Ar.IsError() || Track.NumKeys < 0 || Track.SeekPoints.Num() != (Track.NumKeys + PrecisionTrack::SeekInterval - 1) / PrecisionTrack::SeekInterval
+			|| !PrecisionTrack::AreSeekPointsValid(Track.SeekPoints.GetData(), Track.SeekPoints.Num(), Track.Bytes.Num())))
+		{
+			Track.Empty();
+		}
+		return Ar;
+	}
+
+private:
+	TArray<uint8> Bytes;
+	TArray<PrecisionTrack::TSeekPoint<Words>> SeekPoints;
+	int32 NumKeys = 0;
+
+	// Incremented by every change, to reset the cursors
+	uint32 Generation = 0;
+
+	// Time and values of the last key, that the next one is written relative to
+	FMantissa LastKey[NumValues];
+};
+
+/**
+ * Asset of a FTransformFixed keyframe track, such as an attack trajectory.
+ */
+UCLASS(BlueprintType)
+class SPACEKITPRECISION_API UTransformFixedTrack : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	TPrecisionKeyframeTrack<FTransformFixed> Track;
+
+	// Replaces the keys, sorted by time. Returns false if they weren't
+	UFUNCTION(BlueprintCallable, Category = "SpaceKit|Precision|Track")
+	bool SetKeys(const TArray<FRealFixed>& Times, const TArray<FTransformFixed>& Keys);
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Track")
+	FTransformFixed Sample(const FRealFixed& Time) const;
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Track")
+	int32 GetNumKeys() const;
+
+	virtual void Serialize(FArchive& Ar) override;
+};
+
+/**
+ * Asset of a FDualVectorRotatorFixed keyframe track, such as a hitbox sweep.
+ */
+UCLASS(BlueprintType)
+class SPACEKITPRECISION_API UDualVectorRotatorFixedTrack : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	TPrecisionKeyframeTrack<FDualVectorRotatorFixed> Track;
+
+	// Replaces the keys, sorted by time. Returns false if they weren't
+	UFUNCTION(BlueprintCallable, Category = "SpaceKit|Precision|Track")
+	bool SetKeys(const TArray<FRealFixed>& Times, const TArray<FDualVectorRotatorFixed>& Keys);
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Track")
+	FDualVectorRotatorFixed Sample(const FRealFixed& Time) const;
+
+	UFUNCTION(BlueprintPure, Category = "SpaceKit|Precision|Track")
+	int32 GetNumKeys() const;
+
+	virtual void Serialize(FArchive& Ar) override;
+};
@@ -0,0 +1,200 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "VectorFixed.h"
+#include "TransformFixed.h"
+
+#include "PrecisionNetSerialization.generated.h"
+
+/**
+ * Origin the FVectorFixed_NetQuantize positions are replicated relative to, so that they only take the bits of their offset to it.
+ * Set it to the origin of the sector (star system, level...) the session plays in, to the same value on the server and the clients,
+ * before anything replicates. It's zero by default.
+ */
+struct SPACEKITPRECISION_API FPrecisionNetAnchor
+{
+	static FVectorFixed Get();
+
+	static void Set(const FVectorFixed& Anchor);
+};
+
+/**
+ * FVectorFixed position, rounded to 1 unit for replication, and replicated relative to FPrecisionNetAnchor.
+ * A component within 1,000,000 units of the anchor takes at most 27 bits (a 7 bits length, the sign, and the offset without its leading bit), where it takes 16 bytes as an FVectorFixed property.
+ */
+USTRUCT(BlueprintType)
+struct SPACEKITPRECISION_API FVectorFixed_NetQuantize : public FVectorFixed
+{
+	GENERATED_BODY()
+
+	FVectorFixed_NetQuantize()
+	{
+	}
+
+	FVectorFixed_NetQuantize(const FVectorFixed& InVec)
+		: FVectorFixed(InVec)
+	{
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+/**
+ * FVectorFixed position, rounded to 1/16 unit (at least 1 decimal place) for replication, and replicated relative to FPrecisionNetAnchor.
+ * Each component takes 4 bits more than with FVectorFixed_NetQuantize
+ */
+USTRUCT(BlueprintType)
+struct SPACEKITPRECISION_API FVectorFixed_NetQuantize10 : public FVectorFixed
+{
+	GENERATED_BODY()
+
+	FVectorFixed_NetQuantize10()
+	{
+	}
+
+	FVectorFixed_NetQuantize10(const FVectorFixed& InVec)
+		: FVectorFixed(InVec)
+	{
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+/**
+ * FVectorFixed position, rounded to 1/128 unit (at least 2 decimal places) for replication, and replicated relative to FPrecisionNetAnchor.
+ * Each component takes 7 bits more than with FVectorFixed_NetQuantize
+ */
+USTRUCT(BlueprintType)
+struct SPACEKITPRECISION_API FVectorFixed_NetQuantize100 : public FVectorFixed
+{
+	GENERATED_BODY()
+
+	FVectorFixed_NetQuantize100()
+	{
+	}
+
+	FVectorFixed_NetQuantize100(const FVectorFixed& InVec)
+		: FVectorFixed(InVec)
+	{
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFixed_NetQuantize> : public TStructOpsTypeTraitsBase2<FVectorFixed_NetQuantize>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+	};
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFixed_NetQuantize10> : public TStructOpsTypeTraitsBase2<FVectorFixed_NetQuantize10>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+	};
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFixed_NetQuantize100> : public TStructOpsTypeTraitsBase2<FVectorFixed_NetQuantize100>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+	};
+};
+
+/**
+ * Replication state of the FTransformFixedNetDeltaArray and FVectorFixedNetDeltaArray containers.
+ * The sender numbers the states it sends, and the receiver only applies the deltas against the state it has: a delta against a state whose packet
+ * was lost is dropped. This relies on the engine rolling the base state of the connection back to the one the lost packet was sent against when
+ * it gets its NAK, so that the next delta is against a state the receiver has, even when the array didn't change since.
+ */
+struct SPACEKITPRECISION_API FPrecisionNetDeltaArrayState
+{
+	// Sender side
+	uint32 LastStateId = 0;
+	uint32 BaselineEpoch = 0;
+
+	// Receiver side: the mantissas received, which the next deltas apply to
+	uint32 ReceivedStateId = 0;
+	TArray<real_fixed_type::ttIntMantissaType> ReceivedMantissas;
+};
+
+/**
+ * Array of fixed-point transforms (projectile pools, formation members...), replicated as the changes since the state each connection has.
+ * Each changed component is sent as the difference of its mantissa, without its leading zero bits, and the unchanged components and
+ * transforms take 1 bit. Modify Items on the server only: the clients overwrite them with the replicated ones.
+ */
+USTRUCT(BlueprintType)
+struct SPACEKITPRECISION_API FTransformFixedNetDeltaArray
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FTransformFixed> Items;
+
+	// Makes the next replication to every connection send the whole array, rather than its changes
+	void ResetBaseline()
+	{
+		++State.BaselineEpoch;
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+
+	FPrecisionNetDeltaArrayState State;
+};
+
+/**
+ * Array of fixed-point vectors, replicated like FTransformFixedNetDeltaArray
+ */
+USTRUCT(BlueprintType)
+struct SPACEKITPRECISION_API FVectorFixedNetDeltaArray
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FVectorFixed> Items;
+
+	// Makes the next replication to every connection send the whole array, rather than its changes
+	void ResetBaseline()
+	{
+		++State.BaselineEpoch;
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+private:
+
+	FPrecisionNetDeltaArrayState State;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTransformFixedNetDeltaArray> : public TStructOpsTypeTraitsBase2<FTransformFixedNetDeltaArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFixedNetDeltaArray> : public TStructOpsTypeTraitsBase2<FVectorFixedNetDeltaArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,33 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VectorFloat.h"
+#include "VectorFixed.h"
+
+/**
+ * Exact geometric predicates for precision vectors. Each one returns a sign: -1, 0 or 1.
+ * They are first evaluated in double, with a bound on the rounding error, and only evaluated again with big numbers when the double result is too close to 0 to be trusted.
+ * That's the case for nearly degenerate inputs only, so most calls cost a few double operations, while the results are always the exact ones.
+ * Both FVectorFixed and FVectorFloat predicates are exact for any input, however far apart the exponents of FVectorFloat coordinates are.
+ */
+struct SPACEKITPRECISION_API FPrecisionPredicates
+{
+	// Positive when D is below the plane through A, B and C, these three appearing counterclockwise when seen from above. Negative when above, 0 when coplanar
+	static int32 Orient3D(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D);
+	static int32 Orient3D(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D);
+
+	// Positive when E is inside the sphere through A, B, C and D, negative when outside, 0 when on it.
+	// A, B, C and D must be ordered so that Orient3D(A, B, C, D) is positive, otherwise the sign is reversed
+	static int32 InSphere(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D, const FVectorFloat& E);
+	static int32 InSphere(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D, const FVectorFixed& E);
+
+	// Sign of the distance between A and B minus Distance: negative when A and B are closer than Distance
+	static int32 CompareDistance(const FVectorFloat& A, const FVectorFloat& B, const FRealFloat& Distance);
+	static int32 CompareDistance(const FVectorFixed& A, const FVectorFixed& B, const FRealFixed& Distance);
+
+	// Sign of the dot product of A and B: positive when they point to the same side
+	static int32 DotSign(const FVectorFloat& A, const FVectorFloat& B);
+	static int32 DotSign(const FVectorFixed& A, const FVectorFixed& B);
+};
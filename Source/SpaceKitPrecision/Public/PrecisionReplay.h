@@ -0,0 +1,92 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RealFixed.h"
+#include "RealFloat.h"
+#include "SpaceKitPrecision/Private/PrecisionReplayKernels.h"
+
+// Operations of the determinism traces, see PrecisionReplayKernels.h
+using EPrecisionReplayOp = PrecisionReplay::EOp;
+
+/**
+ * Result of the replay of a determinism trace.
+ * The build gives the same results as the one that recorded the trace, bit for bit, when IsOk().
+ */
+struct SPACEKITPRECISION_API FPrecisionReplayReport
+{
+	// Why the trace couldn't be replayed (not a trace, other precision settings, truncated...), empty otherwise
+	FString Error;
+
+	// ttmath backend of the build that recorded the trace
+	FString RecordedBackend;
+
+	// Number of operations replayed, up to and including the divergent one
+	int64 NumOps = 0;
+
+	// Index of the first operation whose result differs, or -1, with its function, inputs, and recorded and replayed results
+	int64 FirstDivergentOp = -1;
+	FString Function;
+	FString Inputs;
+	FString Expected;
+	FString Actual;
+
+	bool IsOk() const
+	{
+		return Error.IsEmpty() && FirstDivergentOp < 0;
+	}
+
+	FString ToString() const;
+};
+
+/**
+ * Records the precision math operations run through it, with their inputs and results, to a determinism trace.
+ * Route the operations lockstep or rollback code depends on through Run (in tests, or in a live session), save the trace,
+ * and replay it with the other builds (compilers, platforms, ttmath backends) to check they give the same results:
+ *     FPrecisionReplayRecorder Recorder;
+ *     const FRealFixed Speed = Recorder.Run(EPrecisionReplayOp::FixedDivide, Distance, Time);
+ *     Recorder.SaveToFile(TEXT("Saved/PrecisionReplay/Session.skpt"));
+ * The operations run with URealFixedMath and URealFloatMath, at full precision (see FRealFloatPrecision).
+ */
+class SPACEKITPRECISION_API FPrecisionReplayRecorder
+{
+public:
+
+	FPrecisionReplayRecorder();
+
+	// Runs a fixed-point operation (FixedAdd to FixedLogE), records it, and returns its result. B is ignored by the operations of one operand
+	FRealFixed Run(EPrecisionReplayOp Op, const FRealFixed& A, const FRealFixed& B = FRealFixed());
+
+	// Runs a big float operation (FloatAdd to FloatPow), records it, and returns its result
+	FRealFloat Run(EPrecisionReplayOp Op, const FRealFloat& A, const FRealFloat& B = FRealFloat());
+
+	// Records NumOps random operations of every kind, whose inputs only depend on Seed
+	void RecordWorkload(uint64 Seed, int32 NumOps);
+
+	int64 GetNumOps() const
+	{
+		return NumOps;
+	}
+
+	const TArray<uint8>& GetTrace() const
+	{
+		return Trace;
+	}
+
+	bool SaveToFile(const FString& Path) const;
+
+private:
+
+	TArray<uint8> Trace;
+	uint64 RollingHash;
+	int64 NumOps = 0;
+};
+
+struct SPACEKITPRECISION_API FPrecisionReplay
+{
+	// Runs the operations of a trace again, and reports the first one whose result differs from the recorded one
+	static FPrecisionReplayReport Replay(const TArray<uint8>& Trace);
+
+	static FPrecisionReplayReport ReplayFile(const FString& Path);
+};
@@ -0,0 +1,23 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "PrecisionReplayCommandlet.generated.h"
+
+/**
+ * Records or replays determinism traces (see FPrecisionReplay) without starting the editor, e.g. on build machines:
+ *     UnrealEditor-Cmd Project.uproject -run=PrecisionReplay -Record=Trace.skpt [-Ops=10000] [-Seed=42]
+ *     UnrealEditor-Cmd Project.uproject -run=PrecisionReplay -Replay=Trace.skpt
+ * Returns 1 when the replayed trace diverges, or can't be replayed.
+ */
+UCLASS()
+class UPrecisionReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -3,20 +3,79 @@
 #include "CoreMinimal.h"
 #include "RealFixedGeneric.h"
 
+// Every setting can also be overridden from the build, e.g. PublicDefinitions in a .Build.cs, or the accuracy harness configurations of Standalone/CMakeLists.txt
+
 // Parameters for real_fixed. Exponent size is 64 bits, which is the minimum
 // We want a 128 bits wide mantissa, as a 64 mantissa is too small, and 192 is overkill.
 // 102 bits mantissa and 26 exponent seems like a fair tradeoff between precision and upper bound:
 // In unreal units (1 unit = 1cm), the precision quantum is 0.14nm, and the upper bound is 40000 light-years (so that the world can be 80000ly wide)
+#ifndef REAL_FIXED_MANTISSA_SIZE
 #define REAL_FIXED_MANTISSA_SIZE 102
+#endif
+#ifndef REAL_FIXED_EXPONENT
 #define REAL_FIXED_EXPONENT 26
+#endif
 
 using real_fixed_type = real_fixed<REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT>;
 
+// real_fixed_type, its constants and its operators are instantiated once, in RealFixedGeneric.cpp, and only declared elsewhere: the
+// modules using the plugin don't compile, nor embed, their own copy of the ttmath multiplications and divisions behind them.
+// The plugin module itself instantiates them implicitly (see SpaceKitPrecision.Build.cs), as does the header-only standalone build.
+// In monolithic builds, the static initializers of the other modules may then run before the exponentiatedTtInt/TtBig constants
+// are initialized: they can build real_fixed_type from numbers, but shouldn't multiply, divide or parse them
+#ifndef SPACEKITPRECISION_EXTERN_TEMPLATES
+	#ifdef SPACEKITPRECISION_STANDALONE
+		#define SPACEKITPRECISION_EXTERN_TEMPLATES 0
+	#else
+		#define SPACEKITPRECISION_EXTERN_TEMPLATES 1
+	#endif
+#endif
+
+// Explicit instantiations of real_fixed_type and its operators. Prefix is "template" for the definitions, "extern template" for the declarations
+#define SPACEKITPRECISION_REAL_FIXED_INSTANTIATIONS(Prefix) \
+	Prefix struct SPACEKITPRECISION_API real_fixed<REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT>; \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator+(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator+=(real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator+=(real_fixed_type&, const float&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator-(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator-=(real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator-(const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator*(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator*=(real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator/(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator/=(real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator%(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API real_fixed_type operator%=(real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator<(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator<=(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator>=(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator>(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator==(const real_fixed_type&, const real_fixed_type&); \
+	Prefix SPACEKITPRECISION_API bool operator!=(const real_fixed_type&, const real_fixed_type&);
+
+#if SPACEKITPRECISION_EXTERN_TEMPLATES
+SPACEKITPRECISION_REAL_FIXED_INSTANTIATIONS(extern template)
+#endif
+
 // Whether to use boost for big numbers. Default is 1
+#ifndef USE_BOOST_BIG
 #define USE_BOOST_BIG 0
+#endif
 
 // Parameters for boost cpp_bin_float. Default is 192
+#ifndef BOOST_REAL_FLOAT_SIZE
 #define BOOST_REAL_FLOAT_SIZE 192
+#endif
 
 // Parameters for ttmath Big float. Exponent size is 64 bits, which is the minimum
+#ifndef TT_REAL_FLOAT_SIZE
 #define TT_REAL_FLOAT_SIZE 128
+#endif
+
+// ttmath float type of FRealFloat when USE_BOOST_BIG is 0, also used by the engine-free build (see Standalone/CMakeLists.txt)
+using tt_real_float_type = ttmath::Big<TTMATH_BITS(64), TTMATH_BITS(TT_REAL_FLOAT_SIZE)>;
+
+// Default precision budget of the FRealFloat transcendental functions, in significand bits. 0 is the full precision. See FRealFloatPrecision in PrecisionBudget.h
+#ifndef REAL_FLOAT_DEFAULT_PRECISION_BITS
+#define REAL_FLOAT_DEFAULT_PRECISION_BITS 0
+#endif
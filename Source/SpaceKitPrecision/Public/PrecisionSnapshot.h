@@ -0,0 +1,108 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceKitPrecision/Public/PrecisionStateHasher.h"
+
+/**
+ * Snapshots of simulation state, for rollback netcode: the state of the last NumFrames frames, captured every frame and restored by frame number.
+ * The state is made of blocks, arrays of precision structs registered once, that are copied to and from a ring buffer allocated when they are
+ * registered, so capturing and restoring don't allocate. The blocks are copied as their bytes, and restored at the address they were captured from.
+ *
+ * Blocks registered with dirty tracking are only copied when MarkDirty was called since their last copy: the frames then share the copy, and
+ * restoring a frame skips the blocks that didn't change since.
+ * With a FPrecisionStateHasher, the blocks are also registered in the hasher, the restored blocks are marked dirty in it, and each frame keeps
+ * the checksum of its state, to compare it with the other peers after a rollback.
+ */
+class SPACEKITPRECISION_API FPrecisionSnapshotBuffer
+{
+public:
+	explicit FPrecisionSnapshotBuffer(int32 InNumFrames = 10, FPrecisionStateHasher* InHasher = nullptr);
+
+	// Registers the Num elements at Data. They must stay at this address until Reset. Registering a block forgets the captured frames.
+	// Returns the index of the block, for MarkDirty
+	template<typename T>
+	int32 AddBlock(T* Data, int32 Num, bool bTrackDirty = false)
+	{
+		static_assert(TStructOpsTypeTraits<T>::WithNoDestructor, "The blocks are precision structs, that can be copied as their bytes");
+		const int32 HasherArray = Hasher ? Hasher->AddArray(Data, Num) : INDEX_NONE;
+		return AddBlock(Data, int64(FMath::Max(Num, 0)) * int64(sizeof(T)), FMath::Max(Num, 0), bTrackDirty, HasherArray);
+	}
+
+	// The array must not be resized until Reset
+	template<typename T>
+	int32 AddBlock(TArray<T>& Array, bool bTrackDirty = false)
+	{
+		return AddBlock(Array.GetData(), Array.Num(), bTrackDirty);
+	}
+
+	// Marks the elements [First, First + Num) of a block as changed, for the dirty tracking of the block and for the hasher
+	void MarkDirty(int32 BlockIndex, int32 First = 0, int32 Num = MAX_int32);
+
+	// Copies the blocks to the snapshot of Frame, from 0. Capturing a frame forgets the frames after it, and the frames NumFrames before it
+	void Capture(int32 Frame);
+
+	// Copies the snapshot of Frame back to the blocks, and forgets the frames after it. Returns false if the frame isn't in the buffer
+	bool Restore(int32 Frame);
+
+	bool HasFrame(int32 Frame) const;
+
+	// Checksum of the state of a frame, if the buffer has a hasher
+	bool GetChecksum(int32 Frame, uint64& OutChecksum) const;
+
+	int32 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	// Bytes copied by the last Capture or Restore
+	int64 GetLastCopiedBytes() const
+	{
+		return LastCopiedBytes;
+	}
+
+	// Unregisters the blocks and forgets the frames. The arrays registered in the hasher stay there
+	void Reset();
+
+private:
+	int32 AddBlock(void* Data, int64 NumBytes, int32 Num, bool bTrackDirty, int32 HasherArray);
+
+	void ForgetFrames();
+
+	// Frees the slots of the frames after Frame, up to LatestFrame, so HasFrame doesn't find them once later frames are captured again
+	void ForgetFramesAfter(int32 Frame);
+
+	struct FBlock
+	{
+		void* Data;
+		int64 NumBytes;
+		int32 Num;
+		bool bTrackDirty;
+		bool bDirty;
+		int32 HasherArray;
+
+		// Offset of the NumFrames copies of the block in the arena, and the index of the copy its data was last copied from or to
+		int64 ArenaOffset;
+		int32 LatestCopy;
+	};
+
+	struct FFrameSlot
+	{
+		int32 Frame;
+		uint64 Checksum;
+	};
+
+	const int32 NumFrames;
+	FPrecisionStateHasher* const Hasher;
+
+	TArray<FBlock> Blocks;
+	TArray<uint8> Arena;
+
+	// Frames of the ring buffer, at Frame % NumFrames, and for each one, the copy of each block it uses
+	TArray<FFrameSlot> Slots;
+	TArray<int32> SlotCopies;
+
+	int32 LatestFrame = INDEX_NONE;
+	int64 LastCopiedBytes = 0;
+};
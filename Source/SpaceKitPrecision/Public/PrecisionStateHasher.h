@@ -0,0 +1,91 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpaceKitPrecision/Public/TransformFixed.h"
+#include "SpaceKitPrecision/Private/PrecisionHashKernels.h"
+
+/**
+ * Checksum of simulation state, for desync detection in lockstep and rollback netcode.
+ * Register the arrays of precision structs the simulation updates, mark the elements it changes, and get the checksum every frame: the arrays
+ * are hashed by chunks of ChunkSize elements, and only the chunks with changed elements are hashed again, so the checksum of a large world
+ * costs about the changed elements. The checksum only depends on the mantissas, so every platform and build with the same state gets the same one.
+ */
+class SPACEKITPRECISION_API FPrecisionStateHasher
+{
+public:
+	static constexpr int32 ChunkSize = 64;
+
+	// Registers the Num elements at Data, of any precision struct with AppendHash (FRealFixed, FVectorFixed, FTransformFixed...).
+	// They must stay at this address until Reset. Returns the index of the array, for MarkDirty. All the elements start dirty
+	template<typename T>
+	int32 AddArray(const T* Data, int32 Num)
+	{
+		return AddArray(Data, Num, &HashElements<T>);
+	}
+
+	template<typename T>
+	int32 AddArray(const TArray<T>& Array)
+	{
+		return AddArray(Array.GetData(), Array.Num());
+	}
+
+	// Marks the elements [First, First + Num) of an array as changed since the last checksum
+	void MarkDirty(int32 ArrayIndex, int32 First, int32 Num = 1);
+
+	// Marks all the elements as changed, e.g. after restoring a snapshot
+	void MarkAllDirty();
+
+	// Unregisters all the arrays
+	void Reset();
+
+	// Checksum of the registered arrays. Hashes the dirty chunks again, and combines the hashes of all the chunks
+	uint64 GetChecksum();
+
+	// Chunks hashed by the last GetChecksum
+	int32 GetNumChunksHashed() const
+	{
+		return NumChunksHashed;
+	}
+
+	// Hash of an array of precision structs, at once
+	template<typename T>
+	static uint64 HashArray(const T* Data, int32 Num)
+	{
+		PrecisionHash::FXxHash64 Hash;
+		HashElements<T>(Hash, Data, 0, Num);
+		return Hash.Finish();
+	}
+
+private:
+	using FHashElementsFunction = void(*)(PrecisionHash::FXxHash64& Hash, const void* Data, int32 First, int32 Num);
+
+	template<typename T>
+	static void HashElements(PrecisionHash::FXxHash64& Hash, const void* Data, int32 First, int32 Num)
+	{
+		const T* Elements = static_cast<const T*>(Data) + First;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Elements[Index].AppendHash(Hash);
+		}
+	}
+
+	int32 AddArray(const void* Data, int32 Num, FHashElementsFunction HashFunction);
+
+	struct FRegisteredArray
+	{
+		const void* Data;
+		int32 Num;
+		FHashElementsFunction HashElements;
+		int32 FirstChunk;
+	};
+
+	TArray<FRegisteredArray> Arrays;
+
+	// Hashes of the chunks of all the arrays, and whether their elements changed since
+	TArray<uint64> ChunkHashes;
+	TBitArray<> DirtyChunks;
+
+	int32 NumChunksHashed = 0;
+};
@@ -0,0 +1,49 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Whether the expensive entry points of the plugin are instrumented. Default is on, except in shipping builds
+#ifndef SPACEKITPRECISION_WITH_STATS
+#define SPACEKITPRECISION_WITH_STATS !UE_BUILD_SHIPPING
+#endif
+
+#if SPACEKITPRECISION_WITH_STATS
+
+// "stat SpaceKitPrecision": time spent in each expensive kernel, and how many times it was called during the frame
+DECLARE_STATS_GROUP(TEXT("SpaceKitPrecision"), STATGROUP_SpaceKitPrecision, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trigonometry"), STAT_SpaceKitPrecision_Trig, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inverse trigonometry"), STAT_SpaceKitPrecision_InverseTrig, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Square root"), STAT_SpaceKitPrecision_Sqrt, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Exponential and logarithm"), STAT_SpaceKitPrecision_ExpLog, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fixed to big float"), STAT_SpaceKitPrecision_ToBig, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("String import"), STAT_SpaceKitPrecision_StringImport, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("String export"), STAT_SpaceKitPrecision_StringExport, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transform compose"), STAT_SpaceKitPrecision_TransformCompose, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trigonometry calls"), STAT_SpaceKitPrecision_TrigCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Inverse trigonometry calls"), STAT_SpaceKitPrecision_InverseTrigCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Square root calls"), STAT_SpaceKitPrecision_SqrtCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Exponential and logarithm calls"), STAT_SpaceKitPrecision_ExpLogCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fixed to big float calls"), STAT_SpaceKitPrecision_ToBigCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("String import calls"), STAT_SpaceKitPrecision_StringImportCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("String export calls"), STAT_SpaceKitPrecision_StringExportCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Transform compose calls"), STAT_SpaceKitPrecision_TransformComposeCalls, STATGROUP_SpaceKitPrecision, SPACEKITPRECISION_API);
+
+// Instruments the rest of the current scope as a call to Kernel (Trig, InverseTrig, Sqrt, ExpLog, ToBig, StringImport, StringExport or TransformCompose):
+// it is named in Unreal Insights, timed in the stat group, and counted in the per-frame calls of the kernel.
+// Kernels can nest (e.g. fixed-point trigonometry converts to big floats), the inner ones are then both timed and counted on their own.
+#define SPACEKITPRECISION_SCOPE(Kernel) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(SpaceKitPrecision_##Kernel); \
+	SCOPE_CYCLE_COUNTER(STAT_SpaceKitPrecision_##Kernel); \
+	INC_DWORD_STAT(STAT_SpaceKitPrecision_##Kernel##Calls)
+
+#else
+
+#define SPACEKITPRECISION_SCOPE(Kernel)
+
+#endif
@@ -60,9 +60,7 @@ public:
     // Rotates a given vector by this quaternion. Assumes this quaternion is normalized.
     FVectorFixed RotateVector(const FVectorFixed& V) const
     {
-        const FVectorFixed Q_xyz(X, Y, Z);
-        const FVectorFixed T = FVectorFixed::CrossProduct(Q_xyz, V) * FRealFixed(2);
-        return V + (T * W) + FVectorFixed::CrossProduct(Q_xyz, T);
+        return PrecisionGeometry::QuatRotateVector(*this, V);
     }
 
 	// Rotates backward a given vector by this quaternion. Assumes this quaternion is normalized.
@@ -97,7 +95,7 @@ public:
     // For a unit quaternion, the inverse is the conjugate.
     FQuatFixed Inverse() const
     {
-        return FQuatFixed(-X, -Y, -Z, W);
+        return PrecisionGeometry::QuatInverse(*this);
     }
 
     FString ToString() const
@@ -112,6 +110,44 @@ public:
 	
     // Gets the axis and angle (in degrees) of this quaternion.
     void ToAxisAndAngle(FVectorFixed& OutAxis, FRealFixed& OutAngleDeg) const;
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FQuatFixed& Q)
+    {
+        return Ar << Q.X << Q.Y << Q.Z << Q.W;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        X.AppendHash(Hash);
+        Y.AppendHash(Hash);
+        Z.AppendHash(Hash);
+        W.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FQuatFixed& Q)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        Q.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FQuatFixed> : public TStructOpsTypeTraitsBase2<FQuatFixed>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 /**
@@ -7,6 +7,7 @@
 #include "QuatFloat.generated.h"
 
 struct FRotatorFloat;
+struct FRotationMatrixFloat;
 
 // Similar to an FQuat, but using reals instead of floats
 USTRUCT(BlueprintType)
@@ -80,6 +81,15 @@ public:
         return Vec + (T * W) + FVectorFloat::CrossProduct(Q, T);
     }
 
+    // Builds the rotation matrix of this quaternion, which must be normalized, to rotate many vectors faster. See FRotationMatrixFloat
+    FRotationMatrixFloat ToMatrix() const;
+
+    // Rotates every vector of the array in place. This builds the rotation matrix once, which is faster than RotateVector as soon as there are a few vectors
+    void RotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
+    // Unrotates every vector of the array in place, see RotateVectors
+    void UnrotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
 	// Normalizes this quaternion. Note that you can only apply a rotation to a vector using a normalized quaternion. Not normalized quaternion's results are undefined
     FQuatFloat GetNormalized()
     {
@@ -140,7 +150,7 @@ public:
         return FQuatFloat(qt[0], qt[1], qt[2], qt[3]);
     }
 
-	// Converts this to a string, with almost 100% precision, except for very small numbers (see FRealFloat.ToString())
+	// Converts this to a string, without precision loss (see FRealFloat::ToChars)
     FString ToString() const
     {
         return FString::Printf(TEXT("(X=%s,Y=%s,Z=%s,W=%s)"), *X.ToString(), *Y.ToString(), *Z.ToString(), *W.ToString());
@@ -173,6 +183,49 @@ public:
     {
         return FQuatFloat(-X, -Y, -Z, W);
     }
+
+    bool operator==(const FQuatFloat& Other) const
+    {
+        return X == Other.X && Y == Other.Y && Z == Other.Z && W == Other.W;
+    }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FQuatFloat& Q)
+    {
+        return Ar << Q.X << Q.Y << Q.Z << Q.W;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        X.AppendHash(Hash);
+        Y.AppendHash(Hash);
+        Z.AppendHash(Hash);
+        W.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FQuatFloat& Q)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        Q.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FQuatFloat> : public TStructOpsTypeTraitsBase2<FQuatFloat>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 struct FRotatorFloat;
@@ -215,4 +268,13 @@ public:
 	UFUNCTION(BlueprintPure, category = "QuatFloat", meta = (DisplayName = "QuatFloat != QuatFloat", CompactNodeTitle = "!="))
     static FQuatFloat Slerp(FQuatFloat First, FQuatFloat Second, const FRealFloat& Alpha);
 
+// Batched rotations, using the rotation matrix of the quaternion
+public:
+
+    UFUNCTION(BlueprintPure, category = "QuatFloat|Array", meta = (DisplayName = "QuatFloat Rotate Vectors"))
+    static TArray<FVectorFloat> RotateVectors(const FQuatFloat& Quat, const TArray<FVectorFloat>& Vectors, bool bParallel = false);
+
+    UFUNCTION(BlueprintPure, category = "QuatFloat|Array", meta = (DisplayName = "QuatFloat Unrotate Vectors"))
+    static TArray<FVectorFloat> UnrotateVectors(const FQuatFloat& Quat, const TArray<FVectorFloat>& Vectors, bool bParallel = false);
+
 };
@@ -5,6 +5,8 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "RealFixedGeneric.h"
 #include "PrecisionSettings.h"
+#include "PrecisionCustomVersion.h"
+#include "SpaceKitPrecision/Private/PrecisionHashKernels.h"
 
 #include "RealFixed.generated.h"
 
@@ -53,6 +55,9 @@ public:
 
     explicit FRealFixed(const FString& InValue);
 
+    // Converts a big floating-point number, rounding it to the nearest fixed-point quantum. This works on the binary representation, without going through double or string
+    explicit FRealFixed(const FRealFloat& InValue);
+
     FRealFixed& operator=(const FRealFixed& Other)
     {
         Value = Other.Value;
@@ -70,6 +75,17 @@ public:
 
     FString ToString() const;
 
+    // Characters needed by ToChars, terminating null included
+    static constexpr int32 MaxChars = real_fixed_type::MaxChars;
+
+    // Writes this number in base 10 to Buffer, without allocating, see real_fixed::ToChars.
+    // Returns the number of characters written, or 0 when BufferLength is smaller than MaxChars
+    int32 ToChars(TCHAR* Buffer, int32 BufferLength) const;
+
+    // Reads a base 10 number from the start of Text, rounded to the nearest, see real_fixed::FromChars.
+    // Returns the number of characters read, or 0 when Text doesn't start with a number
+    static int32 FromChars(const TCHAR* Text, FRealFixed& OutValue);
+
     explicit operator int32() const
     {
         return ToDouble();
@@ -78,6 +94,30 @@ public:
     bool ExportTextItem(FString& ValueStr, FRealFixed const& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
     bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
 
+    // Replicates the mantissa without its leading zero bits, losslessly. See PrecisionNetKernels.h
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    // Saves and loads the words of the mantissa, see PrecisionBinaryKernels.h. Returns false when loading data saved as tagged properties
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend SPACEKITPRECISION_API FArchive& operator<<(FArchive& Ar, FRealFixed& Real);
+
+    // Feeds the words of the mantissa to a hash, see FPrecisionStateHasher. Equal numbers have equal hashes
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        Hash.Add(Value.mantissa);
+    }
+
+    friend uint32 GetTypeHash(const FRealFixed& Real)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        Real.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+
     static FRealFixed GetMaxValue()
     {
         return FRealFixed(real_fixed_type::GetMaxValue());
@@ -96,7 +136,8 @@ public:
 
 FRealFixed operator""_fx(const char* str);
 
-// Type traits, so Unreal Engine knows FRealFixed implements ExportTextItem and ImportTextItem
+// Type traits, so Unreal Engine knows FRealFixed implements ExportTextItem, ImportTextItem, Serialize, NetSerialize and operator==.
+// The precision structs are not WithZeroConstructor: their constructors bind Value to InternalValue
 template<>
 struct TStructOpsTypeTraits<FRealFixed> : public TStructOpsTypeTraitsBase2<FRealFixed>
 {
@@ -104,6 +145,12 @@ struct TStructOpsTypeTraits<FRealFixed> : public TStructOpsTypeTraitsBase2<FReal
     {
         WithExportTextItem = true,
         WithImportTextItem = true,
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+        WithNetSerializer = true,
+        WithNetSharedSerialization = true,
     };
 };
 
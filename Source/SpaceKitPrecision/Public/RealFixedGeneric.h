@@ -3,18 +3,15 @@
 #pragma once
 
 // Include ttmath
-#pragma warning(push)
-#pragma warning(disable: 5051)
-#define TTMATH_NOASM // It doesn't seem to be possible to link to ASM in UE4, so, disable it
-#include "SpaceKitPrecision/Private/ttmath/ttmath.h"
-#pragma warning(pop)
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+#include "SpaceKitPrecision/Private/PrecisionTextKernels.h"
 
 #include "HAL/Platform.h"
 #include "CoreMinimal.h"
 
 
 // Helpers for pow big, as the default Pow function is inline
-template<int a, int b>
+template<ttmath::uint a, ttmath::uint b>
 constexpr ttmath::Big<a, b> PowBig(const ttmath::Big<a, b>& x, const ttmath::Big<a, b>& y)
 {
 	ttmath::Big<a, b> temp = x;
@@ -23,7 +20,7 @@ constexpr ttmath::Big<a, b> PowBig(const ttmath::Big<a, b>& x, const ttmath::Big
 }
 
 // Helpers for pow int, as the default Pow function is inline
-template<int a>
+template<ttmath::uint a>
 constexpr ttmath::Int<a> PowInt(const ttmath::Int<a>& x, const ttmath::Int<a>& y)
 {
 	ttmath::Int<a> temp = x;
@@ -31,6 +28,17 @@ constexpr ttmath::Int<a> PowInt(const ttmath::Int<a>& x, const ttmath::Int<a>& y
 	return temp;
 }
 
+// Helper for 2^x as a double, computed at compile time, so that it's ready for the static initializers of any module
+constexpr double PowTwoDouble(int x)
+{
+	double temp = 1.0;
+	for (int i = 0; i < x; ++i)
+	{
+		temp *= 2.0;
+	}
+	return temp;
+}
+
 // Type for a number with fixed point. MantissaSize is the size of the mantissa, in bits, and exponent is the (negated) 2-powered exponent of the number.
 // Exponent has to be positive, as it is negated i.e. if the actual value is mantissa * 2^(-exponent).
 // The actual mantissa size is guaranteed to be at least MantissaSize, but can actually be bigger.
@@ -62,6 +70,8 @@ struct real_fixed
 	{
 	}
 
+	real_fixed<MantissaSize, Exponent>& operator=(const real_fixed<MantissaSize, Exponent>& x) = default;
+
 private:
 
 	// Do not use. Use real_fixed::FromMantissa instead, that explicitly describes this
@@ -92,22 +102,22 @@ public:
 		(inValue * exponentiatedTtBig).ToInt(mantissa);
 	}
 
-	// Creates a real_fixed number based on a base-10 string representation
+	// Creates a real_fixed number based on a base-10 string representation, rounded to the nearest. See FromChars
 	constexpr real_fixed(const std::string& initString)
 	{
-		(ttBigType(initString) * exponentiatedTtBig).ToInt(mantissa);
+		FromChars(initString.c_str(), *this);
 	}
 
 	// See real_fixed(std::string initString)
 	constexpr real_fixed(const char* initString)
 	{
-		(ttBigType(initString) * exponentiatedTtBig).ToInt(mantissa);
+		FromChars(initString, *this);
 	}
 
 	// See real_fixed(std::string initString)
 	constexpr real_fixed(const FString& initString)
 	{
-		(ttBigType(TCHAR_TO_ANSI(*initString)) * exponentiatedTtBig).ToInt(mantissa);
+		FromChars(*initString, *this);
 	}
 
 	// Creates a real_fixed number based on a double number
@@ -147,41 +157,123 @@ public:
 	}
 
 	// Converts this number to a floating-point big number. This may not lead to precision loss
-	constexpr ttBigType ToBig() const
+	ttBigType ToBig() const
 	{
-		return ttBigType(mantissa) / exponentiatedDouble;
+		return ToBigExact<ttBigType>();
 	}
 
-	// Converts this number to a base 10 string, with little to no precision loss
-	// The precision loss appears for small numbers, where the string is rounded:
-	// For a given x, then |x - real_fixed(x.ToString())| <= 10^(-floor(Exponent*ln(2)/ln(10)))
-	// However, if x is itself imported from an exported string, there will be no precision loss:
-	// For a given y, so that x=real_fixed(y.ToString()), then x = real_fixed(x.ToString())
-	FString ToString()
+	// Converts this number to a ttmath float number of any size, by moving the mantissa into the float's significand and offsetting its exponent.
+	// There is no precision loss as long as the float's significand is at least as wide as the mantissa. Otherwise, the lowest bits are dropped
+	template<typename BigType>
+	BigType ToBigExact() const
 	{
-		// There is no built-in way to convert fixed point numbers to string, and it's too hard and error prone to code it manually,
-		// so we'll use some of the features ttmath has to offer, but with some modifications
-
-		// First, extract the integral (left side of comma) and decimal (right side of the comma) parts
-		const ttBigType RightPart = ttBigType(Abs(mantissa) % exponentiatedTtInt) / exponentiatedTtBig;
-		const ttIntMantissaType LeftPart = mantissa / exponentiatedTtInt;
-
-		// Convert the right side to string, using ttmath.
-		ttmath::Conv c;
-		// Also, tell ttmath about the maximum figures, so we don't get rounding errors (aka 0.1 that becomes 0.099999999)
-		c.round = FMath::FloorToInt((float)Exponent * FMath::Loge(2.0) / FMath::Loge(10.0));
-		FString RightPartString = FString(RightPart.ToString(c).c_str());
-		// Remove the "0." part, so we can append this to the left part, adding a comma in between
-		RightPartString.RemoveFromStart("0.");
-
-		// Convert the left side to string, using ttmath.
-		auto LeftPartString = ttbigToString<ttIntMantissaType>(LeftPart);
-
-		// Compute the result, and return
-		const FString Result = LeftPartString + "." + RightPartString;
+		BigType Result;
+		Result.FromInt(mantissa);
+		if (!Result.IsZero())
+		{
+			Result.exponent.SubInt(Exponent);
+		}
 		return Result;
 	}
 
+	// Builds a real_fixed number from a ttmath float number of any size, by shifting the float's significand to the fixed point.
+	// The result is rounded to the nearest quantum (2^-Exponent), ties away from zero. NaN gives 0, and values out of range are clamped to +/-GetMaxValue()
+	template<ttmath::uint BigExponent, ttmath::uint BigMantissa>
+	static real_fixed<MantissaSize, Exponent> FromBigRounded(const ttmath::Big<BigExponent, BigMantissa>& inValue)
+	{
+		constexpr ttmath::uint MantissaWords = TTMATH_BITS(MantissaSize + Exponent);
+		constexpr ttmath::uint WorkWords = (BigMantissa > MantissaWords ? BigMantissa : MantissaWords) + 1;
+
+		if (inValue.IsNan() || inValue.IsZero())
+		{
+			return FromMantissa(ttIntMantissaType(0));
+		}
+
+		// The significand, as an integer, in a buffer wide enough for both the float and the fixed mantissa
+		ttmath::UInt<WorkWords> Work;
+		Work.SetZero();
+		for (ttmath::uint i = 0; i < BigMantissa; ++i)
+		{
+			Work.table[i] = inValue.mantissa.table[i];
+		}
+
+		// inValue = significand * 2^exponent, and we want mantissa = inValue * 2^Exponent = significand * 2^(exponent + Exponent)
+		const ttmath::sint Shift = inValue.exponent.ToInt() + ttmath::sint(Exponent);
+		bool bOverflow = false;
+
+		if (Shift < 0)
+		{
+			if (-Shift > ttmath::sint(WorkWords * TTMATH_BITS_PER_UINT))
+			{
+				return FromMantissa(ttIntMantissaType(0));
+			}
+
+			// Rcr returns the last bit shifted out, i.e. the half quantum bit
+			if (Work.Rcr(ttmath::uint(-Shift)))
+			{
+				Work.AddOne();
+			}
+		}
+		else if (Shift > 0)
+		{
+			bOverflow = Shift >= ttmath::sint(WorkWords * TTMATH_BITS_PER_UINT) || Work.Rcl(ttmath::uint(Shift)) != 0;
+		}
+
+		// The value must fit in the mantissa, leaving its sign bit free
+		for (ttmath::uint i = MantissaWords; i < WorkWords && !bOverflow; ++i)
+		{
+			bOverflow = Work.table[i] != 0;
+		}
+		bOverflow = bOverflow || (Work.table[MantissaWords - 1] & TTMATH_UINT_HIGHEST_BIT) != 0;
+
+		ttIntMantissaType Result;
+		if (bOverflow)
+		{
+			Result.SetMax();
+		}
+		else
+		{
+			for (ttmath::uint i = 0; i < MantissaWords; ++i)
+			{
+				Result.table[i] = Work.table[i];
+			}
+		}
+
+		if (inValue.IsSign())
+		{
+			Result.ChangeSign();
+		}
+
+		return FromMantissa(Result);
+	}
+
+	// Characters needed by ToChars, terminating null included
+	static constexpr int32 MaxChars = PrecisionText::FixedChars(TTMATH_BITS(MantissaSize + Exponent), Exponent);
+
+	// Writes this number in base 10 to Buffer, as [-]integer.fraction, with the shortest fraction that converts back to the same number: x = real_fixed(x.ToString()).
+	// Returns the number of characters written, without the terminating null, or 0 when BufferLength is smaller than MaxChars
+	template<typename CharType>
+	int32 ToChars(CharType* Buffer, int32 BufferLength) const
+	{
+		return PrecisionText::FormatFixed<Exponent>(mantissa, Buffer, BufferLength);
+	}
+
+	// Reads a base 10 number, [+-]digits[.digits][(e|E)[+-]digits], from the start of Text, rounded to the nearest, saturated to GetMaxValue.
+	// Returns the number of characters read, or 0 when Text doesn't start with a number, and Result is then 0
+	template<typename CharType>
+	static int32 FromChars(const CharType* Text, real_fixed<MantissaSize, Exponent>& Result)
+	{
+		return PrecisionText::ParseFixed<Exponent>(Text, Result.mantissa);
+	}
+
+	// Converts this number to a base 10 string, see ToChars
+	FString ToString() const
+	{
+		TCHAR Buffer[MaxChars];
+		ToChars(Buffer, MaxChars);
+		return FString(Buffer);
+	}
+
 	static real_fixed<MantissaSize, Exponent> GetMaxValue()
 	{
 		ttIntMantissaType temp;
@@ -203,7 +295,7 @@ template<int MantissaSize, int Exponent>
 const ttmath::Big<1, TTMATH_BITS(MantissaSize + Exponent)> real_fixed<MantissaSize, Exponent>::exponentiatedTtBig = PowBig(ttBigType(2.0), ttBigType(Exponent));
 
 template<int MantissaSize, int Exponent>
-const double real_fixed<MantissaSize, Exponent>::exponentiatedDouble = pow(2.0, Exponent);
+const double real_fixed<MantissaSize, Exponent>::exponentiatedDouble = PowTwoDouble(Exponent);
 
 // Operators for fixed point numbers
 
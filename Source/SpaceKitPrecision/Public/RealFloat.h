@@ -3,23 +3,28 @@
 #pragma once
 
 // Include ttmath
-#pragma warning(push)
-#pragma warning(disable: 5051)
-#define TTMATH_NOASM // That's super sad to not include ASM, but otherwise, it doesn't compile on MSVC/UE4
-#include "SpaceKitPrecision/Private/ttmath/ttmath.h"
-#pragma warning(pop)
+#include "SpaceKitPrecision/Private/PrecisionTtmath.h"
+#include "SpaceKitPrecision/Private/PrecisionTextKernels.h"
 
 #include "Kismet/BlueprintFunctionLibrary.h"
-#include "BoostFPM/Public/BoostFPM.h"
 #include "CoreMinimal.h"
 #include "PrecisionSettings.h"
+#include "PrecisionCustomVersion.h"
+#include "SpaceKitPrecision/Private/PrecisionHashKernels.h"
 #include "HAL/Platform.h"
 #include "Internationalization/FastDecimalFormat.h"
 
+// boost is only needed when it's the storage of FRealFloat
+#if USE_BOOST_BIG
+#include "BoostFPM/Public/BoostFPM.h"
+#endif
+
 #include "RealFloat.generated.h"
 
+#if USE_BOOST_BIG
 using float256 = boost::multiprecision::number<boost::multiprecision::backends::cpp_bin_float<BOOST_REAL_FLOAT_SIZE,
     boost::multiprecision::backends::digit_base_2>, boost::multiprecision::et_off>;
+#endif
 
 struct FRealFixed;
 /**
@@ -37,7 +42,7 @@ struct SPACEKITPRECISION_API FRealFloat
     using ttBigType = float256;
 #else
     // Alternatively, if you prefer to use the ttmath numbers, you can use this
-    using ttBigType = ttmath::Big<TTMATH_BITS(64), TTMATH_BITS(TT_REAL_FLOAT_SIZE)>; 
+    using ttBigType = tt_real_float_type;
 #endif
 
 /*
@@ -78,6 +83,9 @@ public:
 
     explicit FRealFloat(const FString& InValue);
 
+    // Converts a fixed-point number. This is exact as long as the significand is at least as wide as the fixed-point mantissa, which is the case with the default settings
+    explicit FRealFloat(const FRealFixed& InValue);
+
     FRealFloat& operator=(const FRealFloat& Other)
     {
         Value = Other.Value;
@@ -92,6 +100,17 @@ public:
 
     FString ToString() const;
 
+    // Characters needed by ToChars, terminating null included
+    static constexpr int32 MaxChars = PrecisionText::FloatChars(TTMATH_BITS(TT_REAL_FLOAT_SIZE));
+
+    // Writes this number in base 10 to Buffer, without allocating, with the shortest digits that convert back to the same number (see PrecisionText::FormatFloat).
+    // Returns the number of characters written, or 0 when BufferLength is smaller than MaxChars
+    int32 ToChars(TCHAR* Buffer, int32 BufferLength) const;
+
+    // Reads a base 10 number, [+-]digits[.digits][(e|E)[+-]digits], from the start of Text, rounded to the nearest.
+    // Returns the number of characters read, or 0 when Text doesn't start with a number
+    static int32 FromChars(const TCHAR* Text, FRealFloat& OutValue);
+
     explicit operator int32() const
     {
         return ToDouble();
@@ -100,6 +119,32 @@ public:
     bool ExportTextItem(FString& ValueStr, FRealFloat const& DefaultValue, UObject* Parent, int32 PortFlags, UObject* ExportRootScope) const;
     bool ImportTextItem(const TCHAR*& Buffer, int32 PortFlags, UObject* Parent, FOutputDevice* ErrorText);
 
+    // Saves and loads the words of the exponent and the mantissa, see PrecisionBinaryKernels.h (with boost, the bytes of the number).
+    // Returns false when loading data saved as tagged properties
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend SPACEKITPRECISION_API FArchive& operator<<(FArchive& Ar, FRealFloat& Real);
+
+    // Feeds the words of the exponent and mantissa to a hash (with boost, the bytes of the number), see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+#if USE_BOOST_BIG
+        Hash.AddBytes(InternalValue, sizeof(InternalValue));
+#else
+        Hash.Add(Value);
+#endif
+    }
+
+    friend uint32 GetTypeHash(const FRealFloat& Real)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        Real.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+
     static FRealFloat GetMaxValue();
 
     static FRealFloat GetMinValue();
@@ -136,7 +181,7 @@ template <> struct TNumericLimits<FRealFloat>
 
 SPACEKITPRECISION_API FRealFloat operator""_fl(const char* str);
 
-// Type traits, so UE4 knows FRealFloat implements ExportTextItem and ImportTextItem
+// Type traits, so UE4 knows FRealFloat implements ExportTextItem, ImportTextItem, Serialize and operator==
 template<>
 struct TStructOpsTypeTraits<FRealFloat> : public TStructOpsTypeTraitsBase2<FRealFloat>
 {
@@ -144,6 +189,10 @@ struct TStructOpsTypeTraits<FRealFloat> : public TStructOpsTypeTraitsBase2<FReal
     {
         WithExportTextItem = true,
         WithImportTextItem = true,
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
     };
 };
 
@@ -391,4 +440,40 @@ public:
     UFUNCTION(BlueprintPure, category = "RealFloat", meta = (DisplayName = "Sign RealFloat", CompactNodeTitle = "Sign"))
     static FRealFloat Sign(FRealFloat Val);
 
+// FRealFloat math with an explicit precision budget, in significand bits (see FRealFloatPrecision). The functions above use the budget of the calling thread
+public:
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "RealFloat sin (Radians, precision)"))
+    static FRealFloat SinRadWithPrecision(FRealFloat InVal, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "RealFloat cos (Radians, precision)"))
+    static FRealFloat CosRadWithPrecision(FRealFloat InVal, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "RealFloat tan (Radians, precision)"))
+    static FRealFloat TanRadWithPrecision(FRealFloat InVal, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "Exp RealFloat (precision)"))
+    static FRealFloat ExpWithPrecision(FRealFloat Val, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "LogE RealFloat (precision)"))
+    static FRealFloat LogEWithPrecision(FRealFloat Val, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "Pow FRealFloat (precision)"))
+    static FRealFloat PowWithPrecision(FRealFloat X, FRealFloat Y, int32 PrecisionBits);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Precision", meta = (DisplayName = "Get RealFloat Precision Budget"))
+    static int32 GetPrecisionBudget();
+
+// Exact array math, rounded once at the end (see FRealFloatAccumulator)
+public:
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Array", meta = (DisplayName = "Sum RealFloat Array"))
+    static FRealFloat SumArray(const TArray<FRealFloat>& Values);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Array", meta = (DisplayName = "Dot RealFloat Arrays"))
+    static FRealFloat DotArrays(const TArray<FRealFloat>& A, const TArray<FRealFloat>& B);
+
+    UFUNCTION(BlueprintPure, category = "RealFloat|Array", meta = (DisplayName = "Mean RealFloat Array"))
+    static FRealFloat MeanArray(const TArray<FRealFloat>& Values);
+
 };
@@ -0,0 +1,72 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VectorFloat.h"
+
+/**
+ * Exact accumulator for FRealFloat sums (Kulisch-style long accumulator).
+ * Added values are stored in a wide fixed-point integer, with integer additions only, and the result is rounded once, when it's read.
+ * As integer additions are exact, the result doesn't depend on the order of the additions: partial sums computed in a ParallelFor and merged together give the same bits as a sequential sum.
+ * The window grows with the exponents of the added values. It is exact as long as they span less than MaxWindowBits bits, beyond which the lowest bits are dropped.
+ */
+struct SPACEKITPRECISION_API FRealFloatAccumulator
+{
+	// Maximum size of the window, in bits
+	static constexpr int64 MaxWindowBits = 65536;
+
+	FRealFloatAccumulator();
+
+	// Adds a value, exactly
+	void Add(const FRealFloat& InValue);
+
+	// Adds A * B. The product is exact too: it isn't rounded to a FRealFloat first
+	void AddProduct(const FRealFloat& A, const FRealFloat& B);
+
+	// Adds the content of another accumulator, exactly. Merging partial sums in any order gives the same result
+	void Merge(const FRealFloatAccumulator& Other);
+
+	// Clears the accumulator
+	void Reset();
+
+	// The sum of the added values, rounded once to the nearest FRealFloat
+	FRealFloat GetResult() const;
+
+	// The sum of the added values divided by Count, rounded once to the nearest FRealFloat. NaN when Count is 0
+	FRealFloat GetResultDividedBy(int64 Count) const;
+
+// Helpers over arrays. All of them are exact, with a single rounding at the end
+public:
+
+	static FRealFloat Sum(TArrayView<const FRealFloat> Values);
+	static FVectorFloat Sum(TArrayView<const FVectorFloat> Values);
+
+	// Same as Sum, with partial sums computed in a ParallelFor. The result is the same as Sum
+	static FRealFloat ParallelSum(TArrayView<const FRealFloat> Values);
+	static FVectorFloat ParallelSum(TArrayView<const FVectorFloat> Values);
+
+	// Sum of A[i] * B[i] (for vectors, of the dot products of A[i] and B[i]). Only the first Min(A.Num(), B.Num()) elements are used
+	static FRealFloat Dot(TArrayView<const FRealFloat> A, TArrayView<const FRealFloat> B);
+	static FRealFloat Dot(TArrayView<const FVectorFloat> A, TArrayView<const FVectorFloat> B);
+
+	// Average of the values. 0 for an empty array
+	static FRealFloat Mean(TArrayView<const FRealFloat> Values);
+	static FVectorFloat Mean(TArrayView<const FVectorFloat> Values);
+
+private:
+
+	// Adds Words * 2^Exponent, with Words being an unsigned integer of NumWords words
+	void AddWords(bool bNegative, const ttmath::uint* Words, int32 NumWords, int64 Exponent);
+
+	// Makes the window start at NewBaseExponent or lower
+	void ExtendDown(int64 NewBaseExponent);
+
+	// Magnitudes of the positive and negative values added so far, both relative to BaseExponent (the word at index 0 is worth 2^BaseExponent)
+	TArray<ttmath::uint> Positive;
+	TArray<ttmath::uint> Negative;
+	int64 BaseExponent;
+
+	// Whether a NaN has been added
+	bool bIsNan;
+};
@@ -0,0 +1,50 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+#include "SpaceKitPrecision/Public/QuatFloat.h"
+#include "SpaceKitPrecision/Public/RotatorFloat.h"
+
+/**
+ * 3x3 rotation matrix using big float reals, for rotating many vectors by the same rotation.
+ * Building it costs one rotator to quaternion conversion (trigonometry, normalization), then each vector costs 9 multiplications and 6 additions,
+ * instead of a full conversion for every FRotatorFloat::RotateVector call. Keep it around as long as the rotation doesn't change.
+ */
+struct SPACEKITPRECISION_API FRotationMatrixFloat
+{
+	// Rows of the matrix: the rotated vector is (Row[0] | V, Row[1] | V, Row[2] | V)
+	FVectorFloat Rows[3];
+
+	// Identity matrix
+	FRotationMatrixFloat();
+
+	// Builds the matrix of a normalized quaternion
+	explicit FRotationMatrixFloat(const FQuatFloat& Quat);
+
+	// Builds the matrix of a rotator
+	explicit FRotationMatrixFloat(const FRotatorFloat& Rotator);
+
+	// Same as FQuatFloat::RotateVector, up to rounding
+	FVectorFloat RotateVector(const FVectorFloat& Vec) const
+	{
+		return FVectorFloat(Rows[0] | Vec, Rows[1] | Vec, Rows[2] | Vec);
+	}
+
+	// Same as FQuatFloat::UnrotateVector, up to rounding. The matrix is orthogonal, so this uses its transpose
+	FVectorFloat UnrotateVector(const FVectorFloat& Vec) const
+	{
+		return Rows[0] * Vec.X + Rows[1] * Vec.Y + Rows[2] * Vec.Z;
+	}
+
+	// Rotates every vector of the array, in place
+	void RotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
+	// Unrotates every vector of the array, in place
+	void UnrotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
+	// Same as RotateVectors, with the vectors split in batches over a ParallelFor. The results are the same as RotateVectors
+	void ParallelRotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
+	// Same as UnrotateVectors, with the vectors split in batches over a ParallelFor. The results are the same as UnrotateVectors
+	void ParallelUnrotateVectors(TArrayView<FVectorFloat> Vectors) const;
+};
@@ -10,6 +10,7 @@
 
 // Forward declaration for the fixed-point quaternion.
 struct FQuatFixed;
+struct FRotatorFloat;
 
 /*
  * Similar to an FRotator, but using deterministic fixed-point reals.
@@ -50,6 +51,9 @@ public:
     // Builds a rotator from a fixed-point quaternion
     explicit FRotatorFixed(const FQuatFixed& InQuat);
 
+    // Converts a big float rotator, rounding each angle to the nearest fixed-point quantum
+    explicit FRotatorFixed(const FRotatorFloat& InRot);
+
 // Rotator math
 public:
 	
@@ -150,6 +154,43 @@ public:
     {
         switch (Axis) { case EAxis::X: return Roll; case EAxis::Y: return Pitch; default: return Yaw; }
     }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FRotatorFixed& R)
+    {
+        return Ar << R.Pitch << R.Yaw << R.Roll;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        Pitch.AppendHash(Hash);
+        Yaw.AppendHash(Hash);
+        Roll.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FRotatorFixed& R)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        R.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRotatorFixed> : public TStructOpsTypeTraitsBase2<FRotatorFixed>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 /**
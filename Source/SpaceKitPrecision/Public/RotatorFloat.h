@@ -8,6 +8,8 @@
 #include "RotatorFloat.generated.h"
 
 struct FQuatFloat;
+struct FRotatorFixed;
+struct FRotationMatrixFloat;
 
 /*
  * Similar to an FRotator, but using big float reals instead of floats.
@@ -48,6 +50,9 @@ public:
     // Builds a rotator from a quaternion
     explicit FRotatorFloat(const FQuatFloat& Rotator);
 
+    // Converts a fixed-point rotator, without precision loss with the default settings
+    explicit FRotatorFloat(const FRotatorFixed& InRot);
+
 // Rotator math
 public:
 	
@@ -136,12 +141,27 @@ public:
         return ! (*this == Other);
     }
 
+    // Compares the angles exactly, for the property system: the tolerance of operator== would hide small edits
+    bool Identical(const FRotatorFloat* Other, uint32 PortFlags) const
+    {
+        return Pitch == Other->Pitch && Yaw == Other->Yaw && Roll == Other->Roll;
+    }
+
     // Rotates a given vector by this quaternion
     FVectorFloat RotateVector(const FVectorFloat& Vec) const;
 
     // Rotates backward a given vector by this quaternion, so that for a given quaternion Q and a given vector V, UnrotateVector(RotateVector(V)) = V
     FVectorFloat UnrotateVector(const FVectorFloat& Vec) const;
 
+    // Builds the rotation matrix of this rotator, to rotate many vectors with a single conversion. See FRotationMatrixFloat
+    FRotationMatrixFloat ToMatrix() const;
+
+    // Rotates every vector of the array in place, converting this rotator only once
+    void RotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
+    // Unrotates every vector of the array in place, converting this rotator only once
+    void UnrotateVectors(TArrayView<FVectorFloat> Vectors) const;
+
     FRealFloat GetAbsSum() const
     {
         return URealFloatMath::Abs(Yaw) + URealFloatMath::Abs(Pitch) + URealFloatMath::Abs(Roll);
@@ -161,6 +181,36 @@ public:
     {
         return Axis == EAxis::Z ? Yaw : Axis == EAxis::Y ? Pitch : Roll;
     }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FRotatorFloat& R)
+    {
+        return Ar << R.Yaw << R.Pitch << R.Roll;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher. No GetTypeHash, as it would disagree with the tolerance of operator==
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        Yaw.AppendHash(Hash);
+        Pitch.AppendHash(Hash);
+        Roll.AppendHash(Hash);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FRotatorFloat> : public TStructOpsTypeTraitsBase2<FRotatorFloat>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdentical = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 /**
@@ -207,4 +257,13 @@ public:
 	UFUNCTION(BlueprintPure, category = "RotatorFloat", meta = (DisplayName = "RotFloat != RotFloat", CompactNodeTitle = "!="))
     static bool RotNotEqualsRot(const FRotatorFloat& First, const FRotatorFloat& Second, const FRealFloat& Tolerance);
 
+// Batched rotations, that convert the rotator only once
+public:
+
+    UFUNCTION(BlueprintPure, category = "RotatorFloat|Array", meta = (DisplayName = "RotFloat Rotate Vectors"))
+    static TArray<FVectorFloat> RotateVectors(const FRotatorFloat& Rot, const TArray<FVectorFloat>& Vectors, bool bParallel = false);
+
+    UFUNCTION(BlueprintPure, category = "RotatorFloat|Array", meta = (DisplayName = "RotFloat Unrotate Vectors"))
+    static TArray<FVectorFloat> UnrotateVectors(const FRotatorFloat& Rot, const TArray<FVectorFloat>& Vectors, bool bParallel = false);
+
 };
@@ -5,6 +5,7 @@
 #include "SpaceKitPrecision/Public/VectorFixed.h"
 #include "SpaceKitPrecision/Public/QuatFixed.h"
 #include "SpaceKitPrecision/Public/RotatorFixed.h"
+#include "SpaceKitPrecision/Public/PrecisionStats.h"
 
 #include "TransformFixed.generated.h"
 
@@ -68,7 +69,7 @@ public:
 
     FVectorFixed TransformPosition(const FVectorFixed& V) const
     {
-        return Rotation.RotateVector(V * Scale) + Location;
+        return PrecisionGeometry::TransformPosition(FQuatFixed(Rotation), Location, Scale, V);
     }
 
     FVectorFixed TransformPositionNoScale(const FVectorFixed& V) const
@@ -88,9 +89,7 @@ public:
 
     FVectorFixed InverseTransformPosition(const FVectorFixed& V) const
     {
-        const FVectorFixed Translated = V - Location;
-        const FVectorFixed Rotated = Rotation.UnrotateVector(Translated);
-        return Rotated / Scale;
+        return PrecisionGeometry::InverseTransformPosition(FQuatFixed(Rotation), Location, Scale, V);
     }
 
     FVectorFixed InverseTransformPositionNoScale(const FVectorFixed& V) const
@@ -110,6 +109,8 @@ public:
 
     FTransformFixed operator*(const FTransformFixed& Other) const
     {
+        SPACEKITPRECISION_SCOPE(TransformCompose);
+
         FTransformFixed Result;
         
         Result.Rotation = FRotatorFixed(FQuatFixed(Rotation) * FQuatFixed(Other.Rotation));
@@ -251,6 +252,43 @@ public:
             *Rotation.ToString(), 
             *Scale.ToString());
     }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FTransformFixed& T)
+    {
+        return Ar << T.Location << T.Rotation << T.Scale;
+    }
+
+    // Feeds the location, rotation and scale to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        Location.AppendHash(Hash);
+        Rotation.AppendHash(Hash);
+        Scale.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FTransformFixed& T)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        T.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FTransformFixed> : public TStructOpsTypeTraitsBase2<FTransformFixed>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 UCLASS(BlueprintType, Abstract)
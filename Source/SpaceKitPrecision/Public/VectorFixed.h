@@ -3,10 +3,11 @@
 #pragma once
 
 #include "SpaceKitPrecision/Public/RealFixed.h"
-#include "VectorFloat.h"
+#include "SpaceKitPrecision/Private/PrecisionGeometryKernels.h"
 
 #include "VectorFixed.generated.h"
 
+struct FVectorFloat;
 
 /*
  * Similar to an FVector, but using fixed-point reals instead of floats.
@@ -62,6 +63,9 @@ public:
     {
     }
 
+    // Converts a big float vector, rounding each component to the nearest fixed-point quantum
+    explicit FVectorFixed(const FVectorFloat& InVec);
+
     // Vector math
 public:
 	
@@ -137,7 +141,7 @@ public:
 
     static FRealFixed DotProduct(const FVectorFixed& Vec, const FVectorFixed& Other)
     {
-        return Vec.X * Other.X + Vec.Y * Other.Y + Vec.Z * Other.Z;
+        return PrecisionGeometry::Dot(Vec, Other);
     }
 
     FRealFixed operator|(const FVectorFixed& Other) const
@@ -147,7 +151,7 @@ public:
 
     static FVectorFixed CrossProduct(const FVectorFixed& Vec, const FVectorFixed& Other)
     {
-        return FVectorFixed(Vec.Y * Other.Z - Vec.Z * Other.Y, Vec.Z * Other.X - Vec.X * Other.Z, Vec.X * Other.Y - Vec.Y * Other.X);
+        return PrecisionGeometry::Cross(Vec, Other);
     }
 
     FVectorFixed operator^(const FVectorFixed& Other) const
@@ -216,7 +220,49 @@ public:
         &&	FMath::Abs(Y)<=Tolerance
         &&	FMath::Abs(Z)<=Tolerance;
     }
-    
+
+    // Replicates the components losslessly, without the leading zero bits of their mantissas.
+    // Positions can use FVectorFixed_NetQuantize instead (see PrecisionNetSerialization.h)
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FVectorFixed& V)
+    {
+        return Ar << V.X << V.Y << V.Z;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        X.AppendHash(Hash);
+        Y.AppendHash(Hash);
+        Z.AppendHash(Hash);
+    }
+
+    friend uint32 GetTypeHash(const FVectorFixed& V)
+    {
+        PrecisionHash::FXxHash64 Hash;
+        V.AppendHash(Hash);
+        return PrecisionHash::ToTypeHash(Hash.Finish());
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFixed> : public TStructOpsTypeTraitsBase2<FVectorFixed>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdenticalViaEquality = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+        WithNetSerializer = true,
+        WithNetSharedSerialization = true,
+    };
 };
 
 /**
@@ -275,4 +321,19 @@ public:
     UFUNCTION(BlueprintPure, category = "VectorFixed", meta = (DisplayName = "VecFixed CrossProduct", CompactNodeTitle = "^"))
     static FVectorFixed ProjectOnTo(const FVectorFixed& A, const FVectorFixed& B);
 
+// Exact predicates, see FPrecisionPredicates
+public:
+
+    UFUNCTION(BlueprintPure, category = "VectorFixed|Predicates", meta = (DisplayName = "VecFixed Orient3D"))
+    static int32 Orient3D(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D);
+
+    UFUNCTION(BlueprintPure, category = "VectorFixed|Predicates", meta = (DisplayName = "VecFixed InSphere"))
+    static int32 InSphere(const FVectorFixed& A, const FVectorFixed& B, const FVectorFixed& C, const FVectorFixed& D, const FVectorFixed& E);
+
+    UFUNCTION(BlueprintPure, category = "VectorFixed|Predicates", meta = (DisplayName = "VecFixed CompareDistance"))
+    static int32 CompareDistance(const FVectorFixed& A, const FVectorFixed& B, const FRealFixed& Distance);
+
+    UFUNCTION(BlueprintPure, category = "VectorFixed|Predicates", meta = (DisplayName = "VecFixed DotSign"))
+    static int32 DotSign(const FVectorFixed& A, const FVectorFixed& B);
+
 };
@@ -49,6 +49,9 @@ public:
     {
     }
 
+    // Converts a fixed-point vector, without precision loss with the default settings
+    explicit FVectorFloat(const FVectorFixed& InVec);
+
 // Vector math
 public:
 	
@@ -157,6 +160,12 @@ public:
         return ! (*this == Other);
     }
 
+    // Exact comparison of the components, for the property system: operator== has a tolerance, so it can't tell edited values apart
+    bool Identical(const FVectorFloat* Other, uint32 PortFlags) const
+    {
+        return X == Other->X && Y == Other->Y && Z == Other->Z;
+    }
+
     FRealFloat SizeSquared() const
     {
         return DotProduct(*this, *this);
@@ -194,6 +203,37 @@ public:
     {
         return Axis == EAxis::X ? X : Axis == EAxis::Y ? Y : Z;
     }
+
+    bool Serialize(FArchive& Ar)
+    {
+        return FPrecisionCustomVersion::SerializeNative(Ar, *this);
+    }
+
+    friend FArchive& operator<<(FArchive& Ar, FVectorFloat& V)
+    {
+        return Ar << V.X << V.Y << V.Z;
+    }
+
+    // Feeds the components to a hash, see FPrecisionStateHasher. There's no GetTypeHash: operator== has a tolerance, so vectors it finds equal
+    // can have different hashes, and can't be TSet or TMap keys
+    void AppendHash(PrecisionHash::FXxHash64& Hash) const
+    {
+        X.AppendHash(Hash);
+        Y.AppendHash(Hash);
+        Z.AppendHash(Hash);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FVectorFloat> : public TStructOpsTypeTraitsBase2<FVectorFloat>
+{
+    enum
+    {
+        WithSerializer = true,
+        WithIdentical = true,
+        WithCopy = true,
+        WithNoDestructor = true,
+    };
 };
 
 
@@ -265,4 +305,31 @@ public:
     UFUNCTION(BlueprintPure, category = "VectorFloat", meta = (DisplayName = "VecFloat CrossProduct", CompactNodeTitle = "^"))
     static FVectorFloat ProjectOnTo(const FVectorFloat& A, const FVectorFloat& B);
 
+// Exact predicates, see FPrecisionPredicates
+public:
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Predicates", meta = (DisplayName = "VecFloat Orient3D"))
+    static int32 Orient3D(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Predicates", meta = (DisplayName = "VecFloat InSphere"))
+    static int32 InSphere(const FVectorFloat& A, const FVectorFloat& B, const FVectorFloat& C, const FVectorFloat& D, const FVectorFloat& E);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Predicates", meta = (DisplayName = "VecFloat CompareDistance"))
+    static int32 CompareDistance(const FVectorFloat& A, const FVectorFloat& B, const FRealFloat& Distance);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Predicates", meta = (DisplayName = "VecFloat DotSign"))
+    static int32 DotSign(const FVectorFloat& A, const FVectorFloat& B);
+
+// Exact array math, rounded once at the end (see FRealFloatAccumulator)
+public:
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Array", meta = (DisplayName = "Sum VectorFloat Array"))
+    static FVectorFloat SumArray(const TArray<FVectorFloat>& Values);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Array", meta = (DisplayName = "Dot VectorFloat Arrays"))
+    static FRealFloat DotArrays(const TArray<FVectorFloat>& A, const TArray<FVectorFloat>& B);
+
+    UFUNCTION(BlueprintPure, category = "VectorFloat|Array", meta = (DisplayName = "Mean VectorFloat Array"))
+    static FVectorFloat MeanArray(const TArray<FVectorFloat>& Values);
+
 };
@@ -7,11 +7,12 @@ public class SpaceKitPrecision : ModuleRules
 	public SpaceKitPrecision(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseSharedPCHs;
-		
-		bUseUnity = false;
 
 		PrivatePCHHeaderFile = "SpaceKitPrecision.h";
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "BoostFPM" });
+
+		// The modules using the plugin link to the real_fixed_type instantiation of RealFixedGeneric.cpp, this one instantiates it where it's used
+		PrivateDefinitions.Add("SPACEKITPRECISION_EXTERN_TEMPLATES=0");
 	}
 }
@@ -0,0 +1,648 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Accuracy harness of the precision core. Every function of URealFixedMath and URealFloatMath is run over randomized and edge-case
+// inputs, and compared with boost cpp_bin_float at SPACEKITPRECISION_REFERENCE_BITS bits. This gives, for each function and each
+// number family of the configuration (see PrecisionSettings.h), an error histogram and the throughput of the function.
+//
+//   SpaceKitPrecisionAccuracy [--samples N] [--seed S] [--csv File] [--check-budgets]
+//
+// The errors are measured in ULPs for big floats, and in quanta (2^-REAL_FIXED_EXPONENT) for fixed-point numbers. To compare the
+// families and configurations with each other, they are also given in correct bits: -log2(|Error| / max(|Reference|, 1)), i.e.
+// relative bits above 1, and absolute bits below 1, which is what a world position or an angle cares about.
+// SpaceKitPrecisionParetoReport merges the CSVs of several configurations into an accuracy/speed Pareto frontier.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "PrecisionCore.h"
+
+#include <boost/multiprecision/cpp_bin_float.hpp>
+
+#ifndef SPACEKITPRECISION_REFERENCE_BITS
+#define SPACEKITPRECISION_REFERENCE_BITS 512
+#endif
+
+#ifndef SPACEKITPRECISION_ACCURACY_CONFIGURATION
+#define SPACEKITPRECISION_ACCURACY_CONFIGURATION "Default"
+#endif
+
+namespace
+{
+	using FReference = boost::multiprecision::number<boost::multiprecision::backends::cpp_bin_float<SPACEKITPRECISION_REFERENCE_BITS,
+		boost::multiprecision::backends::digit_base_2>, boost::multiprecision::et_off>;
+
+	// Same type as FRealFloat::ttBigType when USE_BOOST_BIG is 1
+	using FBoostFloat = boost::multiprecision::number<boost::multiprecision::backends::cpp_bin_float<BOOST_REAL_FLOAT_SIZE,
+		boost::multiprecision::backends::digit_base_2>, boost::multiprecision::et_off>;
+
+	enum class EFunction
+	{
+		Multiply,
+		Divide,
+		Sqrt,
+		SinRad,
+		CosRad,
+		TanRad,
+		AsinRad,
+		AcosRad,
+		AtanRad,
+		Exp,
+		Ln,
+		Log2,
+		Log10,
+		Pow,
+	};
+
+	// Input domain of a function: random inputs are drawn uniformly in [Min, Max] (in log scale when bLogScale is set), and the
+	// edge cases are always measured. Arguments of binary functions are drawn in the same domain, except for Pow (see MakeSamples)
+	struct FFunctionSpec
+	{
+		EFunction Function;
+		const char* Name;
+		double Min;
+		double Max;
+		bool bLogScale;
+		std::vector<double> EdgeCases;
+	};
+
+	const std::vector<FFunctionSpec>& GetFunctions()
+	{
+		static const std::vector<FFunctionSpec> Functions = {
+			{ EFunction::Multiply, "Multiply", -1e4, 1e4, false, { 0, 1, -1, 0.5, 3 } },
+			{ EFunction::Divide, "Divide", 1e-3, 1e4, true, { 1, 3, 7, 0.1 } },
+			{ EFunction::Sqrt, "Sqrt", 1e-6, 1e12, true, { 0, 1, 2, 0.5, 1e-6 } },
+			{ EFunction::SinRad, "SinRad", -10, 10, false, { 0, 1e-6, 1.5707963267948966, 3.141592653589793, 6.283185307179586, 1000, -12345.678 } },
+			{ EFunction::CosRad, "CosRad", -10, 10, false, { 0, 1e-6, 1.5707963267948966, 3.141592653589793, 6.283185307179586, 1000, -12345.678 } },
+			{ EFunction::TanRad, "TanRad", -1.5, 1.5, false, { 0, 1e-6, 0.7853981633974483, 1.57, -1.57 } },
+			{ EFunction::AsinRad, "AsinRad", -0.999, 0.999, false, { 0, 1, -1, 0.5, 1e-6, 0.9999 } },
+			{ EFunction::AcosRad, "AcosRad", -0.999, 0.999, false, { 0, 1, -1, 0.5, 1e-6, 0.9999 } },
+			{ EFunction::AtanRad, "AtanRad", -100, 100, false, { 0, 1, -1, 1e-6, 1e6 } },
+			{ EFunction::Exp, "Exp", -20, 40, false, { 0, 1, -1, 1e-6, 0.6931471805599453 } },
+			{ EFunction::Ln, "Ln", 1e-4, 1e8, true, { 1, 2, 0.5, 1.000001, 2.718281828459045 } },
+			{ EFunction::Log2, "Log2", 1e-4, 1e8, true, { 1, 2, 1024, 0.5, 3 } },
+			{ EFunction::Log10, "Log10", 1e-4, 1e8, true, { 1, 10, 1000, 0.1, 3 } },
+			{ EFunction::Pow, "Pow", 1e-2, 1e2, true, { 1, 2, 10, 0.5 } },
+		};
+		return Functions;
+	}
+
+	// Exact value of a ttmath float: mantissa * 2^exponent
+	template<ttmath::uint exp, ttmath::uint man>
+	FReference ToReference(const ttmath::Big<exp, man>& Value)
+	{
+		if (Value.IsZero() || Value.IsNan())
+		{
+			return FReference(0);
+		}
+
+		FReference Result(0);
+		for (ttmath::uint i = man; i-- > 0;)
+		{
+			Result = ldexp(Result, int(TTMATH_BITS_PER_UINT));
+			Result += FReference(uint64(Value.mantissa.table[i]));
+		}
+		Result = ldexp(Result, int(Value.exponent.ToInt()));
+		return Value.IsSign() ? FReference(-Result) : Result;
+	}
+
+	FReference ToReference(const real_fixed_type& Value)
+	{
+		// A float with as many words as the mantissa holds it exactly
+		return ToReference(Value.ToBigExact<ttmath::Big<1, TTMATH_BITS(REAL_FIXED_MANTISSA_SIZE + REAL_FIXED_EXPONENT)>>());
+	}
+
+	FReference ToReference(const FBoostFloat& Value)
+	{
+		return FReference(Value);
+	}
+
+	FReference EvaluateReference(EFunction Function, const FReference& A, const FReference& B)
+	{
+		switch (Function)
+		{
+		case EFunction::Multiply: return A * B;
+		case EFunction::Divide: return A / B;
+		case EFunction::Sqrt: return sqrt(A);
+		case EFunction::SinRad: return sin(A);
+		case EFunction::CosRad: return cos(A);
+		case EFunction::TanRad: return tan(A);
+		case EFunction::AsinRad: return asin(A);
+		case EFunction::AcosRad: return acos(A);
+		case EFunction::AtanRad: return atan(A);
+		case EFunction::Exp: return exp(A);
+		case EFunction::Ln: return log(A);
+		case EFunction::Log2: return log2(A);
+		case EFunction::Log10: return log10(A);
+		case EFunction::Pow: return pow(A, B);
+		}
+		return FReference(0);
+	}
+
+	// Whether the function takes a precision budget in URealFloatMath (see FRealFloatPrecision)
+	bool IsBudgeted(EFunction Function)
+	{
+		switch (Function)
+		{
+		case EFunction::SinRad:
+		case EFunction::CosRad:
+		case EFunction::TanRad:
+		case EFunction::Exp:
+		case EFunction::Ln:
+		case EFunction::Log2:
+		case EFunction::Log10:
+		case EFunction::Pow:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// Fixed-point numbers, computed like URealFixedMath: through ttBigType, then rounded back to the fixed point
+	struct FFixedFamily
+	{
+		using Type = real_fixed_type;
+		using BigType = real_fixed_type::ttBigType;
+
+		static constexpr const char* Name = "RealFixed";
+		static constexpr const char* Unit = "quantum";
+		static constexpr int32 PrecisionBits = REAL_FIXED_EXPONENT;
+
+		static std::vector<int32> GetBudgets() { return { 0 }; }
+
+		// The double gives the top bits, and the rest of the quanta below 2^-10 are random
+		static Type MakeInput(double Value, bool bExact, std::mt19937_64& Random)
+		{
+			Type Result(Value);
+			if (!bExact && REAL_FIXED_EXPONENT > 10 && std::abs(Value) > 1e-3)
+			{
+				const uint64 Low = Random() & ((uint64(1) << (REAL_FIXED_EXPONENT - 10)) - 1);
+				Result = Result + Type::FromMantissa(Type::ttIntMantissaType(ttmath::uint(Low)));
+			}
+			return Result;
+		}
+
+		static Type Evaluate(EFunction Function, const Type& A, const Type& B, int32 /*Budget*/)
+		{
+			switch (Function)
+			{
+			case EFunction::Multiply: return A * B;
+			case EFunction::Divide: return A / B;
+			case EFunction::Sqrt: return Type(ttmath::Sqrt(A.ToBig()));
+			case EFunction::SinRad: return Type(ttmath::Sin(A.ToBig()));
+			case EFunction::CosRad: return Type(ttmath::Cos(A.ToBig()));
+			case EFunction::TanRad: return Type(ttmath::Tan(A.ToBig()));
+			case EFunction::AsinRad: return Type(ttmath::ASin(A.ToBig()));
+			case EFunction::AcosRad: return Type(ttmath::ACos(A.ToBig()));
+			case EFunction::AtanRad: return Type(ttmath::ATan(A.ToBig()));
+			case EFunction::Exp: return Type(ttmath::Exp(A.ToBig()));
+			case EFunction::Ln: return Type(ttmath::Ln(A.ToBig()));
+			case EFunction::Log2: return Type(ttmath::Log(A.ToBig(), BigType(2)));
+			case EFunction::Log10: return Type(ttmath::Log(A.ToBig(), BigType(10)));
+			case EFunction::Pow: return Type(ttmath::Exp(B.ToBig() * ttmath::Ln(A.ToBig())));
+			}
+			return Type(0);
+		}
+
+		static FReference GetErrorUnit(const FReference& /*Reference*/)
+		{
+			return ldexp(FReference(1), -REAL_FIXED_EXPONENT);
+		}
+	};
+
+	// Unit in the last place of Reference, in a float of Bits bits of significand
+	FReference GetUlp(const FReference& Reference, int32 Bits)
+	{
+		if (Reference == 0)
+		{
+			return FReference(0);
+		}
+
+		int Exponent = 0;
+		frexp(Reference, &Exponent);
+		return ldexp(FReference(1), Exponent - Bits);
+	}
+
+	// ttmath big floats, computed like URealFloatMath, at the full precision and at a few precision budgets (see PrecisionBudget.h)
+	struct FTtFloatFamily
+	{
+		using Type = tt_real_float_type;
+
+		static constexpr const char* Name = "RealFloat";
+		static constexpr const char* Unit = "ulp";
+		static constexpr int32 PrecisionBits = int32(TTMATH_BITS(TT_REAL_FLOAT_SIZE) * TTMATH_BITS_PER_UINT);
+
+		static std::vector<int32> GetBudgets()
+		{
+			std::vector<int32> Budgets = { 0 };
+			for (const int32 Budget : { 96, 64, 53, 32, 24 })
+			{
+				if (Budget < PrecisionBits)
+				{
+					Budgets.push_back(Budget);
+				}
+			}
+			return Budgets;
+		}
+
+		// The double gives the top bits, and the rest of the significand is random
+		static Type MakeInput(double Value, bool bExact, std::mt19937_64& Random)
+		{
+			Type Result(Value);
+			if (!bExact && !Result.IsZero())
+			{
+				for (ttmath::uint i = 0; i + 1 < TTMATH_BITS(TT_REAL_FLOAT_SIZE); ++i)
+				{
+					Result.mantissa.table[i] = ttmath::uint(Random());
+				}
+			}
+			return Result;
+		}
+
+		static Type Evaluate(EFunction Function, const Type& A, const Type& B, int32 Budget)
+		{
+			switch (Function)
+			{
+			case EFunction::Multiply: return A * B;
+			case EFunction::Divide: return A / B;
+			case EFunction::Sqrt: return ttmath::Sqrt(A);
+			case EFunction::SinRad: return PrecisionBudget::Sin(A, Budget);
+			case EFunction::CosRad: return PrecisionBudget::Cos(A, Budget);
+			case EFunction::TanRad: return PrecisionBudget::Tan(A, Budget);
+			case EFunction::AsinRad: return ttmath::ASin(A);
+			case EFunction::AcosRad: return ttmath::ACos(A);
+			case EFunction::AtanRad: return ttmath::ATan(A);
+			case EFunction::Exp: return PrecisionBudget::Exp(A, Budget);
+			case EFunction::Ln: return PrecisionBudget::Ln(A, Budget);
+			case EFunction::Log2: return PrecisionBudget::Log(A, Type(2), Budget);
+			case EFunction::Log10: return PrecisionBudget::Log(A, Type(10), Budget);
+			case EFunction::Pow: return PrecisionBudget::Pow(A, B, Budget);
+			}
+			return Type(0);
+		}
+
+		static FReference GetErrorUnit(const FReference& Reference)
+		{
+			return GetUlp(Reference, PrecisionBits);
+		}
+	};
+
+	// boost big floats, i.e. FRealFloat when USE_BOOST_BIG is 1
+	struct FBoostFloatFamily
+	{
+		using Type = FBoostFloat;
+
+		static constexpr const char* Name = "RealFloatBoost";
+		static constexpr const char* Unit = "ulp";
+		static constexpr int32 PrecisionBits = BOOST_REAL_FLOAT_SIZE;
+
+		static std::vector<int32> GetBudgets() { return { 0 }; }
+
+		static Type MakeInput(double Value, bool bExact, std::mt19937_64& Random)
+		{
+			Type Result(Value);
+			if (!bExact && Value != 0)
+			{
+				// 53 random bits at a time, down to the last bit of the significand
+				int Exponent = 0;
+				std::frexp(Value, &Exponent);
+				for (int32 Shift = 53; Shift < BOOST_REAL_FLOAT_SIZE; Shift += 53)
+				{
+					Result += ldexp(Type(double(Random() >> 11)), Exponent - 53 - Shift);
+				}
+			}
+			return Result;
+		}
+
+		static Type Evaluate(EFunction Function, const Type& A, const Type& B, int32 /*Budget*/)
+		{
+			switch (Function)
+			{
+			case EFunction::Multiply: return A * B;
+			case EFunction::Divide: return A / B;
+			case EFunction::Sqrt: return sqrt(A);
+			case EFunction::SinRad: return sin(A);
+			case EFunction::CosRad: return cos(A);
+			case EFunction::TanRad: return tan(A);
+			case EFunction::AsinRad: return asin(A);
+			case EFunction::AcosRad: return acos(A);
+			case EFunction::AtanRad: return atan(A);
+			case EFunction::Exp: return exp(A);
+			case EFunction::Ln: return log(A);
+			case EFunction::Log2: return log2(A);
+			case EFunction::Log10: return log10(A);
+			case EFunction::Pow: return pow(A, B);
+			}
+			return Type(0);
+		}
+
+		static FReference GetErrorUnit(const FReference& Reference)
+		{
+			return GetUlp(Reference, PrecisionBits);
+		}
+	};
+
+	// Upper bounds of the histogram buckets, in error units. The last bucket holds everything above 2^20 units
+	constexpr int32 NumHistogramBuckets = 23;
+
+	double GetBucketBound(int32 Bucket)
+	{
+		return Bucket == 0 ? 0.0 : Bucket == 1 ? 0.5 : std::ldexp(1.0, Bucket - 2);
+	}
+
+	int32 GetBucket(double Error)
+	{
+		for (int32 Bucket = 0; Bucket < NumHistogramBuckets - 1; ++Bucket)
+		{
+			if (Error <= GetBucketBound(Bucket))
+			{
+				return Bucket;
+			}
+		}
+		return NumHistogramBuckets - 1;
+	}
+
+	// Bits at which a matching result is reported, as the reference can't tell more
+	constexpr double MaxCorrectBits = SPACEKITPRECISION_REFERENCE_BITS - 16;
+
+	struct FMeasurement
+	{
+		std::string Family;
+		std::string Function;
+		std::string Unit;
+		int32 PrecisionBits = 0;
+		int32 Budget = 0;
+		int32 Samples = 0;
+		double MaxError = 0;
+		double MeanError = 0;
+		double P99Error = 0;
+		double MinCorrectBits = MaxCorrectBits;
+		double NanosecondsPerOp = 0;
+		int64 Histogram[NumHistogramBuckets] = {};
+	};
+
+	// Error budgets at the full precision, a few times the largest errors seen over many seeds, so that a kernel change that loses
+	// precision is caught by --check-budgets. Fixed-point results must stay within a number of quanta of the reference
+	double GetMaxQuanta(EFunction Function)
+	{
+		return Function == EFunction::Multiply || Function == EFunction::Divide ? 1.0 : 1.5;
+	}
+
+	// Big float results may lose a number of bits of their significand, counted in correct bits: ULPs blow up around the zeros of sin
+	// and cos, where the result is tiny, and the range reduction of large angles costs the error of pi times the number of turns
+	int32 GetMaxLostBits(EFunction Function)
+	{
+		switch (Function)
+		{
+		case EFunction::Multiply:
+		case EFunction::Divide:
+			return 2;
+		case EFunction::Sqrt:
+		case EFunction::AtanRad:
+		case EFunction::Ln:
+		case EFunction::Log2:
+		case EFunction::Log10:
+			return 12;
+		default:
+			return 20;
+		}
+	}
+
+	// Inputs of a function. Edge cases are exact, the random ones get random low bits below the double (see MakeInput)
+	struct FSample
+	{
+		double A;
+		double B;
+		bool bEdgeCase;
+	};
+
+	std::vector<FSample> MakeSamples(const FFunctionSpec& Spec, int32 NumSamples, std::mt19937_64& Random)
+	{
+		std::vector<FSample> Samples;
+		for (const double Edge : Spec.EdgeCases)
+		{
+			Samples.push_back({ Edge, Spec.Function == EFunction::Pow ? 2.5 : Edge == 0 ? 1.0 : Edge, true });
+		}
+
+		std::uniform_real_distribution<double> Uniform(0, 1);
+		auto Draw = [&](double Min, double Max, bool bLogScale)
+		{
+			return bLogScale ? std::exp(std::log(Min) + Uniform(Random) * (std::log(Max) - std::log(Min))) : Min + Uniform(Random) * (Max - Min);
+		};
+
+		while (int32(Samples.size()) < NumSamples)
+		{
+			const double A = Draw(Spec.Min, Spec.Max, Spec.bLogScale);
+			// The exponent of Pow is kept small enough for the result to fit the fixed-point range
+			const double B = Spec.Function == EFunction::Pow ? Draw(-4, 4, false) : Draw(Spec.Min, Spec.Max, Spec.bLogScale);
+			Samples.push_back({ A, B, false });
+		}
+		return Samples;
+	}
+
+	template<typename FamilyType>
+	void Measure(const FFunctionSpec& Spec, const std::vector<FSample>& Samples, uint64 Seed, std::vector<FMeasurement>& OutMeasurements)
+	{
+		using Type = typename FamilyType::Type;
+
+		std::mt19937_64 Random(Seed);
+		std::vector<Type> InputsA;
+		std::vector<Type> InputsB;
+		std::vector<FReference> References;
+		std::vector<FReference> Units;
+		for (const FSample& Sample : Samples)
+		{
+			InputsA.push_back(FamilyType::MakeInput(Sample.A, Sample.bEdgeCase, Random));
+			InputsB.push_back(FamilyType::MakeInput(Sample.B, Sample.bEdgeCase, Random));
+			References.push_back(EvaluateReference(Spec.Function, ToReference(InputsA.back()), ToReference(InputsB.back())));
+			Units.push_back(FamilyType::GetErrorUnit(References.back()));
+		}
+
+		for (const int32 Budget : FamilyType::GetBudgets())
+		{
+			if (Budget > 0 && !IsBudgeted(Spec.Function))
+			{
+				continue;
+			}
+
+			FMeasurement Measurement;
+			Measurement.Family = FamilyType::Name;
+			Measurement.Function = Spec.Name;
+			Measurement.Unit = FamilyType::Unit;
+			Measurement.PrecisionBits = FamilyType::PrecisionBits;
+			Measurement.Budget = Budget;
+			Measurement.Samples = int32(Samples.size());
+
+			std::vector<double> Errors;
+			for (size_t i = 0; i < Samples.size(); ++i)
+			{
+				const FReference Result = ToReference(FamilyType::Evaluate(Spec.Function, InputsA[i], InputsB[i], Budget));
+				const FReference AbsoluteError = abs(Result - References[i]);
+
+				double Error = 0;
+				if (AbsoluteError != 0)
+				{
+					Error = Units[i] != 0 ? (AbsoluteError / Units[i]).template convert_to<double>() : std::numeric_limits<double>::infinity();
+				}
+				Errors.push_back(Error);
+				++Measurement.Histogram[GetBucket(Error)];
+
+				const FReference Scale = std::max(abs(References[i]), FReference(1));
+				const double CorrectBits = AbsoluteError == 0 ? MaxCorrectBits : std::min(MaxCorrectBits, -log2(AbsoluteError / Scale).template convert_to<double>());
+				Measurement.MinCorrectBits = std::min(Measurement.MinCorrectBits, CorrectBits);
+			}
+
+			std::sort(Errors.begin(), Errors.end());
+			Measurement.MaxError = Errors.back();
+			Measurement.P99Error = Errors[std::min(Errors.size() - 1, Errors.size() * 99 / 100)];
+			double Sum = 0;
+			for (const double Error : Errors)
+			{
+				Sum += Error;
+			}
+			Measurement.MeanError = Sum / double(Errors.size());
+
+			// Throughput over the same inputs, repeated until the measure is long enough to be stable
+			const auto Start = std::chrono::steady_clock::now();
+			int64 Ops = 0;
+			volatile bool Sink = false;
+			do
+			{
+				for (size_t i = 0; i < Samples.size(); ++i)
+				{
+					Sink = Sink ^ (FamilyType::Evaluate(Spec.Function, InputsA[i], InputsB[i], Budget) == InputsA[i]);
+				}
+				Ops += int64(Samples.size());
+			}
+			while (std::chrono::steady_clock::now() - Start < std::chrono::milliseconds(20));
+			const double Nanoseconds = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count());
+			Measurement.NanosecondsPerOp = Nanoseconds / double(Ops);
+
+			OutMeasurements.push_back(Measurement);
+		}
+	}
+
+	void WriteCsv(FILE* File, const std::vector<FMeasurement>& Measurements)
+	{
+		std::fprintf(File, "configuration,mantissa_bits,exponent_bits,tt_float_bits,boost_float_bits,reference_bits,family,precision_bits,function,budget_bits,samples,unit,max_error,mean_error,p99_error,min_correct_bits,ns_per_op");
+		for (int32 Bucket = 0; Bucket < NumHistogramBuckets - 1; ++Bucket)
+		{
+			std::fprintf(File, ",le_%g", GetBucketBound(Bucket));
+		}
+		std::fprintf(File, ",gt_%g\n", GetBucketBound(NumHistogramBuckets - 2));
+
+		for (const FMeasurement& Measurement : Measurements)
+		{
+			std::fprintf(File, "%s,%d,%d,%d,%d,%d,%s,%d,%s,%d,%d,%s,%.6g,%.6g,%.6g,%.2f,%.1f",
+				SPACEKITPRECISION_ACCURACY_CONFIGURATION, REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT, TT_REAL_FLOAT_SIZE, BOOST_REAL_FLOAT_SIZE, SPACEKITPRECISION_REFERENCE_BITS,
+				Measurement.Family.c_str(), Measurement.PrecisionBits, Measurement.Function.c_str(), Measurement.Budget, Measurement.Samples, Measurement.Unit.c_str(),
+				Measurement.MaxError, Measurement.MeanError, Measurement.P99Error, Measurement.MinCorrectBits, Measurement.NanosecondsPerOp);
+			for (const int64 Count : Measurement.Histogram)
+			{
+				std::fprintf(File, ",%lld", (long long)Count);
+			}
+			std::fprintf(File, "\n");
+		}
+	}
+
+	// Full precision functions must stay within their error budget, and budgeted ones must keep the correct bits documented for their budget
+	int32 CheckBudgets(const std::vector<FMeasurement>& Measurements)
+	{
+		int32 Failures = 0;
+		for (const FMeasurement& Measurement : Measurements)
+		{
+			EFunction Function = EFunction::Multiply;
+			for (const FFunctionSpec& Spec : GetFunctions())
+			{
+				Function = Measurement.Function == Spec.Name ? Spec.Function : Function;
+			}
+
+			bool bWithinBudget = true;
+			if (Measurement.Budget > 0)
+			{
+				bWithinBudget = Measurement.MinCorrectBits >= PrecisionBudget::GetGuaranteedBits(Measurement.Budget);
+			}
+			else if (Measurement.Family == FFixedFamily::Name)
+			{
+				bWithinBudget = Measurement.MaxError <= GetMaxQuanta(Function);
+			}
+			else
+			{
+				bWithinBudget = Measurement.MinCorrectBits >= double(Measurement.PrecisionBits - GetMaxLostBits(Function));
+			}
+
+			if (!bWithinBudget)
+			{
+				std::fprintf(stderr, "%s %s (budget %d): max error %g %s, %.2f correct bits, out of its error budget\n",
+					Measurement.Family.c_str(), Measurement.Function.c_str(), Measurement.Budget, Measurement.MaxError, Measurement.Unit.c_str(), Measurement.MinCorrectBits);
+				++Failures;
+			}
+		}
+		return Failures;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int32 NumSamples = 2000;
+	uint64 Seed = 42;
+	const char* CsvPath = nullptr;
+	bool bCheckBudgets = false;
+
+	for (int32 i = 1; i < argc; ++i)
+	{
+		if (!std::strcmp(argv[i], "--samples") && i + 1 < argc)
+		{
+			NumSamples = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+		{
+			Seed = std::strtoull(argv[++i], nullptr, 10);
+		}
+		else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc)
+		{
+			CsvPath = argv[++i];
+		}
+		else if (!std::strcmp(argv[i], "--check-budgets"))
+		{
+			bCheckBudgets = true;
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--samples N] [--seed S] [--csv File] [--check-budgets]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	std::vector<FMeasurement> Measurements;
+	std::mt19937_64 Random(Seed);
+	for (const FFunctionSpec& Spec : GetFunctions())
+	{
+		const std::vector<FSample> Samples = MakeSamples(Spec, NumSamples, Random);
+		const uint64 InputSeed = Random();
+		Measure<FFixedFamily>(Spec, Samples, InputSeed, Measurements);
+		Measure<FTtFloatFamily>(Spec, Samples, InputSeed, Measurements);
+		Measure<FBoostFloatFamily>(Spec, Samples, InputSeed, Measurements);
+	}
+
+	FILE* File = CsvPath ? std::fopen(CsvPath, "w") : stdout;
+	if (!File)
+	{
+		std::fprintf(stderr, "Can't write %s\n", CsvPath);
+		return 2;
+	}
+	WriteCsv(File, Measurements);
+	if (File != stdout)
+	{
+		std::fclose(File);
+	}
+
+	return bCheckBudgets && CheckBudgets(Measurements) > 0 ? 1 : 0;
+}
@@ -0,0 +1,178 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Merges the CSVs of SpaceKitPrecisionAccuracy, usually one per configuration, into a Markdown report of the accuracy/speed tradeoffs.
+// For each function, every configuration, family and precision budget is a point (ns/op, worst correct bits), and the points that no
+// other point beats on both speed and accuracy form the Pareto frontier: those are the only settings worth picking for that function.
+//
+//   SpaceKitPrecisionParetoReport [-o Report.md] Accuracy_Default.csv Accuracy_Wide.csv ...
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct FPoint
+	{
+		std::string Configuration;
+		std::string Family;
+		std::string Function;
+		int Budget = 0;
+		double MaxError = 0;
+		std::string Unit;
+		double CorrectBits = 0;
+		double NanosecondsPerOp = 0;
+		bool bPareto = false;
+	};
+
+	std::vector<std::string> SplitCsvLine(const std::string& Line)
+	{
+		std::vector<std::string> Fields;
+		std::stringstream Stream(Line);
+		std::string Field;
+		while (std::getline(Stream, Field, ','))
+		{
+			Fields.push_back(Field);
+		}
+		return Fields;
+	}
+
+	bool ReadCsv(const char* Path, std::vector<FPoint>& OutPoints)
+	{
+		std::ifstream File(Path);
+		std::string Line;
+		if (!File || !std::getline(File, Line))
+		{
+			return false;
+		}
+
+		// Columns are looked up by name, so that the report keeps working when the harness adds some
+		std::map<std::string, size_t> Columns;
+		const std::vector<std::string> Header = SplitCsvLine(Line);
+		for (size_t i = 0; i < Header.size(); ++i)
+		{
+			Columns[Header[i]] = i;
+		}
+		for (const char* Column : { "configuration", "family", "function", "budget_bits", "max_error", "unit", "min_correct_bits", "ns_per_op" })
+		{
+			if (!Columns.count(Column))
+			{
+				return false;
+			}
+		}
+
+		while (std::getline(File, Line))
+		{
+			const std::vector<std::string> Fields = SplitCsvLine(Line);
+			if (Fields.size() < Header.size())
+			{
+				continue;
+			}
+
+			FPoint Point;
+			Point.Configuration = Fields[Columns["configuration"]];
+			Point.Family = Fields[Columns["family"]];
+			Point.Function = Fields[Columns["function"]];
+			Point.Budget = std::atoi(Fields[Columns["budget_bits"]].c_str());
+			Point.MaxError = std::atof(Fields[Columns["max_error"]].c_str());
+			Point.Unit = Fields[Columns["unit"]];
+			Point.CorrectBits = std::atof(Fields[Columns["min_correct_bits"]].c_str());
+			Point.NanosecondsPerOp = std::atof(Fields[Columns["ns_per_op"]].c_str());
+			OutPoints.push_back(Point);
+		}
+		return true;
+	}
+
+	// A point is on the frontier when no other point is at least as fast and as accurate, and strictly better on one of them
+	void MarkParetoFrontier(std::vector<FPoint>& Points)
+	{
+		for (FPoint& Point : Points)
+		{
+			Point.bPareto = std::none_of(Points.begin(), Points.end(), [&Point](const FPoint& Other)
+			{
+				return Other.NanosecondsPerOp <= Point.NanosecondsPerOp && Other.CorrectBits >= Point.CorrectBits
+					&& (Other.NanosecondsPerOp < Point.NanosecondsPerOp || Other.CorrectBits > Point.CorrectBits);
+			});
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* OutputPath = nullptr;
+	std::vector<FPoint> Points;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!std::strcmp(argv[i], "-o") && i + 1 < argc)
+		{
+			OutputPath = argv[++i];
+		}
+		else if (!ReadCsv(argv[i], Points))
+		{
+			std::fprintf(stderr, "Can't read %s, expected a CSV of SpaceKitPrecisionAccuracy\n", argv[i]);
+			return 2;
+		}
+	}
+
+	if (Points.empty())
+	{
+		std::fprintf(stderr, "Usage: %s [-o Report.md] Accuracy.csv...\n", argv[0]);
+		return 2;
+	}
+
+	// Functions in the order of the CSVs
+	std::vector<std::string> Functions;
+	for (const FPoint& Point : Points)
+	{
+		if (std::find(Functions.begin(), Functions.end(), Point.Function) == Functions.end())
+		{
+			Functions.push_back(Point.Function);
+		}
+	}
+
+	FILE* File = OutputPath ? std::fopen(OutputPath, "w") : stdout;
+	if (!File)
+	{
+		std::fprintf(stderr, "Can't write %s\n", OutputPath);
+		return 2;
+	}
+
+	std::fprintf(File, "# SpaceKitPrecision accuracy/speed report\n\n");
+	std::fprintf(File, "Correct bits are the worst case of -log2(|error| / max(|reference|, 1)) over the samples. Settings marked with * are on the Pareto frontier of the function: nothing else is both faster and more accurate.\n");
+
+	for (const std::string& Function : Functions)
+	{
+		std::vector<FPoint> FunctionPoints;
+		for (const FPoint& Point : Points)
+		{
+			if (Point.Function == Function)
+			{
+				FunctionPoints.push_back(Point);
+			}
+		}
+		MarkParetoFrontier(FunctionPoints);
+		std::sort(FunctionPoints.begin(), FunctionPoints.end(), [](const FPoint& A, const FPoint& B) { return A.NanosecondsPerOp < B.NanosecondsPerOp; });
+
+		std::fprintf(File, "\n## %s\n\n", Function.c_str());
+		std::fprintf(File, "| Pareto | Configuration | Family | Budget bits | ns/op | Correct bits | Max error |\n");
+		std::fprintf(File, "|---|---|---|---|---|---|---|\n");
+		for (const FPoint& Point : FunctionPoints)
+		{
+			std::fprintf(File, "| %s | %s | %s | %s | %.1f | %.2f | %.3g %s |\n", Point.bPareto ? "*" : "", Point.Configuration.c_str(), Point.Family.c_str(),
+				Point.Budget > 0 ? std::to_string(Point.Budget).c_str() : "full", Point.NanosecondsPerOp, Point.CorrectBits, Point.MaxError, Point.Unit.c_str());
+		}
+	}
+
+	if (File != stdout)
+	{
+		std::fclose(File);
+	}
+	return 0;
+}
@@ -0,0 +1,490 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Google Benchmark harness of the engine-free precision core. It covers the same operations as the SpaceKitPrecision.Benchmarks automation tests
+// that don't need the engine. Use --benchmark_format=json (or csv) for machine-readable results, and --benchmark_repetitions for percentiles.
+
+#include <benchmark/benchmark.h>
+
+#include "PrecisionCore.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionBlockKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionHashKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionImportKernels.h"
+
+using namespace PrecisionCore;
+
+namespace
+{
+	const real_fixed_type FixedA("1234.5678");
+	const real_fixed_type FixedB("-0.3125");
+	const real_fixed_type FixedAngle("0.75");
+
+	const tt_real_float_type FloatA("1234.5678");
+	const tt_real_float_type FloatB("-0.3125");
+	const tt_real_float_type FloatAngle("0.75");
+
+	template<typename T>
+	TVector<T> MakeVectorA()
+	{
+		return TVector<T>(T("1.5"), T("-2.25"), T(1000000));
+	}
+
+	template<typename T>
+	TVector<T> MakeVectorB()
+	{
+		return TVector<T>(T("-0.125"), T(3), T(42));
+	}
+
+	template<typename T>
+	TQuat<T> MakeQuatA()
+	{
+		return QuatFromRotator(T(30), T(-45), T(60));
+	}
+
+	template<typename T>
+	TQuat<T> MakeQuatB()
+	{
+		return QuatFromRotator(T(-10), T(90), T(5));
+	}
+}
+
+// Scalars
+
+template<typename T>
+struct TScalarInputs;
+
+template<>
+struct TScalarInputs<real_fixed_type>
+{
+	static const real_fixed_type& A() { return FixedA; }
+	static const real_fixed_type& B() { return FixedB; }
+	static const real_fixed_type& Angle() { return FixedAngle; }
+};
+
+template<>
+struct TScalarInputs<tt_real_float_type>
+{
+	static const tt_real_float_type& A() { return FloatA; }
+	static const tt_real_float_type& B() { return FloatB; }
+	static const tt_real_float_type& Angle() { return FloatAngle; }
+};
+
+// Runs Operation(A, B, Angle) on copies the compiler can't constant-fold
+template<typename T, typename OperationType>
+void RunScalarBenchmark(benchmark::State& State, OperationType Operation)
+{
+	T A = TScalarInputs<T>::A();
+	T B = TScalarInputs<T>::B();
+	T Angle = TScalarInputs<T>::Angle();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(B);
+		benchmark::DoNotOptimize(Angle);
+		auto Result = Operation(A, B, Angle);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T> void BM_Add(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T& B, const T&) { return A + B; }); }
+template<typename T> void BM_Subtract(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T& B, const T&) { return A - B; }); }
+template<typename T> void BM_Multiply(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T& B, const T&) { return A * B; }); }
+template<typename T> void BM_Divide(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T& B, const T&) { return A / B; }); }
+template<typename T> void BM_Compare(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T& B, const T&) { return A < B; }); }
+template<typename T> void BM_Sqrt(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T& A, const T&, const T&) { return Sqrt(A); }); }
+template<typename T> void BM_SinRad(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T&, const T&, const T& Angle) { return SinRad(Angle); }); }
+template<typename T> void BM_CosRad(benchmark::State& State) { RunScalarBenchmark<T>(State, [](const T&, const T&, const T& Angle) { return CosRad(Angle); }); }
+
+BENCHMARK_TEMPLATE(BM_Add, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Add, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_Subtract, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Subtract, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_Multiply, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Multiply, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_Divide, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Divide, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_Compare, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Compare, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_Sqrt, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_Sqrt, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_SinRad, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_SinRad, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_CosRad, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_CosRad, tt_real_float_type);
+
+static void BM_SinRadWithPrecision64(benchmark::State& State)
+{
+	tt_real_float_type Angle = FloatAngle;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Angle);
+		auto Result = PrecisionBudget::Sin(Angle, 64);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_SinRadWithPrecision64);
+
+// Vectors, quaternions and transforms
+
+template<typename T>
+void BM_VectorDot(benchmark::State& State)
+{
+	TVector<T> A = MakeVectorA<T>();
+	TVector<T> B = MakeVectorB<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(B);
+		auto Result = PrecisionGeometry::Dot(A, B);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_VectorCross(benchmark::State& State)
+{
+	TVector<T> A = MakeVectorA<T>();
+	TVector<T> B = MakeVectorB<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(B);
+		auto Result = PrecisionGeometry::Cross(A, B);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_QuatMultiply(benchmark::State& State)
+{
+	TQuat<T> A = MakeQuatA<T>();
+	TQuat<T> B = MakeQuatB<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(A);
+		benchmark::DoNotOptimize(B);
+		auto Result = PrecisionGeometry::QuatMultiply(A, B);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_QuatRotateVector(benchmark::State& State)
+{
+	TQuat<T> Quat = MakeQuatA<T>();
+	TVector<T> Vec = MakeVectorA<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Quat);
+		benchmark::DoNotOptimize(Vec);
+		auto Result = PrecisionGeometry::QuatRotateVector(Quat, Vec);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_QuatFromRotator(benchmark::State& State)
+{
+	T Pitch(30);
+	T Yaw(-45);
+	T Roll(60);
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Pitch);
+		benchmark::DoNotOptimize(Yaw);
+		benchmark::DoNotOptimize(Roll);
+		auto Result = QuatFromRotator(Pitch, Yaw, Roll);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_TransformPosition(benchmark::State& State)
+{
+	TQuat<T> Rotation = MakeQuatA<T>();
+	TVector<T> Location(T(1000000000), T(-3), T("0.5"));
+	TVector<T> Scale(T(2), T(2), T(2));
+	TVector<T> Vec = MakeVectorA<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Rotation);
+		benchmark::DoNotOptimize(Vec);
+		auto Result = PrecisionGeometry::TransformPosition(Rotation, Location, Scale, Vec);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+template<typename T>
+void BM_InverseTransformPosition(benchmark::State& State)
+{
+	TQuat<T> Rotation = MakeQuatA<T>();
+	TVector<T> Location(T(1000000000), T(-3), T("0.5"));
+	TVector<T> Scale(T(2), T(2), T(2));
+	TVector<T> Vec = MakeVectorA<T>();
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Rotation);
+		benchmark::DoNotOptimize(Vec);
+		auto Result = PrecisionGeometry::InverseTransformPosition(Rotation, Location, Scale, Vec);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+
+BENCHMARK_TEMPLATE(BM_VectorDot, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_VectorDot, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_VectorCross, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_VectorCross, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_QuatMultiply, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_QuatMultiply, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_QuatRotateVector, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_QuatRotateVector, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_QuatFromRotator, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_QuatFromRotator, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_TransformPosition, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_TransformPosition, tt_real_float_type);
+BENCHMARK_TEMPLATE(BM_InverseTransformPosition, real_fixed_type);
+BENCHMARK_TEMPLATE(BM_InverseTransformPosition, tt_real_float_type);
+
+// Conversions
+
+static void BM_FixedToBig(benchmark::State& State)
+{
+	real_fixed_type Value = FixedA;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		auto Result = Value.ToBigExact<tt_real_float_type>();
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FixedToBig);
+
+static void BM_BigToFixed(benchmark::State& State)
+{
+	tt_real_float_type Value = FloatA;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		auto Result = real_fixed_type::FromBigRounded(Value);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_BigToFixed);
+
+static void BM_FixedFromDouble(benchmark::State& State)
+{
+	double Value = 1234.5678;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		real_fixed_type Result(Value);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FixedFromDouble);
+
+static void BM_FixedToDouble(benchmark::State& State)
+{
+	real_fixed_type Value = FixedA;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		double Result = Value.ToDouble();
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FixedToDouble);
+
+static void BM_FixedToString(benchmark::State& State)
+{
+	real_fixed_type Value = FixedA;
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		FString Result = Value.ToString();
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FixedToString);
+
+static void BM_FixedFromString(benchmark::State& State)
+{
+	const char* Value = "1234.5678";
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		real_fixed_type Result(Value);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FixedFromString);
+
+static void BM_FixedToChars(benchmark::State& State)
+{
+	real_fixed_type Value = FixedA;
+	char Buffer[real_fixed_type::MaxChars];
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		int32 Length = Value.ToChars(Buffer, real_fixed_type::MaxChars);
+		benchmark::DoNotOptimize(Length);
+		benchmark::DoNotOptimize(Buffer);
+	}
+}
+BENCHMARK(BM_FixedToChars);
+
+static void BM_FloatToChars(benchmark::State& State)
+{
+	tt_real_float_type Value = FloatA / FloatB;
+	char Buffer[PrecisionText::FloatChars(TTMATH_BITS(TT_REAL_FLOAT_SIZE))];
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		int32 Length = PrecisionText::FormatFloat(Value, Buffer, int32(sizeof(Buffer)));
+		benchmark::DoNotOptimize(Length);
+		benchmark::DoNotOptimize(Buffer);
+	}
+}
+BENCHMARK(BM_FloatToChars);
+
+static void BM_FloatFromChars(benchmark::State& State)
+{
+	const char* Value = "-3950.61696000000000000000000000000000000";
+	for (auto _ : State)
+	{
+		benchmark::DoNotOptimize(Value);
+		tt_real_float_type Result;
+		PrecisionText::ParseFloat(Value, Result);
+		benchmark::DoNotOptimize(Result);
+	}
+}
+BENCHMARK(BM_FloatFromChars);
+
+// Checksum of the transforms of 10,000 entities, 9 fixed-point numbers each, as FPrecisionStateHasher hashes them when they all changed
+static void BM_HashTransforms(benchmark::State& State)
+{
+	std::vector<real_fixed_type> Transforms(10000 * 9);
+	for (size_t Index = 0; Index < Transforms.size(); ++Index)
+	{
+		Transforms[Index] = real_fixed_type(int32(Index * 7919 % 100003) - 50000) / real_fixed_type(3);
+	}
+	for (auto _ : State)
+	{
+		PrecisionHash::FXxHash64 Hash;
+		for (const real_fixed_type& Value : Transforms)
+		{
+			Hash.Add(Value.mantissa);
+		}
+		benchmark::DoNotOptimize(Hash.Finish());
+	}
+	State.SetItemsProcessed(State.iterations() * 10000);
+}
+BENCHMARK(BM_HashTransforms)->Unit(benchmark::kMicrosecond);
+
+// Decoding of 10,000 height samples compressed by blocks of 64 (see TBlockFixedArray), to a buffer of mantissas, against copying them uncompressed
+static void BM_BlockDecode(benchmark::State& State)
+{
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+	constexpr ttmath::uint Words = sizeof(FMantissa) / sizeof(ttmath::uint);
+	std::vector<FMantissa> Heights(10000);
+	for (size_t Index = 0; Index < Heights.size(); ++Index)
+	{
+		Heights[Index] = (real_fixed_type(1000) + real_fixed_type(int32(Index * 7919 % 1009)) / real_fixed_type(64)).mantissa;
+	}
+	std::vector<PrecisionBlock::TBlock<Words>> Blocks(Heights.size() / 64);
+	std::vector<uint8> Deltas(size_t(PrecisionBlock::MaxDeltaBytes<Words>(int32(Heights.size()))));
+	int64 NumBytes = 0;
+	for (size_t Block = 0; Block < Blocks.size(); ++Block)
+	{
+		Blocks[Block].Offset = NumBytes;
+		NumBytes += PrecisionBlock::EncodeBlock(&Heights[Block * 64], 64, 0, Blocks[Block], Deltas.data() + NumBytes);
+	}
+
+	std::vector<FMantissa> Decoded(Blocks.size() * 64);
+	for (auto _ : State)
+	{
+		if (State.range(0))
+		{
+			for (size_t Block = 0; Block < Blocks.size(); ++Block)
+			{
+				PrecisionBlock::DecodeBlock(Blocks[Block], Deltas.data() + Blocks[Block].Offset, 0, 64, &Decoded[Block * 64]);
+			}
+		}
+		else
+		{
+			std::memcpy(static_cast<void*>(Decoded.data()), Heights.data(), Decoded.size() * sizeof(FMantissa));
+		}
+		benchmark::DoNotOptimize(Decoded.data());
+		benchmark::ClobberMemory();
+	}
+	State.SetItemsProcessed(State.iterations() * int64(Decoded.size()));
+	State.counters["BytesPerValue"] = double(NumBytes + int64(Blocks.size() * sizeof(PrecisionBlock::TBlock<Words>))) / double(Decoded.size());
+}
+BENCHMARK(BM_BlockDecode)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Import of a CSV column of 10,000 decimals with 6 fraction digits (see FPrecisionBulkImport), on one thread: splitting in rows and cells,
+// and parsing the cells in place, against copying each cell to a string to construct the number from
+static void BM_CsvImport(benchmark::State& State)
+{
+	std::string Csv = "Name,Value\n";
+	for (int32 Row = 0; Row < 10000; ++Row)
+	{
+		Csv += "Row" + std::to_string(Row) + "," + std::to_string(Row * 7919 % 1000003 - 500000) + "." + std::to_string(100000 + Row * 104729 % 900000) + "\n";
+	}
+
+	std::vector<real_fixed_type> Values(10000);
+	for (auto _ : State)
+	{
+		int32 Row = -1;
+		PrecisionImport::SplitCsvRows(Csv.c_str(), int32(Csv.size()), [&](const char* Start, const char* End)
+		{
+			PrecisionImport::SplitCsvCells(Start, End, [&](int32 Column, const char* CellStart, const char* CellEnd)
+			{
+				if (Column != 1 || Row < 0)
+				{
+					return;
+				}
+				if (State.range(0))
+				{
+					PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(CellStart, CellEnd, Values[Row].mantissa);
+				}
+				else
+				{
+					Values[Row] = real_fixed_type(std::string(CellStart, CellEnd).c_str());
+				}
+			});
+			++Row;
+		});
+		benchmark::DoNotOptimize(Values.data());
+		benchmark::ClobberMemory();
+	}
+	State.SetItemsProcessed(State.iterations() * int64(Values.size()));
+	State.SetBytesProcessed(State.iterations() * int64(Csv.size()));
+}
+BENCHMARK(BM_CsvImport)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Decoding of 10,000 numbers from the canonical encoding (see FPrecisionCanonicalReader): written with the build's settings, which is a copy
+// on little-endian platforms, or with 4 more fraction bits, which are rounded off
+static void BM_CanonicalDecode(benchmark::State& State)
+{
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+	const int32 FractionBits = REAL_FIXED_EXPONENT + int32(State.range(0)) * 4;
+	const PrecisionBinary::FCanonicalHeader Header = PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE, FractionBits, 0);
+	std::vector<FMantissa> Mantissas(10000);
+	for (size_t Index = 0; Index < Mantissas.size(); ++Index)
+	{
+		Mantissas[Index] = (real_fixed_type(int32(Index) - 5000) / real_fixed_type(7)).mantissa;
+	}
+	std::vector<uint8> Encoded(Mantissas.size() * Header.ValueBytes);
+	PrecisionBinary::EncodeCanonical(Mantissas.data(), int64(Mantissas.size()), Header, Encoded.data());
+
+	std::vector<FMantissa> Decoded(Mantissas.size());
+	for (auto _ : State)
+	{
+		PrecisionBinary::DecodeCanonical<REAL_FIXED_EXPONENT>(Encoded.data(), int64(Decoded.size()), Header, Decoded.data());
+		benchmark::DoNotOptimize(Decoded.data());
+		benchmark::ClobberMemory();
+	}
+	State.SetItemsProcessed(State.iterations() * int64(Decoded.size()));
+}
+BENCHMARK(BM_CanonicalDecode)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,25 @@
+# Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+#
+# Runs the digest executable of every ttmath backend (DIGEST_EXECUTABLES), and fails unless they all print the same digest.
+#
+#   cmake -DDIGEST_EXECUTABLES="A;B;C" -P CompareDigests.cmake
+
+set(ReferenceDigest)
+foreach(Executable IN LISTS DIGEST_EXECUTABLES)
+	execute_process(COMMAND "${Executable}" OUTPUT_VARIABLE Output RESULT_VARIABLE Result OUTPUT_STRIP_TRAILING_WHITESPACE)
+	if(NOT Result EQUAL 0)
+		message(FATAL_ERROR "${Executable} failed: ${Result}")
+	endif()
+
+	string(REPLACE " " ";" Fields "${Output}")
+	list(GET Fields 0 Backend)
+	list(GET Fields 1 Digest)
+	message(STATUS "${Backend}: ${Digest}")
+
+	if(NOT ReferenceDigest)
+		set(ReferenceDigest "${Digest}")
+		set(ReferenceBackend "${Backend}")
+	elseif(NOT Digest STREQUAL ReferenceDigest)
+		message(FATAL_ERROR "ttmath backend ${Backend} doesn't give the same results as ${ReferenceBackend}")
+	endif()
+endforeach()
@@ -0,0 +1,159 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Digest of the results of the precision core, for the ttmath backend it's compiled with (SPACEKITPRECISION_TTMATH_BACKEND, see
+// PrecisionTtmath.h). The build compiles it once per backend the compiler supports, and CompareDigests.cmake checks that all the
+// digests match, i.e. that the backends give the same results bit for bit. It prints the ttmath library type, then the digest.
+
+#include <cinttypes>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "PrecisionCore.h"
+
+namespace
+{
+	// FNV-1a over the words of every result
+	struct FDigest
+	{
+		uint64 Hash = 14695981039346656037ull;
+
+		void Add(uint64 Word)
+		{
+			for (int32 Byte = 0; Byte < 8; ++Byte)
+			{
+				Hash = (Hash ^ ((Word >> (Byte * 8)) & 0xff)) * 1099511628211ull;
+			}
+		}
+
+		template<ttmath::uint Size>
+		void Add(const ttmath::UInt<Size>& Value)
+		{
+			for (ttmath::uint i = 0; i < Size; ++i)
+			{
+				Add(uint64(Value.table[i]));
+			}
+		}
+
+		template<ttmath::uint exp, ttmath::uint man>
+		void Add(const ttmath::Big<exp, man>& Value)
+		{
+			Add(Value.mantissa);
+			Add(Value.exponent);
+			Add(uint64(Value.info));
+		}
+
+		void Add(const real_fixed_type& Value)
+		{
+			Add(Value.mantissa);
+		}
+
+		void Add(const std::string& Value)
+		{
+			for (const char Character : Value)
+			{
+				Add(uint64(uint8(Character)));
+			}
+		}
+	};
+
+	template<ttmath::uint Size>
+	ttmath::UInt<Size> RandomUInt(std::mt19937_64& Random)
+	{
+		ttmath::UInt<Size> Result;
+		for (ttmath::uint i = 0; i < Size; ++i)
+		{
+			Result.table[i] = ttmath::uint(Random());
+		}
+		return Result;
+	}
+
+	tt_real_float_type RandomFloat(std::mt19937_64& Random, double Min, double Max)
+	{
+		tt_real_float_type Result(std::uniform_real_distribution<double>(Min, Max)(Random));
+		for (ttmath::uint i = 0; i + 1 < TTMATH_BITS(TT_REAL_FLOAT_SIZE); ++i)
+		{
+			Result.mantissa.table[i] = ttmath::uint(Random());
+		}
+		return Result;
+	}
+}
+
+int main()
+{
+	FDigest Digest;
+	std::mt19937_64 Random(42);
+
+	// Integer limbs: carries, borrows, products and quotients that cross words
+	for (int32 i = 0; i < 2000; ++i)
+	{
+		const ttmath::UInt<4> A = RandomUInt<4>(Random);
+		ttmath::UInt<4> B = RandomUInt<4>(Random);
+		B.table[3] >>= (i % 64);
+
+		ttmath::UInt<4> Sum = A;
+		Digest.Add(Sum.Add(B));
+		Digest.Add(Sum);
+
+		ttmath::UInt<4> Difference = A;
+		Digest.Add(Difference.Sub(B));
+		Digest.Add(Difference);
+
+		ttmath::UInt<8> Product;
+		ttmath::UInt<4>(A).MulBig(B, Product);
+		Digest.Add(Product);
+
+		if (!B.IsZero())
+		{
+			ttmath::UInt<4> Quotient = A;
+			ttmath::UInt<4> Remainder;
+			Digest.Add(Quotient.Div(B, &Remainder));
+			Digest.Add(Quotient);
+			Digest.Add(Remainder);
+		}
+
+		ttmath::UInt<4> Shifted = A;
+		Digest.Add(Shifted.Rcl(i % 200, i & 1));
+		Digest.Add(Shifted);
+		Digest.Add(Shifted.Rcr(i % 150, 0));
+		Digest.Add(Shifted);
+	}
+
+	// Big floats: arithmetic, the transcendental functions, with and without a precision budget, and the string conversions
+	for (int32 i = 0; i < 300; ++i)
+	{
+		const tt_real_float_type A = RandomFloat(Random, -1000, 1000);
+		const tt_real_float_type B = RandomFloat(Random, 0.001, 100);
+
+		Digest.Add(A + B);
+		Digest.Add(A - B);
+		Digest.Add(A * B);
+		Digest.Add(A / B);
+		Digest.Add(ttmath::Sqrt(B));
+		Digest.Add(ttmath::Sin(A));
+		Digest.Add(ttmath::ATan(A));
+		Digest.Add(ttmath::Exp(B));
+		Digest.Add(ttmath::Ln(B));
+		Digest.Add(PrecisionBudget::Sin(A, 53));
+		Digest.Add(PrecisionBudget::Exp(B, 64));
+		Digest.Add(PrecisionBudget::Ln(B, 32));
+		Digest.Add(A.ToString());
+		Digest.Add(tt_real_float_type(A.ToString()));
+	}
+
+	// Fixed-point numbers, whose multiplications and divisions go through wider integers
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		real_fixed_type A(std::uniform_real_distribution<double>(-1e6, 1e6)(Random));
+		const real_fixed_type B(std::uniform_real_distribution<double>(0.01, 1e3)(Random));
+
+		Digest.Add(A * B);
+		Digest.Add(A / B);
+		Digest.Add(PrecisionCore::Sqrt(B));
+		Digest.Add(PrecisionCore::SinRad(A));
+		Digest.Add(std::string(*A.ToString()));
+	}
+
+	std::printf("%s %016" PRIx64 "\n", ttmath::UInt<1>::LibTypeStr(), Digest.Hash);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Records a determinism trace (see PrecisionReplayKernels.h) of a random workload, or replays one, with the ttmath backend it's compiled
+// with (see PrecisionTtmath.h). The build records a trace with one backend, and replays it with every other one.
+//
+//   SpaceKitPrecisionReplay<Backend> record Trace.skpt [NumOps] [Seed]
+//   SpaceKitPrecisionReplay<Backend> replay Trace.skpt
+//
+// replay prints the first divergent operation, if any, and fails when there is one, or when the trace can't be replayed.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "PrecisionCore.h"
+#include "SpaceKitPrecision/Private/PrecisionReplayKernels.h"
+
+namespace
+{
+	using FExecutor = PrecisionReplay::TCoreExecutor<real_fixed_type, tt_real_float_type>;
+
+	// The kernels write to anything with TArray<uint8>'s Append
+	struct FByteArray
+	{
+		std::vector<uint8> Bytes;
+
+		void Append(const uint8* Data, size_t Num)
+		{
+			Bytes.insert(Bytes.end(), Data, Data + Num);
+		}
+	};
+
+	int Record(const char* Path, int32 NumOps, uint64 Seed)
+	{
+		FByteArray Trace;
+		uint64 RollingHash = PrecisionReplay::HashSeed;
+		PrecisionReplay::WriteHeader<real_fixed_type, tt_real_float_type>(Trace, FExecutor::Id, ttmath::UInt<1>::LibTypeStr());
+		PrecisionReplay::RunWorkload<real_fixed_type, tt_real_float_type>(Seed, NumOps, [&](PrecisionReplay::EOp Op, const auto& A, const auto& B)
+		{
+			PrecisionReplay::WriteOp(Trace, RollingHash, Op, A, B, FExecutor::Execute(Op, A, B));
+		});
+
+		std::ofstream File(Path, std::ios::binary);
+		File.write(reinterpret_cast<const char*>(Trace.Bytes.data()), std::streamsize(Trace.Bytes.size()));
+		if (!File)
+		{
+			std::fprintf(stderr, "Can't write %s\n", Path);
+			return 2;
+		}
+
+		std::printf("Recorded %d operations with %s to %s\n", NumOps, ttmath::UInt<1>::LibTypeStr(), Path);
+		return 0;
+	}
+
+	int Replay(const char* Path)
+	{
+		std::ifstream File(Path, std::ios::binary);
+		const std::vector<uint8> Trace((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+		if (!File && !File.eof())
+		{
+			std::fprintf(stderr, "Can't read %s\n", Path);
+			return 2;
+		}
+
+		const PrecisionReplay::FReplayReport Report = PrecisionReplay::Replay<FExecutor>(Trace.data(), int64(Trace.size()));
+		std::printf("%s: %s\n", ttmath::UInt<1>::LibTypeStr(), Report.ToString().c_str());
+		return Report.IsOk() ? 0 : 1;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc >= 3 && !std::strcmp(argv[1], "record"))
+	{
+		return Record(argv[2], argc >= 4 ? std::atoi(argv[3]) : 10000, argc >= 5 ? std::strtoull(argv[4], nullptr, 10) : 42);
+	}
+	if (argc == 3 && !std::strcmp(argv[1], "replay"))
+	{
+		return Replay(argv[2]);
+	}
+
+	std::fprintf(stderr, "Usage: %s record Trace.skpt [NumOps] [Seed] | replay Trace.skpt\n", argv[0]);
+	return 2;
+}
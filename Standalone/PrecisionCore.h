@@ -0,0 +1,82 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Engine-free entry point of the SpaceKitPrecision numeric core, for the standalone build (see CMakeLists.txt next to this file).
+// It includes the headers that only depend on CoreMinimal (the shim provides it here), and adds plain vector and quaternion types
+// standing in for the USTRUCTs, so the geometry kernels can be run, tested and profiled on machines without the engine.
+
+#include "SpaceKitPrecision/Public/PrecisionSettings.h"
+#include "SpaceKitPrecision/Private/PrecisionBudgetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionPredicatesKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionGeometryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionScalarKernels.h"
+
+namespace PrecisionCore
+{
+	// Vector of any real type, standing in for FVectorFixed and FVectorFloat
+	template<typename T>
+	struct TVector
+	{
+		T X;
+		T Y;
+		T Z;
+
+		TVector()
+			: X(0), Y(0), Z(0)
+		{
+		}
+
+		TVector(const T& InX, const T& InY, const T& InZ)
+			: X(InX), Y(InY), Z(InZ)
+		{
+		}
+
+		TVector operator+(const TVector& Other) const { return TVector(X + Other.X, Y + Other.Y, Z + Other.Z); }
+		TVector operator-(const TVector& Other) const { return TVector(X - Other.X, Y - Other.Y, Z - Other.Z); }
+		TVector operator*(const TVector& Other) const { return TVector(X * Other.X, Y * Other.Y, Z * Other.Z); }
+		TVector operator/(const TVector& Other) const { return TVector(X / Other.X, Y / Other.Y, Z / Other.Z); }
+		TVector operator*(const T& Scale) const { return TVector(X * Scale, Y * Scale, Z * Scale); }
+		TVector operator-() const { return TVector(-X, -Y, -Z); }
+
+		bool operator==(const TVector& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+	};
+
+	// Quaternion of any real type, standing in for FQuatFixed and FQuatFloat
+	template<typename T>
+	struct TQuat
+	{
+		T X;
+		T Y;
+		T Z;
+		T W;
+
+		TQuat()
+			: X(0), Y(0), Z(0), W(1)
+		{
+		}
+
+		TQuat(const T& InX, const T& InY, const T& InZ, const T& InW)
+			: X(InX), Y(InY), Z(InZ), W(InW)
+		{
+		}
+
+		bool operator==(const TQuat& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z && W == Other.W; }
+	};
+
+	using FFixedVector = TVector<real_fixed_type>;
+	using FFixedQuat = TQuat<real_fixed_type>;
+	using FFloatVector = TVector<tt_real_float_type>;
+	using FFloatQuat = TQuat<tt_real_float_type>;
+
+	// Scalar functions and rotator conversion shared with URealFixedMath, URealFloatMath and FQuatFixed
+	using PrecisionScalar::Sqrt;
+	using PrecisionScalar::SinRad;
+	using PrecisionScalar::CosRad;
+
+	template<typename T>
+	TQuat<T> QuatFromRotator(const T& Pitch, const T& Yaw, const T& Roll)
+	{
+		return PrecisionScalar::QuatFromRotator<TQuat<T>>(Pitch, Yaw, Roll);
+	}
+}
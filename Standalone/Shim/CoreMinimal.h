@@ -0,0 +1,230 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Stand-in for the engine's CoreMinimal.h, used by the standalone build only (see Standalone/CMakeLists.txt).
+// It provides what the engine-free headers of SpaceKitPrecision use: the integer types, TCHAR, a small FString and TArray, and a few FMath functions.
+// Don't add anything here that the core headers don't need: the core is meant to only depend on this.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using int8 = std::int8_t;
+using int16 = std::int16_t;
+using int32 = std::int32_t;
+using int64 = std::int64_t;
+using uint8 = std::uint8_t;
+using uint16 = std::uint16_t;
+using uint32 = std::uint32_t;
+using uint64 = std::uint64_t;
+
+// The standalone build uses narrow strings
+using TCHAR = char;
+using ANSICHAR = char;
+
+#ifndef TEXT
+#define TEXT(x) x
+#endif
+
+#define TCHAR_TO_ANSI(x) (x)
+#define ANSI_TO_TCHAR(x) (x)
+
+#ifndef FORCEINLINE
+#define FORCEINLINE inline
+#endif
+
+#ifndef PLATFORM_LITTLE_ENDIAN
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define PLATFORM_LITTLE_ENDIAN 0
+#else
+#define PLATFORM_LITTLE_ENDIAN 1
+#endif
+#endif
+
+#ifndef SPACEKITPRECISION_API
+#define SPACEKITPRECISION_API
+#endif
+
+// String, with the subset of the engine's FString interface the core uses
+class FString
+{
+public:
+	FString() = default;
+
+	FString(const TCHAR* InString)
+		: Data(InString ? InString : "")
+	{
+	}
+
+	explicit FString(const std::string& InString)
+		: Data(InString)
+	{
+	}
+
+	const TCHAR* operator*() const
+	{
+		return Data.c_str();
+	}
+
+	int32 Len() const
+	{
+		return int32(Data.size());
+	}
+
+	bool IsEmpty() const
+	{
+		return Data.empty();
+	}
+
+	bool RemoveFromStart(const TCHAR* InPrefix)
+	{
+		const size_t PrefixLen = std::strlen(InPrefix);
+		if (PrefixLen == 0 || Data.compare(0, PrefixLen, InPrefix) != 0)
+		{
+			return false;
+		}
+		Data.erase(0, PrefixLen);
+		return true;
+	}
+
+	FString& operator+=(const FString& Other)
+	{
+		Data += Other.Data;
+		return *this;
+	}
+
+	friend FString operator+(const FString& A, const FString& B)
+	{
+		return FString(A.Data + B.Data);
+	}
+
+	friend FString operator+(const TCHAR* A, const FString& B)
+	{
+		return FString(A + B.Data);
+	}
+
+	friend FString operator+(const FString& A, const TCHAR* B)
+	{
+		return FString(A.Data + B);
+	}
+
+	friend bool operator==(const FString& A, const FString& B)
+	{
+		return A.Data == B.Data;
+	}
+
+	friend bool operator!=(const FString& A, const FString& B)
+	{
+		return A.Data != B.Data;
+	}
+
+private:
+	std::string Data;
+};
+
+// Array, with the subset of the engine's TArray interface the core uses
+template<typename ElementType>
+class TArray
+{
+public:
+	int32 Num() const
+	{
+		return int32(Data.size());
+	}
+
+	void Reserve(int32 Number)
+	{
+		Data.reserve(size_t(Number));
+	}
+
+	int32 Add(const ElementType& Item)
+	{
+		Data.push_back(Item);
+		return Num() - 1;
+	}
+
+	void Append(const TArray& Source)
+	{
+		Data.insert(Data.end(), Source.Data.begin(), Source.Data.end());
+	}
+
+	ElementType& Last()
+	{
+		return Data.back();
+	}
+
+	ElementType& operator[](int32 Index)
+	{
+		return Data[size_t(Index)];
+	}
+
+	const ElementType& operator[](int32 Index) const
+	{
+		return Data[size_t(Index)];
+	}
+
+	template<typename PredicateType>
+	void Sort(const PredicateType& Predicate)
+	{
+		std::sort(Data.begin(), Data.end(), Predicate);
+	}
+
+	typename std::vector<ElementType>::iterator begin()
+	{
+		return Data.begin();
+	}
+
+	typename std::vector<ElementType>::iterator end()
+	{
+		return Data.end();
+	}
+
+	typename std::vector<ElementType>::const_iterator begin() const
+	{
+		return Data.begin();
+	}
+
+	typename std::vector<ElementType>::const_iterator end() const
+	{
+		return Data.end();
+	}
+
+private:
+	std::vector<ElementType> Data;
+};
+
+// Subset of the engine's FMath
+struct FMath
+{
+	static int32 FloorToInt(float Value)
+	{
+		return int32(std::floor(Value));
+	}
+
+	static float Loge(float Value)
+	{
+		return std::log(Value);
+	}
+
+	template<typename T>
+	static T Abs(const T& Value)
+	{
+		return Value < T(0) ? -Value : Value;
+	}
+
+	template<typename T>
+	static T Min(const T& A, const T& B)
+	{
+		return A < B ? A : B;
+	}
+
+	template<typename T>
+	static T Max(const T& A, const T& B)
+	{
+		return A < B ? B : A;
+	}
+};
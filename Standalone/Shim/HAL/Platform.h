@@ -0,0 +1,6 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+#pragma once
+
+// Stand-in for the engine's HAL/Platform.h, used by the standalone build only. The types live in the CoreMinimal.h shim
+#include "CoreMinimal.h"
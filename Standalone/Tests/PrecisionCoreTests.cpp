@@ -0,0 +1,1223 @@
+// Copyright 2020 Baptiste Hutteau Licensed under the Apache License, Version 2.0
+
+// Tests of the engine-free precision core. They mirror the SpaceKitPrecision automation tests that only need the core,
+// so that the math can be checked on machines without the engine.
+
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_test_macros.hpp>
+#else
+#include <catch2/catch.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "PrecisionCore.h"
+#include "SpaceKitPrecision/Private/PrecisionBinaryKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionBlockKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionDatasetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionHashKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionImportKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionNetKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionReplayKernels.h"
+#include "SpaceKitPrecision/Private/PrecisionTrackKernels.h"
+
+using namespace PrecisionCore;
+
+TEST_CASE("Fixed-point arithmetic", "[RealFixed]")
+{
+	const real_fixed_type A(6);
+	const real_fixed_type B(2);
+
+	CHECK(A + B == real_fixed_type(8));
+	CHECK(A - B == real_fixed_type(4));
+	CHECK(A * B == real_fixed_type(12));
+	CHECK(A / B == real_fixed_type(3));
+	CHECK(-A < B);
+	CHECK(real_fixed_type("0.25") * real_fixed_type(4) == real_fixed_type(1));
+}
+
+TEST_CASE("Fixed-point string round trip", "[RealFixed]")
+{
+	// The shortest fraction that converts back to the same value
+	CHECK(std::string(*real_fixed_type(3).ToString()) == "3.0");
+	CHECK(std::string(*real_fixed_type("0.1").ToString()) == "0.1");
+	CHECK(std::string(*real_fixed_type("-0.5").ToString()) == "-0.5");
+
+	std::mt19937_64 Random(39);
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		const real_fixed_type Value = real_fixed_type::FromMantissa(real_fixed_type::ttIntMantissaType(ttmath::sint(Random())) * real_fixed_type::ttIntMantissaType(ttmath::sint(Random() >> (i % 64))));
+		char Buffer[real_fixed_type::MaxChars];
+		const int32 Length = Value.ToChars(Buffer, real_fixed_type::MaxChars);
+		real_fixed_type Parsed;
+		REQUIRE(real_fixed_type::FromChars(Buffer, Parsed) == Length);
+		REQUIRE(Parsed == Value);
+	}
+
+	char Small[4];
+	CHECK(real_fixed_type("-12345.6789").ToChars(Small, 4) == 0);
+
+	// Parsing rounds to the nearest quantum (2^-26), and stops at the end of the number
+	const real_fixed_type Quantum = real_fixed_type::FromMantissa(1);
+	real_fixed_type Parsed;
+	CHECK(real_fixed_type::FromChars("0.00000001)", Parsed) == 10);
+	CHECK(Parsed == Quantum);
+	CHECK(real_fixed_type::FromChars("-1.5e3", Parsed) == 6);
+	CHECK(Parsed == real_fixed_type(-1500));
+	CHECK(real_fixed_type::FromChars("e3", Parsed) == 0);
+	CHECK(real_fixed_type("1e100") == real_fixed_type::GetMaxValue());
+}
+
+TEST_CASE("Big float string round trip", "[RealFloat]")
+{
+	auto Format = [](const tt_real_float_type& Value)
+	{
+		char Buffer[PrecisionText::FloatChars(TTMATH_BITS(TT_REAL_FLOAT_SIZE))];
+		PrecisionText::FormatFloat(Value, Buffer, int32(sizeof(Buffer)));
+		return std::string(Buffer);
+	};
+	auto Parse = [](const char* Text)
+	{
+		tt_real_float_type Value;
+		PrecisionText::ParseFloat(Text, Value);
+		return Value;
+	};
+
+	CHECK(Format(tt_real_float_type(2)) == "2");
+	CHECK(Format(Parse("0.1")) == "0.1");
+	CHECK(Format(tt_real_float_type(-0.25)) == "-0.25");
+	CHECK(Format(Parse("1e22")) == "1e+22");
+	CHECK(Format(Parse("0.0000001")) == "1e-7");
+
+	std::mt19937_64 Random(39);
+	std::uniform_int_distribution<int32> Exponents(-900, 900);
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		tt_real_float_type Value;
+		Value.mantissa.table[0] = Random();
+		Value.mantissa.table[1] = Random() | (ttmath::uint(1) << (TTMATH_BITS_PER_UINT - 1));
+		Value.exponent = Exponents(Random);
+		Value.info = (i & 1) ? TTMATH_BIG_SIGN : 0;
+
+		const std::string String = Format(Value);
+		tt_real_float_type Parsed;
+		REQUIRE(PrecisionText::ParseFloat(String.c_str(), Parsed) == int32(String.size()));
+		REQUIRE(Parsed == Value);
+	}
+
+	// Parsing rounds to the nearest, where ttmath truncates: 1 + 0.75 units in the last place rounds up
+	tt_real_float_type Expected(1);
+	Expected.mantissa.table[0] = 1;
+	CHECK(Parse("1.0000000000000000000000000000000000000044081660908397065212") == Expected);
+
+	char Small[4];
+	CHECK(PrecisionText::FormatFloat(tt_real_float_type("1.5e-20"), Small, 4) == 0);
+}
+
+TEST_CASE("Text import tokens", "[RealFixed]")
+{
+	// ImportTextItem reads (number), with blanks inside the parentheses, or a bare number, and nothing after it
+	real_fixed_type Value;
+	auto ParseFixed = [&Value](const char* Text) { return real_fixed_type::FromChars(Text, Value); };
+	CHECK(PrecisionText::ParseToken("(1.5),(2.5)", ParseFixed) == 5);
+	CHECK(Value == real_fixed_type("1.5"));
+	CHECK(PrecisionText::ParseToken("( -2.25 )", ParseFixed) == 9);
+	CHECK(Value == real_fixed_type("-2.25"));
+	CHECK(PrecisionText::ParseToken("3)", ParseFixed) == 1);
+	CHECK(PrecisionText::ParseToken("(1.5", ParseFixed) == 0);
+	CHECK(PrecisionText::ParseToken("(1.5x)", ParseFixed) == 0);
+	CHECK(PrecisionText::ParseToken("()", ParseFixed) == 0);
+
+	// Linear in the size of the buffer: each token is read from where the previous one stopped
+	std::string Buffer;
+	for (int32 i = 0; i < 100000; ++i)
+	{
+		Buffer += "(" + std::to_string(i) + ".5),";
+	}
+	const char* Cursor = Buffer.c_str();
+	int32 NumTokens = 0;
+	while (const int32 Length = PrecisionText::ParseToken(Cursor, ParseFixed))
+	{
+		REQUIRE(Value == real_fixed_type(NumTokens) + real_fixed_type("0.5"));
+		Cursor += Length + 1;
+		++NumTokens;
+	}
+	CHECK(NumTokens == 100000);
+
+	// NaN round trips through the big float text
+	tt_real_float_type Float;
+	CHECK(PrecisionText::ParseToken("(NaN)", [&Float](const char* Text) { return PrecisionText::ParseFloat(Text, Float); }) == 5);
+	CHECK(Float.IsNan());
+}
+
+TEST_CASE("Fixed-point to big float conversions are exact", "[RealFixed]")
+{
+	std::mt19937_64 Random(42);
+	for (int32 i = 0; i < 1000; ++i)
+	{
+		ttmath::Int<TTMATH_BITS(REAL_FIXED_MANTISSA_SIZE + REAL_FIXED_EXPONENT)> Mantissa;
+		Mantissa.table[0] = Random();
+		Mantissa.table[1] = Random() >> 8;
+		if (Random() & 1)
+		{
+			Mantissa.ChangeSign();
+		}
+
+		const real_fixed_type Value = real_fixed_type::FromMantissa(Mantissa);
+		CHECK(real_fixed_type::FromBigRounded(Value.ToBigExact<tt_real_float_type>()) == Value);
+	}
+
+	CHECK(real_fixed_type::FromBigRounded(tt_real_float_type("1e300")) == real_fixed_type::GetMaxValue());
+}
+
+TEST_CASE("Quaternion kernels", "[Geometry]")
+{
+	const FFixedVector Vec(real_fixed_type(1), real_fixed_type("0.2"), real_fixed_type(5));
+	// Degrees to radians alone costs a few quanta per degree, see FRealFixed::DegToRad
+	const real_fixed_type Tolerance("0.00001");
+
+	// 90 degrees of yaw turns X into Y
+	const FFixedQuat Yaw = QuatFromRotator(real_fixed_type(0), real_fixed_type(90), real_fixed_type(0));
+	const FFixedVector Rotated = PrecisionGeometry::QuatRotateVector(Yaw, Vec);
+	CHECK(FMath::Abs(Rotated.X.ToDouble() + 0.2) < Tolerance.ToDouble());
+	CHECK(FMath::Abs(Rotated.Y.ToDouble() - 1.0) < Tolerance.ToDouble());
+	CHECK(FMath::Abs(Rotated.Z.ToDouble() - 5.0) < Tolerance.ToDouble());
+
+	// The conjugate rotates back
+	const FFixedVector Back = PrecisionGeometry::QuatRotateVector(PrecisionGeometry::QuatInverse(Yaw), Rotated);
+	CHECK(FMath::Abs((Back.X - Vec.X).ToDouble()) < Tolerance.ToDouble());
+	CHECK(FMath::Abs((Back.Y - Vec.Y).ToDouble()) < Tolerance.ToDouble());
+
+	// Rotating twice by 90 degrees is rotating once by 180 degrees
+	const FFixedQuat Twice = PrecisionGeometry::QuatMultiply(Yaw, Yaw);
+	const FFixedVector Half = PrecisionGeometry::QuatRotateVector(Twice, Vec);
+	CHECK(FMath::Abs(Half.X.ToDouble() + 1.0) < Tolerance.ToDouble());
+	CHECK(FMath::Abs(Half.Y.ToDouble() + 0.2) < Tolerance.ToDouble());
+
+	// Same with big floats
+	const FFloatQuat FloatYaw = QuatFromRotator(tt_real_float_type(0), tt_real_float_type(90), tt_real_float_type(0));
+	const FFloatVector FloatRotated = PrecisionGeometry::QuatRotateVector(FloatYaw, FFloatVector(tt_real_float_type(1), tt_real_float_type(0), tt_real_float_type(0)));
+	CHECK(std::abs(FloatRotated.Y.ToDouble() - 1.0) < 1e-15);
+}
+
+TEST_CASE("Transform kernels", "[Geometry]")
+{
+	const FFixedQuat Rotation = QuatFromRotator(real_fixed_type(30), real_fixed_type(-45), real_fixed_type(60));
+	const FFixedVector Location(real_fixed_type(1e9), real_fixed_type(-3), real_fixed_type("0.5"));
+	const FFixedVector Scale(real_fixed_type(2), real_fixed_type(4), real_fixed_type("0.5"));
+	const FFixedVector Vec(real_fixed_type("1.5"), real_fixed_type("-2.25"), real_fixed_type(10));
+
+	const FFixedVector Transformed = PrecisionGeometry::TransformPosition(Rotation, Location, Scale, Vec);
+	const FFixedVector Back = PrecisionGeometry::InverseTransformPosition(Rotation, Location, Scale, Transformed);
+	CHECK(FMath::Abs((Back.X - Vec.X).ToDouble()) < 1e-5);
+	CHECK(FMath::Abs((Back.Y - Vec.Y).ToDouble()) < 1e-5);
+	CHECK(FMath::Abs((Back.Z - Vec.Z).ToDouble()) < 1e-5);
+}
+
+TEST_CASE("Predicates", "[Predicates]")
+{
+	const real_fixed_type Zero(0);
+	const real_fixed_type One(1);
+	const real_fixed_type Offset(1000000000);
+
+	// Points of the z=0 plane, and one point above or below it, far from the origin
+	const real_fixed_type A[3] = { Offset, Offset, Zero };
+	const real_fixed_type B[3] = { Offset + One, Offset, Zero };
+	const real_fixed_type C[3] = { Offset, Offset + One, Zero };
+	const real_fixed_type Above[3] = { Offset, Offset, real_fixed_type::GetMinValue() };
+	const real_fixed_type OnPlane[3] = { Offset + One, Offset + One, Zero };
+
+	const real_fixed_type* const AbovePoints[4][3] = { { &A[0], &A[1], &A[2] }, { &B[0], &B[1], &B[2] }, { &C[0], &C[1], &C[2] }, { &Above[0], &Above[1], &Above[2] } };
+	const real_fixed_type* const FlatPoints[4][3] = { { &A[0], &A[1], &A[2] }, { &B[0], &B[1], &B[2] }, { &C[0], &C[1], &C[2] }, { &OnPlane[0], &OnPlane[1], &OnPlane[2] } };
+
+	CHECK(PrecisionPredicates::Orient3D(AbovePoints) != 0);
+	CHECK(PrecisionPredicates::Orient3D(FlatPoints) == 0);
+
+	// Big floats thousands of binary orders of magnitude apart: 1 * +-2^-3000 + 2^1000 * 2^-1000 + 1 * -1 is exactly +-2^-3000
+	const auto PowerOfTwo = [](int32 Power)
+	{
+		tt_real_float_type Result;
+		Result.SetOne();
+		Result.exponent.AddInt(Power);
+		return Result;
+	};
+	const tt_real_float_type BigOne(1);
+	const tt_real_float_type BigMinusOne(-1);
+	const tt_real_float_type Huge = PowerOfTwo(1000);
+	const tt_real_float_type Small = PowerOfTwo(-1000);
+	const tt_real_float_type Tiny = PowerOfTwo(-3000);
+	const tt_real_float_type MinusTiny = -Tiny;
+	const tt_real_float_type* const Positive[2][3] = { { &BigOne, &Huge, &BigOne }, { &Tiny, &Small, &BigMinusOne } };
+	const tt_real_float_type* const Negative[2][3] = { { &BigOne, &Huge, &BigOne }, { &MinusTiny, &Small, &BigMinusOne } };
+	const tt_real_float_type BigZero(0);
+	const tt_real_float_type* const Orthogonal[2][3] = { { &BigZero, &Huge, &BigOne }, { &Tiny, &Small, &BigMinusOne } };
+	CHECK(PrecisionPredicates::DotSign(Positive) == 1);
+	CHECK(PrecisionPredicates::DotSign(Negative) == -1);
+	CHECK(PrecisionPredicates::DotSign(Orthogonal) == 0);
+
+	// The unit sphere around 2^125, too far for the double filter: E on it, at its center, then outside of it
+	const tt_real_float_type Far = PowerOfTwo(125);
+	const tt_real_float_type FarPlusOne = Far + BigOne;
+	const tt_real_float_type FarMinusOne = Far - BigOne;
+	const tt_real_float_type FarOutside = FarMinusOne - BigOne;
+	const tt_real_float_type* const Sphere[5][3] = { { &FarPlusOne, &Far, &Far }, { &Far, &FarPlusOne, &Far }, { &FarMinusOne, &Far, &Far }, { &Far, &Far, &FarMinusOne }, { &Far, &FarMinusOne, &Far } };
+	CHECK(PrecisionPredicates::InSphere(Sphere) == 0);
+	const tt_real_float_type* const Inside[5][3] = { { &FarPlusOne, &Far, &Far }, { &Far, &FarPlusOne, &Far }, { &FarMinusOne, &Far, &Far }, { &Far, &Far, &FarMinusOne }, { &Far, &Far, &Far } };
+	CHECK(PrecisionPredicates::InSphere(Inside) == 1);
+	const tt_real_float_type* const Outside[5][3] = { { &FarPlusOne, &Far, &Far }, { &Far, &FarPlusOne, &Far }, { &FarMinusOne, &Far, &Far }, { &Far, &Far, &FarMinusOne }, { &Far, &FarOutside, &Far } };
+	CHECK(PrecisionPredicates::InSphere(Outside) == -1);
+}
+
+TEST_CASE("Precision budget", "[PrecisionBudget]")
+{
+	const tt_real_float_type Angle("0.75");
+	const tt_real_float_type Full = ttmath::Sin(Angle);
+
+	// The full precision gives the ttmath result, and a budget stays close to it
+	CHECK(PrecisionBudget::Sin(Angle, 0) == Full);
+	CHECK(std::abs(PrecisionBudget::Sin(Angle, 64).ToDouble() - Full.ToDouble()) < 1e-15);
+}
+
+namespace
+{
+	// Random words, with the patterns that stress carries and quotient estimations: zeros, all ones, only a high or a low word
+	template<ttmath::uint Size>
+	ttmath::UInt<Size> MakeLimbTestValue(std::mt19937_64& Random)
+	{
+		ttmath::UInt<Size> Result;
+		const uint64 Pattern = Random() % 6;
+		for (ttmath::uint i = 0; i < Size; ++i)
+		{
+			switch (Pattern)
+			{
+			case 0: Result.table[i] = 0; break;
+			case 1: Result.table[i] = TTMATH_UINT_MAX_VALUE; break;
+			case 2: Result.table[i] = i + 1 == Size ? ttmath::uint(Random()) : 0; break;
+			case 3: Result.table[i] = i == 0 ? ttmath::uint(Random()) : 0; break;
+			default: Result.table[i] = ttmath::uint(Random()); break;
+			}
+		}
+
+		// Random number of significant words, so that every divisor length is covered
+		for (ttmath::uint i = Size - Random() % Size; i < Size; ++i)
+		{
+			Result.table[i] = 0;
+		}
+		return Result;
+	}
+
+	// The unrolled kernels give the same results as the bit by bit algorithms of ttmath
+	template<ttmath::uint Size>
+	void CheckUnrolledLimbKernels()
+	{
+		static_assert(ttmath::UnrolledKernels<Size>::enabled, "UInt of this size isn't unrolled");
+
+		std::mt19937_64 Random(Size);
+		for (int32 i = 0; i < 20000; ++i)
+		{
+			const ttmath::UInt<Size> A = MakeLimbTestValue<Size>(Random);
+			const ttmath::UInt<Size> B = MakeLimbTestValue<Size>(Random);
+
+			ttmath::UInt<Size * 2> Product, ReferenceProduct;
+			ttmath::UInt<Size>(A).MulBig(B, Product);
+			ttmath::UInt<Size>(A).MulBig(B, ReferenceProduct, 1);
+			REQUIRE(Product == ReferenceProduct);
+
+			ttmath::UInt<Size> Square = A;
+			ttmath::UInt<Size * 2> SquareProduct, ReferenceSquare;
+			Square.MulBig(Square, SquareProduct);
+			ttmath::UInt<Size>(A).MulBig(A, ReferenceSquare, 1);
+			REQUIRE(SquareProduct == ReferenceSquare);
+
+			// ttmath's bit by bit division (Div1) is wrong when the highest bit of the dividend is set, so the quotient and the
+			// remainder are checked against their definition instead: A = Quotient * B + Remainder, with Remainder < B
+			ttmath::UInt<Size> Quotient = A;
+			ttmath::UInt<Size> Remainder;
+			REQUIRE(Quotient.Div(B, &Remainder) == (B.IsZero() ? 1u : 0u));
+			if (!B.IsZero())
+			{
+				ttmath::UInt<Size * 2> Dividend, WideRemainder;
+				Quotient.MulBig(B, Dividend, 1);
+				WideRemainder = Remainder;
+				REQUIRE(Dividend.Add(WideRemainder) == 0);
+				REQUIRE(Dividend == ttmath::UInt<Size * 2>(A));
+				REQUIRE(Remainder < B);
+			}
+		}
+	}
+}
+
+TEST_CASE("Unrolled limb kernels", "[ttmath]")
+{
+	CheckUnrolledLimbKernels<1>();
+	CheckUnrolledLimbKernels<2>();
+	CheckUnrolledLimbKernels<3>();
+	CheckUnrolledLimbKernels<4>();
+#if TTMATH_UNROLLED_MAX_SIZE >= 8
+	// Divisors of more than 4 words, when the unrolled sizes are raised
+	CheckUnrolledLimbKernels<5>();
+	CheckUnrolledLimbKernels<8>();
+#endif
+}
+
+namespace
+{
+	struct FTraceBytes
+	{
+		std::vector<uint8> Bytes;
+
+		void Append(const uint8* Data, size_t Num)
+		{
+			Bytes.insert(Bytes.end(), Data, Data + Num);
+		}
+	};
+
+	// The core functions, pretending to be the engine ones
+	struct FOtherExecutor : PrecisionReplay::TCoreExecutor<real_fixed_type, tt_real_float_type>
+	{
+		static constexpr uint8 Id = PrecisionReplay::EngineExecutorId;
+	};
+}
+
+namespace
+{
+	// Bit stream with the SerializeBits of FBitWriter and FBitReader, lowest bits first
+	struct FBitStream
+	{
+		std::vector<uint8> Bytes;
+		int64 NumBits = 0;
+		int64 Position = 0;
+		bool bLoading = false;
+
+		bool IsLoading() const
+		{
+			return bLoading;
+		}
+
+		void SerializeBits(void* Data, int64 LengthBits)
+		{
+			uint8* DataBytes = static_cast<uint8*>(Data);
+			for (int64 Bit = 0; Bit < LengthBits; ++Bit)
+			{
+				const uint8 Mask = uint8(1 << (Bit & 7));
+				if (bLoading)
+				{
+					const bool bSet = Position < NumBits && (Bytes[size_t(Position >> 3)] >> (Position & 7)) & 1;
+					DataBytes[Bit >> 3] = uint8(bSet ? DataBytes[Bit >> 3] | Mask : DataBytes[Bit >> 3] & ~Mask);
+					++Position;
+				}
+				else
+				{
+					if ((NumBits & 7) == 0)
+					{
+						Bytes.push_back(0);
+					}
+					Bytes.back() |= uint8((DataBytes[Bit >> 3] & Mask) ? 1 << (NumBits & 7) : 0);
+					++NumBits;
+				}
+			}
+		}
+	};
+
+	template<int32 DroppedBits>
+	real_fixed_type NetRoundTrip(const real_fixed_type& Value, int64& NumBits)
+	{
+		FBitStream Stream;
+		real_fixed_type Copy = Value;
+		PrecisionNet::SerializeMantissa<DroppedBits>(Stream, Copy.mantissa);
+		NumBits = Stream.NumBits;
+
+		Stream.bLoading = true;
+		real_fixed_type Result(42);
+		REQUIRE(PrecisionNet::SerializeMantissa<DroppedBits>(Stream, Result.mantissa));
+		REQUIRE(Stream.Position == Stream.NumBits);
+		return Result;
+	}
+}
+
+TEST_CASE("Network encoding", "[Net]")
+{
+	int64 NumBits;
+
+	// Lossless, without the leading zero bits
+	CHECK(NetRoundTrip<0>(real_fixed_type(0), NumBits) == real_fixed_type(0));
+	CHECK(NumBits == 8);
+	CHECK(NetRoundTrip<0>(real_fixed_type("1000.5"), NumBits) == real_fixed_type("1000.5"));
+	CHECK(NumBits == 8 + 1 + 35);
+	CHECK(NetRoundTrip<0>(real_fixed_type::GetMaxValue(), NumBits) == real_fixed_type::GetMaxValue());
+	CHECK(NetRoundTrip<0>(real_fixed_type::FromMantissa(real_fixed_type::ttIntMantissaType(ttmath::sint(-1))), NumBits) == real_fixed_type::FromMantissa(real_fixed_type::ttIntMantissaType(ttmath::sint(-1))));
+
+	real_fixed_type Min;
+	Min.mantissa.SetMin();
+	CHECK(NetRoundTrip<0>(Min, NumBits) == Min);
+	CHECK(NumBits == 8 + 1 + 127);
+
+	std::mt19937_64 Random(41);
+	for (int32 i = 0; i < 10000; ++i)
+	{
+		const real_fixed_type Value = real_fixed_type::FromMantissa(real_fixed_type::ttIntMantissaType(ttmath::sint(Random() >> (i % 64))) * real_fixed_type::ttIntMantissaType(ttmath::sint(Random())));
+		REQUIRE(NetRoundTrip<0>(Value, NumBits) == Value);
+
+		// Quantized to 1/128: rounded to the nearest multiple, ties away from zero
+		const real_fixed_type Quantized = NetRoundTrip<REAL_FIXED_EXPONENT - 7>(Value, NumBits);
+		const real_fixed_type Error = Quantized < Value ? Value - Quantized : Quantized - Value;
+		REQUIRE(Error <= real_fixed_type::FromMantissa(real_fixed_type::ttIntMantissaType(ttmath::sint(1) << (REAL_FIXED_EXPONENT - 8))));
+		REQUIRE((Quantized.mantissa % real_fixed_type::ttIntMantissaType(ttmath::sint(1) << (REAL_FIXED_EXPONENT - 7))).IsZero());
+	}
+
+	// A position within 1,000,000 units, rounded to 1 unit, takes 27 bits per component
+	CHECK(NetRoundTrip<REAL_FIXED_EXPONENT>(real_fixed_type("-999999.6"), NumBits) == real_fixed_type(-1000000));
+	CHECK(NumBits == 7 + 1 + 19);
+	CHECK(NetRoundTrip<REAL_FIXED_EXPONENT>(real_fixed_type("0.49"), NumBits) == real_fixed_type(0));
+	CHECK(NumBits == 7);
+
+	// Rounding up the biggest values saturates
+	CHECK(NetRoundTrip<REAL_FIXED_EXPONENT>(real_fixed_type::GetMaxValue(), NumBits) == real_fixed_type::GetMaxValue());
+	CHECK(NetRoundTrip<REAL_FIXED_EXPONENT>(Min, NumBits) == Min);
+
+	// Malformed data: a length beyond the mantissa
+	FBitStream Stream;
+	uint32 Length = 127;
+	Stream.SerializeBits(&Length, 7);
+	Stream.bLoading = true;
+	real_fixed_type Result(42);
+	CHECK_FALSE(PrecisionNet::SerializeMantissa<REAL_FIXED_EXPONENT>(Stream, Result.mantissa));
+	CHECK(Result == real_fixed_type(0));
+}
+
+TEST_CASE("Network delta encoding", "[Net]")
+{
+	using FMantissa = real_fixed_type::ttIntMantissaType;
+	constexpr int32 NumComponents = 9;
+	constexpr int32 NumItems = 200;
+
+	// Transforms of a projectile pool, that move a little between two replications
+	std::mt19937_64 Random(42);
+	std::vector<FMantissa> Base(NumItems * NumComponents);
+	for (FMantissa& Mantissa : Base)
+	{
+		Mantissa = real_fixed_type(int32(Random() % 2000000) - 1000000).mantissa;
+	}
+	std::vector<FMantissa> Next = Base;
+	for (int32 Index = 0; Index < NumItems; Index += 4)
+	{
+		for (int32 Component = 0; Component < 3; ++Component)
+		{
+			Next[Index * NumComponents + Component] = (real_fixed_type::FromMantissa(Next[Index * NumComponents + Component]) + real_fixed_type("0.75")).mantissa;
+		}
+	}
+	Next[5] = real_fixed_type::GetMaxValue().mantissa;
+	Next[6].SetMin();
+
+	FBitStream Stream;
+	uint32 Num = NumItems;
+	PrecisionNet::SerializeVarUInt32(Stream, Num);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		REQUIRE(PrecisionNet::SerializeElementDelta<NumComponents>(Stream, &Base[Index * NumComponents], &Next[Index * NumComponents]));
+	}
+
+	// 1 bit per unchanged transform, and about 37 bits per moved component, where the whole array takes 28,800 bytes
+	CHECK(Stream.NumBits < 200 + 50 * (NumComponents + 3 * 37) + 2 * 256);
+
+	Stream.bLoading = true;
+	uint32 NumRead = 0;
+	PrecisionNet::SerializeVarUInt32(Stream, NumRead);
+	CHECK(NumRead == Num);
+	std::vector<FMantissa> Received(NumItems * NumComponents);
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		REQUIRE(PrecisionNet::SerializeElementDelta<NumComponents>(Stream, &Base[Index * NumComponents], &Received[Index * NumComponents]));
+	}
+	CHECK(Received == Next);
+	CHECK(Stream.Position == Stream.NumBits);
+
+	// Without a base, the whole elements are sent
+	FBitStream FullStream;
+	REQUIRE(PrecisionNet::SerializeElementDelta<NumComponents>(FullStream, static_cast<const FMantissa*>(nullptr), &Next[0]));
+	FullStream.bLoading = true;
+	std::vector<FMantissa> Full(NumComponents);
+	REQUIRE(PrecisionNet::SerializeElementDelta<NumComponents>(FullStream, static_cast<const FMantissa*>(nullptr), &Full[0]));
+	CHECK(std::equal(Full.begin(), Full.end(), Next.begin()));
+
+	// Variable-length integers
+	for (uint32 Value : { 0u, 127u, 128u, 300000u, 0xffffffffu })
+	{
+		FBitStream IntStream;
+		uint32 Written = Value;
+		PrecisionNet::SerializeVarUInt32(IntStream, Written);
+		IntStream.bLoading = true;
+		uint32 Read = 1;
+		PrecisionNet::SerializeVarUInt32(IntStream, Read);
+		CHECK(Read == Value);
+		CHECK(IntStream.NumBits == 8 * (Value < 128 ? 1 : Value < 16384 ? 2 : Value < 2097152 ? 3 : 5));
+	}
+}
+
+namespace
+{
+	// Byte archive, with the interface of FArchive the binary kernels use
+	struct FByteStream
+	{
+		std::vector<uint8> Bytes;
+		size_t Position = 0;
+		bool bLoading = false;
+		bool bByteSwapping = false;
+
+		bool IsByteSwapping() const
+		{
+			return bByteSwapping;
+		}
+
+		void Serialize(void* Data, int64 Length)
+		{
+			uint8* DataBytes = static_cast<uint8*>(Data);
+			if (bLoading)
+			{
+				std::copy(Bytes.begin() + Position, Bytes.begin() + Position + size_t(Length), DataBytes);
+				Position += size_t(Length);
+			}
+			else
+			{
+				Bytes.insert(Bytes.end(), DataBytes, DataBytes + Length);
+			}
+		}
+
+		template<typename T>
+		FByteStream& operator<<(T& Value)
+		{
+			uint8 Swapped[sizeof(T)];
+			std::memcpy(Swapped, &Value, sizeof(T));
+			if (bByteSwapping)
+			{
+				std::reverse(Swapped, Swapped + sizeof(T));
+			}
+			Serialize(Swapped, sizeof(T));
+			if (bByteSwapping)
+			{
+				std::reverse(Swapped, Swapped + sizeof(T));
+			}
+			std::memcpy(&Value, Swapped, sizeof(T));
+			return *this;
+		}
+	};
+}
+
+TEST_CASE("Binary encoding", "[Binary]")
+{
+	// Mantissas are their words, lowest first, so on little-endian platforms the bytes of the integer, lowest first
+	real_fixed_type Value("-123456789.015625");
+	FByteStream Stream;
+	PrecisionBinary::SerializeInt(Stream, Value.mantissa);
+	REQUIRE(Stream.Bytes.size() == sizeof(Value.mantissa));
+	uint64 Low = 0;
+	std::memcpy(&Low, Stream.Bytes.data(), sizeof(Low));
+	CHECK(Low == uint64(int64(-123456789) * (int64(1) << REAL_FIXED_EXPONENT) - (int64(1) << (REAL_FIXED_EXPONENT - 6))));
+
+	Stream.bLoading = true;
+	real_fixed_type Loaded;
+	PrecisionBinary::SerializeInt(Stream, Loaded.mantissa);
+	CHECK(Loaded == Value);
+
+	// Archives that swap bytes swap each word
+	FByteStream Swapped;
+	Swapped.bByteSwapping = true;
+	PrecisionBinary::SerializeInt(Swapped, Value.mantissa);
+	REQUIRE(Swapped.Bytes.size() == Stream.Bytes.size());
+	CHECK(std::equal(Swapped.Bytes.begin(), Swapped.Bytes.begin() + sizeof(ttmath::uint), Stream.Bytes.rend() - sizeof(ttmath::uint)));
+	Swapped.bLoading = true;
+	Loaded = real_fixed_type();
+	PrecisionBinary::SerializeInt(Swapped, Loaded.mantissa);
+	CHECK(Loaded == Value);
+
+	// Big floats, including NaN
+	tt_real_float_type Float;
+	PrecisionText::ParseFloat("-1.5e300", Float);
+	tt_real_float_type NaN;
+	NaN.SetNan();
+	FByteStream FloatStream;
+	PrecisionBinary::SerializeBig(FloatStream, Float);
+	PrecisionBinary::SerializeBig(FloatStream, NaN);
+	CHECK(FloatStream.Bytes.size() == 2 * (sizeof(Float.exponent) + sizeof(Float.mantissa) + 1));
+	FloatStream.bLoading = true;
+	tt_real_float_type LoadedFloat;
+	tt_real_float_type LoadedNaN;
+	PrecisionBinary::SerializeBig(FloatStream, LoadedFloat);
+	PrecisionBinary::SerializeBig(FloatStream, LoadedNaN);
+	CHECK(LoadedFloat == Float);
+	CHECK(LoadedNaN.IsNan());
+}
+
+TEST_CASE("State hashes", "[Hash]")
+{
+	// XXH64 of the little-endian bytes of the words
+	auto HashWords = [](std::initializer_list<uint64> Words, uint64 Seed)
+	{
+		PrecisionHash::FXxHash64 Hash(Seed);
+		for (uint64 Word : Words)
+		{
+			Hash.Add(Word);
+		}
+		return Hash.Finish();
+	};
+	CHECK(HashWords({}, 0) == 0xef46db3751d8e999ull);
+	CHECK(HashWords({ 1, 2, 3 }, 0) == 0x8799e152e5c0cdfaull);
+	CHECK(HashWords({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }, 0) == 0x7baf501f77d78047ull);
+	CHECK(HashWords({ 1, 2, 3, 4, 5, 6, 7, 8, 9 }, 42) == 0x5e1604b2357d8129ull);
+
+	const uint8 Bytes[12] = { 1, 0, 0, 0, 0, 0, 0, 0, 2 };
+	PrecisionHash::FXxHash64 BytesHash;
+	BytesHash.AddBytes(Bytes, sizeof(Bytes));
+	CHECK(BytesHash.Finish() == HashWords({ 1, 2 }, 0));
+
+	// Numbers hash their values, and a single changed bit changes the hash
+	real_fixed_type Value("-123456.789");
+	PrecisionHash::FXxHash64 FixedHash;
+	FixedHash.Add(Value.mantissa);
+	PrecisionHash::FXxHash64 SameHash;
+	SameHash.Add(real_fixed_type("-123456.789").mantissa);
+	CHECK(FixedHash.Finish() == SameHash.Finish());
+	Value.mantissa.table[0] ^= 1;
+	PrecisionHash::FXxHash64 ChangedHash;
+	ChangedHash.Add(Value.mantissa);
+	CHECK(ChangedHash.Finish() != SameHash.Finish());
+
+	tt_real_float_type Float;
+	PrecisionText::ParseFloat("1e-300", Float);
+	PrecisionHash::FXxHash64 FloatHash;
+	FloatHash.Add(Float);
+	PrecisionHash::FXxHash64 NegatedHash;
+	NegatedHash.Add(-Float);
+	CHECK(FloatHash.Finish() != NegatedHash.Finish());
+}
+
+TEST_CASE("Determinism traces", "[Replay]")
+{
+	using FExecutor = PrecisionReplay::TCoreExecutor<real_fixed_type, tt_real_float_type>;
+	using PrecisionReplay::EOp;
+
+	FTraceBytes Trace;
+	uint64 RollingHash = PrecisionReplay::HashSeed;
+	PrecisionReplay::WriteHeader<real_fixed_type, tt_real_float_type>(Trace, FExecutor::Id, "Tests");
+	const auto Run = [&](EOp Op, const auto& A, const auto& B)
+	{
+		PrecisionReplay::WriteOp(Trace, RollingHash, Op, A, B, FExecutor::Execute(Op, A, B));
+	};
+	PrecisionReplay::RunWorkload<real_fixed_type, tt_real_float_type>(7, 500, Run);
+
+	// The same build gives the same results
+	PrecisionReplay::FReplayReport Report = PrecisionReplay::Replay<FExecutor>(Trace.Bytes.data(), int64(Trace.Bytes.size()));
+	CHECK(Report.IsOk());
+	CHECK(Report.NumOps == 500);
+	CHECK(Report.RecordedBackend == "Tests");
+
+	// So are truncated traces
+	Report = PrecisionReplay::Replay<FExecutor>(Trace.Bytes.data(), int64(Trace.Bytes.size()) - 3);
+	CHECK(!Report.Error.empty());
+	CHECK(Report.NumOps == 499);
+
+	// A wrong result is pinpointed, with its function and inputs
+	const real_fixed_type A(3);
+	const real_fixed_type B(4);
+	PrecisionReplay::WriteOp(Trace, RollingHash, EOp::FixedMultiply, A, B, real_fixed_type(13));
+	Run(EOp::FixedAdd, A, B);
+	Report = PrecisionReplay::Replay<FExecutor>(Trace.Bytes.data(), int64(Trace.Bytes.size()));
+	CHECK(Report.FirstDivergentOp == 500);
+	CHECK(Report.Function == "FixedMultiply");
+	CHECK(Report.Expected.rfind("13.", 0) == 0);
+	CHECK(Report.Actual.rfind("12.", 0) == 0);
+
+	// Traces of other functions are reported as such
+	Report = PrecisionReplay::Replay<FOtherExecutor>(Trace.Bytes.data(), int64(Trace.Bytes.size()));
+	CHECK(!Report.Error.empty());
+	CHECK(Report.NumOps == 0);
+}
+
+TEST_CASE("Mapped datasets", "[Dataset]")
+{
+	using real_fixed_mantissa = real_fixed_type::ttIntMantissaType;
+	constexpr ttmath::uint Words = sizeof(real_fixed_mantissa) / sizeof(ttmath::uint);
+
+	// 1000 positions, in LODs of 10 and 100 positions
+	std::vector<real_fixed_mantissa> Mantissas;
+	for (int32 Index = 0; Index < 1000 * 3; ++Index)
+	{
+		Mantissas.push_back(real_fixed_type(std::to_string(int64(Index) * 1000003 - 1500000000) + ".25").mantissa);
+	}
+	const int64 LodCounts[] = { 10, 100 };
+
+	for (PrecisionDataset::ELayout Layout : { PrecisionDataset::ELayout::ArrayOfStructures, PrecisionDataset::ELayout::StructureOfArrays })
+	{
+		FTraceBytes Dataset;
+		PrecisionDataset::Write(Dataset, Mantissas.data(), 1000, REAL_FIXED_EXPONENT, Layout, LodCounts, 2);
+
+		// Mapped with boost, like a cooked dataset: the view reads the positions in the mapping
+		const std::string Path = "PrecisionDatasetTest.skpd";
+		std::FILE* File = std::fopen(Path.c_str(), "wb");
+		REQUIRE(File);
+		std::fwrite(Dataset.Bytes.data(), 1, Dataset.Bytes.size(), File);
+		std::fclose(File);
+		{
+			boost::interprocess::file_mapping Mapping(Path.c_str(), boost::interprocess::read_only);
+			boost::interprocess::mapped_region Region(Mapping, boost::interprocess::read_only);
+			const uint8* Data = static_cast<const uint8*>(Region.get_address());
+			REQUIRE(int64(Region.get_size()) == int64(Dataset.Bytes.size()));
+
+			PrecisionDataset::FHeader Header;
+			REQUIRE(PrecisionDataset::ReadHeader(Data, int64(Region.get_size()), int64(Region.get_size()), Header));
+			CHECK(Header.NumLods == 3);
+			CHECK(Header.PayloadOffset % PrecisionDataset::PayloadAlignment == 0);
+			CHECK(PrecisionDataset::FView::IsCompatible<Words>(Header, REAL_FIXED_EXPONENT));
+			CHECK(!PrecisionDataset::FView::IsCompatible<Words + 1>(Header, REAL_FIXED_EXPONENT));
+
+			const PrecisionDataset::FView Lod1(Data, Header, 1);
+			const PrecisionDataset::FView All(Data, Header);
+			CHECK(Lod1.Num() == 100);
+			CHECK(All.Num() == 1000);
+			real_fixed_type X, Y, Z;
+			for (int64 Index : { 0, 9, 99 })
+			{
+				Lod1.GetPosition(Index, X.mantissa, Y.mantissa, Z.mantissa);
+				CHECK((X.mantissa == Mantissas[Index * 3] && Y.mantissa == Mantissas[Index * 3 + 1] && Z.mantissa == Mantissas[Index * 3 + 2]));
+			}
+			All.GetMantissa(999, 2, Z.mantissa);
+			CHECK(Z.mantissa == Mantissas.back());
+
+			// The LODs are prefixes, in one range per component
+			int64 Offsets[3];
+			int64 Sizes[3];
+			const int32 NumRanges = Header.GetLodRanges(0, Offsets, Sizes);
+			CHECK(NumRanges == (Layout == PrecisionDataset::ELayout::ArrayOfStructures ? 1 : 3));
+			CHECK(Sizes[0] * NumRanges == 10 * 3 * int64(sizeof(real_fixed_mantissa)));
+			CHECK(std::memcmp(Data + Offsets[NumRanges - 1], &Mantissas[Layout == PrecisionDataset::ELayout::ArrayOfStructures ? 0 : 2], sizeof(real_fixed_mantissa)) == 0);
+
+			// A LOD read alone, like from bulk data that isn't mapped
+			Header.GetLodRanges(1, Offsets, Sizes);
+			std::vector<uint8> LodBytes;
+			for (int32 Range = 0; Range < NumRanges; ++Range)
+			{
+				LodBytes.insert(LodBytes.end(), Data + Offsets[Range], Data + Offsets[Range] + Sizes[Range]);
+			}
+			const PrecisionDataset::FView Lod1Alone(LodBytes.data(), Header.GetLodHeader(1));
+			CHECK(Lod1Alone.Num() == 100);
+			for (int64 Index : { 0, 50, 99 })
+			{
+				Lod1Alone.GetPosition(Index, X.mantissa, Y.mantissa, Z.mantissa);
+				CHECK((X.mantissa == Mantissas[Index * 3] && Y.mantissa == Mantissas[Index * 3 + 1] && Z.mantissa == Mantissas[Index * 3 + 2]));
+			}
+		}
+		std::remove(Path.c_str());
+
+		// Truncated or corrupted files are rejected
+		PrecisionDataset::FHeader Header;
+		CHECK(!PrecisionDataset::ReadHeader(Dataset.Bytes.data(), int64(Dataset.Bytes.size()), int64(Dataset.Bytes.size()) - 1, Header));
+		Dataset.Bytes[PrecisionDataset::HeaderSize] = 200;
+		CHECK(!PrecisionDataset::ReadHeader(Dataset.Bytes.data(), int64(Dataset.Bytes.size()), int64(Dataset.Bytes.size()), Header));
+	}
+}
+
+TEST_CASE("Block floating point", "[Block]")
+{
+	using real_fixed_mantissa = real_fixed_type::ttIntMantissaType;
+	constexpr ttmath::uint Words = sizeof(real_fixed_mantissa) / sizeof(ttmath::uint);
+
+	// Blocks of 64 values around Center, Spread quanta apart
+	const auto Encode = [](const std::string& Center, int64 Spread, int32 DroppedBits, std::vector<real_fixed_mantissa>& Values,
+		PrecisionBlock::TBlock<Words>& Block, std::vector<uint8>& Deltas)
+	{
+		std::mt19937_64 Random{ uint64(Spread) };
+		Values.clear();
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			real_fixed_mantissa Value = real_fixed_type(Center).mantissa;
+			Value.AddInt(ttmath::uint(Random() % uint64(Spread + 1)));
+			Values.push_back(Value);
+		}
+		Deltas.assign(size_t(PrecisionBlock::MaxDeltaBytes<Words>(64)), 0);
+		return PrecisionBlock::EncodeBlock(Values.data(), 64, DroppedBits, Block, Deltas.data());
+	};
+
+	std::vector<real_fixed_mantissa> Values;
+	PrecisionBlock::TBlock<Words> Block;
+	std::vector<uint8> Deltas;
+	std::vector<real_fixed_mantissa> Decoded(64);
+
+	// Lossless, on the narrowest differences that hold the spread
+	for (int64 Spread : { int64(0), int64(60000), int64(1) << 31, int64(1) << 50 })
+	{
+		const int64 NumBytes = Encode("-987654321.5", Spread, 0, Values, Block, Deltas);
+		CHECK(NumBytes == 64 * (Spread == 0 ? 0 : Spread < 65536 ? 2 : Spread < (int64(1) << 32) ? 4 : 8));
+		PrecisionBlock::DecodeBlock(Block, Deltas.data(), 0, 64, Decoded.data());
+		CHECK(Decoded == Values);
+		real_fixed_mantissa Value;
+		PrecisionBlock::DecodeValue(Block, Deltas.data(), 37, Value);
+		CHECK(Value == Values[37]);
+		PrecisionBlock::DecodeBlock(Block, Deltas.data(), 10, 5, Decoded.data());
+		CHECK(std::equal(Decoded.begin(), Decoded.begin() + 5, Values.begin() + 10));
+	}
+
+	// Shared trailing zeros are shifted out: whole numbers 1000 units apart take 16 bits
+	Values.clear();
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		Values.push_back(real_fixed_type(int32(Index * 1000 - 20000)).mantissa);
+	}
+	CHECK(PrecisionBlock::EncodeBlock(Values.data(), 64, 0, Block, Deltas.data()) == 64 * 2);
+	CHECK(Block.Shift >= REAL_FIXED_EXPONENT);
+	PrecisionBlock::DecodeBlock(Block, Deltas.data(), 0, 64, Decoded.data());
+	CHECK(Decoded == Values);
+
+	// Values too far apart for 64 bits are stored whole
+	Values[5] = real_fixed_type("1e20").mantissa;
+	Values[6] = real_fixed_type("-1e20").mantissa;
+	Values[7].table[0] |= 1;
+	CHECK(PrecisionBlock::EncodeBlock(Values.data(), 64, 0, Block, Deltas.data()) == PrecisionBlock::MaxDeltaBytes<Words>(64));
+	PrecisionBlock::DecodeBlock(Block, Deltas.data(), 0, 64, Decoded.data());
+	CHECK(Decoded == Values);
+
+	// Rounded to a quantum, values are within half of it
+	Encode("123.456", int64(1) << 40, 24, Values, Block, Deltas);
+	CHECK(Block.DeltaBytes == 2);
+	PrecisionBlock::DecodeBlock(Block, Deltas.data(), 0, 64, Decoded.data());
+	for (int32 Index = 0; Index < 64; ++Index)
+	{
+		real_fixed_mantissa Error = Decoded[Index];
+		Error.Sub(Values[Index]);
+		CHECK(!(Error > real_fixed_mantissa(1 << 23)));
+		CHECK(!(Error < real_fixed_mantissa(-(1 << 23))));
+	}
+}
+
+TEST_CASE("Keyframe tracks", "[Track]")
+{
+	using real_fixed_mantissa = real_fixed_type::ttIntMantissaType;
+	constexpr ttmath::uint Words = sizeof(real_fixed_mantissa) / sizeof(ttmath::uint);
+	constexpr int32 NumValues = 4;
+
+	// Differences are zigzag encoded, 7 bits per byte
+	const auto EncodedSize = [](const char* Value)
+	{
+		FTraceBytes Bytes;
+		const real_fixed_mantissa Key = real_fixed_type(Value).mantissa;
+		PrecisionTrack::WriteKey(Bytes, &Key, static_cast<const real_fixed_mantissa*>(nullptr), 1);
+		const uint8* Read = Bytes.Bytes.data();
+		real_fixed_mantissa Decoded;
+		CHECK(PrecisionTrack::ReadKey(Read, Read + Bytes.Bytes.size(), &Decoded, 1, true));
+		CHECK(Decoded == Key);
+		CHECK(Read == Bytes.Bytes.data() + Bytes.Bytes.size());
+		return Bytes.Bytes.size();
+	};
+	CHECK(EncodedSize("0") == 1);
+	CHECK(EncodedSize("-0.000000001") == 1);
+	CHECK(EncodedSize("1") == 4);
+	CHECK(EncodedSize("-1e25") == 16);
+
+	// A trajectory of 1000 keys, its time and 3 coordinates, written like TPrecisionKeyframeTrack does
+	std::vector<std::array<real_fixed_mantissa, NumValues>> Keys;
+	std::mt19937_64 Random(7);
+	real_fixed_type Time;
+	for (int32 Key = 0; Key < 1000; ++Key)
+	{
+		Time += real_fixed_type(int32(Random() % 100 + 1)) / real_fixed_type(60);
+		std::array<real_fixed_mantissa, NumValues> Values;
+		Values[0] = Time.mantissa;
+		for (int32 Value = 1; Value < NumValues; ++Value)
+		{
+			Values[Value] = (real_fixed_type(1000000 * Value) + real_fixed_type(int32(Random() % 20000) - 10000) / real_fixed_type(1024)).mantissa;
+		}
+		Keys.push_back(Values);
+	}
+	FTraceBytes Track;
+	std::vector<PrecisionTrack::TSeekPoint<Words>> SeekPoints;
+	for (size_t Key = 0; Key < Keys.size(); ++Key)
+	{
+		const bool bSeekPoint = Key % PrecisionTrack::SeekInterval == 0;
+		if (bSeekPoint)
+		{
+			SeekPoints.push_back({ Keys[Key][0], int64(Track.Bytes.size()) });
+		}
+		PrecisionTrack::WriteKey(Track, Keys[Key].data(), bSeekPoint ? nullptr : Keys[Key - 1].data(), NumValues);
+	}
+	CHECK(Track.Bytes.size() < Keys.size() * NumValues * sizeof(real_fixed_mantissa) / 3);
+
+	// Seeks, from scratch, and forward and backward from a cursor, find the same keys as a linear scan
+	const auto ExpectedKey = [&Keys](const real_fixed_mantissa& At)
+	{
+		int32 Key = 0;
+		while (Key + 1 < int32(Keys.size()) && !(At < Keys[Key + 1][0]))
+		{
+			++Key;
+		}
+		return Key;
+	};
+	PrecisionTrack::TCursor<Words, NumValues> Playing;
+	bool bAllFound = true;
+	for (int32 Sample = -10; Sample < 60000; Sample += 7)
+	{
+		const real_fixed_mantissa At = (real_fixed_type(Sample) / real_fixed_type(60)).mantissa;
+		const int32 Expected = ExpectedKey(At);
+		PrecisionTrack::TCursor<Words, NumValues> Fresh;
+		REQUIRE(PrecisionTrack::Seek(Track.Bytes.data(), int64(Track.Bytes.size()), int32(Keys.size()), SeekPoints.data(), At, Fresh));
+		REQUIRE(PrecisionTrack::Seek(Track.Bytes.data(), int64(Track.Bytes.size()), int32(Keys.size()), SeekPoints.data(), At, Playing));
+		for (const auto* Cursor : { &Fresh, &Playing })
+		{
+			bAllFound &= Cursor->Key == Expected && std::equal(Cursor->Current, Cursor->Current + NumValues, Keys[Expected].begin());
+			bAllFound &= Cursor->bHasNext == (Expected + 1 < int32(Keys.size()));
+			if (Cursor->bHasNext)
+			{
+				bAllFound &= std::equal(Cursor->Next, Cursor->Next + NumValues, Keys[Expected + 1].begin());
+			}
+		}
+		if (Sample % 1000 == 3)
+		{
+			const real_fixed_mantissa Back = (real_fixed_type(Sample / 2) / real_fixed_type(60)).mantissa;
+			REQUIRE(PrecisionTrack::Seek(Track.Bytes.data(), int64(Track.Bytes.size()), int32(Keys.size()), SeekPoints.data(), Back, Playing));
+			bAllFound &= Playing.Key == ExpectedKey(Back);
+		}
+	}
+	CHECK(bAllFound);
+
+	// Truncated tracks fail to seek past their end
+	PrecisionTrack::TCursor<Words, NumValues> Truncated;
+	CHECK(!PrecisionTrack::Seek(Track.Bytes.data(), int64(Track.Bytes.size()) - 2, int32(Keys.size()), SeekPoints.data(), Keys.back()[0], Truncated));
+	CHECK(Truncated.Key == -1);
+
+	// Loaded seek points past the keys, or out of order, are caught before seeking
+	CHECK(PrecisionTrack::AreSeekPointsValid(SeekPoints.data(), int32(SeekPoints.size()), int64(Track.Bytes.size())));
+	CHECK(!PrecisionTrack::AreSeekPointsValid(SeekPoints.data(), int32(SeekPoints.size()), SeekPoints.back().Offset - 1));
+	std::swap(SeekPoints[3].Time, SeekPoints[4].Time);
+	CHECK(!PrecisionTrack::AreSeekPointsValid(SeekPoints.data(), int32(SeekPoints.size()), int64(Track.Bytes.size())));
+}
+
+TEST_CASE("Bulk import", "[Import]")
+{
+	using real_fixed_mantissa = real_fixed_type::ttIntMantissaType;
+
+	// Short decimals take the 64-bit parser, that rounds like the general one, here given the same number with more digits and an exponent
+	std::mt19937_64 Random(49);
+	for (int32 i = 0; i < 20000; ++i)
+	{
+		const std::string Digits = std::string(20, '0') + std::to_string(Random() >> (i % 64));
+		const size_t Point = Digits.size() - size_t(i % 20);
+		real_fixed_mantissa Fast;
+		real_fixed_mantissa General;
+		const std::string FastText = (i % 2 ? "-" : "") + Digits.substr(0, Point) + "." + Digits.substr(Point);
+		const std::string GeneralText = (i % 2 ? "-" : "") + Digits + "000000000000000000000e-" + std::to_string(i % 20 + 21);
+		REQUIRE(PrecisionText::ParseFixed<REAL_FIXED_EXPONENT>(FastText.c_str(), Fast) == int32(FastText.size()));
+		REQUIRE(PrecisionText::ParseFixed<REAL_FIXED_EXPONENT>(GeneralText.c_str(), General) == int32(GeneralText.size()));
+		REQUIRE(Fast == General);
+	}
+	real_fixed_type Tenth;
+	CHECK(real_fixed_type::FromChars("0.1", Tenth) == 3);
+	CHECK(Tenth.mantissa == real_fixed_mantissa(6710886));
+
+	// Rows end at line breaks outside quotes, blank lines skipped
+	const std::string Csv = "---,Mass,Position\r\n\r\nA,1.5,\"(X=1,Y=2,Z=3)\"\n\"B\"\"\n2\", (2.25) ,\"X=-1, Y=0.5, Z=1e3\"\nC,heavy,(X=1,Y=2)";
+	std::vector<std::pair<const char*, const char*>> Rows;
+	PrecisionImport::SplitCsvRows(Csv.c_str(), int32(Csv.size()), [&Rows](const char* Start, const char* End) { Rows.emplace_back(Start, End); });
+	REQUIRE(Rows.size() == 4);
+	CHECK(std::string(Rows[0].first, Rows[0].second) == "---,Mass,Position");
+	CHECK(std::string(Rows[2].first, Rows[2].second) == "\"B\"\"\n2\", (2.25) ,\"X=-1, Y=0.5, Z=1e3\"");
+
+	std::vector<std::string> Cells;
+	PrecisionImport::SplitCsvCells(Rows[2].first, Rows[2].second, [&Cells](int32 Column, const char* Start, const char* End)
+	{
+		CHECK(Column == int32(Cells.size()));
+		Cells.emplace_back(Start, End);
+	});
+	REQUIRE(Cells.size() == 3);
+	CHECK(Cells[0] == "B\"\"\n2");
+	CHECK(Cells[1] == "(2.25)");
+
+	real_fixed_mantissa Mantissa;
+	real_fixed_mantissa Vector[3];
+	CHECK(PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(Cells[1].c_str(), Cells[1].c_str() + Cells[1].size(), Mantissa));
+	CHECK(Mantissa == real_fixed_type("2.25").mantissa);
+	CHECK(PrecisionImport::ParseVector<REAL_FIXED_EXPONENT>(Cells[2].c_str(), Cells[2].c_str() + Cells[2].size(), Vector));
+	CHECK((Vector[0] == real_fixed_type(-1).mantissa && Vector[1] == real_fixed_type("0.5").mantissa && Vector[2] == real_fixed_type(1000).mantissa));
+
+	// Cells that are only partly numbers are invalid, and 0
+	const std::string Partial = "1.5x";
+	CHECK(!PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(Partial.c_str(), Partial.c_str() + Partial.size(), Mantissa));
+	CHECK(Mantissa.IsZero());
+	const std::string Short = "(X=1,Y=2)";
+	CHECK(!PrecisionImport::ParseVector<REAL_FIXED_EXPONENT>(Short.c_str(), Short.c_str() + Short.size(), Vector));
+	CHECK(Vector[0].IsZero());
+
+	// JSON rows, whose strings and nested values can have commas and brackets
+	const std::string Json = " [ {\"Name\": \"A\", \"Note\": \"}, [\\\"\", \"Mass\": \"1.5\", \"Position\": {\"X\": 1, \"Y\": [2], \"Z\": 3}},"
+		" {\"Position\": {\"X\": -1, \"Y\": \"0.5\", \"Z\": 1e3}, \"Mass\": 2.25} ] ";
+	std::vector<std::pair<const char*, const char*>> Elements;
+	CHECK(PrecisionImport::SplitJsonArray(Json.c_str(), int32(Json.size()), [&Elements](const char* Start, const char* End) { Elements.emplace_back(Start, End); }));
+	REQUIRE(Elements.size() == 2);
+	const char* ValueStart;
+	const char* ValueEnd;
+	REQUIRE(PrecisionImport::FindJsonField(Elements[0].first, Elements[0].second, "Mass", 4, ValueStart, ValueEnd));
+	CHECK((PrecisionImport::ParseJsonNumber<REAL_FIXED_EXPONENT>(ValueStart, ValueEnd, Mantissa) && Mantissa == real_fixed_type("1.5").mantissa));
+	REQUIRE(PrecisionImport::FindJsonField(Elements[0].first, Elements[0].second, "Position", 8, ValueStart, ValueEnd));
+	CHECK(!PrecisionImport::ParseJsonVector<REAL_FIXED_EXPONENT>(ValueStart, ValueEnd, Vector));
+	REQUIRE(PrecisionImport::FindJsonField(Elements[1].first, Elements[1].second, "Position", 8, ValueStart, ValueEnd));
+	CHECK(PrecisionImport::ParseJsonVector<REAL_FIXED_EXPONENT>(ValueStart, ValueEnd, Vector));
+	CHECK((Vector[0] == real_fixed_type(-1).mantissa && Vector[1] == real_fixed_type("0.5").mantissa && Vector[2] == real_fixed_type(1000).mantissa));
+	CHECK(!PrecisionImport::FindJsonField(Elements[1].first, Elements[1].second, "Name", 4, ValueStart, ValueEnd));
+	CHECK(!PrecisionImport::SplitJsonArray("[1, 2", 5, [](const char*, const char*) {}));
+
+	// Ranges of rows parsed on threads, each into the slots of its rows, give the sequential result
+	std::string Table = "Value\n";
+	for (int32 Row = 0; Row < 10000; ++Row)
+	{
+		Table += std::to_string(int64(Random() % 2000000000) - 1000000000) + "." + std::to_string(Random() % 1000000) + "\n";
+	}
+	Rows.clear();
+	PrecisionImport::SplitCsvRows(Table.c_str(), int32(Table.size()), [&Rows](const char* Start, const char* End) { Rows.emplace_back(Start, End); });
+	REQUIRE(Rows.size() == 10001);
+	std::vector<real_fixed_mantissa> Sequential(Rows.size() - 1);
+	for (size_t Row = 1; Row < Rows.size(); ++Row)
+	{
+		REQUIRE(PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(Rows[Row].first, Rows[Row].second, Sequential[Row - 1]));
+	}
+	std::vector<real_fixed_mantissa> Parallel(Rows.size() - 1);
+	std::vector<std::thread> Threads;
+	constexpr size_t RowsPerThread = 1024;
+	for (size_t First = 0; First < Parallel.size(); First += RowsPerThread)
+	{
+		Threads.emplace_back([&, First]()
+		{
+			for (size_t Row = First; Row < std::min(Parallel.size(), First + RowsPerThread); ++Row)
+			{
+				PrecisionImport::ParseNumber<REAL_FIXED_EXPONENT>(Rows[Row + 1].first, Rows[Row + 1].second, Parallel[Row]);
+			}
+		});
+	}
+	for (std::thread& Thread : Threads)
+	{
+		Thread.join();
+	}
+	CHECK(Parallel == Sequential);
+	real_fixed_type Parsed;
+	CHECK(real_fixed_type::FromChars(Rows[1234].first, Parsed) == int32(Rows[1234].second - Rows[1234].first));
+	CHECK(Parsed.mantissa == Sequential[1233]);
+}
+
+TEST_CASE("Canonical encoding", "[Binary]")
+{
+	using real_fixed_mantissa = real_fixed_type::ttIntMantissaType;
+	constexpr ttmath::uint Words = sizeof(real_fixed_mantissa) / sizeof(ttmath::uint);
+	const PrecisionBinary::FCanonicalHeader Header = PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE, REAL_FIXED_EXPONENT, 1);
+
+	FTraceBytes Bytes;
+	PrecisionBinary::WriteCanonicalHeader(Bytes, Header);
+	REQUIRE(Bytes.Bytes.size() == size_t(PrecisionBinary::CanonicalHeaderSize));
+	PrecisionBinary::FCanonicalHeader Read;
+	REQUIRE(PrecisionBinary::ReadCanonicalHeader(Bytes.Bytes.data(), int64(Bytes.Bytes.size()), Read));
+	CHECK((Read.MantissaBits == REAL_FIXED_MANTISSA_SIZE && Read.FractionBits == REAL_FIXED_EXPONENT && Read.Backend == 1));
+	CHECK(Read.ValueBytes == (REAL_FIXED_MANTISSA_SIZE + REAL_FIXED_EXPONENT + 63) / 64 * 8);
+	Bytes.Bytes[4] = 2;
+	CHECK(!PrecisionBinary::ReadCanonicalHeader(Bytes.Bytes.data(), int64(Bytes.Bytes.size()), Read));
+
+	// Little-endian two's complement, whatever the platform
+	std::mt19937_64 Random(50);
+	std::vector<real_fixed_mantissa> Mantissas(1000);
+	for (size_t Index = 0; Index < Mantissas.size(); ++Index)
+	{
+		Mantissas[Index] = real_fixed_mantissa(ttmath::sint(Random())) * real_fixed_mantissa(ttmath::sint(Random() >> (Index % 64)));
+	}
+	Mantissas[0] = real_fixed_type(-1).mantissa;
+	std::vector<uint8> Encoded(Mantissas.size() * Header.ValueBytes);
+	PrecisionBinary::EncodeCanonical(Mantissas.data(), int64(Mantissas.size()), Header, Encoded.data());
+	CHECK(Encoded[REAL_FIXED_EXPONENT / 8] == uint8(0xff << (REAL_FIXED_EXPONENT % 8)));
+	CHECK(Encoded[Header.ValueBytes - 1] == 0xff);
+
+	std::vector<real_fixed_mantissa> Decoded(Mantissas.size());
+	CHECK(PrecisionBinary::DecodeCanonical<REAL_FIXED_EXPONENT>(Encoded.data(), int64(Mantissas.size()), Header, Decoded.data()) == 0);
+	CHECK(Decoded == Mantissas);
+
+	// From other settings: the same numbers, with 6 more fraction bits, or 10 fewer, on 64-bit values, or on 192-bit values
+	const auto Convert = [&](int32 MantissaBits, int32 FractionBits, const std::vector<uint8>& Values, std::vector<real_fixed_mantissa>& Out)
+	{
+		const PrecisionBinary::FCanonicalHeader Other = PrecisionBinary::MakeCanonicalHeader(MantissaBits, FractionBits, 0);
+		Out.resize(Values.size() / Other.ValueBytes);
+		return PrecisionBinary::DecodeCanonical<REAL_FIXED_EXPONENT>(Values.data(), int64(Out.size()), Other, Out.data());
+	};
+	const auto MakeValue = [](int64 Mantissa, int32 ValueBytes)
+	{
+		std::vector<uint8> Value(size_t(ValueBytes), Mantissa < 0 ? 0xff : 0);
+		for (int32 Byte = 0; Byte < 8; ++Byte)
+		{
+			Value[Byte] = uint8(uint64(Mantissa) >> (8 * Byte));
+		}
+		return Value;
+	};
+
+	// Rounded to the nearest, ties to even: 1.25, 1.5, 2.5, 1.75, -1.5 and -2.5 quanta
+	std::vector<uint8> Finer;
+	for (const int64 Quarters : { 5, 6, 10, 7, -6, -10 })
+	{
+		const std::vector<uint8> Value = MakeValue(Quarters, 16);
+		Finer.insert(Finer.end(), Value.begin(), Value.end());
+	}
+	std::vector<real_fixed_mantissa> Converted;
+	CHECK(Convert(REAL_FIXED_MANTISSA_SIZE - 2, REAL_FIXED_EXPONENT + 2, Finer, Converted) == 0);
+	const std::vector<real_fixed_mantissa> Rounded = { real_fixed_mantissa(1), real_fixed_mantissa(2), real_fixed_mantissa(2), real_fixed_mantissa(2),
+		real_fixed_mantissa(-2), real_fixed_mantissa(-2) };
+	CHECK(Converted == Rounded);
+
+	// Coarser fractions are exact, and sign extended from smaller values
+	std::vector<uint8> Coarser = MakeValue(-3 * (int64(1) << (REAL_FIXED_EXPONENT - 10)), 8);
+	CHECK(Convert(64 - (REAL_FIXED_EXPONENT - 10), REAL_FIXED_EXPONENT - 10, Coarser, Converted) == 0);
+	REQUIRE(Converted.size() == 1);
+	CHECK(Converted[0] == real_fixed_type(-3).mantissa);
+
+	// Larger values than the build's mantissas saturate
+	std::vector<uint8> Wide = MakeValue(-1, 24);
+	Wide[20] = 0x7f;
+	Wide[23] = 0x7f;
+	CHECK(Convert(192 - REAL_FIXED_EXPONENT, REAL_FIXED_EXPONENT, Wide, Converted) == 1);
+	CHECK(Converted[0] == real_fixed_type::GetMaxValue().mantissa);
+	Wide = MakeValue(-12345, 24);
+	CHECK(Convert(192 - REAL_FIXED_EXPONENT, REAL_FIXED_EXPONENT, Wide, Converted) == 0);
+	CHECK(Converted[0] == real_fixed_mantissa(-12345));
+
+	// The most negative mantissa fits, though its magnitude is past the positive ones, and the next value down saturates
+	real_fixed_mantissa Lowest;
+	Lowest.SetMin();
+	std::vector<uint8> LowestBytes(24, 0xff);
+	std::fill(LowestBytes.begin(), LowestBytes.begin() + sizeof(real_fixed_mantissa), uint8(0));
+	LowestBytes[sizeof(real_fixed_mantissa) - 1] = 0x80;
+	CHECK(Convert(192 - REAL_FIXED_EXPONENT, REAL_FIXED_EXPONENT, LowestBytes, Converted) == 0);
+	CHECK(Converted[0] == Lowest);
+	LowestBytes[sizeof(real_fixed_mantissa) - 1] = 0x7f;
+	CHECK(Convert(192 - REAL_FIXED_EXPONENT, REAL_FIXED_EXPONENT, LowestBytes, Converted) == 1);
+
+	// Random numbers written with 8 more fraction bits, then converted back, are the originals
+	std::vector<real_fixed_mantissa> Shifted(Mantissas.size());
+	for (size_t Index = 0; Index < Mantissas.size(); ++Index)
+	{
+		Shifted[Index] = Mantissas[Index];
+		Shifted[Index].Rcl(8);
+	}
+	std::vector<uint8> ShiftedBytes(Shifted.size() * Header.ValueBytes);
+	const PrecisionBinary::FCanonicalHeader ShiftedHeader = PrecisionBinary::MakeCanonicalHeader(REAL_FIXED_MANTISSA_SIZE + 8, REAL_FIXED_EXPONENT + 8, 0);
+	REQUIRE(ShiftedHeader.ValueBytes == Header.ValueBytes + 8);
+	ShiftedBytes.resize(Shifted.size() * ShiftedHeader.ValueBytes);
+	for (size_t Index = 0; Index < Shifted.size(); ++Index)
+	{
+		// The shifted mantissa, with the 8 bits shifted out as the next byte
+		PrecisionBinary::EncodeCanonical(&Shifted[Index], 1, Header, &ShiftedBytes[Index * ShiftedHeader.ValueBytes]);
+		const uint8 TopByte = uint8(Mantissas[Index].table[Words - 1] >> (TTMATH_BITS_PER_UINT - 8));
+		ShiftedBytes[Index * ShiftedHeader.ValueBytes + Header.ValueBytes] = TopByte;
+		std::fill_n(&ShiftedBytes[Index * ShiftedHeader.ValueBytes + Header.ValueBytes + 1], 7, (TopByte & 0x80) ? 0xff : 0);
+	}
+	CHECK(Convert(REAL_FIXED_MANTISSA_SIZE + 8, REAL_FIXED_EXPONENT + 8, ShiftedBytes, Converted) == 0);
+	CHECK(Converted == Mantissas);
+}